@@ -0,0 +1,827 @@
+/* ------------------------------------------------------------------ */
+/* decAccumulator.c -- exact summation module                         */
+/* ------------------------------------------------------------------ */
+/* This module comprises the routines for decAccumulators, which sum  */
+/* decNumbers, decimal64s, and decimal128s exactly and round once.    */
+/*                                                                    */
+/* Each value is added into three-digit limbs of the sum without any  */
+/* carrying: a limb holds an int32_t, and each add puts less than     */
+/* 10**5 into any limb (a three-digit group times 1, 10, or 100, as   */
+/* the first limb's exponent is a multiple of three), so the carries  */
+/* need only be propagated every DECACCLAZY adds, and when the sum is */
+/* finally wanted.  Subtraction needs no special treatment, as limbs  */
+/* may be negative.                                                   */
+/*                                                                    */
+/* Error handling is the same as decNumber (qv.); errors found while  */
+/* adding are held in the accumulator and set in the context by       */
+/* decAccumulatorToNumber.                                            */
+/* ------------------------------------------------------------------ */
+#include <string.h>           // [for memset/memcpy]
+#include <stdlib.h>           // [for malloc/free]
+
+#define  DECNUMDIGITS 34      // make decNumbers with space for 34
+#include "decNumber.h"        // base number library
+#include "decNumberLocal.h"   // decNumber local types, etc.
+#include "decAccumulator.h"   // our primary include
+
+/* Utility tables [in decimal64.c]; externs for C++ */
+#define DPD2BIN DPD2BINx
+extern const uInt COMBEXP[32], COMBMSD[32];
+extern const uShort DPD2BIN[1024];
+
+#define DECACCBASE 1000            // limb base (three digits)
+#define DECACCLAZY 20000           // adds between carry propagations
+                                   // [<(2**31-10**3)/10**5]
+
+/* Local routines */
+static Int  decAccPrepare(decAccumulator *, Int, Int, Int *);
+static void decAccCarry(decAccumulator *);
+static void decAccFinite(decAccumulator *, Int, Flag);
+static void decAccGroups(decAccumulator *, const uInt *, Int, Int, Flag);
+static void decAccSpecial(decAccumulator *, const decNumber *);
+static uByte decAccDecimal64(const decimal64 *, uInt *, Int *);
+static void decAccUnitGroups(const decNumber *, uInt *);
+static void decAccProduct(decAccumulator *, const uInt *, Int,
+                          const uInt *, Int, uInt *, Int, Flag);
+static void decAccSpecialProduct(decAccumulator *, const decNumber *,
+                                 const decNumber *);
+
+/* ------------------------------------------------------------------ */
+/* decAccumulatorInit -- set an accumulator to an empty sum           */
+/*                                                                    */
+/*   acc is the accumulator to initialize                             */
+/*   returns acc                                                      */
+/*                                                                    */
+/* The sum of no values is 0 (with an exponent of 0).  No error is    */
+/* possible.                                                          */
+/* ------------------------------------------------------------------ */
+decAccumulator * decAccumulatorInit(decAccumulator *acc) {
+  acc->exponent=0;
+  acc->ideal=0;
+  acc->length=0;
+  acc->size=DECACC_Local;
+  acc->lazy=0;
+  acc->status=0;
+  acc->signs=0;
+  acc->infs=0;
+  acc->limbs=acc->local;
+  acc->nan=NULL;
+  return acc;
+  } // decAccumulatorInit
+
+/* ------------------------------------------------------------------ */
+/* decAccumulatorFree -- free any storage used by an accumulator      */
+/*                                                                    */
+/*   acc is the accumulator to free                                   */
+/*                                                                    */
+/* The accumulator is left as set by decAccumulatorInit, so it may be */
+/* used for a new sum.  No error is possible.                         */
+/* ------------------------------------------------------------------ */
+void decAccumulatorFree(decAccumulator *acc) {
+  if (acc->limbs!=acc->local) free(acc->limbs);
+  free(acc->nan);                  // [may be NULL]
+  decAccumulatorInit(acc);
+  } // decAccumulatorFree
+
+/* ------------------------------------------------------------------ */
+/* decAccumulatorAdd -- add a decNumber to an accumulator             */
+/*                                                                    */
+/*   acc is the accumulator                                           */
+/*   dn  is the number to add                                         */
+/*   returns acc                                                      */
+/*                                                                    */
+/* The number is added exactly; to subtract, add the negated number   */
+/* (decNumberCopyNegate).  Errors are held until the sum is taken.    */
+/* ------------------------------------------------------------------ */
+decAccumulator * decAccumulatorAdd(decAccumulator *acc,
+                                   const decNumber *dn) {
+  const Unit *up;                  // work
+  Int  first;                      // limb for the lsu
+  Int  mult;                       // 1, 10, or 100, signed
+  Int  units;                      // Units in the coefficient
+  #if DECDPUN!=3
+  uInt u, piece, v=0;              // regrouping the Units
+  Int  have=0, left, take;         // ..
+  #endif
+
+  if (decNumberIsSpecial(dn)) {
+    decAccSpecial(acc, dn);
+    return acc;
+    }
+  decAccFinite(acc, dn->exponent, decNumberIsNegative(dn));
+  if (decNumberIsZero(dn)) return acc;
+  units=D2U(dn->digits);
+  mult=decAccPrepare(acc, dn->exponent, units*DECDPUN, &first);
+  if (mult==0) return acc;         // too wide
+  if (decNumberIsNegative(dn)) mult=-mult;
+
+  up=dn->lsu;
+  #if DECDPUN==3
+  for (; up<dn->lsu+units; up++, first++) acc->limbs[first]+=(Int)*up*mult;
+  #else
+  // regroup the digits into threes, taking up to three at a time from
+  // each Unit [v stays below 10**5]
+  for (; up<dn->lsu+units; up++) {
+    u=*up;
+    for (left=DECDPUN; left>0; left-=take) {
+      take=(left<3 ? left : 3);
+      piece=u%DECPOWERS[take];
+      u/=DECPOWERS[take];
+      v+=piece*DECPOWERS[have];
+      have+=take;
+      if (have>=3) {
+        acc->limbs[first++]+=(Int)(v%DECACCBASE)*mult;
+        v/=DECACCBASE;
+        have-=3;
+        }
+      }
+    }
+  if (have>0) acc->limbs[first]+=(Int)v*mult;
+  #endif
+
+  if (++acc->lazy>=DECACCLAZY) decAccCarry(acc);
+  return acc;
+  } // decAccumulatorAdd
+
+/* ------------------------------------------------------------------ */
+/* decAccumulatorAddNumbers -- add an array of decNumbers             */
+/*                                                                    */
+/*   acc   is the accumulator                                         */
+/*   dns   is an array of pointers to the numbers to add              */
+/*   count is the number of entries in dns                            */
+/*   returns acc                                                      */
+/* ------------------------------------------------------------------ */
+decAccumulator * decAccumulatorAddNumbers(decAccumulator *acc,
+                   const decNumber * const *dns, Int count) {
+  Int i;                           // work
+  for (i=0; i<count; i++) decAccumulatorAdd(acc, dns[i]);
+  return acc;
+  } // decAccumulatorAddNumbers
+
+/* ------------------------------------------------------------------ */
+/* decAccumulatorAddDecimal64s -- add an array of decimal64s          */
+/*                                                                    */
+/*   acc   is the accumulator                                         */
+/*   d64   is the array of decimal64s to add                          */
+/*   count is the number of entries in d64                            */
+/*   returns acc                                                      */
+/*                                                                    */
+/* Finite values are added directly from their declets, with no       */
+/* conversion to decNumber.                                           */
+/* ------------------------------------------------------------------ */
+decAccumulator * decAccumulatorAddDecimal64s(decAccumulator *acc,
+                   const decimal64 *d64, Int count) {
+  uInt  g[6];                      // three-digit groups, lsd first
+  Int   exp;                       // exponent
+  uByte bits;                      // sign and special bits
+  Int   i;                         // work
+  decNumber dn;                    // for a special value
+
+  for (i=0; i<count; i++) {
+    bits=decAccDecimal64(&d64[i], g, &exp);
+    if (bits&DECSPECIAL)
+      decAccSpecial(acc, decimal64ToNumber(&d64[i], &dn));
+     else decAccGroups(acc, g, 6, exp, (Flag)(bits!=0));
+    }
+  return acc;
+  } // decAccumulatorAddDecimal64s
+
+/* ------------------------------------------------------------------ */
+/* decAccumulatorAddDecimal128s -- add an array of decimal128s        */
+/*                                                                    */
+/*   acc   is the accumulator                                         */
+/*   d128  is the array of decimal128s to add                         */
+/*   count is the number of entries in d128                           */
+/*   returns acc                                                      */
+/*                                                                    */
+/* Finite values are added directly from their declets, with no       */
+/* conversion to decNumber.                                           */
+/* ------------------------------------------------------------------ */
+decAccumulator * decAccumulatorAddDecimal128s(decAccumulator *acc,
+                   const decimal128 *d128, Int count) {
+  uInt g[12];                      // three-digit groups, lsd first
+  uInt sour[4];                    // the words, least significant first
+  uInt comb, exp, uoff, dpd;       // ..
+  Int  i, n;                       // work
+  decNumber dn;                    // for a special value
+  uInt uiwork;                     // for macros
+
+  for (i=0; i<count; i++) {
+    // load source from storage; this is endian
+    if (DECLITEND) {
+      sour[0]=UBTOUI(d128[i].bytes   );
+      sour[1]=UBTOUI(d128[i].bytes+4 );
+      sour[2]=UBTOUI(d128[i].bytes+8 );
+      sour[3]=UBTOUI(d128[i].bytes+12);
+      }
+     else {
+      sour[3]=UBTOUI(d128[i].bytes   );
+      sour[2]=UBTOUI(d128[i].bytes+4 );
+      sour[1]=UBTOUI(d128[i].bytes+8 );
+      sour[0]=UBTOUI(d128[i].bytes+12);
+      }
+    comb=(sour[3]>>26)&0x1f;       // combination field
+    exp=COMBEXP[comb];             // ..
+    if (exp==3) {                  // is a special
+      decAccSpecial(acc, decimal128ToNumber(&d128[i], &dn));
+      continue;
+      }
+    exp=(exp<<12)+((sour[3]>>14)&0xfff);    // biased exponent
+    for (n=0, uoff=0; n<11; n++, uoff+=10) {
+      dpd=sour[uoff>>5]>>(uoff&31);
+      if ((uoff&31)>22) dpd|=sour[(uoff>>5)+1]<<(32-(uoff&31));
+      g[n]=DPD2BIN[dpd&0x3ff];
+      }
+    g[11]=COMBMSD[comb];
+    decAccGroups(acc, g, 12, (Int)exp-DECIMAL128_Bias,
+                 (Flag)(sour[3]>>31));
+    }
+  return acc;
+  } // decAccumulatorAddDecimal128s
+
+/* ------------------------------------------------------------------ */
+/* decAccumulatorAddProduct -- add the product of two decNumbers      */
+/*                                                                    */
+/*   acc is the accumulator                                           */
+/*   lhs is one number to multiply                                    */
+/*   rhs is the other                                                 */
+/*   returns acc                                                      */
+/*                                                                    */
+/* The product is added exactly, without being rounded.  NaNs and     */
+/* Infinities follow the decNumberMultiply rules, so 0 times Infinity */
+/* makes the sum NaN, with Invalid operation.  Products too small for */
+/* their exponent to be held (below -2*DECNUMMAXE) set                */
+/* DEC_Insufficient_storage.                                          */
+/* ------------------------------------------------------------------ */
+decAccumulator * decAccumulatorAddProduct(decAccumulator *acc,
+                   const decNumber *lhs, const decNumber *rhs) {
+  uInt  glocal[DECACC_Local*4];    // groups, if short enough
+  uInt *ga=glocal;                 // -> lhs groups
+  uInt *gb, *gp;                   // -> rhs groups, product groups
+  Int   na, nb;                    // groups in lhs and rhs
+
+  if ((lhs->bits|rhs->bits)&DECSPECIAL) {
+    decAccSpecialProduct(acc, lhs, rhs);
+    return acc;
+    }
+  // only the sum of two negative exponents can go out of range
+  if (rhs->exponent<0 && lhs->exponent<-2*DECNUMMAXE-rhs->exponent) {
+    acc->status|=DEC_Insufficient_storage;
+    return acc;
+    }
+  na=(lhs->digits+2)/3;
+  nb=(rhs->digits+2)/3;
+  if ((na+nb)*2>(Int)(sizeof(glocal)/sizeof(uInt))) {
+    ga=(uInt *)malloc((na+nb)*2*sizeof(uInt));
+    if (ga==NULL) {
+      acc->status|=DEC_Insufficient_storage;
+      return acc;
+      }
+    }
+  gb=ga+na;
+  gp=gb+nb;
+  decAccUnitGroups(lhs, ga);
+  decAccUnitGroups(rhs, gb);
+  decAccProduct(acc, ga, na, gb, nb, gp, lhs->exponent+rhs->exponent,
+                (Flag)(((lhs->bits^rhs->bits)&DECNEG)!=0));
+  if (ga!=glocal) free(ga);
+  return acc;
+  } // decAccumulatorAddProduct
+
+/* ------------------------------------------------------------------ */
+/* decAccumulatorAddProducts -- add the products of two arrays        */
+/*                                                                    */
+/*   acc   is the accumulator                                         */
+/*   lhs   is an array of pointers to numbers                         */
+/*   rhs   is an array of pointers to the numbers to multiply them by */
+/*   count is the number of entries in lhs and rhs                    */
+/*   returns acc                                                      */
+/* ------------------------------------------------------------------ */
+decAccumulator * decAccumulatorAddProducts(decAccumulator *acc,
+                   const decNumber * const *lhs,
+                   const decNumber * const *rhs, Int count) {
+  Int i;                           // work
+  for (i=0; i<count; i++) decAccumulatorAddProduct(acc, lhs[i], rhs[i]);
+  return acc;
+  } // decAccumulatorAddProducts
+
+/* ------------------------------------------------------------------ */
+/* decAccumulatorAddDecimal64Products -- add products of decimal64s   */
+/*                                                                    */
+/*   acc   is the accumulator                                         */
+/*   lhs   is an array of decimal64s                                  */
+/*   rhs   is an array of the decimal64s to multiply them by          */
+/*   count is the number of entries in lhs and rhs                    */
+/*   returns acc                                                      */
+/*                                                                    */
+/* Finite products are formed directly from the declets, with no      */
+/* conversion to decNumber.                                           */
+/* ------------------------------------------------------------------ */
+decAccumulator * decAccumulatorAddDecimal64Products(decAccumulator *acc,
+                   const decimal64 *lhs, const decimal64 *rhs,
+                   Int count) {
+  uInt  ga[6], gb[6], gp[12];      // groups of lhs, rhs, and product
+  Int   ea, eb;                    // exponents
+  uByte ba, bb;                    // sign and special bits
+  Int   i;                         // work
+  decNumber da, db;                // for special values
+
+  for (i=0; i<count; i++) {
+    ba=decAccDecimal64(&lhs[i], ga, &ea);
+    bb=decAccDecimal64(&rhs[i], gb, &eb);
+    if ((ba|bb)&DECSPECIAL) decAccSpecialProduct(acc,
+                                decimal64ToNumber(&lhs[i], &da),
+                                decimal64ToNumber(&rhs[i], &db));
+     else decAccProduct(acc, ga, 6, gb, 6, gp, ea+eb, (Flag)(ba!=bb));
+    }
+  return acc;
+  } // decAccumulatorAddDecimal64Products
+
+/* ------------------------------------------------------------------ */
+/* decAccumulatorToNumber -- round the sum to a decNumber             */
+/*                                                                    */
+/*   acc is the accumulator                                           */
+/*   res is the result, with space for set->digits digits             */
+/*   set is the context                                               */
+/*   returns res                                                      */
+/*                                                                    */
+/* The exact sum is rounded once, under set, with the status that a   */
+/* decNumberAdd with unlimited precision would have given (including  */
+/* the sign of a zero sum), followed by any errors found when the     */
+/* values were added.  The sum is unchanged, so more values may then  */
+/* be added.                                                          */
+/* ------------------------------------------------------------------ */
+decNumber * decAccumulatorToNumber(decAccumulator *acc, decNumber *res,
+                                   decContext *set) {
+  decNumber  dzero;                // the zero with the ideal exponent
+  decNumber  dlocal;               // the exact sum, if short enough
+  decNumber *sum=&dlocal;          // the exact sum
+  uByte      blocal[DECACC_Local*3];        // BCD, if short enough
+  uByte     *bcd=blocal;           // the sum in BCD, msd first
+  uByte     *ub;                   // work
+  Int        i, v, digits;         // ..
+  Flag       neg;                  // sum is negative
+
+  if (acc->length>0) decAccCarry(acc);
+  if (acc->status&DEC_Insufficient_storage) {
+    decNumberZero(res);
+    res->bits=DECNAN;
+    decContextSetStatus(set, acc->status);
+    return res;
+    }
+  if (acc->nan!=NULL) return decNumberPlus(res, acc->nan, set);
+  if (acc->infs!=0) {
+    decNumberZero(res);
+    if (acc->infs==3) {            // +Inf and -Inf
+      res->bits=DECNAN;
+      decContextSetStatus(set, DEC_Invalid_operation);
+      }
+     else res->bits=(uByte)(DECINF | (acc->infs==2 ? DECNEG : 0));
+    return res;
+    }
+
+  decNumberZero(&dzero);
+  dzero.exponent=acc->ideal;
+  if (acc->length==0) {            // an exact zero
+    // the sign is negative only if all the values were negative, or
+    // if rounding to floor and the signs differed
+    if (acc->signs==2
+     || (acc->signs==3 && set->round==DEC_ROUND_FLOOR)) dzero.bits=DECNEG;
+    return decNumberAdd(res, &dzero, &dzero, set);
+    }
+
+  neg=(Flag)(acc->limbs[acc->length-1]<0);
+  if (neg) {                       // work on the magnitude
+    for (i=0; i<acc->length; i++) acc->limbs[i]=-acc->limbs[i];
+    decAccCarry(acc);
+    }
+  digits=acc->length*3;
+  if (digits>(Int)sizeof(blocal)) {
+    bcd=(uByte *)malloc(digits);
+    if (bcd==NULL) acc->status|=DEC_Insufficient_storage;
+    }
+  if (bcd!=NULL) {
+    for (i=acc->length-1, ub=bcd; i>=0; i--, ub+=3) {
+      v=acc->limbs[i];
+      ub[0]=(uByte)(v/100);
+      ub[1]=(uByte)(v/10%10);
+      ub[2]=(uByte)(v%10);
+      }
+    for (ub=bcd; *ub==0; ub++) digits--;  // skip leading zeros
+    // digits below the ideal exponent are zero, and are dropped
+    if (acc->ideal>acc->exponent) digits-=acc->ideal-acc->exponent;
+    if (digits>DECNUMDIGITS) {
+      sum=(decNumber *)malloc(sizeof(decNumber)
+                              +(D2U(digits)-DECNUMUNITS)*sizeof(Unit));
+      if (sum==NULL) acc->status|=DEC_Insufficient_storage;
+      }
+    if (sum!=NULL) {
+      sum->digits=digits;          // [SetBCD fills this many digits]
+      decNumberSetBCD(sum, ub, (uInt)digits);
+      sum->exponent=(acc->ideal>acc->exponent ? acc->ideal
+                                              : acc->exponent);
+      sum->bits=(uByte)(neg ? DECNEG : 0);
+      }
+    }
+  if (neg) {                       // restore the sign
+    for (i=0; i<acc->length; i++) acc->limbs[i]=-acc->limbs[i];
+    decAccCarry(acc);
+    }
+  if (bcd==NULL || sum==NULL) {
+    decNumberZero(res);
+    res->bits=DECNAN;
+    decContextSetStatus(set, DEC_Insufficient_storage);
+    }
+   else decNumberAdd(res, sum, &dzero, set);  // round once
+  if (bcd!=blocal) free(bcd);
+  if (sum!=&dlocal) free(sum);
+  return res;
+  } // decAccumulatorToNumber
+
+/* ------------------------------------------------------------------ */
+/* decNumberDotProduct -- sum of products, rounded once               */
+/*                                                                    */
+/*   This computes C = A[0]*B[0] + A[1]*B[1] + ... + A[n-1]*B[n-1]    */
+/*                                                                    */
+/*   res   is C, the result.  C may be the same as any A[i] or B[i]   */
+/*   lhs   is A, an array of n pointers to numbers                    */
+/*   rhs   is B, an array of n pointers to numbers                    */
+/*   count is n, the number of products (the sum of none is 0)        */
+/*   set   is the context                                             */
+/*   returns res                                                      */
+/*                                                                    */
+/* C must have space for set->digits digits.  The products and their  */
+/* sum are exact, and only the sum is rounded, so the result with one */
+/* product is that of decNumberMultiply, and that of A[0]*B[0]+C*1 is */
+/* that of decNumberFMA.                                              */
+/* ------------------------------------------------------------------ */
+decNumber * decNumberDotProduct(decNumber *res,
+                                const decNumber * const *lhs,
+                                const decNumber * const *rhs,
+                                Int count, decContext *set) {
+  decAccumulator acc;              // the exact sum
+
+  decAccumulatorInit(&acc);
+  decAccumulatorAddProducts(&acc, lhs, rhs, count);
+  decAccumulatorToNumber(&acc, res, set);
+  decAccumulatorFree(&acc);
+  return res;
+  } // decNumberDotProduct
+
+/* ------------------------------------------------------------------ */
+/* decimal64DotProduct -- sum of decimal64 products, rounded once     */
+/*                                                                    */
+/*   res   is the result                                              */
+/*   lhs   is an array of n decimal64s                                */
+/*   rhs   is an array of n decimal64s to multiply them by            */
+/*   count is n, the number of products                               */
+/*   set   is the context, normally DEC_INIT_DECIMAL64                */
+/*   returns res                                                      */
+/*                                                                    */
+/* The sum is rounded to at most DECIMAL64_Pmax digits, and is then   */
+/* encoded as for decimal64FromNumber.                                */
+/* ------------------------------------------------------------------ */
+decimal64 * decimal64DotProduct(decimal64 *res, const decimal64 *lhs,
+                                const decimal64 *rhs, Int count,
+                                decContext *set) {
+  decAccumulator acc;              // the exact sum
+  decNumber  dn;                   // the rounded sum
+  decContext dc=*set;              // context for the rounding
+
+  if (dc.digits>DECIMAL64_Pmax) dc.digits=DECIMAL64_Pmax;
+  dc.status=0;
+  decAccumulatorInit(&acc);
+  decAccumulatorAddDecimal64Products(&acc, lhs, rhs, count);
+  decAccumulatorToNumber(&acc, &dn, &dc);
+  decAccumulatorFree(&acc);
+  if (dc.status!=0) decContextSetStatus(set, dc.status);
+  return decimal64FromNumber(res, &dn, set);
+  } // decimal64DotProduct
+
+/* ------------------------------------------------------------------ */
+/* decAccPrepare -- make room in the limbs for a coefficient          */
+/*                                                                    */
+/*   acc    is the accumulator                                        */
+/*   exp    is the exponent of the coefficient                        */
+/*   digits is the number of digits to be added (a multiple of 3, or  */
+/*          of DECDPUN)                                               */
+/*   first  is set to the index of the limb for the lsd               */
+/*   returns the multiplier for the groups of the coefficient (1, 10, */
+/*          or 100), or 0 if the sum would be too wide                */
+/*                                                                    */
+/* The limbs are extended, and if need be moved up (so the first limb */
+/* has an exponent which is a multiple of three and no higher than    */
+/* exp), and any new limbs are set to zero.                           */
+/* ------------------------------------------------------------------ */
+static Int decAccPrepare(decAccumulator *acc, Int exp, Int digits,
+                         Int *first) {
+  Int   base, top;                 // new extent, as exponents
+  Int   length;                    // new length
+  Int   shift;                     // limbs to move up
+  Int   r;                         // work
+  Int  *limbs;                     // new limbs
+  uInt  width;                     // new width, in digits
+
+  // fastpath: the coefficient lies within the limbs already in use
+  // [the exponents may be more than 2**31 apart]
+  if (exp>=acc->exponent && acc->length*3>=digits
+   && (uInt)exp-(uInt)acc->exponent<=(uInt)(acc->length*3-digits)) {
+    *first=(exp-acc->exponent)/3;
+    return (Int)DECPOWERS[(exp-acc->exponent)%3];
+    }
+
+  r=exp%3;
+  if (r<0) r+=3;
+  base=exp-r;                // [no overflow, as exp>=-2*DECNUMMAXE]
+  top=exp+digits;
+  if (acc->length>0) {
+    if (acc->exponent<base) base=acc->exponent;
+    if (acc->exponent+acc->length*3>top) top=acc->exponent+acc->length*3;
+    }
+  width=(uInt)top-(uInt)base;      // [as the difference may be >2**31]
+  if (width>DECACC_Digits) {
+    acc->status|=DEC_Insufficient_storage;
+    return 0;
+    }
+  length=(Int)(width+2)/3;
+  shift=(acc->length>0 ? (acc->exponent-base)/3 : 0);
+
+  if (length>acc->size) {          // need more limbs
+    r=acc->size*2;
+    if (r<length) r=length;
+    limbs=(Int *)malloc(r*sizeof(Int));
+    if (limbs==NULL) {
+      acc->status|=DEC_Insufficient_storage;
+      return 0;
+      }
+    memcpy(limbs+shift, acc->limbs, acc->length*sizeof(Int));
+    if (acc->limbs!=acc->local) free(acc->limbs);
+    acc->limbs=limbs;
+    acc->size=r;
+    }
+   else if (shift>0) memmove(acc->limbs+shift, acc->limbs,
+                             acc->length*sizeof(Int));
+  memset(acc->limbs, 0, shift*sizeof(Int));
+  memset(acc->limbs+shift+acc->length, 0,
+         (length-shift-acc->length)*sizeof(Int));
+  acc->length=length;
+  acc->exponent=base;
+
+  *first=(exp-base)/3;
+  return (Int)DECPOWERS[(exp-base)%3];
+  } // decAccPrepare
+
+/* ------------------------------------------------------------------ */
+/* decAccCarry -- propagate the carries between limbs                 */
+/*                                                                    */
+/*   acc is the accumulator                                           */
+/*                                                                    */
+/* Afterwards each limb is in the range 0-999, except the most        */
+/* significant, which is non-zero and in the range -999-999 (its sign */
+/* is the sign of the sum), and the length is 0 if the sum is zero.   */
+/* ------------------------------------------------------------------ */
+static void decAccCarry(decAccumulator *acc) {
+  Int  i, v, carry=0;              // work
+  Int *limbs;                      // new limbs
+
+  for (i=0; i<acc->length; i++) {
+    v=acc->limbs[i]+carry;
+    carry=v/DECACCBASE;            // [truncates towards zero]
+    v-=carry*DECACCBASE;
+    if (v<0) {                     // so borrow
+      v+=DECACCBASE;
+      carry--;
+      }
+    acc->limbs[i]=v;
+    }
+  // then any carry out is spread over new limbs, leaving the sign in
+  // the last
+  while (carry!=0) {
+    if (acc->length==acc->size) {
+      limbs=(Int *)malloc((acc->size+DECACC_Local)*sizeof(Int));
+      if (limbs==NULL) {
+        acc->status|=DEC_Insufficient_storage;
+        return;
+        }
+      memcpy(limbs, acc->limbs, acc->length*sizeof(Int));
+      if (acc->limbs!=acc->local) free(acc->limbs);
+      acc->limbs=limbs;
+      acc->size+=DECACC_Local;
+      }
+    if (carry>-DECACCBASE && carry<DECACCBASE) v=carry;
+     else {
+      v=carry%DECACCBASE;
+      if (v<0) v+=DECACCBASE;
+      }
+    carry=(carry-v)/DECACCBASE;
+    acc->limbs[acc->length++]=v;
+    }
+  while (acc->length>0 && acc->limbs[acc->length-1]==0) acc->length--;
+  acc->lazy=0;
+  } // decAccCarry
+
+/* ------------------------------------------------------------------ */
+/* decAccFinite -- note the exponent and sign of a finite value       */
+/*                                                                    */
+/*   acc is the accumulator                                           */
+/*   exp is the exponent of the value                                 */
+/*   neg is 1 if the value is negative                                */
+/* ------------------------------------------------------------------ */
+static void decAccFinite(decAccumulator *acc, Int exp, Flag neg) {
+  if (acc->signs==0 || exp<acc->ideal) acc->ideal=exp;
+  acc->signs|=(uByte)(neg ? 2 : 1);
+  } // decAccFinite
+
+/* ------------------------------------------------------------------ */
+/* decAccGroups -- add a coefficient given as three-digit groups      */
+/*                                                                    */
+/*   acc is the accumulator                                           */
+/*   g   is the groups (0-999), least significant first               */
+/*   n   is the number of groups                                      */
+/*   exp is the exponent                                              */
+/*   neg is 1 if the value is negative                                */
+/* ------------------------------------------------------------------ */
+static void decAccGroups(decAccumulator *acc, const uInt *g, Int n,
+                         Int exp, Flag neg) {
+  Int first, mult, i;              // work
+
+  decAccFinite(acc, exp, neg);
+  for (; n>0 && g[n-1]==0; n--);   // ignore leading zero groups
+  if (n==0) return;                // is zero
+  mult=decAccPrepare(acc, exp, n*3, &first);
+  if (mult==0) return;             // too wide
+  if (neg) mult=-mult;
+  for (i=0; i<n; i++) acc->limbs[first+i]+=(Int)g[i]*mult;
+  if (++acc->lazy>=DECACCLAZY) decAccCarry(acc);
+  } // decAccGroups
+
+/* ------------------------------------------------------------------ */
+/* decAccSpecial -- note an Infinity or NaN                           */
+/*                                                                    */
+/*   acc is the accumulator                                           */
+/*   dn  is the special value                                         */
+/*                                                                    */
+/* As for decNumberAdd, the first sNaN, or if none the first NaN, is  */
+/* the result; it is copied, as the caller's number may not last.     */
+/* ------------------------------------------------------------------ */
+static void decAccSpecial(decAccumulator *acc, const decNumber *dn) {
+  decNumber *nan;                  // copy of a NaN
+  Int units;                       // Units needed beyond those in it
+
+  if (decNumberIsInfinite(dn)) {
+    acc->infs|=(uByte)(decNumberIsNegative(dn) ? 2 : 1);
+    return;
+    }
+  if (acc->nan!=NULL
+   && (decNumberIsQNaN(dn) || decNumberIsSNaN(acc->nan))) return;
+  units=D2U(dn->digits)-DECNUMUNITS;
+  if (units<0) units=0;
+  nan=(decNumber *)malloc(sizeof(decNumber)+units*sizeof(Unit));
+  if (nan==NULL) {
+    acc->status|=DEC_Insufficient_storage;
+    return;
+    }
+  decNumberCopy(nan, dn);
+  free(acc->nan);                  // [may be NULL]
+  acc->nan=nan;
+  } // decAccSpecial
+
+/* ------------------------------------------------------------------ */
+/* decAccDecimal64 -- decode a decimal64 into three-digit groups      */
+/*                                                                    */
+/*   d64 is the decimal64 to decode                                   */
+/*   g   is set to its six groups, least significant first            */
+/*   exp is set to its exponent                                       */
+/*   returns DECNEG if it is negative, or DECSPECIAL if it is special */
+/*           (in which case g and exp are not set), or else 0         */
+/* ------------------------------------------------------------------ */
+static uByte decAccDecimal64(const decimal64 *d64, uInt *g, Int *exp) {
+  uInt sour, top;                  // the two words
+  uInt comb, bexp;                 // combination field, biased exponent
+  uInt uiwork;                     // for macros
+
+  // load source from storage; this is endian
+  if (DECLITEND) {
+    sour=UBTOUI(d64->bytes);
+    top=UBTOUI(d64->bytes+4);
+    }
+   else {
+    top=UBTOUI(d64->bytes);
+    sour=UBTOUI(d64->bytes+4);
+    }
+  comb=(top>>26)&0x1f;             // combination field
+  bexp=COMBEXP[comb];              // ..
+  if (bexp==3) return DECSPECIAL;  // is a special
+  bexp=(bexp<<8)+((top>>18)&0xff);
+  *exp=(Int)bexp-DECIMAL64_Bias;
+  g[5]=COMBMSD[comb];
+  g[4]=DPD2BIN[(top>>8)&0x3ff];
+  g[3]=DPD2BIN[((top&0xff)<<2) | (sour>>30)];
+  g[2]=DPD2BIN[(sour>>20)&0x3ff];
+  g[1]=DPD2BIN[(sour>>10)&0x3ff];
+  g[0]=DPD2BIN[sour&0x3ff];
+  return (uByte)(top>>31 ? DECNEG : 0);
+  } // decAccDecimal64
+
+/* ------------------------------------------------------------------ */
+/* decAccUnitGroups -- split a coefficient into three-digit groups    */
+/*                                                                    */
+/*   dn is the finite number                                          */
+/*   g  is set to the (digits+2)/3 groups, least significant first    */
+/* ------------------------------------------------------------------ */
+static void decAccUnitGroups(const decNumber *dn, uInt *g) {
+  const Unit *up=dn->lsu;          // work
+  #if DECDPUN==3
+  Int  n;                          // ..
+  for (n=D2U(dn->digits); n>0; n--) *g++=*up++;
+  #else
+  uInt u, piece, v=0;              // regrouping the Units
+  Int  have=0, left, take, digits; // ..
+  for (digits=dn->digits; digits>0; up++, digits-=DECDPUN) {
+    u=*up;
+    for (left=(digits<DECDPUN ? digits : DECDPUN); left>0; left-=take) {
+      take=(left<3 ? left : 3);
+      piece=u%DECPOWERS[take];
+      u/=DECPOWERS[take];
+      v+=piece*DECPOWERS[have];
+      have+=take;
+      if (have>=3) {
+        *g++=v%DECACCBASE;
+        v/=DECACCBASE;
+        have-=3;
+        }
+      }
+    }
+  if (have>0) *g=v;
+  #endif
+  } // decAccUnitGroups
+
+/* ------------------------------------------------------------------ */
+/* decAccProduct -- add the product of two coefficients               */
+/*                                                                    */
+/*   acc is the accumulator                                           */
+/*   ga  is the groups (0-999) of one coefficient, lsg first          */
+/*   na  is the number of groups in ga                                */
+/*   gb  is the groups of the other coefficient                       */
+/*   nb  is the number of groups in gb                                */
+/*   gp  is space for the na+nb groups of the product                 */
+/*   exp is the exponent of the product                               */
+/*   neg is 1 if the product is negative                              */
+/*                                                                    */
+/* The product is formed by long multiplication in base 1000, with    */
+/* the carry taken at each step (so no group exceeds 999*999+999+999  */
+/* before the carry), and is then added as groups.                    */
+/* ------------------------------------------------------------------ */
+static void decAccProduct(decAccumulator *acc, const uInt *ga, Int na,
+                          const uInt *gb, Int nb, uInt *gp, Int exp,
+                          Flag neg) {
+  Int  i, j;                       // work
+  uInt t, carry;                   // ..
+
+  for (; na>0 && ga[na-1]==0; na--); // ignore leading zero groups
+  for (; nb>0 && gb[nb-1]==0; nb--); // ..
+  if (na==0 || nb==0) {            // product is zero
+    decAccFinite(acc, exp, neg);
+    return;
+    }
+  for (i=0; i<na+nb; i++) gp[i]=0;
+  for (i=0; i<na; i++) {
+    if (ga[i]==0) continue;        // row adds nothing
+    for (carry=0, j=0; j<nb; j++) {
+      t=gp[i+j]+ga[i]*gb[j]+carry;
+      carry=t/DECACCBASE;
+      gp[i+j]=t-carry*DECACCBASE;
+      }
+    gp[i+nb]=carry;
+    }
+  decAccGroups(acc, gp, na+nb, exp, neg);
+  } // decAccProduct
+
+/* ------------------------------------------------------------------ */
+/* decAccSpecialProduct -- add a product with a special operand       */
+/*                                                                    */
+/*   acc is the accumulator                                           */
+/*   lhs is one operand                                               */
+/*   rhs is the other; at least one of them is special                */
+/*                                                                    */
+/* As for decNumberMultiply, an sNaN operand takes precedence over a  */
+/* NaN, and lhs over rhs.  0 times Infinity is added as an sNaN, so   */
+/* that the sum is NaN with Invalid operation.                        */
+/* ------------------------------------------------------------------ */
+static void decAccSpecialProduct(decAccumulator *acc,
+                                 const decNumber *lhs,
+                                 const decNumber *rhs) {
+  decNumber dn;                    // the Infinity or NaN to add
+
+  if (decNumberIsNaN(lhs) || decNumberIsNaN(rhs)) {
+    if (decNumberIsSNaN(lhs)
+     || (decNumberIsQNaN(lhs) && !decNumberIsSNaN(rhs)))
+      decAccSpecial(acc, lhs);
+     else decAccSpecial(acc, rhs);
+    return;
+    }
+  decNumberZero(&dn);
+  if (decNumberIsZero(lhs) || decNumberIsZero(rhs)) dn.bits=DECSNAN;
+   else dn.bits=(uByte)(DECINF | ((lhs->bits^rhs->bits)&DECNEG));
+  decAccSpecial(acc, &dn);
+  } // decAccSpecialProduct
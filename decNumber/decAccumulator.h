@@ -0,0 +1,81 @@
+/* ------------------------------------------------------------------ */
+/* decAccumulator.h -- Exact summation module header                  */
+/* ------------------------------------------------------------------ */
+/* A decAccumulator sums decNumbers, decimal64s, and decimal128s      */
+/* exactly, as a fixed-point integer whose least significant digit    */
+/* has the lowest exponent added so far, and rounds only once, when   */
+/* the sum is taken as a decNumber under a context.  The result is    */
+/* then the same as that of one decNumberAdd with all the values as   */
+/* operands: correctly rounded, with the ideal exponent (the lowest   */
+/* exponent of the values), and the usual NaN and Infinity rules.     */
+/*                                                                    */
+/* The accumulator grows as needed, up to DECACC_Digits digits (which */
+/* is enough for any sum of decimal128s); values too far apart to be  */
+/* held set DEC_Insufficient_storage.  Once it is no longer needed,   */
+/* an accumulator must be freed with decAccumulatorFree.              */
+/*                                                                    */
+/* Exact products may be added too, so decNumberDotProduct and        */
+/* decimal64DotProduct give sums of products with a single rounding.  */
+/* ------------------------------------------------------------------ */
+
+#if !defined(DECACCUMULATOR)
+  #define DECACCUMULATOR
+  #define DECACCNAME     "decAccumulator"               /* Short name */
+  #define DECACCFULLNAME "Decimal Exact Summation"    /* Verbose name */
+  #define DECACCAUTHOR   "Mike Cowlishaw"             /* Who to blame */
+
+  /* Required includes                                                */
+  #include "decimal64.h"
+  #include "decimal128.h"
+
+  /* parameters for decAccumulators                                   */
+  #define DECACC_Digits 12600   /* most digits in a sum [decimal128s] */
+  #define DECACC_Local  16      /* limbs held in the structure        */
+
+  /* The sum is held in limbs of three digits each, least significant */
+  /* first; between carry propagations a limb may hold any int32_t,   */
+  /* and the most significant limb carries the sign.                  */
+  typedef struct {
+    int32_t    exponent;        /* exponent of the first limb         */
+    int32_t    ideal;           /* lowest exponent added              */
+    int32_t    length;          /* limbs in use                       */
+    int32_t    size;            /* limbs available                    */
+    int32_t    lazy;            /* adds since the last carry          */
+    uint32_t   status;          /* errors so far                      */
+    uint8_t    signs;           /* finite signs added (1=+, 2=-)      */
+    uint8_t    infs;            /* Infinities added (1=+, 2=-)        */
+    int32_t   *limbs;           /* the limbs (local, or allocated)    */
+    decNumber *nan;             /* the NaN to return (allocated)      */
+    int32_t    local[DECACC_Local];     /* limbs for small sums       */
+    } decAccumulator;
+
+  /* ---------------------------------------------------------------- */
+  /* Routines                                                         */
+  /* ---------------------------------------------------------------- */
+  decAccumulator * decAccumulatorInit(decAccumulator *);
+  void             decAccumulatorFree(decAccumulator *);
+  decAccumulator * decAccumulatorAdd(decAccumulator *, const decNumber *);
+  decAccumulator * decAccumulatorAddNumbers(decAccumulator *,
+                     const decNumber * const *, int32_t);
+  decAccumulator * decAccumulatorAddDecimal64s(decAccumulator *,
+                     const decimal64 *, int32_t);
+  decAccumulator * decAccumulatorAddDecimal128s(decAccumulator *,
+                     const decimal128 *, int32_t);
+  decAccumulator * decAccumulatorAddProduct(decAccumulator *,
+                     const decNumber *, const decNumber *);
+  decAccumulator * decAccumulatorAddProducts(decAccumulator *,
+                     const decNumber * const *, const decNumber * const *,
+                     int32_t);
+  decAccumulator * decAccumulatorAddDecimal64Products(decAccumulator *,
+                     const decimal64 *, const decimal64 *, int32_t);
+  decNumber      * decAccumulatorToNumber(decAccumulator *, decNumber *,
+                     decContext *);
+
+  /* Sums of products, rounded once                                   */
+  decNumber      * decNumberDotProduct(decNumber *,
+                     const decNumber * const *, const decNumber * const *,
+                     int32_t, decContext *);
+  decimal64      * decimal64DotProduct(decimal64 *, const decimal64 *,
+                     const decimal64 *, int32_t, decContext *);
+
+#endif
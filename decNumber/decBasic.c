@@ -0,0 +1,1099 @@
+/* ------------------------------------------------------------------ */
+/* decBasic.c -- common arithmetic for decDouble and decQuad          */
+/* ------------------------------------------------------------------ */
+/* This module comprises the arithmetic, min/max, and logical         */
+/* routines that are shared between decDouble and decQuad.  Like      */
+/* decCommon.c it is not compiled on its own; it is included (after   */
+/* decCommon.c, whose binnum type and private routines it uses) by    */
+/* decDouble.c and decQuad.c.                                         */
+/*                                                                    */
+/* Each routine gives the same result and status as the decNumber     */
+/* routine of the same name would with a context of the format's      */
+/* precision and exponent range (and clamp=1).  Apart from            */
+/* decFloatFMA, which uses decNumber, no storage is allocated.        */
+/* ------------------------------------------------------------------ */
+
+/* Digits added per step in long division; the remainder (less than   */
+/* 10**DECPMAX) times 10**DECDIVCHUNK must fit in a register          */
+#if DOUBLE
+  #define DECDIVCHUNK 3
+#else
+  #define DECDIVCHUNK 4
+#endif
+
+/* Operation codes for decDivideOp (those for decCompareOp are in     */
+/* decCommon.c)                                                       */
+#define DIVIDE    0x80                  // Divide operator
+#define REMAINDER 0x40                  // .. remainder
+#define DIVIDEINT 0x20                  // .. integer part
+#define REMNEAR   0x10                  // .. IEEE remainder
+
+/* ------------------------------------------------------------------ */
+/* decInfinity -- set a decFloat to Infinity                          */
+/*                                                                    */
+/*   result is the target                                             */
+/*   sign is the sign to use (0 or DECFLOAT_Sign)                     */
+/*   returns result                                                   */
+/* ------------------------------------------------------------------ */
+static decFloat * decInfinity(decFloat *result, uInt sign) {
+  binnum inf;
+  inf.sign=sign;
+  inf.exponent=DECFLOAT_Inf;
+  inf.coeff=0;
+  return decPack(result, &inf);
+  } // decInfinity
+
+/* ------------------------------------------------------------------ */
+/* decAddNum -- add two finite binnums                                */
+/*                                                                    */
+/*   result is the target                                             */
+/*   a, b are the operands (b's sign has already been inverted for a  */
+/*     subtraction); they may be altered                              */
+/*   round is the rounding mode                                       */
+/*   status is the status accumulator                                 */
+/*   returns result                                                   */
+/*                                                                    */
+/* The operand with the larger exponent is aligned to the other as a  */
+/* double-register value (hi*10**DECPMAX+lo).  If the alignment would */
+/* be more than DECPMAX+1 digits then the smaller operand lies wholly */
+/* below the rounding digit, and is truncated to the digits that can  */
+/* matter plus a sticky bit; a subtraction with a sticky bit is done  */
+/* as A-(B+1), the fraction then being 1-f.  Zero operands follow the */
+/* decNumber rules for the exponent and sign of the result.           */
+/* ------------------------------------------------------------------ */
+static decFloat * decAddNum(decFloat *result, binnum *a, binnum *b,
+                            enum rounding round, uInt *status) {
+  binnum num;                           // the result
+  DECREG hi, lo, bc;                    // aligned a, and b
+  Int shift;                            // alignment
+  Flag sticky=0;                        // 1 if b was truncated
+
+  if (a->coeff==0 || b->coeff==0) {     // one or both zero
+    if (a->coeff==0 && b->coeff==0) {
+      num.coeff=0;
+      num.exponent=MINI(a->exponent, b->exponent);
+      // 0-0 gives +0 unless rounding to -Infinity; -0-0 gives -0
+      if (a->sign==b->sign) num.sign=a->sign;
+       else num.sign=(round==DEC_ROUND_FLOOR) ? DECFLOAT_Sign : 0;
+      return decFinalize(result, &num, 0, round, status);
+      }
+    if (a->coeff==0) {                  // make a the non-zero one
+      binnum *t=a;
+      a=b;
+      b=t;
+      }
+    num=*a;
+    if (b->exponent<a->exponent) {      // 0-padding needed
+      Int pad=a->exponent-b->exponent;
+      Int room=DECPMAX-decRegDigits(a->coeff);
+      if (pad>room) {
+        pad=room;
+        *status|=DEC_Rounded;           // [but exact]
+        }
+      num.coeff*=DECREGPOW[pad];
+      num.exponent-=pad;
+      }
+    return decFinalize(result, &num, 0, round, status);
+    }
+
+  if (a->exponent<b->exponent) {        // make a the more significant
+    binnum *t=a;
+    a=b;
+    b=t;
+    }
+  shift=a->exponent-b->exponent;
+  bc=b->coeff;
+  num.exponent=b->exponent;
+  if (shift>DECPMAX+1) {                // b is below the rounding digit
+    Int k=shift-(DECPMAX+1);            // digits of b to discard
+    if (k>DECPMAX) bc=0;                // [b is non-zero]
+     else bc/=DECREGPOW[k];
+    sticky=(bc*DECREGPOW[MINI(k, DECPMAX)]!=b->coeff);
+    shift=DECPMAX+1;
+    num.exponent=a->exponent-shift;
+    }
+
+  // form a*10**shift as hi*10**DECPMAX+lo
+  if (shift==0) {
+    hi=0;
+    lo=a->coeff;
+    }
+   else if (shift<=DECPMAX) {
+    hi=a->coeff/DECREGPOW[DECPMAX-shift];
+    lo=(a->coeff-hi*DECREGPOW[DECPMAX-shift])*DECREGPOW[shift];
+    }
+   else {                               // shift is DECPMAX+1
+    hi=a->coeff*10;
+    lo=0;
+    }
+
+  num.sign=a->sign;
+  if (a->sign==b->sign) {               // addition
+    lo+=bc;
+    if (lo>=DECREGPOW[DECPMAX]) {
+      lo-=DECREGPOW[DECPMAX];
+      hi++;
+      }
+    }
+   else {                               // subtraction
+    DECREG sub=bc+sticky;               // [see above]
+    if (hi==0 && lo<sub) {              // b is larger [sticky is 0]
+      lo=sub-lo;
+      num.sign=b->sign;
+      }
+     else if (lo>=sub) lo-=sub;
+     else {                             // borrow
+      lo=lo+DECREGPOW[DECPMAX]-sub;
+      hi--;
+      }
+    if (hi==0 && lo==0 && !sticky) {    // exact zero
+      num.sign=(round==DEC_ROUND_FLOOR) ? DECFLOAT_Sign : 0;
+      }
+    }
+  sticky|=decNarrow(&num, hi, lo);
+  return decFinalize(result, &num, sticky, round, status);
+  } // decAddNum
+
+/* ------------------------------------------------------------------ */
+/* decAddOp -- add or subtract two decFloats                          */
+/*                                                                    */
+/*   result gets the result of adding (or subtracting) dfl and dfr    */
+/*   dfl is the first decFloat (lhs)                                  */
+/*   dfr is the second decFloat (rhs)                                 */
+/*   set is the context                                               */
+/*   negate is DECFLOAT_Sign for subtraction, 0 for addition          */
+/*   returns result                                                   */
+/* ------------------------------------------------------------------ */
+static decFloat * decAddOp(decFloat *result, const decFloat *dfl,
+                           const decFloat *dfr, decContext *set,
+                           uInt negate) {
+  binnum a, b;                          // unpacked operands
+  uInt status=0;                        // accumulator
+
+  if (DFISSPECIAL(dfl) || DFISSPECIAL(dfr)) {
+    if (DFISNAN(dfl) || DFISNAN(dfr)) decNaNs(result, dfl, dfr, &status);
+     else if (DFISINF(dfl)) {
+      // Infinity-Infinity (after adjusting the sign) is invalid
+      if (DFISINF(dfr)
+       && (GETSIGN(dfl)!=(GETSIGN(dfr)^negate))) decInvalid(result, &status);
+       else decInfinity(result, GETSIGN(dfl));
+      }
+     else decInfinity(result, GETSIGN(dfr)^negate);
+    }
+   else {
+    decUnpack(dfl, &a);
+    decUnpack(dfr, &b);
+    b.sign^=negate;
+    decAddNum(result, &a, &b, set->round, &status);
+    }
+  if (status!=0) decContextSetStatus(set, status);
+  return result;
+  } // decAddOp
+
+/* ------------------------------------------------------------------ */
+/* decFloatAdd -- add two decFloats                                   */
+/* decFloatSubtract -- subtract a decFloat from another               */
+/*                                                                    */
+/*   result gets the result of adding dfl and dfr (or dfl-dfr)        */
+/*   dfl is the first decFloat (lhs)                                  */
+/*   dfr is the second decFloat (rhs)                                 */
+/*   set is the context                                               */
+/*   returns result                                                   */
+/* ------------------------------------------------------------------ */
+decFloat * decFloatAdd(decFloat *result, const decFloat *dfl,
+                       const decFloat *dfr, decContext *set) {
+  return decAddOp(result, dfl, dfr, set, 0);
+  } // decFloatAdd
+
+decFloat * decFloatSubtract(decFloat *result, const decFloat *dfl,
+                            const decFloat *dfr, decContext *set) {
+  return decAddOp(result, dfl, dfr, set, DECFLOAT_Sign);
+  } // decFloatSubtract
+
+/* ------------------------------------------------------------------ */
+/* decFloatPlus -- add to 0 (+x)                                      */
+/* decFloatMinus -- subtract from 0 (-x)                              */
+/* decFloatAbs -- absolute value                                      */
+/*                                                                    */
+/*   result gets the result                                           */
+/*   df is the decFloat to use                                        */
+/*   set is the context                                               */
+/*   returns result                                                   */
+/*                                                                    */
+/* These are 0+x and 0-x, where the 0 has the exponent of x, as in    */
+/* decNumber (so -0 becomes 0, unless rounding is to -Infinity).      */
+/* Abs is Minus if x is negative and Plus otherwise.                  */
+/* ------------------------------------------------------------------ */
+static decFloat * decZeroAddOp(decFloat *result, const decFloat *df,
+                               decContext *set, uInt negate) {
+  binnum zero, num;                     // operands
+  uInt status=0;                        // accumulator
+  if (DFISNAN(df)) decNaNs(result, df, NULL, &status);
+   else if (DFISINF(df)) decInfinity(result, GETSIGN(df)^negate);
+   else {
+    decUnpack(df, &num);
+    num.sign^=negate;
+    zero.sign=0;
+    zero.coeff=0;
+    zero.exponent=num.exponent;
+    decAddNum(result, &zero, &num, set->round, &status);
+    }
+  if (status!=0) decContextSetStatus(set, status);
+  return result;
+  } // decZeroAddOp
+
+decFloat * decFloatPlus(decFloat *result, const decFloat *df,
+                        decContext *set) {
+  return decZeroAddOp(result, df, set, 0);
+  } // decFloatPlus
+
+decFloat * decFloatMinus(decFloat *result, const decFloat *df,
+                         decContext *set) {
+  return decZeroAddOp(result, df, set, DECFLOAT_Sign);
+  } // decFloatMinus
+
+decFloat * decFloatAbs(decFloat *result, const decFloat *df,
+                       decContext *set) {
+  if (DFISSIGNED(df) && !DFISNAN(df))
+    return decZeroAddOp(result, df, set, DECFLOAT_Sign);
+  return decZeroAddOp(result, df, set, 0);
+  } // decFloatAbs
+
+/* ------------------------------------------------------------------ */
+/* decFloatMultiply -- multiply two decFloats                         */
+/*                                                                    */
+/*   result gets the result of multiplying dfl and dfr:               */
+/*   dfl is the first decFloat (lhs)                                  */
+/*   dfr is the second decFloat (rhs)                                 */
+/*   set is the context                                               */
+/*   returns result                                                   */
+/*                                                                    */
+/* Each coefficient is split into two halves of DECPMAX/2 digits, so  */
+/* the partial products each fit in a register, and the product is    */
+/* accumulated as hi*10**DECPMAX+lo.                                  */
+/* ------------------------------------------------------------------ */
+decFloat * decFloatMultiply(decFloat *result, const decFloat *dfl,
+                            const decFloat *dfr, decContext *set) {
+  binnum a, b, num;                     // operands and result
+  uInt status=0;                        // accumulator
+  Flag sticky;                          // from decNarrow
+
+  if (DFISSPECIAL(dfl) || DFISSPECIAL(dfr)) {
+    if (DFISNAN(dfl) || DFISNAN(dfr)) decNaNs(result, dfl, dfr, &status);
+     else if ((DFISINF(dfl) && DFISZERO(dfr))
+           || (DFISINF(dfr) && DFISZERO(dfl))) decInvalid(result, &status);
+     else decInfinity(result, GETSIGN(dfl)^GETSIGN(dfr));
+    }
+   else {
+    decUnpack(dfl, &a);
+    decUnpack(dfr, &b);
+    num.sign=a.sign^b.sign;
+    num.exponent=a.exponent+b.exponent;
+    if (a.coeff==0 || b.coeff==0) {
+      num.coeff=0;
+      decFinalize(result, &num, 0, set->round, &status);
+      }
+     else {
+      const DECREG h=DECREGPOW[DECPMAX/2];   // half-split divisor
+      // remainders are formed by subtraction, to avoid a second
+      // division (which is costly for a 128-bit register)
+      DECREG a1=a.coeff/h, a0=a.coeff-a1*h;
+      DECREG b1=b.coeff/h, b0=b.coeff-b1*h;
+      DECREG mid=a1*b0+a0*b1;
+      DECREG m1=mid/h;
+      DECREG hi=a1*b1+m1;
+      DECREG lo=a0*b0+(mid-m1*h)*h;
+      if (lo>=DECREGPOW[DECPMAX]) {
+        lo-=DECREGPOW[DECPMAX];
+        hi++;
+        }
+      sticky=decNarrow(&num, hi, lo);
+      decFinalize(result, &num, sticky, set->round, &status);
+      }
+    }
+  if (status!=0) decContextSetStatus(set, status);
+  return result;
+  } // decFloatMultiply
+
+/* ------------------------------------------------------------------ */
+/* decFloatFMA -- multiply and add three decFloats, fused             */
+/*                                                                    */
+/*   result gets the result of (dfl*dfr)+dff with a single rounding   */
+/*   dfl is the first decFloat (lhs)                                  */
+/*   dfr is the second decFloat (rhs)                                 */
+/*   dff is the final decFloat (fhs)                                  */
+/*   set is the context                                               */
+/*   returns result                                                   */
+/*                                                                    */
+/* The exact product needs up to 2*DECPMAX digits, so this is carried */
+/* out by decNumberFMA in a context for the format, with the caller's */
+/* rounding mode and allocator.                                       */
+/* ------------------------------------------------------------------ */
+decFloat * decFloatFMA(decFloat *result, const decFloat *dfl,
+                       const decFloat *dfr, const decFloat *dff,
+                       decContext *set) {
+  decNumber dnl, dnr, dnf, dnres;       // working numbers
+  decContext dc;                        // .. and context
+  decContextDefault(&dc, DEFCONTEXT);
+  dc.round=set->round;
+  dc.allocator=set->allocator;          // caller's working storage
+  decFloatToNumber(dfl, &dnl);
+  decFloatToNumber(dfr, &dnr);
+  decFloatToNumber(dff, &dnf);
+  decNumberFMA(&dnres, &dnl, &dnr, &dnf, &dc);
+  decFloatFromNumber(result, &dnres, &dc);
+  if (dc.status!=0) decContextSetStatus(set, dc.status);
+  return result;
+  } // decFloatFMA
+
+/* ------------------------------------------------------------------ */
+/* decDivInt -- integer division of two finite non-zero binnums       */
+/*                                                                    */
+/*   a is the dividend                                                */
+/*   b is the divisor                                                 */
+/*   quot receives the integer part of a/b (a register)               */
+/*   rem receives the remainder, with the exponent of whichever of a  */
+/*     and b has the lower exponent, and the sign of a                */
+/*   returns 1 if the integer part has more than DECPMAX digits       */
+/*     (Division_impossible), 0 otherwise                             */
+/* ------------------------------------------------------------------ */
+static Flag decDivInt(const binnum *a, const binnum *b, DECREG *quot,
+                      binnum *rem) {
+  DECREG q, r;                          // quotient and remainder
+  Int d=a->exponent-b->exponent;        // alignment
+  rem->sign=a->sign;
+  if (d>=0) {                           // dividend to be extended
+    Int rest=d;
+    q=a->coeff/b->coeff;
+    r=a->coeff-q*b->coeff;
+    while (rest>0) {
+      Int k=MINI(rest, DECDIVCHUNK);
+      DECREG d;                         // next quotient digits
+      if (q>=DECREGPOW[DECPMAX]) return 1;
+      r*=DECREGPOW[k];
+      d=r/b->coeff;
+      r-=d*b->coeff;
+      q=q*DECREGPOW[k]+d;
+      rest-=k;
+      }
+    if (q>=DECREGPOW[DECPMAX]) return 1;
+    rem->coeff=r;
+    rem->exponent=b->exponent;
+    }
+   else {                               // divisor to be extended
+    Int m=-d;
+    if (m>DECPMAX) {                    // a<b, so all is remainder
+      q=0;
+      rem->coeff=a->coeff;
+      }
+     else {
+      DECREG t=a->coeff/DECREGPOW[m];   // digits at or above b's
+      q=t/b->coeff;
+      rem->coeff=(t-q*b->coeff)*DECREGPOW[m]+(a->coeff-t*DECREGPOW[m]);
+      }
+    rem->exponent=a->exponent;
+    }
+  *quot=q;
+  return 0;
+  } // decDivInt
+
+/* ------------------------------------------------------------------ */
+/* decDivideOp -- division operations                                 */
+/*                                                                    */
+/*   result gets the result of dividing dfl by dfr                    */
+/*   dfl is the first decFloat (lhs)                                  */
+/*   dfr is the second decFloat (rhs)                                 */
+/*   set is the context                                               */
+/*   op is the operation selector                                     */
+/*   returns result                                                   */
+/*                                                                    */
+/* op is one of DIVIDE, DIVIDEINT, REMAINDER, or REMNEAR.  The rules  */
+/* for special values and zeros are those of decNumber's decDivideOp. */
+/*                                                                    */
+/* For DIVIDE, the coefficient of the dividend is extended by enough  */
+/* digits that the quotient has DECPMAX+1 or DECPMAX+2 digits; this   */
+/* is done in steps of DECDIVCHUNK digits so that the remainder never */
+/* overflows a register.  An exact quotient has its trailing zeros    */
+/* removed, down to the ideal exponent.                               */
+/* ------------------------------------------------------------------ */
+static decFloat * decDivideOp(decFloat *result, const decFloat *dfl,
+                              const decFloat *dfr, decContext *set,
+                              Flag op) {
+  binnum a, b, num;                     // operands and result
+  uInt status=0;                        // accumulator
+  uInt sign=GETSIGN(dfl)^GETSIGN(dfr);  // quotient sign
+
+  if (DFISSPECIAL(dfl) || DFISSPECIAL(dfr)) {
+    if (DFISNAN(dfl) || DFISNAN(dfr)) decNaNs(result, dfl, dfr, &status);
+     else if (DFISINF(dfl)) {           // lhs is infinite
+      if (DFISINF(dfr) || op&(REMAINDER|REMNEAR))
+        decInvalid(result, &status);
+       else decInfinity(result, sign);
+      }
+     else {                             // rhs is infinite
+      if (op&(REMAINDER|REMNEAR)) {     // result is lhs
+        decUnpack(dfl, &num);
+        decFinalize(result, &num, 0, set->round, &status);
+        }
+       else {                           // a zero
+        num.sign=sign;
+        num.coeff=0;
+        num.exponent=0;
+        if (op&DIVIDE) {                // with lowest exponent
+          num.exponent=DECETINY;
+          status|=DEC_Clamped;
+          }
+        decPack(result, &num);
+        }
+      }
+    if (status!=0) decContextSetStatus(set, status);
+    return result;
+    }
+
+  decUnpack(dfl, &a);
+  decUnpack(dfr, &b);
+  if (b.coeff==0) {                     // x/0
+    if (a.coeff==0) {                   // 0/0 is undefined
+      decInvalid(result, &status);
+      status=DEC_Division_undefined;
+      }
+     else if (op&(REMAINDER|REMNEAR)) decInvalid(result, &status);
+     else {
+      decInfinity(result, sign);
+      status=DEC_Division_by_zero;
+      }
+    decContextSetStatus(set, status);
+    return result;
+    }
+
+  if (a.coeff==0) {                     // 0/x
+    if (op&DIVIDE) {
+      num.sign=sign;
+      num.coeff=0;
+      num.exponent=a.exponent-b.exponent;
+      decFinalize(result, &num, 0, set->round, &status);
+      }
+     else if (op&DIVIDEINT) {
+      num.sign=sign;
+      num.coeff=0;
+      num.exponent=0;
+      decPack(result, &num);
+      }
+     else {                             // remainder keeps lhs sign
+      a.exponent=MINI(a.exponent, b.exponent);
+      decPack(result, &a);
+      }
+    if (status!=0) decContextSetStatus(set, status);
+    return result;
+    }
+
+  if (op&DIVIDE) {
+    Int da=decRegDigits(a.coeff);
+    Int db=decRegDigits(b.coeff);
+    Int s=DECPMAX+1+db-da;              // digits to extend by (>=2)
+    Int rest=s;
+    DECREG q=a.coeff/b.coeff;
+    DECREG r=a.coeff-q*b.coeff;
+    DECREG d;                           // next quotient digits
+    Flag sticky;
+    while (rest>0) {
+      Int k=MINI(rest, DECDIVCHUNK);
+      r*=DECREGPOW[k];
+      d=r/b.coeff;
+      r-=d*b.coeff;
+      q=q*DECREGPOW[k]+d;
+      rest-=k;
+      }
+    num.sign=sign;
+    num.exponent=a.exponent-b.exponent-s;
+    if (r==0) {                         // exact; strip to ideal exponent
+      Int ideal=a.exponent-b.exponent;
+      while (num.exponent<ideal && q%10==0) {
+        q/=10;
+        num.exponent++;
+        }
+      }
+    sticky=(r!=0);
+    {
+      DECREG hi=q/DECREGPOW[DECPMAX];
+      sticky|=decNarrow(&num, hi, q-hi*DECREGPOW[DECPMAX]);
+    }
+    decFinalize(result, &num, sticky, set->round, &status);
+    }
+   else {                               // integer division
+    DECREG q;                           // integer part
+    if (decDivInt(&a, &b, &q, &num)) {
+      decInvalid(result, &status);
+      status=DEC_Division_impossible;
+      }
+     else if (op&DIVIDEINT) {
+      num.sign=sign;
+      num.coeff=q;
+      num.exponent=0;
+      decPack(result, &num);
+      }
+     else {
+      if (op&REMNEAR) {                 // may need to go the other way
+        DECREG bc=b.coeff;              // b, aligned to remainder
+        Flag fits=1;                    // 0 if bc is too large
+        DECREG twice=num.coeff*2;
+        if (b.exponent>num.exponent) {
+          Int m=b.exponent-num.exponent;
+          if (decRegDigits(bc)+m>DECPMAX+1) fits=0;
+           else bc*=DECREGPOW[m];
+          }
+        if (fits && (twice>bc || (twice==bc && (q&1)!=0))) {
+          if (q+1>=DECREGPOW[DECPMAX]) {     // quotient too long
+            decInvalid(result, &status);
+            decContextSetStatus(set, DEC_Division_impossible);
+            return result;
+            }
+          num.coeff=bc-num.coeff;
+          num.sign^=DECFLOAT_Sign;
+          }
+        }
+      decFinalize(result, &num, 0, set->round, &status);
+      }
+    }
+  if (status!=0) decContextSetStatus(set, status);
+  return result;
+  } // decDivideOp
+
+/* ------------------------------------------------------------------ */
+/* decFloatDivide -- divide a decFloat by another                     */
+/* decFloatDivideInteger -- integer divide a decFloat by another      */
+/* decFloatRemainder -- integer divide and return remainder           */
+/* decFloatRemainderNear -- integer divide to nearest and remainder   */
+/*                                                                    */
+/*   result gets the result of dividing dfl by dfr                    */
+/*   dfl is the first decFloat (lhs)                                  */
+/*   dfr is the second decFloat (rhs)                                 */
+/*   set is the context                                               */
+/*   returns result                                                   */
+/* ------------------------------------------------------------------ */
+decFloat * decFloatDivide(decFloat *result, const decFloat *dfl,
+                          const decFloat *dfr, decContext *set) {
+  return decDivideOp(result, dfl, dfr, set, DIVIDE);
+  } // decFloatDivide
+
+decFloat * decFloatDivideInteger(decFloat *result, const decFloat *dfl,
+                                 const decFloat *dfr, decContext *set) {
+  return decDivideOp(result, dfl, dfr, set, DIVIDEINT);
+  } // decFloatDivideInteger
+
+decFloat * decFloatRemainder(decFloat *result, const decFloat *dfl,
+                             const decFloat *dfr, decContext *set) {
+  return decDivideOp(result, dfl, dfr, set, REMAINDER);
+  } // decFloatRemainder
+
+decFloat * decFloatRemainderNear(decFloat *result, const decFloat *dfl,
+                                 const decFloat *dfr, decContext *set) {
+  return decDivideOp(result, dfl, dfr, set, REMNEAR);
+  } // decFloatRemainderNear
+
+/* ------------------------------------------------------------------ */
+/* decFloatMax -- return maxnum of two operands                       */
+/* decFloatMaxMag -- return maxnummag of two operands                 */
+/* decFloatMin -- return minnum of two operands                       */
+/* decFloatMinMag -- return minnummag of two operands                 */
+/*                                                                    */
+/*   result gets the result of the operation                          */
+/*   dfl is the first decFloat (lhs)                                  */
+/*   dfr is the second decFloat (rhs)                                 */
+/*   set is the context                                               */
+/*   returns result                                                   */
+/*                                                                    */
+/* These share decCompareOp with the comparisons in decCommon.c.      */
+/* ------------------------------------------------------------------ */
+DECCOMPAREOP(decFloatMax, COMPMAX)
+DECCOMPAREOP(decFloatMaxMag, COMPMAXMAG)
+DECCOMPAREOP(decFloatMin, COMPMIN)
+DECCOMPAREOP(decFloatMinMag, COMPMINMAG)
+#undef DECCOMPAREOP
+
+/* ------------------------------------------------------------------ */
+/* decFloatQuantize -- quantize a decFloat                            */
+/*                                                                    */
+/*   result gets the result of quantizing dfl to match dfr            */
+/*   dfl is the first decFloat (lhs)                                  */
+/*   dfr is the second decFloat (rhs), which sets the exponent        */
+/*   set is the context                                               */
+/*   returns result                                                   */
+/*                                                                    */
+/* Unless there is an error or an underflow occurs, the exponent of   */
+/* the result is always equal to that of dfr.  Underflow is never     */
+/* set, as for decNumberQuantize.                                     */
+/* ------------------------------------------------------------------ */
+decFloat * decFloatQuantize(decFloat *result, const decFloat *dfl,
+                            const decFloat *dfr, decContext *set) {
+  binnum a, b;                          // operands
+  uInt status=0;                        // accumulator
+
+  if (DFISSPECIAL(dfl) || DFISSPECIAL(dfr)) {
+    if (DFISNAN(dfl) || DFISNAN(dfr)) decNaNs(result, dfl, dfr, &status);
+     else if (DFISINF(dfl) && DFISINF(dfr)) decInfinity(result, GETSIGN(dfl));
+     else decInvalid(result, &status);  // just one Infinity
+    }
+   else {
+    decUnpack(dfl, &a);
+    decUnpack(dfr, &b);
+    if (a.coeff!=0) {
+      Int adjust=b.exponent-a.exponent; // digit adjustment needed
+      Int digits=decRegDigits(a.coeff);
+      if (digits-adjust>DECPMAX) {      // will definitely not fit
+        decInvalid(result, &status);
+        decContextSetStatus(set, status);
+        return result;
+        }
+      if (adjust>0) {                   // round to fewer digits
+        Int half;                       // see decDropDigits
+        uInt rstatus=DEC_Rounded;       // status from rounding
+        half=decDropDigits(&a.coeff, adjust, 0);
+        if (half!=0) {
+          rstatus|=DEC_Inexact;
+          if (decRoundUp(set->round, half, a.coeff, a.sign)) a.coeff++;
+          }
+        if (a.coeff>=DECREGPOW[DECPMAX]) {   // rounded up too far
+          decInvalid(result, &status);
+          decContextSetStatus(set, status);
+          return result;
+          }
+        status|=rstatus;
+        }
+       else a.coeff*=DECREGPOW[-adjust];
+      }
+    a.exponent=b.exponent;
+    decFinalize(result, &a, 0, set->round, &status);
+    status&=~DEC_Underflow;             // [as per 754]
+    }
+  if (status!=0) decContextSetStatus(set, status);
+  return result;
+  } // decFloatQuantize
+
+/* ------------------------------------------------------------------ */
+/* decFloatReduce -- reduce finite coefficient to minimum length      */
+/*                                                                    */
+/*   result gets the reduced decFloat                                 */
+/*   df is the source decFloat                                        */
+/*   set is the context                                               */
+/*   returns result, which will be canonical                          */
+/*                                                                    */
+/* This removes all possible trailing zeros from the coefficient;     */
+/* some may remain when the number is very close to Nmax.  A zero     */
+/* gets an exponent of 0.                                             */
+/* ------------------------------------------------------------------ */
+decFloat * decFloatReduce(decFloat *result, const decFloat *df,
+                          decContext *set) {
+  binnum num;                           // work
+  uInt status=0;                        // accumulator
+  if (DFISNAN(df)) decNaNs(result, df, NULL, &status);
+   else if (DFISINF(df)) decInfinity(result, GETSIGN(df));
+   else {
+    decUnpack(df, &num);
+    if (num.coeff==0) {
+      num.exponent=0;
+      decPack(result, &num);
+      }
+     else {
+      decFinalize(result, &num, 0, set->round, &status);  // flags
+      decUnpack(result, &num);
+      while (num.exponent<DECQMAX && num.coeff%10==0) {
+        num.coeff/=10;
+        num.exponent++;
+        }
+      decPack(result, &num);
+      }
+    }
+  if (status!=0) decContextSetStatus(set, status);
+  return result;
+  } // decFloatReduce
+
+/* ------------------------------------------------------------------ */
+/* decToIntegral -- round a decFloat to an integral value             */
+/*                                                                    */
+/*   result gets the result                                           */
+/*   df is the decFloat to round                                      */
+/*   round is the rounding mode to use                                */
+/*   status is the status accumulator                                 */
+/*   returns result                                                   */
+/*                                                                    */
+/* A finite number with a negative exponent is rounded to exponent 0, */
+/* setting Rounded and (if any non-zero digits were lost) Inexact.    */
+/* ------------------------------------------------------------------ */
+static decFloat * decToIntegral(decFloat *result, const decFloat *df,
+                                enum rounding round, uInt *status) {
+  binnum num;                           // work
+  if (DFISNAN(df)) return decNaNs(result, df, NULL, status);
+  if (DFISINF(df)) return decInfinity(result, GETSIGN(df));
+  decUnpack(df, &num);
+  if (num.exponent<0) {                 // there are fractional digits
+    if (num.coeff!=0) {
+      Int half=decDropDigits(&num.coeff, -num.exponent, 0);
+      *status|=DEC_Rounded;
+      if (half!=0) {
+        *status|=DEC_Inexact;
+        if (decRoundUp(round, half, num.coeff, num.sign)) num.coeff++;
+        }
+      }
+    num.exponent=0;
+    }
+  return decPack(result, &num);
+  } // decToIntegral
+
+/* ------------------------------------------------------------------ */
+/* decFloatToIntegralExact -- round to integral value (exact)         */
+/* decFloatToIntegralValue -- round to integral value (quiet)         */
+/*                                                                    */
+/*   result gets the result                                           */
+/*   df is the decFloat to round                                      */
+/*   set is the context                                               */
+/*   round is the rounding mode to use (ToIntegralValue only)         */
+/*   returns result                                                   */
+/*                                                                    */
+/* ToIntegralExact uses the rounding mode in the context and may set  */
+/* Inexact and Rounded; ToIntegralValue sets only Invalid_operation   */
+/* (for an sNaN).                                                     */
+/* ------------------------------------------------------------------ */
+decFloat * decFloatToIntegralExact(decFloat *result, const decFloat *df,
+                                   decContext *set) {
+  uInt status=0;                        // accumulator
+  decToIntegral(result, df, set->round, &status);
+  if (status!=0) decContextSetStatus(set, status);
+  return result;
+  } // decFloatToIntegralExact
+
+decFloat * decFloatToIntegralValue(decFloat *result, const decFloat *df,
+                                   decContext *set, enum rounding round) {
+  uInt status=0;                        // accumulator
+  decToIntegral(result, df, round, &status);
+  status&=DEC_Invalid_operation;        // only sNaN Invalid please
+  if (status!=0) decContextSetStatus(set, status);
+  return result;
+  } // decFloatToIntegralValue
+
+/* ------------------------------------------------------------------ */
+/* decNextOp -- next representable value toward +/- Infinity          */
+/*                                                                    */
+/*   result gets the result                                           */
+/*   df is the (finite) decFloat to start from                        */
+/*   up is 1 for toward +Infinity, 0 for toward -Infinity             */
+/*   status is the status accumulator                                 */
+/*   returns result                                                   */
+/*                                                                    */
+/* As in decNumber, this adds (or subtracts) a value which is smaller */
+/* than the tiniest subnormal, rounding toward the target.  The tiny  */
+/* value is below the rounding digit for any operand, so only its     */
+/* sticky bit is used.                                                */
+/* ------------------------------------------------------------------ */
+static decFloat * decNextOp(decFloat *result, const decFloat *df, Flag up,
+                            uInt *status) {
+  binnum num, tiny;                     // operands
+  decUnpack(df, &num);
+  tiny.sign=up ? 0 : DECFLOAT_Sign;
+  tiny.coeff=1;
+  tiny.exponent=DECETINY-(DECPMAX+2);
+  return decAddNum(result, &num, &tiny,
+                   up ? DEC_ROUND_CEILING : DEC_ROUND_FLOOR, status);
+  } // decNextOp
+
+/* ------------------------------------------------------------------ */
+/* decFloatNextMinus -- next towards -Infinity                        */
+/* decFloatNextPlus -- next towards +Infinity                         */
+/*                                                                    */
+/*   result gets the next lesser (or greater) decFloat                */
+/*   df is the decFloat to start with                                 */
+/*   set is the context                                               */
+/*   returns result                                                   */
+/*                                                                    */
+/* This is 754 nextdown (or nextup); Invalid is the only status       */
+/* possible (from an sNaN).                                           */
+/* ------------------------------------------------------------------ */
+decFloat * decFloatNextMinus(decFloat *result, const decFloat *df,
+                             decContext *set) {
+  uInt status=0;                        // accumulator
+  if (DFISNAN(df)) decNaNs(result, df, NULL, &status);
+   else if (DFISINF(df)) {
+    if (DFISSIGNED(df)) decInfinity(result, DECFLOAT_Sign);
+     else DFSETNMAX(result);            // +Infinity gives Nmax
+    }
+   else decNextOp(result, df, 0, &status);
+  status&=DEC_Invalid_operation;        // only sNaN Invalid please
+  if (status!=0) decContextSetStatus(set, status);
+  return result;
+  } // decFloatNextMinus
+
+decFloat * decFloatNextPlus(decFloat *result, const decFloat *df,
+                            decContext *set) {
+  uInt status=0;                        // accumulator
+  if (DFISNAN(df)) decNaNs(result, df, NULL, &status);
+   else if (DFISINF(df)) {
+    if (!DFISSIGNED(df)) decInfinity(result, 0);
+     else {                             // -Infinity gives -Nmax
+      DFSETNMAX(result);
+      DFWORD(result, 0)|=DECFLOAT_Sign;
+      }
+    }
+   else decNextOp(result, df, 1, &status);
+  status&=DEC_Invalid_operation;        // only sNaN Invalid please
+  if (status!=0) decContextSetStatus(set, status);
+  return result;
+  } // decFloatNextPlus
+
+/* ------------------------------------------------------------------ */
+/* decFloatNextToward -- next towards a decFloat                      */
+/*                                                                    */
+/*   result gets the next decFloat                                    */
+/*   dfl is the decFloat to start with                                */
+/*   dfr is the decFloat to move toward                               */
+/*   set is the context                                               */
+/*   returns result                                                   */
+/*                                                                    */
+/* If the operands are equal the result is dfl with the sign of dfr.  */
+/* The status from the step is kept unless the result is normal.      */
+/* ------------------------------------------------------------------ */
+decFloat * decFloatNextToward(decFloat *result, const decFloat *dfl,
+                              const decFloat *dfr, decContext *set) {
+  binnum a, b;                          // operands
+  uInt status=0;                        // accumulator
+  Int r;                                // comparison
+
+  if (DFISNAN(dfl) || DFISNAN(dfr)) decNaNs(result, dfl, dfr, &status);
+   else {
+    decUnpack(dfl, &a);
+    decUnpack(dfr, &b);
+    r=decNumCompare(&a, &b, 0);
+    if (r==0) {                         // equal: copysign
+      a.sign=b.sign;
+      decPack(result, &a);
+      }
+     else if (EXPISINF(a.exponent)) {   // must be toward the other
+      DFSETNMAX(result);
+      DFWORD(result, 0)|=a.sign;
+      }
+     else {
+      decNextOp(result, dfl, r<0, &status);
+      if (decFloatIsNormal(result)) status=0;
+      }
+    }
+  if (status!=0) decContextSetStatus(set, status);
+  return result;
+  } // decFloatNextToward
+
+/* ------------------------------------------------------------------ */
+/* decFloatLogB -- return adjusted exponent, by 754 rules             */
+/*                                                                    */
+/*   result gets the adjusted exponent as an integer, or a NaN etc.   */
+/*   df is the decFloat to be examined                                */
+/*   set is the context                                               */
+/*   returns result                                                   */
+/*                                                                    */
+/* Notable cases:                                                     */
+/*   A<0 -> Use |A|                                                   */
+/*   A=0 -> -Infinity (Division by zero)                              */
+/*   A=Infinite -> +Infinity (Exact)                                  */
+/*   A=1 exactly -> 0 (Exact)                                         */
+/*   NaNs are propagated as usual                                     */
+/* ------------------------------------------------------------------ */
+decFloat * decFloatLogB(decFloat *result, const decFloat *df,
+                        decContext *set) {
+  uInt status=0;                        // accumulator
+  if (DFISNAN(df)) decNaNs(result, df, NULL, &status);
+   else if (DFISINF(df)) decInfinity(result, 0);
+   else if (DFISZERO(df)) {
+    decInfinity(result, DECFLOAT_Sign);
+    status=DEC_Division_by_zero;
+    }
+   else decFloatFromInt32(result,
+                          GETEXPUN(df)+(Int)decFloatDigits(df)-1);
+  if (status!=0) decContextSetStatus(set, status);
+  return result;
+  } // decFloatLogB
+
+/* ------------------------------------------------------------------ */
+/* decIntOperand -- get the value of an integer operand               */
+/*                                                                    */
+/*   df is the operand, which is not a NaN                            */
+/*   limit is the largest magnitude allowed                           */
+/*   value receives the value, if valid                               */
+/*   returns 1 if df is a finite integer (q=0) no larger than limit,  */
+/*     0 otherwise                                                    */
+/* ------------------------------------------------------------------ */
+static Flag decIntOperand(const decFloat *df, Int limit, Int *value) {
+  binnum num;
+  if (DFISINF(df)) return 0;
+  decUnpack(df, &num);
+  if (num.exponent!=0 || num.coeff>(DECREG)limit) return 0;
+  *value=(Int)num.coeff;
+  if (num.sign) *value=-*value;
+  return 1;
+  } // decIntOperand
+
+/* ------------------------------------------------------------------ */
+/* decFloatScaleB -- multiply by a power of 10, as per 754            */
+/*                                                                    */
+/*   result gets the result of the operation                          */
+/*   dfl is the first decFloat (lhs)                                  */
+/*   dfr is the second decFloat (rhs), am integer (with q=0)          */
+/*   set is the context                                               */
+/*   returns result                                                   */
+/*                                                                    */
+/* This computes result=dfl x 10**dfr where dfr is an integer in the  */
+/* range +/-2*(emax+pmax), typically resulting from LogB.             */
+/* ------------------------------------------------------------------ */
+decFloat * decFloatScaleB(decFloat *result, const decFloat *dfl,
+                          const decFloat *dfr, decContext *set) {
+  binnum num;                           // work
+  uInt status=0;                        // accumulator
+  Int scale;                            // dfr as an Int
+
+  if (DFISNAN(dfl) || DFISNAN(dfr)) decNaNs(result, dfl, dfr, &status);
+   else if (!decIntOperand(dfr, 2*(DECEMAX+DECPMAX), &scale))
+    decInvalid(result, &status);
+   else if (DFISINF(dfl)) decInfinity(result, GETSIGN(dfl));
+   else {
+    decUnpack(dfl, &num);
+    num.exponent+=scale;
+    decFinalize(result, &num, 0, set->round, &status);
+    }
+  if (status!=0) decContextSetStatus(set, status);
+  return result;
+  } // decFloatScaleB
+
+/* ------------------------------------------------------------------ */
+/* decFloatShift -- shift the coefficient of a decFloat               */
+/* decFloatRotate -- rotate the coefficient of a decFloat             */
+/*                                                                    */
+/*   result gets the result of shifting (or rotating) dfl             */
+/*   dfl is the source decFloat to shift                              */
+/*   dfr is the count of digits to shift, an integer (with q=0)       */
+/*   set is the context                                               */
+/*   returns result                                                   */
+/*                                                                    */
+/* The digits of the coefficient of dfl are shifted (or rotated)      */
+/* within DECPMAX digits, to the left if dfr is positive or to the    */
+/* right if dfr is negative; the exponent and sign are unchanged.     */
+/* dfr must be in the range -DECPMAX through +DECPMAX.                */
+/* ------------------------------------------------------------------ */
+static decFloat * decShiftOp(decFloat *result, const decFloat *dfl,
+                             const decFloat *dfr, decContext *set,
+                             Flag rotate) {
+  binnum num;                           // work
+  uInt status=0;                        // accumulator
+  Int shift;                            // dfr as an Int
+
+  if (DFISNAN(dfl) || DFISNAN(dfr)) decNaNs(result, dfl, dfr, &status);
+   else if (!decIntOperand(dfr, DECPMAX, &shift))
+    decInvalid(result, &status);
+   else if (DFISINF(dfl)) decInfinity(result, GETSIGN(dfl));
+   else {
+    DECREG c;
+    decUnpack(dfl, &num);
+    c=num.coeff;
+    if (rotate && shift<0) shift+=DECPMAX;   // as a left rotation
+    if (shift>0) {                      // to the left
+      num.coeff=(c%DECREGPOW[DECPMAX-shift])*DECREGPOW[shift];
+      if (rotate) num.coeff+=c/DECREGPOW[DECPMAX-shift];
+      }
+     else if (shift<0) num.coeff=c/DECREGPOW[-shift];
+    decPack(result, &num);
+    }
+  if (status!=0) decContextSetStatus(set, status);
+  return result;
+  } // decShiftOp
+
+decFloat * decFloatShift(decFloat *result, const decFloat *dfl,
+                         const decFloat *dfr, decContext *set) {
+  return decShiftOp(result, dfl, dfr, set, 0);
+  } // decFloatShift
+
+decFloat * decFloatRotate(decFloat *result, const decFloat *dfl,
+                          const decFloat *dfr, decContext *set) {
+  return decShiftOp(result, dfl, dfr, set, 1);
+  } // decFloatRotate
+
+/* ------------------------------------------------------------------ */
+/* decFloatAnd -- logical digitwise AND of two decFloats              */
+/* decFloatOr -- logical digitwise OR of two decFloats                */
+/* decFloatXor -- logical digitwise XOR of two decFloats              */
+/*                                                                    */
+/*   result gets the result of the operation                          */
+/*   dfl is the first decFloat (lhs)                                  */
+/*   dfr is the second decFloat (rhs)                                 */
+/*   set is the context                                               */
+/*   returns result, which will be canonical with sign=0              */
+/*                                                                    */
+/* The operands must be positive, finite with exponent q=0, and       */
+/* comprise just zeros and ones; if not, Invalid operation results.   */
+/* As the digits 0 and 1 each encode as bits 0, 4, and 7 of their     */
+/* declet, the operation can be applied to the encodings directly.    */
+/* ------------------------------------------------------------------ */
+#if DOUBLE
+  #define DECLOGICTOP 0x04009124        // MSD bit and digits in word 0
+#else
+  #define DECLOGICTOP 0x04000912
+#endif
+#define DECLOGICOP(name, oper)                                        \
+  decFloat * name(decFloat *result, const decFloat *dfl,              \
+                  const decFloat *dfr, decContext *set) {             \
+    if (!DFISUINT01(dfl) || !DFISUINT01(dfr)                          \
+     || !DFISCC01(dfl)   || !DFISCC01(dfr)) {                         \
+      uInt status=0;                                                  \
+      decInvalid(result, &status);                                    \
+      decContextSetStatus(set, status);                               \
+      return result;                                                  \
+      }                                                               \
+    DFWORD(result, 0)=ZEROWORD                                        \
+      |((DFWORD(dfl, 0) oper DFWORD(dfr, 0))&DECLOGICTOP);            \
+    DECLOGICLOW(oper)                                                 \
+    return result;                                                    \
+    }
+#if DOUBLE
+  #define DECLOGICLOW(oper)                                           \
+    DFWORD(result, 1)=(DFWORD(dfl, 1) oper DFWORD(dfr, 1))&0x49124491;
+#else
+  #define DECLOGICLOW(oper)                                           \
+    DFWORD(result, 1)=(DFWORD(dfl, 1) oper DFWORD(dfr, 1))&0x44912449; \
+    DFWORD(result, 2)=(DFWORD(dfl, 2) oper DFWORD(dfr, 2))&0x12449124; \
+    DFWORD(result, 3)=(DFWORD(dfl, 3) oper DFWORD(dfr, 3))&0x49124491;
+#endif
+DECLOGICOP(decFloatAnd, &)
+DECLOGICOP(decFloatOr, |)
+DECLOGICOP(decFloatXor, ^)
+#undef DECLOGICOP
+
+/* ------------------------------------------------------------------ */
+/* decFloatInvert -- logical digitwise INVERT of a decFloat           */
+/*                                                                    */
+/*   result gets the result of inverting df                           */
+/*   df is the decFloat to invert                                     */
+/*   set is the context                                               */
+/*   returns result, which will be canonical with sign=0              */
+/*                                                                    */
+/* The operand must be positive, finite with exponent q=0, and        */
+/* comprise just zeros and ones; if not, Invalid operation results.   */
+/* ------------------------------------------------------------------ */
+decFloat * decFloatInvert(decFloat *result, const decFloat *df,
+                          decContext *set) {
+  decFloat ones;                        // all-ones integer
+  uInt status=0;
+  if (!DFISUINT01(df) || !DFISCC01(df)) {
+    decInvalid(result, &status);
+    decContextSetStatus(set, status);
+    return result;
+    }
+  DFWORD(&ones, 0)=0xffffffff;          // [masked by DECLOGICTOP]
+  DFWORD(&ones, 1)=0xffffffff;
+  #if QUAD
+    DFWORD(&ones, 2)=0xffffffff;
+    DFWORD(&ones, 3)=0xffffffff;
+  #endif
+  {
+    const decFloat *dfl=df, *dfr=&ones;
+    DFWORD(result, 0)=ZEROWORD
+      |((DFWORD(dfl, 0) ^ DFWORD(dfr, 0))&DECLOGICTOP);
+    DECLOGICLOW(^)
+  }
+  return result;
+  } // decFloatInvert
+#undef DECLOGICLOW
+#undef DECLOGICTOP
@@ -0,0 +1,1389 @@
+/* ------------------------------------------------------------------ */
+/* decCommon.c -- common code for decSingle, decDouble and decQuad    */
+/* ------------------------------------------------------------------ */
+/* This module comprises code that is shared between the decSingle,   */
+/* decDouble, and decQuad modules (decSingle.c, decDouble.c, and      */
+/* decQuad.c).  It is not compiled on its own; each of those modules  */
+/* defines the format parameters (DECPMAX, etc.), maps the decFloat   */
+/* names to its own names, and then includes this file followed (for  */
+/* decDouble and decQuad) by decBasic.c.                              */
+/*                                                                    */
+/* This file holds the conversions, the rounding and encoding code,   */
+/* the comparisons, and the non-computational routines; decBasic.c    */
+/* holds the arithmetic.  decSingle is a storage format, so has no    */
+/* arithmetic and only a subset of the routines here.                 */
+/*                                                                    */
+/* Unlike decNumber, the coefficient of a finite decFloat is worked   */
+/* on as a single unsigned binary integer (a 'register', of type      */
+/* DECREG), which must be able to hold 10**(DECPMAX+2); a uInt is     */
+/* used for decSingle, a uDFLong for decDouble, and a (128-bit)       */
+/* uDFLLong for decQuad, whatever DECUSE64 and DECUSE128 say.  No     */
+/* storage is allocated and there are no digit arrays.                */
+/*                                                                    */
+/* Error handling is the same as decNumber: status bits are collected */
+/* during an operation and then set in the context (which may cause a */
+/* signal to be raised) just before returning.                        */
+/* ------------------------------------------------------------------ */
+#include "decNumberLocal.h"           // local includes (need DECPMAX)
+
+/* Constant mappings */
+#if DECPMAX==7
+  #define SINGLE 1
+  #define DOUBLE 0
+  #define QUAD   0
+  #define DEFCONTEXT DEC_INIT_DECIMAL32 // for decNumber proxies
+#elif DECPMAX==16
+  #define SINGLE 0
+  #define DOUBLE 1
+  #define QUAD   0
+  #define DEFCONTEXT DEC_INIT_DECIMAL64
+#elif DECPMAX==34
+  #define SINGLE 0
+  #define DOUBLE 0
+  #define QUAD   1
+  #define DEFCONTEXT DEC_INIT_DECIMAL128
+#else
+  #error decCommon.c only supports DECPMAX of 7, 16, or 34
+#endif
+#if QUAD && !defined(uDFLLong)
+  #error decQuad needs a compiler with __int128
+#endif
+
+/* Exponent limits, as unbiased exponents (q) */
+#define DECETINY (DECEMIN-DECPMAX+1)    // lowest exponent
+#define DECQMAX  (DECEMAX-DECPMAX+1)    // highest exponent
+
+/* binnum -- a format-independent unpacked decFloat, whose            */
+/* coefficient (or NaN payload) is held in a register                 */
+typedef struct {
+  DECREG  coeff;              // coefficient, or payload; 0 for Inf
+  Int     exponent;           // unbiased exponent (q), or
+                              // DECFLOAT_NaN etc. for a special
+  uInt    sign;               // 0=positive, DECFLOAT_Sign=negative
+  } binnum;
+
+/* Powers of ten as registers, 10**0 through 10**(DECPMAX+2) */
+#define DECE18 ((DECREG)1000000000000000000ULL)
+static const DECREG DECREGPOW[DECPMAX+3]={1, 10, 100, 1000, 10000,
+  100000, 1000000, 10000000, 100000000, 1000000000
+  #if !SINGLE
+  , 10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+  100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+  100000000000000000ULL, 1000000000000000000ULL
+  #if QUAD
+  , DECE18*10, DECE18*100, DECE18*1000, DECE18*10000, DECE18*100000,
+  DECE18*1000000, DECE18*10000000, DECE18*100000000,
+  DECE18*1000000000, DECE18*10000000000ULL, DECE18*100000000000ULL,
+  DECE18*1000000000000ULL, DECE18*10000000000000ULL,
+  DECE18*100000000000000ULL, DECE18*1000000000000000ULL,
+  DECE18*10000000000000000ULL, DECE18*100000000000000000ULL,
+  DECE18*1000000000000000000ULL
+  #endif
+  #endif
+  };
+
+/* Combination field -> exponent top two bits, pre-shifted so that    */
+/* GETEXP can simply add the exponent continuation (DECCOMBEXP is     */
+/* format-dependent, so is local to the format module)                */
+#define CE1 (1<<DECECONL)
+#define CE2 (2<<DECECONL)
+static const uInt DECCOMBEXP[64]={
+  0, 0, 0, 0, 0, 0, 0, 0, CE1, CE1, CE1, CE1, CE1, CE1, CE1, CE1,
+  CE2, CE2, CE2, CE2, CE2, CE2, CE2, CE2, 0, 0, CE1, CE1, CE2, CE2, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, CE1, CE1, CE1, CE1, CE1, CE1, CE1, CE1,
+  CE2, CE2, CE2, CE2, CE2, CE2, CE2, CE2, 0, 0, CE1, CE1, CE2, CE2, 0, 0};
+#undef CE1
+#undef CE2
+
+#if QUAD
+/* Shared lookup tables, defined here once (decQuad.c is included in  */
+/* every build that uses decDouble)                                   */
+/* Combination field (with sign) -> MSD; 0 for specials */
+const uInt DECCOMBMSD[64]={
+  0, 1, 2, 3, 4, 5, 6, 7, 0, 1, 2, 3, 4, 5, 6, 7,
+  0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 8, 9, 8, 9, 0, 0,
+  0, 1, 2, 3, 4, 5, 6, 7, 0, 1, 2, 3, 4, 5, 6, 7,
+  0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 8, 9, 8, 9, 0, 0};
+
+/* Exponent top two bits and MSD, indexed by (top<<4)+msd -> the      */
+/* combination field in its final position in the top word            */
+const uInt DECCOMBFROM[48]={
+  0x00000000, 0x04000000, 0x08000000, 0x0c000000, 0x10000000,
+  0x14000000, 0x18000000, 0x1c000000, 0x60000000, 0x64000000,
+  0, 0, 0, 0, 0, 0,
+  0x20000000, 0x24000000, 0x28000000, 0x2c000000, 0x30000000,
+  0x34000000, 0x38000000, 0x3c000000, 0x68000000, 0x6c000000,
+  0, 0, 0, 0, 0, 0,
+  0x40000000, 0x44000000, 0x48000000, 0x4c000000, 0x50000000,
+  0x54000000, 0x58000000, 0x5c000000, 0x70000000, 0x74000000,
+  0, 0, 0, 0, 0, 0};
+
+/* Shared DPD conversion tables (decimal64.c renames its own copies  */
+/* of DPD2BIN and BIN2DPD, and defines BIN2CHAR)                      */
+#define DEC_BCD2DPD  1
+#define DEC_BIN2DPD  1
+#define DEC_DPD2BIN  1
+#define DEC_DPD2BINK 1
+#define DEC_DPD2BINM 1
+#define DEC_DPD2BCD8 1
+#define DEC_BIN2BCD8 1
+#include "decDPD.h"
+#endif
+
+/* Private routines shared with decBasic.c */
+static decFloat * decFinalize(decFloat *, binnum *, Flag, enum rounding,
+                              uInt *);
+static Int        decDropDigits(DECREG *, Int, Flag);
+#if !SINGLE
+static Flag       decNarrow(binnum *, DECREG, DECREG);
+#endif
+static decFloat * decNaNs(decFloat *, const decFloat *, const decFloat *,
+                          uInt *);
+static decFloat * decInvalid(decFloat *, uInt *);
+static Flag       decRoundUp(enum rounding, Int, DECREG, uInt);
+static decFloat * decPack(decFloat *, const binnum *);
+static Int        decRegDigits(DECREG);
+static void       decUnpack(const decFloat *, binnum *);
+
+/* ================================================================== */
+/* Utilities                                                          */
+/* ================================================================== */
+
+/* ------------------------------------------------------------------ */
+/* decRegDigits -- count the digits in a register                     */
+/*                                                                    */
+/*   c is the register, which must be less than 10**(DECPMAX+2)       */
+/*   returns the number of digits in c (1 if c is 0)                  */
+/*                                                                    */
+/* When the compiler can count leading zeros the digit count is       */
+/* estimated from the bit length (using 1233/4096 as log10(2)) and    */
+/* corrected with one comparison; otherwise a simple scan is used.    */
+/* ------------------------------------------------------------------ */
+static Int decRegDigits(DECREG c) {
+  #if defined(__GNUC__)
+    Int bits, t;                        // bit length and estimate
+    #if SINGLE
+      bits=32-__builtin_clz(c|1);
+    #elif QUAD
+      uDFLong hi=(uDFLong)(c>>64);        // top half
+      if (hi!=0) bits=128-__builtin_clzll(hi);
+       else bits=64-__builtin_clzll((uDFLong)c|1);
+    #else
+      bits=64-__builtin_clzll(c|1);
+    #endif
+    t=(bits*1233)>>12;                  // floor(log10(2**bits)), or less
+    return t+((c>=DECREGPOW[t]) | (c==0));
+  #else
+    Int n=1;
+    for (; n<DECPMAX+3 && c>=DECREGPOW[n]; n++);
+    return n;
+  #endif
+  } // decRegDigits
+
+#if !SINGLE
+/* ------------------------------------------------------------------ */
+/* decLongToThou -- split a uDFLong of up to 18 digits into six       */
+/*                  base-thousand digits                              */
+/*                                                                    */
+/*   c is the value, which must be less than 10**18                   */
+/*   thou is the array to fill (least-significant digit at offset 0)  */
+/* ------------------------------------------------------------------ */
+static void decLongToThou(uDFLong c, uInt *thou) {
+  uInt lo=(uInt)(c%1000000000);         // bottom nine digits
+  uInt hi=(uInt)(c/1000000000);         // top nine digits
+  thou[0]=lo%1000; lo/=1000;
+  thou[1]=lo%1000; thou[2]=lo/1000;
+  thou[3]=hi%1000; hi/=1000;
+  thou[4]=hi%1000; thou[5]=hi/1000;
+  } // decLongToThou
+#endif
+
+/* ------------------------------------------------------------------ */
+/* decUnpack -- unpack a decFloat into a binnum                       */
+/*                                                                    */
+/*   df is the decFloat to unpack                                     */
+/*   num is the binnum to fill                                        */
+/*                                                                    */
+/* A NaN's payload is placed in the coefficient; an Infinity has a    */
+/* zero coefficient.  Non-canonical declets are decoded as by         */
+/* DPD2BIN, so the coefficient is always in range.                    */
+/* ------------------------------------------------------------------ */
+static void decUnpack(const decFloat *df, binnum *num) {
+  uInt thou[DECLETS+1];                 // base-thousand coefficient
+  #if QUAD
+  uDFLong hi, lo;                       // halves of the coefficient
+  #endif
+
+  num->sign=GETSIGN(df);
+  if (DFISSPECIAL(df)) {
+    if (DFISINF(df)) {
+      num->exponent=DECFLOAT_Inf;
+      num->coeff=0;
+      return;
+      }
+    num->exponent=DFWORD(df, 0)&0x7e000000;  // qNaN or sNaN
+    GETCOEFFTHOU(df, thou);
+    thou[DECLETS]=0;                    // payload has no MSD
+    }
+   else {
+    num->exponent=GETEXPUN(df);
+    GETCOEFFTHOU(df, thou);
+    }
+
+  #if SINGLE
+    num->coeff=(thou[2]*1000+thou[1])*1000+thou[0];
+  #elif DOUBLE
+    num->coeff=(((((uDFLong)thou[5]*1000+thou[4])*1000+thou[3])*1000
+               +thou[2])*1000+thou[1])*1000+thou[0];
+  #else
+    hi=(((((uDFLong)thou[11]*1000+thou[10])*1000+thou[9])*1000
+        +thou[8])*1000+thou[7])*1000+thou[6];
+    lo=(((((uDFLong)thou[5]*1000+thou[4])*1000+thou[3])*1000
+        +thou[2])*1000+thou[1])*1000+thou[0];
+    num->coeff=(DECREG)hi*DECE18+lo;
+  #endif
+  } // decUnpack
+
+/* ------------------------------------------------------------------ */
+/* decPack -- encode a binnum into a decFloat                         */
+/*                                                                    */
+/*   df is the target decFloat                                        */
+/*   num is the binnum to encode                                      */
+/*   returns df                                                       */
+/*                                                                    */
+/* The coefficient must have no more than DECPMAX digits and, if the  */
+/* binnum is finite, the exponent must be in the range DECETINY       */
+/* through DECQMAX.  A NaN payload must have less than DECPMAX digits */
+/* and an Infinity must have a zero coefficient.  The result is       */
+/* always canonical.                                                  */
+/* ------------------------------------------------------------------ */
+static decFloat * decPack(decFloat *df, const binnum *num) {
+  uInt thou[DECLETS+1];                 // base-thousand coefficient
+  uInt dpd[DECLETS];                    // .. and as declets
+  uInt top;                             // sign and combination field
+  Int  i;                               // work
+  #if QUAD
+  uDFLong hi;                           // top half of the coefficient
+  #endif
+
+  #if SINGLE
+    thou[0]=num->coeff%1000;
+    thou[1]=(num->coeff/1000)%1000;
+    thou[2]=num->coeff/1000000;
+  #elif DOUBLE
+    decLongToThou(num->coeff, thou);
+  #else
+    hi=(uDFLong)(num->coeff/DECE18);
+    decLongToThou((uDFLong)(num->coeff-(DECREG)hi*DECE18), thou);
+    decLongToThou(hi, thou+6);
+  #endif
+  for (i=0; i<DECLETS; i++) dpd[i]=BIN2DPD[thou[i]];
+
+  if (EXPISSPECIAL(num->exponent)) top=num->sign|(uInt)num->exponent;
+   else {
+    uInt bexp=(uInt)(num->exponent+DECBIAS);     // biased exponent
+    top=num->sign
+       |DECCOMBFROM[((bexp>>DECECONL)<<4)+thou[DECLETS]]
+       |((bexp&((1<<DECECONL)-1))<<(26-DECECONL));
+    }
+
+  #if SINGLE
+    DFWORD(df, 0)=top|(dpd[1]<<10)|dpd[0];
+  #elif DOUBLE
+    DFWORD(df, 0)=top|(dpd[4]<<8)|(dpd[3]>>2);
+    DFWORD(df, 1)=(dpd[3]<<30)|(dpd[2]<<20)|(dpd[1]<<10)|dpd[0];
+  #else
+    DFWORD(df, 0)=top|(dpd[10]<<4)|(dpd[9]>>6);
+    DFWORD(df, 1)=(dpd[9]<<26)|(dpd[8]<<16)|(dpd[7]<<6)|(dpd[6]>>4);
+    DFWORD(df, 2)=(dpd[6]<<28)|(dpd[5]<<18)|(dpd[4]<<8)|(dpd[3]>>2);
+    DFWORD(df, 3)=(dpd[3]<<30)|(dpd[2]<<20)|(dpd[1]<<10)|dpd[0];
+  #endif
+  return df;
+  } // decPack
+
+#if !SINGLE
+/* ------------------------------------------------------------------ */
+/* decNarrow -- reduce a double-register value to a single register   */
+/*                                                                    */
+/*   num receives the coefficient; its exponent is adjusted to suit   */
+/*   hi, lo are the value, which is hi*10**DECPMAX+lo, where          */
+/*       hi<10**(DECPMAX+1) and lo<10**DECPMAX                        */
+/*   returns 1 if any non-zero digits were discarded, 0 otherwise     */
+/*                                                                    */
+/* The coefficient set will have at most DECPMAX+1 digits, which is   */
+/* the most that decFinalize accepts.                                 */
+/* ------------------------------------------------------------------ */
+static Flag decNarrow(binnum *num, DECREG hi, DECREG lo) {
+  Int cut;                              // digits to discard from lo
+  DECREG q;                             // lo without those digits
+  if (hi==0) {
+    num->coeff=lo;
+    return 0;
+    }
+  cut=decRegDigits(hi)-1;
+  num->exponent+=cut;
+  if (cut==0) {
+    num->coeff=hi*DECREGPOW[DECPMAX]+lo;
+    return 0;
+    }
+  q=lo/DECREGPOW[cut];                  // [remainder is lo-q*10**cut]
+  num->coeff=hi*DECREGPOW[DECPMAX-cut]+q;
+  return lo!=q*DECREGPOW[cut];
+  } // decNarrow
+#endif
+
+/* ------------------------------------------------------------------ */
+/* decSetOverflow -- set a decFloat to the overflow result            */
+/*                                                                    */
+/*   df is the target                                                 */
+/*   sign is the sign of the result                                   */
+/*   round is the rounding mode                                       */
+/*   status is the status accumulator                                 */
+/*   returns df                                                       */
+/*                                                                    */
+/* The result is Nmax or Infinity (with the given sign), depending on */
+/* the rounding mode, as for decNumber.                               */
+/* ------------------------------------------------------------------ */
+static decFloat * decSetOverflow(decFloat *df, uInt sign,
+                                 enum rounding round, uInt *status) {
+  Flag needmax=0;                       // 1 for Nmax
+  switch (round) {
+    case DEC_ROUND_DOWN:
+    case DEC_ROUND_05UP:
+      needmax=1;
+      break;
+    case DEC_ROUND_CEILING:
+      if (sign) needmax=1;              // Nmax if negative
+      break;
+    case DEC_ROUND_FLOOR:
+      if (!sign) needmax=1;             // Nmax if positive
+      break;
+    default: break;                     // Infinity in all other cases
+    }
+  if (needmax) {
+    DFSETNMAX(df);
+    DFWORD(df, 0)|=sign;
+    }
+   else {
+    binnum inf;
+    inf.sign=sign;
+    inf.exponent=DECFLOAT_Inf;
+    inf.coeff=0;
+    decPack(df, &inf);
+    }
+  *status|=DEC_Overflow | DEC_Inexact | DEC_Rounded;
+  return df;
+  } // decSetOverflow
+
+/* ------------------------------------------------------------------ */
+/* decRoundUp -- decide whether a truncated coefficient is incremented*/
+/*                                                                    */
+/*   round is the rounding mode                                       */
+/*   half describes the discarded part: 1 (less than half a unit),    */
+/*        2 (exactly half), or 3 (more than half)                     */
+/*   c is the truncated coefficient                                   */
+/*   sign is the sign of the number                                   */
+/*   returns 1 if the coefficient must be incremented                 */
+/* ------------------------------------------------------------------ */
+static Flag decRoundUp(enum rounding round, Int half, DECREG c,
+                       uInt sign) {
+  switch (round) {
+    case DEC_ROUND_HALF_EVEN:
+      return half==3 || (half==2 && (c&1)!=0);
+    case DEC_ROUND_HALF_UP:   return half>=2;
+    case DEC_ROUND_HALF_DOWN: return half==3;
+    case DEC_ROUND_DOWN:      return 0;
+    case DEC_ROUND_UP:        return 1;
+    case DEC_ROUND_CEILING:   return sign==0;
+    case DEC_ROUND_FLOOR:     return sign!=0;
+    case DEC_ROUND_05UP: {              // only if last digit is 0 or 5
+      uInt last=(uInt)(c%10);
+      return last==0 || last==5;
+      }
+    default: return 0;                  // [cannot happen]
+    }
+  } // decRoundUp
+
+/* ------------------------------------------------------------------ */
+/* decDropDigits -- discard the least-significant digits of a register*/
+/*                                                                    */
+/*   c is the register; it is divided by 10**drop                     */
+/*   drop is the number of digits to discard (>0)                     */
+/*   sticky is 1 if there were further non-zero digits below c        */
+/*   returns 0 if the discarded part was zero, otherwise 1 (less than */
+/*     half a unit in the new last place), 2 (exactly half), or 3     */
+/*     (more than half)                                               */
+/* ------------------------------------------------------------------ */
+static Int decDropDigits(DECREG *c, Int drop, Flag sticky) {
+  DECREG p, r, h;                       // divisor, remainder, half
+  if (drop>DECPMAX+1) {                 // all digits discarded
+    Int half=(*c!=0 || sticky);         // [c is less than half of p]
+    *c=0;
+    return half;
+    }
+  p=DECREGPOW[drop];
+  h=p>>1;
+  r=*c;
+  *c/=p;
+  r-=*c*p;                              // [one division for both]
+  if (r<h) return (r!=0 || sticky);
+  if (r==h) return sticky ? 3 : 2;
+  return 3;
+  } // decDropDigits
+
+/* ------------------------------------------------------------------ */
+/* decFinalize -- round, check, and encode a finite result            */
+/*                                                                    */
+/*   df is the target decFloat                                        */
+/*   num is the result; its coefficient may have up to DECPMAX+1      */
+/*       digits and its exponent may be outside the format's range    */
+/*   sticky is 1 if the exact result is larger (in magnitude) than    */
+/*       num by less than one unit in the last place of num, and 0 if */
+/*       num is exact.  If sticky is 1 the coefficient must have      */
+/*       DECPMAX+1 digits                                             */
+/*   round is the rounding mode to use                                */
+/*   status is the status accumulator                                 */
+/*   returns df                                                       */
+/*                                                                    */
+/* This follows decNumber's decFinalize and decSetSubnormal: tiny is  */
+/* detected before rounding, Underflow is set only if the result is   */
+/* both subnormal and inexact, a subnormal which rounds to zero is    */
+/* Clamped, and an exponent which is too large for the coefficient to */
+/* be encoded is reduced by padding with zeros ('fold-down').         */
+/* ------------------------------------------------------------------ */
+static decFloat * decFinalize(decFloat *df, binnum *num, Flag sticky,
+                              enum rounding round, uInt *status) {
+  DECREG c=num->coeff;                  // working coefficient
+  Int e=num->exponent;                  // .. and exponent
+  Int n, drop;                          // digits, and digits to drop
+  Flag tiny=0;                          // 1 if subnormal
+
+  if (c==0 && !sticky) {                // exact zero
+    if (e<DECETINY) {
+      num->exponent=DECETINY;
+      *status|=DEC_Clamped;
+      }
+     else if (e>DECQMAX) {
+      num->exponent=DECQMAX;
+      *status|=DEC_Clamped;
+      }
+    return decPack(df, num);
+    }
+
+  n=decRegDigits(c);
+  drop=n-DECPMAX;
+  if (e+n-1<DECEMIN) {                  // tiny before rounding
+    tiny=1;
+    *status|=DEC_Subnormal;
+    if (e+drop<DECETINY) drop=DECETINY-e;  // round at Etiny
+    }
+
+  if (drop>0 || sticky) {               // rounding may be needed
+    Int half;                           // see decDropDigits
+    if (drop<=0) {                      // only the sticky bit
+      drop=0;
+      half=1;
+      }
+     else {
+      *status|=DEC_Rounded;
+      half=decDropDigits(&c, drop, sticky);
+      e+=drop;
+      }
+    if (half!=0) {
+      *status|=DEC_Inexact | DEC_Rounded;
+      if (tiny) *status|=DEC_Underflow;
+      if (decRoundUp(round, half, c, num->sign)) {
+        c++;
+        if (c==DECREGPOW[DECPMAX]) {    // carried out; renormalize
+          c=DECREGPOW[DECPMAX-1];
+          e++;
+          }
+        }
+      if (c==0) *status|=DEC_Clamped;   // subnormal rounded to 0
+      }
+    }
+
+  if (e>DECQMAX) {                      // may overflow or need padding
+    if (c==0) e=DECQMAX;                // [cannot happen]
+     else {
+      n=decRegDigits(c);
+      if (e+n-1>DECEMAX) return decSetOverflow(df, num->sign, round,
+                                               status);
+      c*=DECREGPOW[e-DECQMAX];          // fold down
+      e=DECQMAX;
+      *status|=DEC_Clamped;
+      }
+    }
+  num->coeff=c;
+  num->exponent=e;
+  return decPack(df, num);
+  } // decFinalize
+
+/* ------------------------------------------------------------------ */
+/* decInvalid -- set a decFloat to the result of an invalid operation */
+/*                                                                    */
+/*   df is the target                                                 */
+/*   status is the status accumulator                                 */
+/*   returns df, which is set to a quiet NaN                          */
+/* ------------------------------------------------------------------ */
+static decFloat * decInvalid(decFloat *df, uInt *status) {
+  binnum nan;
+  nan.sign=0;
+  nan.exponent=DECFLOAT_qNaN;
+  nan.coeff=0;
+  *status|=DEC_Invalid_operation;
+  return decPack(df, &nan);
+  } // decInvalid
+
+/* ------------------------------------------------------------------ */
+/* decNaNs -- handle NaN operand or operands                          */
+/*                                                                    */
+/*   result is the target                                             */
+/*   dfl is the first operand                                         */
+/*   dfr is the second operand, or NULL if a monadic operation        */
+/*   status is the status accumulator                                 */
+/*   returns result                                                   */
+/*                                                                    */
+/* At least one operand must be a NaN.  The result is the first sNaN, */
+/* or if there is none the first NaN, made quiet and canonical; an    */
+/* sNaN operand sets Invalid_operation.                               */
+/* ------------------------------------------------------------------ */
+static decFloat * decNaNs(decFloat *result, const decFloat *dfl,
+                          const decFloat *dfr, uInt *status) {
+  binnum num;
+  if (dfr!=NULL) {
+    if (DFISSNAN(dfr) && !DFISSNAN(dfl)) dfl=dfr;
+     else if (!DFISNAN(dfl)) dfl=dfr;
+    }
+  if (DFISSNAN(dfl)) *status|=DEC_Invalid_operation;
+  decUnpack(dfl, &num);
+  num.exponent=DECFLOAT_qNaN;
+  return decPack(result, &num);
+  } // decNaNs
+
+/* ------------------------------------------------------------------ */
+/* decStrEq -- caseless comparison of strings                         */
+/*                                                                    */
+/*   str1 is one of the strings to compare                            */
+/*   str2 is the other, which must be lowercase                       */
+/*   returns 1 if the strings are equal, caselessly, 0 otherwise      */
+/* ------------------------------------------------------------------ */
+static Flag decStrEq(const char *str1, const char *str2) {
+  for (;; str1++, str2++) {
+    char u1=*str1;
+    if (u1>='A' && u1<='Z') u1=(char)(u1+('a'-'A'));
+    if (u1!=*str2) return 0;
+    if (u1=='\0') return 1;
+    }
+  } // decStrEq
+
+/* ================================================================== */
+/* Conversions                                                        */
+/* ================================================================== */
+
+/* ------------------------------------------------------------------ */
+/* decFloatFromString -- conversion from numeric string               */
+/*                                                                    */
+/*   result is the decFloat format number which gets the result of    */
+/*     the conversion                                                 */
+/*   string is the character string which should contain a valid      */
+/*     number (which may be a special value), \0-terminated           */
+/*   set is the context                                               */
+/*   returns result                                                   */
+/*                                                                    */
+/* The syntax and rounding are as for decNumberFromString, with the   */
+/* precision and exponent range of the format.  Only DECPMAX+1        */
+/* significant digits are kept, with any further non-zero digits      */
+/* noted as a sticky bit, so very long strings need no extra storage. */
+/* A NaN payload may have at most DECPMAX-1 digits.  If the syntax is */
+/* invalid the result is a quiet NaN and Conversion_syntax is set.    */
+/* ------------------------------------------------------------------ */
+decFloat * decFloatFromString(decFloat *result, const char *string,
+                              decContext *set) {
+  binnum num;                           // unpacked result
+  uInt status=0;                        // accumulator
+  const char *c=string;                 // work
+  Int digits=0;                         // significant digits seen
+  Int dropped=0;                        // .. and not kept
+  Int frac=0;                           // digits after '.'
+  Int exp=0;                            // explicit exponent
+  Flag sticky=0;                        // 1 if a dropped digit was >0
+  Flag seendot=0, seendigit=0;          // syntax flags
+
+  num.sign=0;
+  num.coeff=0;
+  if (*c=='-') {
+    num.sign=DECFLOAT_Sign;
+    c++;
+    }
+   else if (*c=='+') c++;
+
+  for (;; c++) {
+    if (*c>='0' && *c<='9') {
+      seendigit=1;
+      if (seendot) frac++;
+      if (digits==0 && *c=='0') continue;    // leading zero
+      if (digits<DECPMAX+1) num.coeff=num.coeff*10+(uInt)(*c-'0');
+       else {
+        dropped++;
+        if (*c!='0') sticky=1;
+        }
+      digits++;
+      continue;
+      }
+    if (*c=='.' && !seendot) {
+      seendot=1;
+      continue;
+      }
+    break;
+    }
+
+  if (!seendigit) {                     // must be a special
+    if (seendot) ;                      // '.' alone is not valid
+     else if (decStrEq(c, "inf") || decStrEq(c, "infinity")) {
+      num.exponent=DECFLOAT_Inf;
+      num.coeff=0;
+      decPack(result, &num);
+      return result;
+      }
+     else {
+      num.exponent=DECFLOAT_qNaN;
+      if (*c=='s' || *c=='S') {
+        num.exponent=DECFLOAT_sNaN;
+        c++;
+        }
+      if ((*c=='n' || *c=='N') && (*(c+1)=='a' || *(c+1)=='A')
+       && (*(c+2)=='n' || *(c+2)=='N')) {
+        c+=3;
+        for (; *c=='0'; c++);           // ignore leading zeros
+        for (; *c>='0' && *c<='9'; c++) {
+          if (digits==DECPMAX-1) break;     // payload too long
+          num.coeff=num.coeff*10+(uInt)(*c-'0');
+          digits++;
+          }
+        if (*c=='\0') {
+          decPack(result, &num);
+          return result;
+          }
+        }
+      }
+    }
+   else {
+    if (*c=='e' || *c=='E') {           // exponent part
+      Flag negexp=0;
+      c++;
+      if (*c=='-') {
+        negexp=1;
+        c++;
+        }
+       else if (*c=='+') c++;
+      if (*c>='0' && *c<='9') {
+        for (; *c>='0' && *c<='9'; c++) {
+          // saturate; any exponent this large is out of range anyway
+          if (exp<100000000) exp=exp*10+(*c-'0');
+          }
+        if (negexp) exp=-exp;
+        }
+       else c=string;                   // force syntax error
+      }
+    if (*c=='\0') {
+      num.exponent=exp-frac+dropped;
+      decFinalize(result, &num, sticky, set->round, &status);
+      if (status!=0) decContextSetStatus(set, status);
+      return result;
+      }
+    }
+
+  // syntax error
+  decInvalid(result, &status);
+  decContextSetStatus(set, DEC_Conversion_syntax);
+  return result;
+  } // decFloatFromString
+
+#if !SINGLE
+/* ------------------------------------------------------------------ */
+/* decFloatFromInt32 -- initialise a decFloat from an Int             */
+/*                                                                    */
+/*   result gets the converted Int                                    */
+/*   n is the Int to convert                                          */
+/*   returns result                                                   */
+/*                                                                    */
+/* The result is exact; no errors or exceptions are possible.         */
+/* ------------------------------------------------------------------ */
+decFloat * decFloatFromInt32(decFloat *result, Int n) {
+  binnum num;
+  num.sign=0;
+  num.exponent=0;
+  if (n<0) {
+    num.sign=DECFLOAT_Sign;
+    num.coeff=(uInt)0-(uInt)n;          // [avoids overflow at INT_MIN]
+    }
+   else num.coeff=(uInt)n;
+  return decPack(result, &num);
+  } // decFloatFromInt32
+
+/* ------------------------------------------------------------------ */
+/* decFloatFromUInt32 -- initialise a decFloat from a uInt            */
+/*                                                                    */
+/*   result gets the converted uInt                                   */
+/*   n is the uInt to convert                                         */
+/*   returns result                                                   */
+/*                                                                    */
+/* The result is exact; no errors or exceptions are possible.         */
+/* ------------------------------------------------------------------ */
+decFloat * decFloatFromUInt32(decFloat *result, uInt n) {
+  binnum num;
+  num.sign=0;
+  num.exponent=0;
+  num.coeff=n;
+  return decPack(result, &num);
+  } // decFloatFromUInt32
+#endif
+
+/* ------------------------------------------------------------------ */
+/* decToString -- lay out a decFloat as a string                      */
+/*                                                                    */
+/*   df is the decFloat format number to convert                      */
+/*   string is the string where the result will be laid out           */
+/*   eng is 1 if Engineering, 0 if Scientific                         */
+/*   returns string                                                   */
+/*                                                                    */
+/* The layout is exactly that of decNumber's decToString; the         */
+/* coefficient digits are taken directly from the declets using       */
+/* DPD2BCD8.  string must be at least DECSTRING characters.           */
+/* ------------------------------------------------------------------ */
+static char * decToString(const decFloat *df, char *string, Flag eng) {
+  uByte bcdar[DECPMAX+4];               // coefficient (+ slack)
+  const uByte *ub, *ulsd;               // first and last digits
+  char *c=string;                       // output pointer
+  Int digits, exp, pre, e;              // work
+
+  if (DFISSIGNED(df)) *c++='-';
+  if (DFISSPECIAL(df)) {
+    if (DFISINF(df)) {
+      strcpy(c, "Infinity");
+      return string;
+      }
+    if (DFISSNAN(df)) *c++='s';
+    strcpy(c, "NaN");
+    c+=3;
+    GETCOEFF(df, bcdar);
+    bcdar[0]=0;                         // payload has no MSD
+    ulsd=bcdar+DECPMAX-1;
+    for (ub=bcdar; ub<=ulsd && *ub==0; ub++);    // skip zeros
+    for (; ub<=ulsd; ub++) *c++=(char)(*ub+'0');  // payload, if any
+    *c='\0';
+    return string;
+    }
+
+  GETCOEFF(df, bcdar);
+  exp=GETEXPUN(df);
+  ulsd=bcdar+DECPMAX-1;
+  for (ub=bcdar; ub<ulsd && *ub==0; ub++);       // keep at least one
+  digits=(Int)(ulsd-ub)+1;
+
+  pre=digits+exp;                       // digits before '.'
+  e=0;                                  // no E
+  if (exp>0 || pre<-5) {                // need exponential form
+    e=exp+digits-1;
+    pre=1;
+    if (eng && e!=0) {                  // may need to adjust
+      Int adj;                          // adjustment
+      // a positive remainder calculation must be used here
+      if (e<0) {
+        adj=(-e)%3;
+        if (adj!=0) adj=3-adj;
+        }
+       else adj=e%3;
+      e-=adj;
+      // a zero still gets an exponent which is a multiple of three,
+      // but there will still only be the one zero before the E
+      if (!(digits==1 && *ub==0)) pre+=adj;
+       else if (adj!=0) {               // 0.00Esnn needed
+        e+=3;
+        pre=-(2-adj);
+        }
+      }
+    }
+
+  if (pre>0) {                          // xxx.xxx or xx00 form
+    Int n=MINI(pre, digits);            // digits before '.'
+    const uByte *u=ub;
+    for (; u<ub+n; u++) *c++=(char)(*u+'0');
+    if (pre<digits) {                   // more to come, after '.'
+      *c++='.';
+      for (; u<=ulsd; u++) *c++=(char)(*u+'0');
+      }
+     else for (; n<pre; n++) *c++='0';  // padding (for engineering)
+    }
+   else {                               // 0.xxx or 0.000xxx form
+    *c++='0';
+    *c++='.';
+    for (; pre<0; pre++) *c++='0';
+    for (; ub<=ulsd; ub++) *c++=(char)(*ub+'0');
+    }
+
+  if (e!=0) {                           // add the E part
+    char ebuf[12];                      // exponent digits, reversed
+    Int ed=0;
+    uInt u;
+    *c++='E';
+    if (e<0) {
+      *c++='-';
+      u=(uInt)-e;
+      }
+     else {
+      *c++='+';
+      u=(uInt)e;
+      }
+    for (; u>0; u/=10) ebuf[ed++]=(char)('0'+u%10);
+    for (; ed>0; ed--) *c++=ebuf[ed-1];
+    }
+  *c='\0';
+  return string;
+  } // decToString
+
+/* ------------------------------------------------------------------ */
+/* decFloatToString -- conversion to numeric string                   */
+/* decFloatToEngString -- conversion to numeric string, engineering   */
+/*                                                                    */
+/*   df is the decFloat format number to convert                      */
+/*   string is the string where the result will be laid out           */
+/*   returns string                                                   */
+/*                                                                    */
+/* string must be at least DECSTRING characters; no error is possible */
+/* ------------------------------------------------------------------ */
+char * decFloatToString(const decFloat *df, char *string) {
+  return decToString(df, string, 0);
+  } // decFloatToString
+
+char * decFloatToEngString(const decFloat *df, char *string) {
+  return decToString(df, string, 1);
+  } // decFloatToEngString
+
+#if SINGLE
+/* ------------------------------------------------------------------ */
+/* decFloatFromWider -- conversion from next-wider format             */
+/*                                                                    */
+/*   result is the decFloat format number which gets the result of    */
+/*     the conversion                                                 */
+/*   wider is the decFloatWider format number which will be narrowed  */
+/*   set is the context                                               */
+/*   returns result                                                   */
+/*                                                                    */
+/* Narrowing can cause rounding, overflow, etc., but not Invalid      */
+/* operation (sNaNs are copied and do not signal).  As with           */
+/* decFloatFromString, only DECPMAX+1 digits are kept, with the rest  */
+/* noted as a sticky bit, and a NaN payload keeps its DECPMAX-1       */
+/* least-significant digits.                                          */
+/* ------------------------------------------------------------------ */
+decFloat * decFloatFromWider(decFloat *result, const decFloatWider *wider,
+                             decContext *set) {
+  uByte bcdar[DECWPMAX];                // wider coefficient
+  binnum num;                           // unpacked result
+  uInt status=0;                        // accumulator
+  uInt sourhi=DFWWORD(wider, 0);        // top word of wider
+  const uByte *ub, *ulsd=bcdar+DECWPMAX-1;    // first and last digits
+  Flag sticky=0;                        // 1 if a dropped digit was >0
+
+  num.sign=sourhi&DECFLOAT_Sign;
+  num.coeff=0;
+  GETWCOEFF(wider, bcdar);
+  if ((sourhi&0x78000000)==0x78000000) {     // wider is a special
+    if ((sourhi&0x7c000000)==0x78000000) {   // Infinity
+      num.exponent=DECFLOAT_Inf;
+      return decPack(result, &num);
+      }
+    num.exponent=sourhi&0x7e000000;     // qNaN or sNaN
+    for (ub=ulsd-(DECPMAX-2); ub<=ulsd; ub++) num.coeff=num.coeff*10+*ub;
+    return decPack(result, &num);
+    }
+
+  num.exponent=(Int)((DECCOMBEXP[sourhi>>26]>>DECECONL)<<DECWECONL)
+               +GETWECON(wider)-DECWBIAS;
+  for (ub=bcdar; ub<ulsd && *ub==0; ub++);  // skip leading zeros
+  if (ulsd-ub>=DECPMAX+1) {             // more than DECPMAX+1 digits
+    const uByte *u=ub+DECPMAX+1;        // first digit not kept
+    num.exponent+=(Int)(ulsd-u)+1;
+    for (; u<=ulsd; u++) if (*u!=0) sticky=1;
+    ulsd=ub+DECPMAX;
+    }
+  for (; ub<=ulsd; ub++) num.coeff=num.coeff*10+*ub;
+  decFinalize(result, &num, sticky, set->round, &status);
+  if (status!=0) decContextSetStatus(set, status);
+  return result;
+  } // decFloatFromWider
+
+/* ------------------------------------------------------------------ */
+/* decFloatToWider -- conversion to next-wider format                 */
+/*                                                                    */
+/*   source is the decFloat format number which gets the result of    */
+/*     the conversion                                                 */
+/*   wider is the decFloatWider format number which will be set       */
+/*   returns wider                                                    */
+/*                                                                    */
+/* Widening is always exact; no status is set (sNaNs are copied and   */
+/* do not signal).  The result is always canonical.                   */
+/* ------------------------------------------------------------------ */
+decFloatWider * decFloatToWider(const decFloat *source, decFloatWider *wider) {
+  binnum num;                           // unpacked source
+  uInt top;                             // sign and combination field
+
+  decUnpack(source, &num);
+  if (EXPISSPECIAL(num.exponent)) top=num.sign|(uInt)num.exponent;
+   else {
+    uInt bexp=(uInt)(num.exponent+DECWBIAS);     // wider biased exponent
+    top=num.sign|DECCOMBFROM[(bexp>>DECWECONL)<<4]
+       |((bexp&((1<<DECWECONL)-1))<<(26-DECWECONL));
+    }
+  // the coefficient fits in the least-significant word of the wider
+  DFWWORD(wider, 0)=top;
+  DFWWORD(wider, 1)=(BIN2DPD[num.coeff/1000000]<<20)
+                   |(BIN2DPD[(num.coeff/1000)%1000]<<10)
+                   |BIN2DPD[num.coeff%1000];
+  return wider;
+  } // decFloatToWider
+#endif
+
+/* ================================================================== */
+/* Comparisons                                                        */
+/* ================================================================== */
+
+/* Operation codes for decCompareOp */
+#define COMPARE   0x01                  // Compare operators
+#define COMPMAX   0x02                  // ..
+#define COMPMIN   0x03                  // ..
+#define COMPTOTAL 0x04                  // ..
+#define COMPSIG   0x06                  // ..
+#define COMPMAXMAG 0x07                 // ..
+#define COMPMINMAG 0x08                 // ..
+
+/* ------------------------------------------------------------------ */
+/* decMagCompare -- compare the magnitudes of two binnums             */
+/*                                                                    */
+/*   a, b are the binnums to compare; neither may be a NaN            */
+/*   returns -1, 0, or 1 as |a| is less than, equal to, or greater    */
+/*     than |b|                                                       */
+/* ------------------------------------------------------------------ */
+static Int decMagCompare(const binnum *a, const binnum *b) {
+  Flag ia=EXPISINF(a->exponent), ib=EXPISINF(b->exponent);
+  Int da, db;                           // digits
+  DECREG ca=a->coeff, cb=b->coeff;      // coefficients
+  if (ia || ib) {
+    if (ia==ib) return 0;
+    return ia ? 1 : -1;
+    }
+  if (ca==0 || cb==0) {
+    if (cb!=0) return -1;
+    return ca!=0;
+    }
+  da=decRegDigits(ca);
+  db=decRegDigits(cb);
+  if (a->exponent+da!=b->exponent+db)   // adjusted exponents differ
+    return (a->exponent+da>b->exponent+db) ? 1 : -1;
+  if (da<db) ca*=DECREGPOW[db-da];      // align
+   else if (db<da) cb*=DECREGPOW[da-db];
+  if (ca==cb) return 0;
+  return ca>cb ? 1 : -1;
+  } // decMagCompare
+
+/* ------------------------------------------------------------------ */
+/* decNumCompare -- compare two binnums by numerical value            */
+/*                                                                    */
+/*   a, b are the binnums to compare; neither may be a NaN            */
+/*   mag is 1 to compare magnitudes only                              */
+/*   returns -1, 0, or 1 as a is less than, equal to, or greater than */
+/*     b                                                              */
+/* ------------------------------------------------------------------ */
+static Int decNumCompare(const binnum *a, const binnum *b, Flag mag) {
+  Int sa, sb;                           // signums
+  Int r;                                // result
+  sa=(a->coeff!=0 || EXPISINF(a->exponent));
+  sb=(b->coeff!=0 || EXPISINF(b->exponent));
+  if (!mag) {
+    if (a->sign) sa=-sa;
+    if (b->sign) sb=-sb;
+    }
+  if (sa!=sb) return sa>sb ? 1 : -1;
+  if (sa==0) return 0;                  // both zero
+  r=decMagCompare(a, b);
+  return sa>0 ? r : -r;
+  } // decNumCompare
+
+/* ------------------------------------------------------------------ */
+/* decCompareOp -- compare, min, or max two decFloats                 */
+/*                                                                    */
+/*   result gets the result of the operation                          */
+/*   dfl is the first decFloat (lhs)                                  */
+/*   dfr is the second decFloat (rhs)                                 */
+/*   set is the context (unused for COMPTOTAL)                        */
+/*   op is the operation (see decNumber's decCompareOp)               */
+/*   status is the status accumulator                                 */
+/*   returns result                                                   */
+/* ------------------------------------------------------------------ */
+static decFloat * decCompareOp(decFloat *result, const decFloat *dfl,
+                               const decFloat *dfr, decContext *set,
+                               Flag op, uInt *status) {
+  binnum a, b, num;                     // operands and result
+  Int r=0;                              // comparison result
+
+  decUnpack(dfl, &a);
+  decUnpack(dfr, &b);
+  if (op==COMPTOTAL) {                  // total ordering
+    if (a.sign!=b.sign) r=a.sign ? -1 : 1;
+     else {
+      Flag na=EXPISNAN(a.exponent), nb=EXPISNAN(b.exponent);
+      if (na || nb) {                   // as if both positive
+        if (!na) r=-1;
+         else if (!nb) r=1;
+         else if (a.exponent!=b.exponent)    // sNaN<qNaN
+          r=(a.exponent==DECFLOAT_sNaN) ? -1 : 1;
+         else if (a.coeff!=b.coeff) r=(a.coeff<b.coeff) ? -1 : 1;
+        }
+       else {
+        r=decMagCompare(&a, &b);
+        // numerically equal; order by exponent
+        if (r==0 && !EXPISINF(a.exponent) && a.exponent!=b.exponent)
+          r=(a.exponent<b.exponent) ? -1 : 1;
+        }
+      if (a.sign) r=-r;
+      }
+    }
+   else if (EXPISNAN(a.exponent) || EXPISNAN(b.exponent)) {
+    if (op==COMPARE);                   // result will be NaN
+     else if (op==COMPSIG) *status|=DEC_Invalid_operation;
+     else if (EXPISNAN(a.exponent)!=EXPISNAN(b.exponent)
+           && a.exponent!=DECFLOAT_sNaN && b.exponent!=DECFLOAT_sNaN) {
+      // min or max with just one quiet NaN; choose the number
+      num=EXPISNAN(a.exponent) ? b : a;
+      if (EXPISINF(num.exponent)) return decPack(result, &num);
+      return decFinalize(result, &num, 0, set->round, status);
+      }
+    return decNaNs(result, dfl, dfr, status);
+    }
+   else if (op==COMPMAXMAG || op==COMPMINMAG) r=decNumCompare(&a, &b, 1);
+   else r=decNumCompare(&a, &b, 0);
+
+  if (op==COMPARE || op==COMPSIG || op==COMPTOTAL) {   // signum
+    num.sign=(r<0) ? DECFLOAT_Sign : 0;
+    num.coeff=(r!=0);
+    num.exponent=0;
+    return decPack(result, &num);
+    }
+
+  // max or min
+  if (r==0) {                           // choose by sign then exponent
+    if (a.sign!=b.sign) r=a.sign ? -1 : 1;
+     else if (a.sign) r=(a.exponent<b.exponent) ? 1 : -1;
+     else r=(a.exponent>b.exponent) ? 1 : -1;
+    }
+  if (op==COMPMIN || op==COMPMINMAG) r=-r;
+  num=(r>0) ? a : b;
+  if (EXPISINF(num.exponent)) return decPack(result, &num);
+  return decFinalize(result, &num, 0, set->round, status);
+  } // decCompareOp
+
+/* ------------------------------------------------------------------ */
+/* decFloatCompare -- compare two decFloats; quiet NaNs allowed       */
+/* decFloatCompareSignal -- compare two decFloats; all NaNs signal    */
+/*                                                                    */
+/*   result gets the result of the operation                          */
+/*   dfl is the first decFloat (lhs)                                  */
+/*   dfr is the second decFloat (rhs)                                 */
+/*   set is the context                                               */
+/*   returns result                                                   */
+/*                                                                    */
+/* DECCOMPAREOP is also used by decBasic.c for Max, Min, etc.         */
+/* ------------------------------------------------------------------ */
+#define DECCOMPAREOP(name, op)                                        \
+  decFloat * name(decFloat *result, const decFloat *dfl,              \
+                  const decFloat *dfr, decContext *set) {             \
+    uInt status=0;                                                    \
+    decCompareOp(result, dfl, dfr, set, op, &status);                 \
+    if (status!=0) decContextSetStatus(set, status);                  \
+    return result;                                                    \
+    }
+DECCOMPAREOP(decFloatCompare, COMPARE)
+DECCOMPAREOP(decFloatCompareSignal, COMPSIG)
+#if SINGLE
+  #undef DECCOMPAREOP                   // [no decBasic.c]
+#endif
+
+/* ------------------------------------------------------------------ */
+/* decFloatCompareTotal -- compare two decFloats with total ordering  */
+/* decFloatCompareTotalMag -- compare magnitudes with total ordering  */
+/*                                                                    */
+/*   result gets the result of comparing dfl and dfr                  */
+/*   dfl is the first decFloat (lhs)                                  */
+/*   dfr is the second decFloat (rhs)                                 */
+/*   returns result, which may be -1, 0, or 1                         */
+/*                                                                    */
+/* No error is possible and no status results.                        */
+/* ------------------------------------------------------------------ */
+decFloat * decFloatCompareTotal(decFloat *result, const decFloat *dfl,
+                                const decFloat *dfr) {
+  uInt status=0;                        // [unused]
+  return decCompareOp(result, dfl, dfr, NULL, COMPTOTAL, &status);
+  } // decFloatCompareTotal
+
+decFloat * decFloatCompareTotalMag(decFloat *result, const decFloat *dfl,
+                                   const decFloat *dfr) {
+  decFloat a, b;                        // absolute copies
+  uInt status=0;                        // [unused]
+  decFloatCopyAbs(&a, dfl);
+  decFloatCopyAbs(&b, dfr);
+  return decCompareOp(result, &a, &b, NULL, COMPTOTAL, &status);
+  } // decFloatCompareTotalMag
+
+/* ================================================================== */
+/* Non-computational routines                                         */
+/* ================================================================== */
+
+/* ------------------------------------------------------------------ */
+/* decFloatCanonical -- copy a decFloat, making canonical             */
+/*                                                                    */
+/*   result gets the canonicalized df                                 */
+/*   df is the decFloat to copy and make canonical                    */
+/*   returns result                                                   */
+/*                                                                    */
+/* Non-canonical declets are replaced by their canonical encoding,    */
+/* unused bits of an Infinity are cleared, and a NaN keeps its        */
+/* payload.  No error is possible.                                    */
+/* ------------------------------------------------------------------ */
+decFloat * decFloatCanonical(decFloat *result, const decFloat *df) {
+  binnum num;
+  decUnpack(df, &num);
+  return decPack(result, &num);
+  } // decFloatCanonical
+
+/* ------------------------------------------------------------------ */
+/* decFloatClass -- return the class of a decFloat                    */
+/*                                                                    */
+/*   df is the decFloat to test                                       */
+/*   returns the decClass that df falls into                          */
+/* ------------------------------------------------------------------ */
+enum decClass decFloatClass(const decFloat *df) {
+  Int exp;                              // exponent
+  if (DFISSPECIAL(df)) {
+    if (DFISQNAN(df)) return DEC_CLASS_QNAN;
+    if (DFISSNAN(df)) return DEC_CLASS_SNAN;
+    // must be an infinity
+    if (DFISSIGNED(df)) return DEC_CLASS_NEG_INF;
+    return DEC_CLASS_POS_INF;
+    }
+  if (DFISZERO(df)) {
+    if (DFISSIGNED(df)) return DEC_CLASS_NEG_ZERO;
+    return DEC_CLASS_POS_ZERO;
+    }
+  // is finite and non-zero; similar code to decFloatIsNormal
+  exp=GETEXPUN(df)+decFloatDigits(df)-1;    // adjusted exponent
+  if (exp>=DECEMIN) {                   // is normal
+    if (DFISSIGNED(df)) return DEC_CLASS_NEG_NORMAL;
+    return DEC_CLASS_POS_NORMAL;
+    }
+  // is subnormal
+  if (DFISSIGNED(df)) return DEC_CLASS_NEG_SUBNORMAL;
+  return DEC_CLASS_POS_SUBNORMAL;
+  } // decFloatClass
+
+/* ------------------------------------------------------------------ */
+/* decFloatClassString -- return the class of a decFloat as a string  */
+/*                                                                    */
+/*   df is the decFloat to test                                       */
+/*   returns a constant string describing the class df falls into     */
+/* ------------------------------------------------------------------ */
+const char *decFloatClassString(const decFloat *df) {
+  enum decClass eclass=decFloatClass(df);
+  if (eclass==DEC_CLASS_POS_NORMAL)    return DEC_ClassString_PN;
+  if (eclass==DEC_CLASS_NEG_NORMAL)    return DEC_ClassString_NN;
+  if (eclass==DEC_CLASS_POS_ZERO)      return DEC_ClassString_PZ;
+  if (eclass==DEC_CLASS_NEG_ZERO)      return DEC_ClassString_NZ;
+  if (eclass==DEC_CLASS_QNAN)          return DEC_ClassString_QN;
+  if (eclass==DEC_CLASS_SNAN)          return DEC_ClassString_SN;
+  if (eclass==DEC_CLASS_POS_INF)       return DEC_ClassString_PI;
+  if (eclass==DEC_CLASS_NEG_INF)       return DEC_ClassString_NI;
+  if (eclass==DEC_CLASS_POS_SUBNORMAL) return DEC_ClassString_PS;
+  if (eclass==DEC_CLASS_NEG_SUBNORMAL) return DEC_ClassString_NS;
+  return DEC_ClassString_UN;           // Unknown
+  } // decFloatClassString
+
+/* ------------------------------------------------------------------ */
+/* decFloatCopy -- copy a decFloat as-is                              */
+/* decFloatCopyAbs -- copy a decFloat as-is and set sign bit to 0     */
+/* decFloatCopyNegate -- copy a decFloat as-is with inverted sign bit */
+/*                                                                    */
+/*   result gets the copy of dfl                                      */
+/*   dfl is the decFloat to copy                                      */
+/*   returns result                                                   */
+/*                                                                    */
+/* These are bitwise operations; no errors or exceptions are possible.*/
+/* ------------------------------------------------------------------ */
+decFloat * decFloatCopy(decFloat *result, const decFloat *dfl) {
+  if (dfl!=result) *result=*dfl;        // copy needed
+  return result;
+  } // decFloatCopy
+
+decFloat * decFloatCopyAbs(decFloat *result, const decFloat *dfl) {
+  if (dfl!=result) *result=*dfl;        // copy needed
+  DFBYTE(result, 0)&=~0x80;             // zero sign bit
+  return result;
+  } // decFloatCopyAbs
+
+decFloat * decFloatCopyNegate(decFloat *result, const decFloat *dfl) {
+  if (dfl!=result) *result=*dfl;        // copy needed
+  DFBYTE(result, 0)^=0x80;              // invert sign bit
+  return result;
+  } // decFloatCopyNegate
+
+/* ------------------------------------------------------------------ */
+/* decFloatCopySign -- copy a decFloat with the sign of another       */
+/*                                                                    */
+/*   result gets the result of copying dfl with the sign of dfr       */
+/*   dfl is the first decFloat (lhs)                                  */
+/*   dfr is the second decFloat (rhs)                                 */
+/*   returns result                                                   */
+/*                                                                    */
+/* This is a bitwise operation; no errors or exceptions are possible. */
+/* ------------------------------------------------------------------ */
+decFloat * decFloatCopySign(decFloat *result, const decFloat *dfl,
+                            const decFloat *dfr) {
+  uByte sign=(uByte)(DFBYTE(dfr, 0)&0x80);   // save sign bit
+  if (dfl!=result) *result=*dfl;        // copy needed
+  DFBYTE(result, 0)&=~0x80;             // clear sign ..
+  DFBYTE(result, 0)=(uByte)(DFBYTE(result, 0)|sign); // .. and set saved
+  return result;
+  } // decFloatCopySign
+
+/* ------------------------------------------------------------------ */
+/* decFloatDigits -- return the number of digits in a decFloat        */
+/*                                                                    */
+/*   df is the decFloat to investigate                                */
+/*   returns the number of significant digits in the decFloat; a      */
+/*     zero coefficient returns 1 as does an infinity (a NaN returns  */
+/*     the number of digits in the payload)                           */
+/* ------------------------------------------------------------------ */
+uInt decFloatDigits(const decFloat *df) {
+  binnum num;
+  decUnpack(df, &num);
+  return (uInt)decRegDigits(num.coeff);
+  } // decFloatDigits
+
+/* ------------------------------------------------------------------ */
+/* decFloatIs -- decFloat tests (IsSigned, etc.)                      */
+/*                                                                    */
+/*   df is the decFloat to test                                       */
+/*   returns 0 or 1 in a uInt                                         */
+/*                                                                    */
+/* Many of these could be macros, but having them as real functions   */
+/* is a little cleaner (and they can be referred to here by the       */
+/* generic names)                                                     */
+/* ------------------------------------------------------------------ */
+uInt decFloatIsCanonical(const decFloat *df) {
+  decFloat canon;
+  decFloatCanonical(&canon, df);
+  return memcmp(&canon, df, sizeof(decFloat))==0;
+  } // decFloatIsCanonical
+
+uInt decFloatIsFinite(const decFloat *df) {
+  return !DFISSPECIAL(df);
+  } // decFloatIsFinite
+
+uInt decFloatIsInfinite(const decFloat *df) {
+  return DFISINF(df);
+  } // decFloatIsInfinite
+
+uInt decFloatIsInteger(const decFloat *df) {
+  return DFISINT(df);
+  } // decFloatIsInteger
+
+uInt decFloatIsNaN(const decFloat *df) {
+  return DFISNAN(df);
+  } // decFloatIsNaN
+
+uInt decFloatIsNormal(const decFloat *df) {
+  Int exp;                              // exponent
+  if (DFISSPECIAL(df)) return 0;
+  if (DFISZERO(df)) return 0;
+  // is finite and non-zero
+  exp=GETEXPUN(df)+decFloatDigits(df)-1;    // adjusted exponent
+  return (exp>=DECEMIN);                // < DECEMIN is subnormal
+  } // decFloatIsNormal
+
+uInt decFloatIsSignaling(const decFloat *df) {
+  return DFISSNAN(df);
+  } // decFloatIsSignaling
+
+uInt decFloatIsSigned(const decFloat *df) {
+  return DFISSIGNED(df);
+  } // decFloatIsSigned
+
+uInt decFloatIsSubnormal(const decFloat *df) {
+  if (DFISSPECIAL(df)) return 0;
+  // is finite
+  if (decFloatIsNormal(df)) return 0;
+  // it is <Nmin, but could be zero
+  if (DFISZERO(df)) return 0;
+  return 1;                             // is subnormal
+  } // decFloatIsSubnormal
+
+uInt decFloatIsZero(const decFloat *df) {
+  return DFISZERO(df);
+  } // decFloatIsZero
+
+/* ------------------------------------------------------------------ */
+/* decFloatRadix -- return the radix of a decFloat                    */
+/*                                                                    */
+/*   returns 10                                                       */
+/* ------------------------------------------------------------------ */
+uInt decFloatRadix(const decFloat *df) {
+  if (df) return 10;                    // to placate compiler
+  return 10;
+  } // decFloatRadix
+
+/* ------------------------------------------------------------------ */
+/* decFloatSameQuantum -- test decFloats for same quantum             */
+/*                                                                    */
+/*   dfl is the first decFloat (lhs)                                  */
+/*   dfr is the second decFloat (rhs)                                 */
+/*   returns 1 if the operands have the same quantum, 0 otherwise     */
+/*                                                                    */
+/* No error is possible and no status results.                        */
+/* ------------------------------------------------------------------ */
+uInt decFloatSameQuantum(const decFloat *dfl, const decFloat *dfr) {
+  if (DFISSPECIAL(dfl) || DFISSPECIAL(dfr)) {
+    if (DFISNAN(dfl) && DFISNAN(dfr)) return 1;
+    if (DFISINF(dfl) && DFISINF(dfr)) return 1;
+    return 0;  // any other special mixture gives false
+    }
+  if (GETEXP(dfl)==GETEXP(dfr)) return 1; // biased exponents match
+  return 0;
+  } // decFloatSameQuantum
+
+/* ------------------------------------------------------------------ */
+/* decFloatVersion -- return implementation version                   */
+/*                                                                    */
+/*   returns a constant string describing this version                */
+/* ------------------------------------------------------------------ */
+const char *decFloatVersion(void) {
+  return DECVERSION;
+  } // decFloatVersion
+
+/* ------------------------------------------------------------------ */
+/* decFloatZero -- set to canonical (integer) zero                    */
+/*                                                                    */
+/*   df is the decFloat format number to integer +0 (q=0, c=+0)       */
+/*   returns df                                                       */
+/*                                                                    */
+/* No error is possible, and no status can be set.                    */
+/* ------------------------------------------------------------------ */
+decFloat * decFloatZero(decFloat *df) {
+  DFWORD(df, 0)=ZEROWORD;               // set appropriate top word
+  #if !SINGLE
+    DFWORD(df, 1)=0;
+  #endif
+  #if QUAD
+    DFWORD(df, 2)=0;
+    DFWORD(df, 3)=0;
+  #endif
+  return df;
+  } // decFloatZero
@@ -22,6 +22,7 @@
 
 #include <string.h>           // for strcmp
 #include <stdio.h>            // for printf if DECCHECK
+#include <stdlib.h>           // for malloc, free
 #include "decContext.h"       // context and base types
 #include "decNumberLocal.h"   // decNumber local types, etc.
 
@@ -41,6 +42,41 @@ const uByte DECSTICKYTAB[10]={1,1,2,3,4,6,6,7,8,9}; /* used if sticky */
 const uInt DECPOWERS[10]={1, 10, 100, 1000, 10000, 100000, 1000000,
                           10000000, 100000000, 1000000000};
 
+/* ------------------------------------------------------------------ */
+/* Allocator used by contexts which do not name one [NULL=workspace]  */
+/* ------------------------------------------------------------------ */
+static DECTLS const decAllocator *decThreadAllocator=NULL;
+
+/* ------------------------------------------------------------------ */
+/* Scratch workspace, used when there is no allocator.  It is a       */
+/* stack: each allocation is a block pushed on top, and released      */
+/* blocks are popped as soon as no live block is above them (as is    */
+/* usual, since operations free their storage in roughly the reverse  */
+/* order of allocation).  When an operation (with any it called)      */
+/* completes the stack is empty, and the workspace is regrown, up to  */
+/* the limit, if the operation needed more than it held; meanwhile    */
+/* blocks which do not fit come from malloc.                          */
+/* ------------------------------------------------------------------ */
+#define DECWORKALIGN 16            // alignment of each allocation
+#define DECWORKHEAD  16            // block header bytes [DECWORKALIGN*n]
+typedef struct {
+  size_t prev;                     // offset of block below [workspace]
+                                   //   or bytes allocated [malloc]
+  size_t released;                 // 1 once released [workspace]
+  } decWorkBlock;
+typedef struct {
+  uByte *base;                     // -> storage [NULL if none]
+  size_t used;                     // bytes in use, to the top
+  size_t top;                      // offset of the top block
+  size_t heap;                     // bytes of blocks from malloc
+  size_t peak;                     // most bytes needed since idle
+  Int    live;                     // allocations not yet released
+  decWorkspaceStats stats;         // size, limit, and counters
+  } decWork;
+static DECTLS decWork decWorkspace={NULL, 0, 0, 0, 0, 0,
+                                    {0, DECWORKSPACE, 0, 0, 0, 0}};
+static void decWorkResize(decWork *, size_t);
+
 /* ------------------------------------------------------------------ */
 /* decContextClearStatus -- clear bits in current status              */
 /*                                                                    */
@@ -81,6 +117,7 @@ decContext * decContextDefault(decContext *context, Int kind) {
   #if DECSUBSET
   context->extended=0;                       // cleared
   #endif
+  context->allocator=NULL;                   // thread default
   switch (kind) {
     case DEC_INIT_BASE:
       // [use defaults]
@@ -126,6 +163,45 @@ decContext * decContextDefault(decContext *context, Int kind) {
 
   return context;} // decContextDefault
 
+/* ------------------------------------------------------------------ */
+/* decContextFreeWorkspace -- free the thread scratch workspace       */
+/*                                                                    */
+/* The storage of the workspace of the current thread is freed and    */
+/* its high-water mark is reset; it will be regrown as needed.  This  */
+/* should be called before a thread which used decNumber ends, and    */
+/* must not be called while an operation on the thread is in          */
+/* progress (though it may be, to recover the workspace, after a      */
+/* trap handler has left an operation by longjmp).  No error is       */
+/* possible.                                                          */
+/* ------------------------------------------------------------------ */
+void decContextFreeWorkspace(void) {
+  decWork *work=&decWorkspace;
+  free(work->base);                          // [may be NULL]
+  work->base=NULL;
+  work->used=0;
+  work->heap=0;
+  work->peak=0;
+  work->live=0;
+  work->stats.size=0;
+  work->stats.highWater=0;
+  } // decContextFreeWorkspace
+
+/* ------------------------------------------------------------------ */
+/* decContextGetAllocator -- return the allocator in effect           */
+/*                                                                    */
+/*  context is the context structure to be queried                    */
+/*  returns the allocator which decNumber operations using context    */
+/*    will use for working storage: that of the context if set,       */
+/*    otherwise the default for the current thread; NULL means        */
+/*    that the thread scratch workspace (or malloc) is used           */
+/*                                                                    */
+/* No error is possible.                                              */
+/* ------------------------------------------------------------------ */
+const decAllocator *decContextGetAllocator(const decContext *context) {
+  if (context->allocator!=NULL) return context->allocator;
+  return decThreadAllocator;
+  } // decContextGetAllocator
+
 /* ------------------------------------------------------------------ */
 /* decContextGetRounding -- return current rounding mode              */
 /*                                                                    */
@@ -150,6 +226,21 @@ uInt decContextGetStatus(decContext *context) {
   return context->status;
   } // decContextGetStatus
 
+/* ------------------------------------------------------------------ */
+/* decContextGetWorkspaceStats -- return scratch workspace usage      */
+/*                                                                    */
+/*  stats is the structure to be filled in with the size, limit,      */
+/*    high-water mark, and counters of the workspace of the current   */
+/*    thread                                                          */
+/*  returns stats                                                     */
+/*                                                                    */
+/* No error is possible.                                              */
+/* ------------------------------------------------------------------ */
+decWorkspaceStats *decContextGetWorkspaceStats(decWorkspaceStats *stats) {
+  *stats=decWorkspace.stats;
+  return stats;
+  } // decContextGetWorkspaceStats
+
 /* ------------------------------------------------------------------ */
 /* decContextRestoreStatus -- restore bits in current status          */
 /*                                                                    */
@@ -183,6 +274,26 @@ uInt decContextSaveStatus(decContext *context, uInt mask) {
   return context->status&mask;
   } // decContextSaveStatus
 
+/* ------------------------------------------------------------------ */
+/* decContextSetAllocator -- set the allocator for working storage    */
+/*                                                                    */
+/*  context is the context structure to be updated                    */
+/*  allocator is the allocator which decNumber operations using       */
+/*    context will use when their working storage does not fit in     */
+/*    their local buffers, or NULL to use the thread default          */
+/*  returns context                                                   */
+/*                                                                    */
+/* The allocator is not copied, so must outlive any use of context.   */
+/* Storage is always released, by the operation which allocated it,   */
+/* before that operation returns, so a scratch arena may be reset     */
+/* between operations.  No error is possible.                         */
+/* ------------------------------------------------------------------ */
+decContext *decContextSetAllocator(decContext *context,
+                                   const decAllocator *allocator) {
+  context->allocator=allocator;
+  return context;
+  } // decContextSetAllocator
+
 /* ------------------------------------------------------------------ */
 /* decContextSetRounding -- set current rounding mode                 */
 /*                                                                    */
@@ -328,6 +439,48 @@ decContext * decContextSetStatusQuiet(decContext *context, uInt status) {
   context->status|=status;
   return context;} // decContextSetStatusQuiet
 
+/* ------------------------------------------------------------------ */
+/* decContextSetThreadAllocator -- set the thread default allocator   */
+/*                                                                    */
+/*  allocator is the allocator which decNumber operations on the      */
+/*    current thread will use for working storage when their context  */
+/*    does not name one, or NULL to use the thread scratch workspace  */
+/*  returns the previous thread default                               */
+/*                                                                    */
+/* The default is per thread when the compiler supports thread-local  */
+/* storage (see DECTLS in decNumberLocal.h), and otherwise is shared. */
+/* It must not be changed while an operation on the thread is in      */
+/* progress.  No error is possible.                                   */
+/* ------------------------------------------------------------------ */
+const decAllocator *decContextSetThreadAllocator(
+                                   const decAllocator *allocator) {
+  const decAllocator *previous=decThreadAllocator;
+  decThreadAllocator=allocator;
+  return previous;
+  } // decContextSetThreadAllocator
+
+/* ------------------------------------------------------------------ */
+/* decContextSetWorkspaceLimit -- bound the thread scratch workspace  */
+/*                                                                    */
+/*  limit is the most bytes the workspace of the current thread may   */
+/*    hold; 0 means that working storage always comes from malloc     */
+/*  returns the previous limit                                        */
+/*                                                                    */
+/* The limit starts as DECWORKSPACE (see decNumberLocal.h), which is */
+/* 0 unless set when decNumber is built.  If the workspace holds more */
+/* than the new limit it is shrunk at once, or when the operation in  */
+/* progress (if any) completes, so lowering the limit is also the way */
+/* to hand storage back.  A thread which sets a limit should call     */
+/* decContextFreeWorkspace before it ends.  No error is possible.     */
+/* ------------------------------------------------------------------ */
+size_t decContextSetWorkspaceLimit(size_t limit) {
+  decWork *work=&decWorkspace;
+  size_t previous=work->stats.limit;
+  work->stats.limit=limit;
+  if (work->live==0) decWorkResize(work, 0);
+  return previous;
+  } // decContextSetWorkspaceLimit
+
 /* ------------------------------------------------------------------ */
 /* decContextStatusToString -- convert status flags to a string       */
 /*                                                                    */
@@ -435,3 +588,102 @@ decContext *decContextZeroStatus(decContext *context) {
   return context;
   } // decContextZeroStatus
 
+/* ------------------------------------------------------------------ */
+/* decWorkAlloc -- allocate working storage from the workspace        */
+/*                                                                    */
+/*   n is the number of bytes to allocate                             */
+/*   returns the storage, or NULL if none is available                */
+/*                                                                    */
+/* This is used by decNumber operations when no allocator is set; the */
+/* storage must be released with decWorkRelease on the same thread.   */
+/* ------------------------------------------------------------------ */
+void *decWorkAlloc(size_t n) {
+  decWork *work=&decWorkspace;     // this thread's workspace
+  size_t size=DECWORKHEAD+ROUNDUP(n, DECWORKALIGN); // block bytes
+  decWorkBlock *block;             // -> new block
+
+  if (size<=work->stats.size-work->used) {   // fits; push
+    block=(decWorkBlock *)(work->base+work->used);
+    block->prev=work->top;
+    block->released=0;
+    work->top=work->used;
+    work->used+=size;
+    work->stats.hits++;
+    }
+   else {                                    // too big; use malloc
+    block=(decWorkBlock *)malloc(size);
+    if (block==NULL) return NULL;
+    block->prev=size;
+    work->heap+=size;
+    work->stats.misses++;
+    }
+  work->live++;
+  if (work->used+work->heap>work->peak) {
+    work->peak=work->used+work->heap;
+    if (work->peak>work->stats.highWater) work->stats.highWater=work->peak;
+    }
+  return (uByte *)block+DECWORKHEAD;
+  } // decWorkAlloc
+
+/* ------------------------------------------------------------------ */
+/* decWorkRelease -- release storage from decWorkAlloc                */
+/*                                                                    */
+/*   alloc is the storage to release                                  */
+/*                                                                    */
+/* When nothing is still allocated, the workspace is regrown (or      */
+/* shrunk) for the next operation.                                    */
+/* ------------------------------------------------------------------ */
+void decWorkRelease(void *alloc) {
+  decWork *work=&decWorkspace;     // this thread's workspace
+  decWorkBlock *block=(decWorkBlock *)((uByte *)alloc-DECWORKHEAD);
+
+  if (work->stats.size!=0 && (uByte *)block>=work->base
+   && (uByte *)block<work->base+work->stats.size) {
+    block->released=1;
+    // pop any released blocks from the top
+    while (work->used>0) {
+      block=(decWorkBlock *)(work->base+work->top);
+      if (!block->released) break;
+      work->used=work->top;
+      work->top=block->prev;
+      }
+    }
+   else {                                    // from malloc
+    work->heap-=block->prev;
+    free(block);
+    }
+  work->live--;
+  if (work->live>0) return;        // operation still in progress
+  decWorkResize(work, work->peak);
+  work->peak=0;
+  } // decWorkRelease
+
+/* ------------------------------------------------------------------ */
+/* decWorkResize -- resize an idle workspace                          */
+/*                                                                    */
+/*   work is the workspace, which must have nothing allocated         */
+/*   need is the bytes the last operation asked for                   */
+/*                                                                    */
+/* The workspace is at least doubled if need did not fit, and is then */
+/* cut to the limit.  If the new storage cannot be allocated the      */
+/* workspace is left empty, and will be tried again later.            */
+/* ------------------------------------------------------------------ */
+static void decWorkResize(decWork *work, size_t need) {
+  size_t size=work->stats.size;    // new size
+
+  if (need>size) {
+    size*=2;
+    if (need>size) size=need;
+    }
+  if (size>work->stats.limit) size=work->stats.limit;
+  if (size==work->stats.size) return;        // no change
+  free(work->base);                          // [may be NULL]
+  work->base=NULL;
+  work->stats.size=0;
+  if (size==0) return;
+  work->base=(uByte *)malloc(size);
+  if (work->base==NULL) return;              // no storage; leave empty
+  work->stats.size=size;
+  work->stats.grows++;
+  } // decWorkResize
+
@@ -71,6 +71,32 @@
     };
   #define DEC_ROUND_DEFAULT DEC_ROUND_HALF_EVEN;
 
+  /* Allocator for working storage, used when an operation needs more */
+  /* than its on-stack buffers (see decContextSetAllocator).  alloc   */
+  /* is given opaque and a length in bytes and returns the storage,   */
+  /* or NULL if none is available; release is given opaque and        */
+  /* storage returned by alloc, and is never given NULL.              */
+  typedef struct {
+    void *(*alloc)(void *, size_t);    /* allocate storage            */
+    void  (*release)(void *, void *);  /* release storage             */
+    void  *opaque;                     /* passed to both              */
+    } decAllocator;
+
+  /* Usage of the scratch workspace of the current thread, which      */
+  /* serves working storage when no allocator is set                  */
+  typedef struct {
+    size_t   size;                 /* bytes held                      */
+    size_t   limit;                /* most bytes it may hold          */
+    size_t   highWater;            /* most bytes needed at once       */
+    uint64_t hits;                 /* allocations it served           */
+    uint64_t misses;               /* allocations passed to malloc    */
+    uint64_t grows;                /* times it was (re)allocated      */
+    } decWorkspaceStats;
+
+  /* A decContext should be set up by decContextDefault (or copied    */
+  /* from one which was); one whose members are set individually must */
+  /* also set allocator, to NULL for the default working storage, as  */
+  /* an indeterminate allocator pointer would be used as an allocator */
   typedef struct {
     int32_t  digits;               /* working precision               */
     int32_t  emax;                 /* maximum positive exponent       */
@@ -82,6 +108,7 @@
     #if DECSUBSET
     uint8_t  extended;             /* flag: special-values allowed    */
     #endif
+    const decAllocator *allocator; /* working storage [NULL=default]  */
     } decContext;
 
   /* Maxima and Minima for context settings                           */
@@ -236,15 +263,21 @@
   /* decContext routines                                              */
   extern decContext  * decContextClearStatus(decContext *, uint32_t);
   extern decContext  * decContextDefault(decContext *, int32_t);
+  extern void          decContextFreeWorkspace(void);
+  extern const decAllocator * decContextGetAllocator(const decContext *);
   extern enum rounding decContextGetRounding(decContext *);
   extern uint32_t      decContextGetStatus(decContext *);
+  extern decWorkspaceStats * decContextGetWorkspaceStats(decWorkspaceStats *);
   extern decContext  * decContextRestoreStatus(decContext *, uint32_t, uint32_t);
   extern uint32_t      decContextSaveStatus(decContext *, uint32_t);
+  extern decContext  * decContextSetAllocator(decContext *, const decAllocator *);
   extern decContext  * decContextSetRounding(decContext *, enum rounding);
   extern decContext  * decContextSetStatus(decContext *, uint32_t);
   extern decContext  * decContextSetStatusFromString(decContext *, const char *);
   extern decContext  * decContextSetStatusFromStringQuiet(decContext *, const char *);
   extern decContext  * decContextSetStatusQuiet(decContext *, uint32_t);
+  extern const decAllocator * decContextSetThreadAllocator(const decAllocator *);
+  extern size_t        decContextSetWorkspaceLimit(size_t);
   extern const char  * decContextStatusToString(const decContext *);
   extern int32_t       decContextTestEndian(uint8_t);
   extern uint32_t      decContextTestSavedStatus(uint32_t, uint32_t);
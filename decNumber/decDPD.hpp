@@ -0,0 +1,333 @@
+/* ------------------------------------------------------------------ */
+/* decDPD.hpp -- compile-time DPD tables and decimal encoders         */
+/* ------------------------------------------------------------------ */
+/* The BIN2DPD, DPD2BIN, DPD2BCD8, and BIN2CHAR tables of decDPD.h,   */
+/* generated as constexpr arrays in namespace dec::dpd (from the      */
+/* declet encoding and decoding rules, rather than held as data), and */
+/* constexpr encoders which give the decimal64 or decimal128 of a     */
+/* literal decimal constant, so that constants need no conversion at  */
+/* run time:                                                          */
+/*                                                                    */
+/*   using namespace dec::literals;                                   */
+/*   constexpr decimal64  tenth=0.1_d64;                              */
+/*   constexpr decimal128 big="-9.99E+6144"_d128;                     */
+/*                                                                    */
+/* A constant is encoded exactly, or not at all: one with more digits */
+/* than the format, or which would be rounded, subnormal, or out of   */
+/* range, throws std::invalid_argument, which is a compile-time error */
+/* when the constant is constexpr.  The string forms also take a      */
+/* sign, Inf, Infinity, NaN, and sNaN (without payloads).             */
+/*                                                                    */
+/* The encodings are in the byte order of the C modules (DECLITEND,   */
+/* as in decNumberLocal.h).  This header needs C++17; the C modules   */
+/* still use decDPD.h.                                                */
+/* ------------------------------------------------------------------ */
+
+#if !defined(DECDPDHPP)
+  #define DECDPDHPP
+
+  #include <stddef.h>
+  #include <stdint.h>
+  #include <array>
+  #include <stdexcept>
+
+  extern "C" {                  // decimal128 first, for DECNUMDIGITS
+  #include "decimal128.h"
+  #include "decimal64.h"
+  }
+
+  #if !defined(DECLITEND)
+  #define DECLITEND 1           /* 1=little-endian, 0=big-endian      */
+  #endif
+
+  namespace dec {
+  namespace dpd {
+
+  /* ---------------------------------------------------------------- */
+  /* Declets                                                          */
+  /* ---------------------------------------------------------------- */
+  // The declet of bin (0-999), from its three digits abcd efgh ijkm
+  // (a, e, and i are the high bits), by the indicators a, e, and i
+  constexpr uint16_t encode(uint32_t bin) {
+    uint32_t d1=bin/100, d2=bin/10%10, d3=bin%10;
+    uint32_t low=((d1&7)<<7)|((d2&7)<<4)|(d3&7);  // bcd fgh 0 jkm
+    switch (((d1>>3)<<2)|((d2>>3)<<1)|(d3>>3)) {
+      case 0: return (uint16_t)low;                   // bcd fgh 0 jkm
+      case 1: return (uint16_t)((low&0x3f0)|0x08|(d3&1));   // 100m
+      case 2: return (uint16_t)((low&0x380)|((d3&6)<<4)
+                     |((d2&1)<<4)|0x0a|(d3&1));   // bcd jkh 1 01m
+      case 4: return (uint16_t)(((d3&6)<<7)|((d1&1)<<7)
+                     |(low&0x070)|0x0c|(d3&1));   // jkd fgh 1 10m
+      case 3: return (uint16_t)((low&0x380)|0x40
+                     |((d2&1)<<4)|0x0e|(d3&1));   // bcd 10h 1 11m
+      case 5: return (uint16_t)(((d2&6)<<7)|((d1&1)<<7)|0x20
+                     |((d2&1)<<4)|0x0e|(d3&1));   // fgd 01h 1 11m
+      case 6: return (uint16_t)(((d3&6)<<7)|((d1&1)<<7)
+                     |((d2&1)<<4)|0x0e|(d3&1));   // jkd 00h 1 11m
+      default: return (uint16_t)(((d1&1)<<7)|0x60
+                     |((d2&1)<<4)|0x0e|(d3&1));   // 00d 11h 1 11m
+      }
+    } // encode
+
+  // The value (0-999) of any declet (0-1023), including the 24
+  // non-canonical ones, whose p and q bits are ignored
+  constexpr uint16_t decode(uint32_t dpd) {
+    uint32_t pqr=(dpd>>7)&7, stu=(dpd>>4)&7, wxy=dpd&7;
+    uint32_t r=pqr&1, u=stu&1, y=wxy&1;
+    uint32_t pq=pqr>>1, st=stu>>1;
+    uint32_t d1=pqr, d2=stu, d3=wxy;
+    if (dpd&0x08) switch (wxy>>1) {           // v=1: some large digit
+      case 0: d3=8+y; break;
+      case 1: d2=8+u; d3=(st<<1)|y; break;
+      case 2: d1=8+r; d3=(pq<<1)|y; break;
+      default: switch (st) {
+        case 0: d1=8+r; d2=8+u; d3=(pq<<1)|y; break;
+        case 1: d1=8+r; d2=(pq<<1)|u; d3=8+y; break;
+        case 2: d2=8+u; d3=8+y; break;
+        default: d1=8+r; d2=8+u; d3=8+y; break;
+        }
+      }
+    return (uint16_t)(d1*100+d2*10+d3);
+    } // decode
+
+  // The significant digits of bin (0-999); 0 has none
+  constexpr uint8_t length(uint32_t bin) {
+    return (uint8_t)(bin>=100 ? 3 : bin>=10 ? 2 : bin>=1 ? 1 : 0);
+    } // length
+
+  /* ---------------------------------------------------------------- */
+  /* Tables, as in decDPD.h                                           */
+  /* ---------------------------------------------------------------- */
+  template<class T, size_t N, class F>
+  constexpr std::array<T, N> table(F entry) {
+    std::array<T, N> t{};
+    for (size_t i=0; i<N; i++) t[i]=entry(i);
+    return t;
+    } // table
+
+  // BIN2DPD[bin] is the declet of bin
+  inline constexpr std::array<uint16_t, 1000> BIN2DPD=
+    table<uint16_t, 1000>([](size_t i) {return encode((uint32_t)i);});
+
+  // DPD2BIN[dpd] is the value of the declet dpd
+  inline constexpr std::array<uint16_t, 1024> DPD2BIN=
+    table<uint16_t, 1024>([](size_t i) {return decode((uint32_t)i);});
+
+  // DPD2BCD8[dpd*4] is the three digits of dpd (as bytes 0-9) then
+  // the count of its significant digits
+  inline constexpr std::array<uint8_t, 4096> DPD2BCD8=
+    table<uint8_t, 4096>([](size_t i) {
+      uint32_t bin=decode((uint32_t)(i/4));
+      switch (i%4) {
+        case 0: return (uint8_t)(bin/100);
+        case 1: return (uint8_t)(bin/10%10);
+        case 2: return (uint8_t)(bin%10);
+        default: return length(bin);
+        }
+      });
+
+  // BIN2CHAR[bin*4] is the count of significant digits of bin then
+  // its three digits as characters; BIN2CHAR[4000] is 0
+  inline constexpr std::array<uint8_t, 4001> BIN2CHAR=
+    table<uint8_t, 4001>([](size_t i) {
+      uint32_t bin=(uint32_t)(i/4);
+      if (i==4000) return (uint8_t)0;
+      switch (i%4) {
+        case 0: return length(bin);
+        case 1: return (uint8_t)('0'+bin/100);
+        case 2: return (uint8_t)('0'+bin/10%10);
+        default: return (uint8_t)('0'+bin%10);
+        }
+      });
+
+  /* ---------------------------------------------------------------- */
+  /* Encoders                                                         */
+  /* ---------------------------------------------------------------- */
+  // The parameters of an interchange format, and its encoding
+  template<int Bits> struct Format;
+  template<> struct Format<64> {
+    typedef decimal64 Encoding;
+    static constexpr int bytes=DECIMAL64_Bytes;
+    static constexpr int pmax=DECIMAL64_Pmax;
+    static constexpr int econ=DECIMAL64_EconL;
+    static constexpr int bias=DECIMAL64_Bias;
+    static constexpr int emin=DECIMAL64_Emin;
+    static constexpr int emax=DECIMAL64_Emax;
+    };
+  template<> struct Format<128> {
+    typedef decimal128 Encoding;
+    static constexpr int bytes=DECIMAL128_Bytes;
+    static constexpr int pmax=DECIMAL128_Pmax;
+    static constexpr int econ=DECIMAL128_EconL;
+    static constexpr int bias=DECIMAL128_Bias;
+    static constexpr int emin=DECIMAL128_Emin;
+    static constexpr int emax=DECIMAL128_Emax;
+    };
+
+  // A literal, parsed; digits holds the coefficient, most significant
+  // first, with no leading zeros
+  enum class Kind {finite, infinite, qNaN, sNaN};
+  template<int Pmax> struct Parsed {
+    bool    negative=false;
+    Kind    kind=Kind::finite;
+    int     count=0;                // digits in use
+    uint8_t digits[Pmax]={};
+    int32_t exponent=0;
+    };
+
+  constexpr bool same(const char *s, size_t n, const char *word) {
+    size_t i=0;
+    for (; i<n && word[i]!='\0'; i++) {
+      char c=s[i];
+      if (c>='A' && c<='Z') c=(char)(c-'A'+'a');
+      if (c!=word[i]) return false;
+      }
+    return i==n && word[i]=='\0';
+    } // same
+
+  // Parse the n characters at s, which are a decNumber string with no
+  // more than Pmax significant digits (apostrophes, the C++ digit
+  // separator, are ignored)
+  template<int Pmax>
+  constexpr Parsed<Pmax> parse(const char *s, size_t n) {
+    Parsed<Pmax> p;
+    size_t i=0;
+    bool any=false, point=false;
+    int32_t scale=0;                  // digits after the point
+    if (i<n && (s[i]=='-' || s[i]=='+')) p.negative=(s[i++]=='-');
+    if (same(s+i, n-i, "inf") || same(s+i, n-i, "infinity")) {
+      p.kind=Kind::infinite;
+      return p;
+      }
+    if (same(s+i, n-i, "nan")) {
+      p.kind=Kind::qNaN;
+      return p;
+      }
+    if (same(s+i, n-i, "snan")) {
+      p.kind=Kind::sNaN;
+      return p;
+      }
+    for (; i<n; i++) {
+      char c=s[i];
+      if (c=='\'') continue;
+      if (c=='.' && !point) {
+        point=true;
+        continue;
+        }
+      if (c<'0' || c>'9') break;
+      any=true;
+      if (point) scale++;
+      if (c=='0' && p.count==0) continue;   // leading zero
+      if (p.count==Pmax)
+        throw std::invalid_argument("too many digits in constant");
+      p.digits[p.count++]=(uint8_t)(c-'0');
+      }
+    if (!any) throw std::invalid_argument("no digits in constant");
+    if (i<n && (s[i]=='e' || s[i]=='E')) {
+      bool minus=false, edigits=false;
+      int32_t e=0;
+      i++;
+      if (i<n && (s[i]=='-' || s[i]=='+')) minus=(s[i++]=='-');
+      for (; i<n && s[i]>='0' && s[i]<='9'; i++) {
+        edigits=true;
+        if (e<100000000) e=e*10+(s[i]-'0');
+        }
+      if (!edigits)
+        throw std::invalid_argument("no exponent digits in constant");
+      p.exponent=minus ? -e : e;
+      }
+    if (i!=n) throw std::invalid_argument("constant is invalid");
+    p.exponent-=scale;
+    return p;
+    } // parse
+
+  // Big-endian bit packing, into the bytes of an encoding
+  template<int Bytes> struct Bits {
+    uint8_t bytes[Bytes]={};
+    int     used=0;
+    constexpr void put(uint32_t value, int count) {
+      for (int b=count-1; b>=0; b--, used++) {
+        if ((value>>b)&1) bytes[used/8]|=(uint8_t)(0x80>>(used%8));
+        }
+      }
+    }; // Bits
+
+  // The encoding of the n characters at s, which must be exact
+  template<int B> constexpr typename Format<B>::Encoding
+  encode(const char *s, size_t n) {
+    typedef Format<B> F;
+    Parsed<F::pmax> p=parse<F::pmax>(s, n);
+    uint8_t coeff[F::pmax]={};        // right-aligned coefficient
+    Bits<F::bytes> bits;
+    typename F::Encoding result{};
+    int32_t qmin=-F::bias;            // exponent range
+    int32_t qmax=F::emax-F::pmax+1;
+    uint32_t biased=0, msd=0;
+    int i=0;
+
+    bits.put(p.negative ? 1 : 0, 1);
+    if (p.kind==Kind::finite) {
+      // a large exponent may be reduced by padding the coefficient,
+      // which is what decNumber does (setting Clamped)
+      if (p.count==0) p.count=1;      // zero [digits are all 0]
+      while (p.exponent>qmax && p.count<F::pmax && p.digits[0]!=0) {
+        p.digits[p.count++]=0;
+        p.exponent--;
+        }
+      if (p.exponent>qmax)
+        throw std::invalid_argument("constant is out of range");
+      if (p.exponent<qmin || (p.digits[0]!=0
+          && p.exponent+p.count-1<F::emin))
+        throw std::invalid_argument("constant is subnormal");
+      for (i=0; i<p.count; i++) coeff[F::pmax-p.count+i]=p.digits[i];
+      biased=(uint32_t)(p.exponent+F::bias);
+      msd=coeff[0];
+      if (msd<8) bits.put(((biased>>F::econ)<<3)|msd, 5);
+       else bits.put(0x18|((biased>>F::econ)<<1)|(msd&1), 5);
+      bits.put(biased&((1u<<F::econ)-1), F::econ);
+      for (i=1; i<F::pmax; i+=3) {
+        bits.put(BIN2DPD[coeff[i]*100+coeff[i+1]*10+coeff[i+2]], 10);
+        }
+      }
+     else if (p.kind==Kind::infinite) bits.put(0x1e, 5);
+     else {
+      bits.put(0x1f, 5);
+      bits.put(p.kind==Kind::sNaN ? 1 : 0, 1);
+      }
+
+    for (i=0; i<F::bytes; i++) {
+      result.bytes[i]=bits.bytes[DECLITEND ? F::bytes-1-i : i];
+      }
+    return result;
+    } // encode
+
+  } // namespace dpd
+
+  /* ---------------------------------------------------------------- */
+  /* Literals -- 1.25_d64, "-Inf"_d128                                */
+  /* ---------------------------------------------------------------- */
+  namespace literals {
+
+  constexpr size_t length(const char *s) {
+    size_t n=0;
+    while (s[n]!='\0') n++;
+    return n;
+    } // length
+
+  constexpr decimal64 operator""_d64(const char *s) {
+    return dpd::encode<64>(s, length(s));
+    }
+  constexpr decimal64 operator""_d64(const char *s, size_t n) {
+    return dpd::encode<64>(s, n);
+    }
+  constexpr decimal128 operator""_d128(const char *s) {
+    return dpd::encode<128>(s, length(s));
+    }
+  constexpr decimal128 operator""_d128(const char *s, size_t n) {
+    return dpd::encode<128>(s, n);
+    }
+
+  } // namespace literals
+  } // namespace dec
+
+#endif
@@ -0,0 +1,105 @@
+/* ------------------------------------------------------------------ */
+/* decDouble.c -- decDouble operations module                         */
+/* ------------------------------------------------------------------ */
+/* This module comprises decDouble operations (including conversions) */
+/* ------------------------------------------------------------------ */
+
+#include "decContext.h"       // public includes
+#define  DECNUMDIGITS 16      // make decNumbers with space for 16
+#include "decNumber.h"        // base number library (for proxies)
+#include "decimal64.h"        // .. and its format (for proxies)
+#include "decDouble.h"        // ..
+
+/* Constant mappings for shared code */
+#define DECPMAX     DECDOUBLE_Pmax
+#define DECEMIN     DECDOUBLE_Emin
+#define DECEMAX     DECDOUBLE_Emax
+#define DECEMAXD    DECDOUBLE_EmaxD
+#define DECBYTES    DECDOUBLE_Bytes
+#define DECSTRING   DECDOUBLE_String
+#define DECECONL    DECDOUBLE_EconL
+#define DECBIAS     DECDOUBLE_Bias
+#define DECLETS     DECDOUBLE_Declets
+// parameters of next-wider format
+#define DECWBYTES   DECQUAD_Bytes
+#define DECWECONL   DECQUAD_EconL
+
+/* Type and function mappings for shared code */
+#define decFloat                   decDouble      // Type name
+#define DECREG                     uDFLong        // Coefficient register
+
+// Utilities and conversions (binary results, extractors, etc.)
+#define decFloatFromInt32          decDoubleFromInt32
+#define decFloatFromNumber         decDoubleFromNumber
+#define decFloatFromString         decDoubleFromString
+#define decFloatFromUInt32         decDoubleFromUInt32
+#define decFloatToEngString        decDoubleToEngString
+#define decFloatToNumber           decDoubleToNumber
+#define decFloatToString           decDoubleToString
+#define decFloatZero               decDoubleZero
+
+// Computational (result is a decFloat)
+#define decFloatAbs                decDoubleAbs
+#define decFloatAdd                decDoubleAdd
+#define decFloatAnd                decDoubleAnd
+#define decFloatDivide             decDoubleDivide
+#define decFloatDivideInteger      decDoubleDivideInteger
+#define decFloatFMA                decDoubleFMA
+#define decFloatInvert             decDoubleInvert
+#define decFloatLogB               decDoubleLogB
+#define decFloatMax                decDoubleMax
+#define decFloatMaxMag             decDoubleMaxMag
+#define decFloatMin                decDoubleMin
+#define decFloatMinMag             decDoubleMinMag
+#define decFloatMinus              decDoubleMinus
+#define decFloatMultiply           decDoubleMultiply
+#define decFloatNextMinus          decDoubleNextMinus
+#define decFloatNextPlus           decDoubleNextPlus
+#define decFloatNextToward         decDoubleNextToward
+#define decFloatOr                 decDoubleOr
+#define decFloatPlus               decDoublePlus
+#define decFloatQuantize           decDoubleQuantize
+#define decFloatReduce             decDoubleReduce
+#define decFloatRemainder          decDoubleRemainder
+#define decFloatRemainderNear      decDoubleRemainderNear
+#define decFloatRotate             decDoubleRotate
+#define decFloatScaleB             decDoubleScaleB
+#define decFloatShift              decDoubleShift
+#define decFloatSubtract           decDoubleSubtract
+#define decFloatToIntegralValue    decDoubleToIntegralValue
+#define decFloatToIntegralExact    decDoubleToIntegralExact
+#define decFloatXor                decDoubleXor
+
+// Comparisons
+#define decFloatCompare            decDoubleCompare
+#define decFloatCompareSignal      decDoubleCompareSignal
+#define decFloatCompareTotal       decDoubleCompareTotal
+#define decFloatCompareTotalMag    decDoubleCompareTotalMag
+
+// Copies
+#define decFloatCanonical          decDoubleCanonical
+#define decFloatCopy               decDoubleCopy
+#define decFloatCopyAbs            decDoubleCopyAbs
+#define decFloatCopyNegate         decDoubleCopyNegate
+#define decFloatCopySign           decDoubleCopySign
+
+// Non-computational
+#define decFloatClass              decDoubleClass
+#define decFloatClassString        decDoubleClassString
+#define decFloatDigits             decDoubleDigits
+#define decFloatIsCanonical        decDoubleIsCanonical
+#define decFloatIsFinite           decDoubleIsFinite
+#define decFloatIsInfinite         decDoubleIsInfinite
+#define decFloatIsInteger          decDoubleIsInteger
+#define decFloatIsNaN              decDoubleIsNaN
+#define decFloatIsNormal           decDoubleIsNormal
+#define decFloatIsSignaling        decDoubleIsSignaling
+#define decFloatIsSigned           decDoubleIsSigned
+#define decFloatIsSubnormal        decDoubleIsSubnormal
+#define decFloatIsZero             decDoubleIsZero
+#define decFloatRadix              decDoubleRadix
+#define decFloatSameQuantum        decDoubleSameQuantum
+#define decFloatVersion            decDoubleVersion
+
+#include "decCommon.c"                  // non-arithmetic decFloat routines
+#include "decBasic.c"                   // basic formats routines
@@ -215,15 +215,110 @@ static Unit uarrone[1]={1};   // Unit array of 1, used for incrementing
   #endif
   #define eInt  Long          // extended integer
   #define ueInt uLong         // unsigned extended integer
+  // Constant multipliers and shifts for divide-by-power-of-ten using
+  // reciprocal multiply; ceil(2**s/10**n), with s=30+ceil(log2 10**n),
+  // gives the exact quotient for any u<2**30, and so for any Unit
+  static const uLong quotmults[]={1073741824, 1717986919, 1374389535,
+    1099511628, 1759218605, 1407374884, 1125899907, 1801439851,
+    1441151881, 1152921505};
+  static const uByte quotshifts[]={30, 34, 37, 40, 44, 47, 50, 54, 57,
+    60};
+  // QUOT10 -- macro to return the quotient of unit u divided by 10**n
+  #define QUOT10(u, n) ((uInt)(((uLong)(u)*quotmults[n])>>quotshifts[n]))
+#endif
+
+/* The vector kernel for decUnitAddSub works in Int lanes, so it is   */
+/* only used when a Unit product fits in an Int                       */
+#define SIMDADD (DECSIMD && DECDPUN<=4)
+#if SIMDADD
+  #define SIMDMIN   32        // shortest run (Units) for vector kernel
+  #define SIMDBLOCK 64        // Units per kernel block
 #endif
 
+/* decAddOp has an optional uLLong fastpath (see decAddOp)            */
+#if !defined(DECFASTADD)
+  #define DECFASTADD 0
+#endif
+#define FASTADD (DECUSE128 && DECFASTADD)
+
+/* decNumberFromString has a fastpath for plain numbers which works   */
+/* on eight characters at a time in a uLong; it needs three-digit     */
+/* Units, a little-endian platform, and GCC builtins                  */
+#if DECDPUN==3 && DECUSE64 && DECLITEND && defined(__GNUC__)
+  #define FASTSTR 1
+#else
+  #define FASTSTR 0
+#endif
+
+/* decToString lays out digits three at a time from this table of the */
+/* ASCII forms of 0 through 999 (as BIN2CHAR in decDPD.h, which is    */
+/* not included here), both for Units when DECDPUN=3 and for the      */
+/* exponent                                                           */
+static const char bin2ascii[3001]=
+  "000001002003004005006007008009010011012013014015016017018019"
+  "020021022023024025026027028029030031032033034035036037038039"
+  "040041042043044045046047048049050051052053054055056057058059"
+  "060061062063064065066067068069070071072073074075076077078079"
+  "080081082083084085086087088089090091092093094095096097098099"
+  "100101102103104105106107108109110111112113114115116117118119"
+  "120121122123124125126127128129130131132133134135136137138139"
+  "140141142143144145146147148149150151152153154155156157158159"
+  "160161162163164165166167168169170171172173174175176177178179"
+  "180181182183184185186187188189190191192193194195196197198199"
+  "200201202203204205206207208209210211212213214215216217218219"
+  "220221222223224225226227228229230231232233234235236237238239"
+  "240241242243244245246247248249250251252253254255256257258259"
+  "260261262263264265266267268269270271272273274275276277278279"
+  "280281282283284285286287288289290291292293294295296297298299"
+  "300301302303304305306307308309310311312313314315316317318319"
+  "320321322323324325326327328329330331332333334335336337338339"
+  "340341342343344345346347348349350351352353354355356357358359"
+  "360361362363364365366367368369370371372373374375376377378379"
+  "380381382383384385386387388389390391392393394395396397398399"
+  "400401402403404405406407408409410411412413414415416417418419"
+  "420421422423424425426427428429430431432433434435436437438439"
+  "440441442443444445446447448449450451452453454455456457458459"
+  "460461462463464465466467468469470471472473474475476477478479"
+  "480481482483484485486487488489490491492493494495496497498499"
+  "500501502503504505506507508509510511512513514515516517518519"
+  "520521522523524525526527528529530531532533534535536537538539"
+  "540541542543544545546547548549550551552553554555556557558559"
+  "560561562563564565566567568569570571572573574575576577578579"
+  "580581582583584585586587588589590591592593594595596597598599"
+  "600601602603604605606607608609610611612613614615616617618619"
+  "620621622623624625626627628629630631632633634635636637638639"
+  "640641642643644645646647648649650651652653654655656657658659"
+  "660661662663664665666667668669670671672673674675676677678679"
+  "680681682683684685686687688689690691692693694695696697698699"
+  "700701702703704705706707708709710711712713714715716717718719"
+  "720721722723724725726727728729730731732733734735736737738739"
+  "740741742743744745746747748749750751752753754755756757758759"
+  "760761762763764765766767768769770771772773774775776777778779"
+  "780781782783784785786787788789790791792793794795796797798799"
+  "800801802803804805806807808809810811812813814815816817818819"
+  "820821822823824825826827828829830831832833834835836837838839"
+  "840841842843844845846847848849850851852853854855856857858859"
+  "860861862863864865866867868869870871872873874875876877878879"
+  "880881882883884885886887888889890891892893894895896897898899"
+  "900901902903904905906907908909910911912913914915916917918919"
+  "920921922923924925926927928929930931932933934935936937938939"
+  "940941942943944945946947948949950951952953954955956957958959"
+  "960961962963964965966967968969970971972973974975976977978979"
+  "980981982983984985986987988989990991992993994995996997998999";
+
 /* Local routines */
 static decNumber * decAddOp(decNumber *, const decNumber *, const decNumber *,
                               decContext *, uByte, uInt *);
+static void *      decAlloc(const decContext *, size_t);
 static Flag        decBiStr(const char *, const char *, const char *);
+#if FASTSTR
+static const char *decSkipDigits(const char *);
+static Flag        decFromStringFast(decNumber *, const char *, decContext *);
+#endif
 static uInt        decCheckMath(const decNumber *, decContext *, uInt *);
 static void        decApplyRound(decNumber *, decContext *, Int, uInt *);
-static Int         decCompare(const decNumber *lhs, const decNumber *rhs, Flag);
+static Int         decCompare(const decNumber *lhs, const decNumber *rhs, Flag,
+                              const decContext *);
 static decNumber * decCompareOp(decNumber *, const decNumber *,
                               const decNumber *, decContext *,
                               Flag, uInt *);
@@ -237,6 +332,13 @@ static decNumber * decExpOp(decNumber *, const decNumber *,
 static void        decFinalize(decNumber *, decContext *, Int *, uInt *);
 static Int         decGetDigits(Unit *, Int);
 static Int         decGetInt(const decNumber *);
+#if DECUSE128
+static uLLong      decGetULLong(const decNumber *);
+#if FASTADD
+static uLLong      decPow10ULLong(Int);
+#endif
+static Int         decULLongToUnits(uLLong, Unit *);
+#endif
 static decNumber * decLnOp(decNumber *, const decNumber *,
                               decContext *, uInt *);
 static decNumber * decMultiplyOp(decNumber *, const decNumber *,
@@ -247,6 +349,7 @@ static decNumber * decNaNs(decNumber *, const decNumber *,
 static decNumber * decQuantizeOp(decNumber *, const decNumber *,
                               const decNumber *, decContext *, Flag,
                               uInt *);
+static void        decRelease(const decContext *, void *);
 static void        decReverse(Unit *, Unit *);
 static void        decSetCoeff(decNumber *, decContext *, const Unit *,
                               Int, Int *, uInt *);
@@ -257,25 +360,101 @@ static Int         decShiftToLeast(Unit *, Int, Int);
 static Int         decShiftToMost(Unit *, Int, Int);
 static void        decStatus(decNumber *, uInt, decContext *);
 static void        decToString(const decNumber *, char[], Flag);
+static char *      decExpToChars(uInt, char *);
+static char *      decUnitsToChars(const decNumber *, char *);
 static decNumber * decTrim(decNumber *, decContext *, Flag, Flag, Int *);
 static Int         decUnitAddSub(const Unit *, Int, const Unit *, Int, Int,
                               Unit *, Int);
-static Int         decUnitCompare(const Unit *, Int, const Unit *, Int, Int);
+#if SIMDADD
+static eInt        decUnitAddSubBlock(const Unit *, const Unit *, Unit *, Int,
+                              Int, eInt);
+#endif
+static Int         decUnitCompare(const Unit *, Int, const Unit *, Int, Int,
+                              const decContext *);
 
 #if !DECSUBSET
-/* decFinish == decFinalize when no subset arithmetic needed */
+/* decFinish == decFinalize when no subset arithmetic needed          */
 #define decFinish(a,b,c,d) decFinalize(a,b,c,d)
 #else
 static void        decFinish(decNumber *, decContext *, Int *, uInt *);
 static decNumber * decRoundOperand(const decNumber *, decContext *, uInt *);
 #endif
 
+/* Hashing support, also used by decimal64 and decimal128 */
+uInt decHashMulAdd(uInt, uInt, uInt);
+uInt decHashFinish(uInt, Int, uByte);
+
 /* Local macros */
 // masked special-values bits
 #define SPECIALARG  (rhs->bits & DECSPECIAL)
 #define SPECIALARGS ((lhs->bits | rhs->bits) & DECSPECIAL)
+// operands which need the special-value, zero, or subset checks of
+// an arithmetic operation, found from bits and lsu[0] with a single
+// branch: non-0 if either is special or has a 0 first Unit (as every
+// zero has), or if subset arithmetic may round them
+#if DECSUBSET
+#define ODDARGS(set) (SPECIALARGS | (*lhs->lsu==0) | (*rhs->lsu==0)    \
+                      | !(set)->extended)
+#else
+#define ODDARGS(set) (SPECIALARGS | (*lhs->lsu==0) | (*rhs->lsu==0))
+#endif
 
 /* Diagnostic macros, etc. */
+#if DECSTATS
+decStats decNumberStats;           // fastpath counters (see decNumber.h)
+#endif
+
+// Allocation counters (see decNumberAllocCounts); DECENTRY, at the
+// start of each public operator, notes the entry point being executed
+static DECTLS decAllocCounts decEntryCounts[DEC_ENTRY_COUNT];
+static DECTLS Int    decEntryNow;       // entry point being executed
+static DECTLS size_t decEntryBytes;     // bytes allocated by this call
+#define DECENTRY(e) (decEntryNow=(e), decEntryBytes=0,                  \
+                     decEntryCounts[e].calls++)
+static const char * const decEntryNames[DEC_ENTRY_COUNT]={
+  "",
+  "decNumberAbs",
+  "decNumberAdd",
+  "decNumberAnd",
+  "decNumberCompare",
+  "decNumberCompareSignal",
+  "decNumberCompareTotal",
+  "decNumberCompareTotalMag",
+  "decNumberDivide",
+  "decNumberDivideInteger",
+  "decNumberExp",
+  "decNumberFMA",
+  "decNumberFromString",
+  "decNumberInvert",
+  "decNumberLn",
+  "decNumberLogB",
+  "decNumberLog10",
+  "decNumberMax",
+  "decNumberMaxMag",
+  "decNumberMin",
+  "decNumberMinMag",
+  "decNumberMinus",
+  "decNumberMultiply",
+  "decNumberNextMinus",
+  "decNumberNextPlus",
+  "decNumberNextToward",
+  "decNumberOr",
+  "decNumberPlus",
+  "decNumberPower",
+  "decNumberQuantize",
+  "decNumberReduce",
+  "decNumberRemainder",
+  "decNumberRemainderNear",
+  "decNumberRescale",
+  "decNumberRotate",
+  "decNumberScaleB",
+  "decNumberShift",
+  "decNumberSquareRoot",
+  "decNumberSubtract",
+  "decNumberToIntegralExact",
+  "decNumberToIntegralValue",
+  "decNumberXor"};
+
 #if DECALLOC
 // Handle malloc/free accounting.  If enabled, our accountable routines
 // are used; otherwise the code just goes straight to the system malloc
@@ -494,12 +673,18 @@ decNumber * decNumberFromString(decNumber *dn, const char chars[],
   #endif
   Int   residue;                   // rounding residue
   uInt  status=0;                  // error code
+  DECENTRY(DEC_ENTRY_FROM_STRING);
 
   #if DECCHECK
   if (decCheckOperands(DECUNRESU, DECUNUSED, DECUNUSED, set))
     return decNumberZero(dn);
   #endif
 
+  #if FASTSTR
+  // plain numbers which need no rounding or checking are common
+  if (decFromStringFast(dn, chars, set)) return dn;
+  #endif
+
   do {                             // status & malloc protection
     for (c=chars;; c++) {          // -> input character
       if (*c>='0' && *c<='9') {    // test for Arabic digit
@@ -583,7 +768,7 @@ decNumber * decNumberFromString(decNumber *dn, const char chars[],
       const char *firstexp;        // -> first significant exponent digit
       status=DEC_Conversion_syntax;// assume the worst
       if (*c!='e' && *c!='E') break;
-      /* Found 'e' or 'E' -- now process explicit exponent */
+      /* Found 'e' or 'E' -- now process explicit exponent            */
       // 1998.07.11: sign no longer required
       nege=0;
       c++;                         // to (possible) sign
@@ -642,7 +827,7 @@ decNumber * decNumberFromString(decNumber *dn, const char chars[],
       Int needbytes=D2U(d)*sizeof(Unit);// bytes needed
       res=resbuff;                      // assume use local buffer
       if (needbytes>(Int)sizeof(resbuff)) { // too big for local
-        allocres=(Unit *)malloc(needbytes);
+        allocres=(Unit *)decAlloc(set, needbytes);
         if (allocres==NULL) {status|=DEC_Insufficient_storage; break;}
         res=allocres;
         }
@@ -700,7 +885,7 @@ decNumber * decNumberFromString(decNumber *dn, const char chars[],
     // decNumberShow(dn);
     } while(0);                         // [for break]
 
-  if (allocres!=NULL) free(allocres);   // drop any storage used
+  if (allocres!=NULL) decRelease(set, allocres); // drop any storage used
   if (status!=0) decStatus(dn, status, set);
   return dn;
   } /* decNumberFromString */
@@ -728,6 +913,7 @@ decNumber * decNumberAbs(decNumber *res, const decNumber *rhs,
                          decContext *set) {
   decNumber dzero;                      // for 0
   uInt status=0;                        // accumulator
+  DECENTRY(DEC_ENTRY_ABS);
 
   #if DECCHECK
   if (decCheckOperands(res, DECUNUSED, rhs, set)) return res;
@@ -759,6 +945,7 @@ decNumber * decNumberAbs(decNumber *res, const decNumber *rhs,
 decNumber * decNumberAdd(decNumber *res, const decNumber *lhs,
                          const decNumber *rhs, decContext *set) {
   uInt status=0;                        // accumulator
+  DECENTRY(DEC_ENTRY_ADD);
   decAddOp(res, lhs, rhs, set, 0, &status);
   if (status!=0) decStatus(res, status, set);
   #if DECCHECK
@@ -788,6 +975,7 @@ decNumber * decNumberAnd(decNumber *res, const decNumber *lhs,
   const Unit *msua, *msub;              // -> operand msus
   Unit *uc,  *msuc;                     // -> result and its msu
   Int   msudigs;                        // digits in res msu
+  DECENTRY(DEC_ENTRY_AND);
   #if DECCHECK
   if (decCheckOperands(res, lhs, rhs, set)) return res;
   #endif
@@ -853,6 +1041,7 @@ decNumber * decNumberAnd(decNumber *res, const decNumber *lhs,
 decNumber * decNumberCompare(decNumber *res, const decNumber *lhs,
                              const decNumber *rhs, decContext *set) {
   uInt status=0;                        // accumulator
+  DECENTRY(DEC_ENTRY_COMPARE);
   decCompareOp(res, lhs, rhs, set, COMPARE, &status);
   if (status!=0) decStatus(res, status, set);
   return res;
@@ -873,6 +1062,7 @@ decNumber * decNumberCompare(decNumber *res, const decNumber *lhs,
 decNumber * decNumberCompareSignal(decNumber *res, const decNumber *lhs,
                                    const decNumber *rhs, decContext *set) {
   uInt status=0;                        // accumulator
+  DECENTRY(DEC_ENTRY_COMPARE_SIGNAL);
   decCompareOp(res, lhs, rhs, set, COMPSIG, &status);
   if (status!=0) decStatus(res, status, set);
   return res;
@@ -894,6 +1084,7 @@ decNumber * decNumberCompareSignal(decNumber *res, const decNumber *lhs,
 decNumber * decNumberCompareTotal(decNumber *res, const decNumber *lhs,
                                   const decNumber *rhs, decContext *set) {
   uInt status=0;                        // accumulator
+  DECENTRY(DEC_ENTRY_COMPARE_TOTAL);
   decCompareOp(res, lhs, rhs, set, COMPTOTAL, &status);
   if (status!=0) decStatus(res, status, set);
   return res;
@@ -921,6 +1112,7 @@ decNumber * decNumberCompareTotalMag(decNumber *res, const decNumber *lhs,
   decNumber bufb[D2N(DECBUFFER+1)];
   decNumber *allocbufb=NULL;       // -> allocated bufb, iff allocated
   decNumber *a, *b;                // temporary pointers
+  DECENTRY(DEC_ENTRY_COMPARE_TOTAL_MAG);
 
   #if DECCHECK
   if (decCheckOperands(res, lhs, rhs, set)) return res;
@@ -932,7 +1124,7 @@ decNumber * decNumberCompareTotalMag(decNumber *res, const decNumber *lhs,
       a=bufa;
       needbytes=sizeof(decNumber)+(D2U(lhs->digits)-1)*sizeof(Unit);
       if (needbytes>sizeof(bufa)) {     // need malloc space
-        allocbufa=(decNumber *)malloc(needbytes);
+        allocbufa=(decNumber *)decAlloc(set, needbytes);
         if (allocbufa==NULL) {          // hopeless -- abandon
           status|=DEC_Insufficient_storage;
           break;}
@@ -946,7 +1138,7 @@ decNumber * decNumberCompareTotalMag(decNumber *res, const decNumber *lhs,
       b=bufb;
       needbytes=sizeof(decNumber)+(D2U(rhs->digits)-1)*sizeof(Unit);
       if (needbytes>sizeof(bufb)) {     // need malloc space
-        allocbufb=(decNumber *)malloc(needbytes);
+        allocbufb=(decNumber *)decAlloc(set, needbytes);
         if (allocbufb==NULL) {          // hopeless -- abandon
           status|=DEC_Insufficient_storage;
           break;}
@@ -959,8 +1151,8 @@ decNumber * decNumberCompareTotalMag(decNumber *res, const decNumber *lhs,
     decCompareOp(res, lhs, rhs, set, COMPTOTAL, &status);
     } while(0);                         // end protected
 
-  if (allocbufa!=NULL) free(allocbufa); // drop any storage used
-  if (allocbufb!=NULL) free(allocbufb); // ..
+  if (allocbufa!=NULL) decRelease(set, allocbufa); // drop any storage used
+  if (allocbufb!=NULL) decRelease(set, allocbufb); // ..
   if (status!=0) decStatus(res, status, set);
   return res;
   } // decNumberCompareTotalMag
@@ -980,6 +1172,7 @@ decNumber * decNumberCompareTotalMag(decNumber *res, const decNumber *lhs,
 decNumber * decNumberDivide(decNumber *res, const decNumber *lhs,
                             const decNumber *rhs, decContext *set) {
   uInt status=0;                        // accumulator
+  DECENTRY(DEC_ENTRY_DIVIDE);
   decDivideOp(res, lhs, rhs, set, DIVIDE, &status);
   if (status!=0) decStatus(res, status, set);
   #if DECCHECK
@@ -1003,6 +1196,7 @@ decNumber * decNumberDivide(decNumber *res, const decNumber *lhs,
 decNumber * decNumberDivideInteger(decNumber *res, const decNumber *lhs,
                                    const decNumber *rhs, decContext *set) {
   uInt status=0;                        // accumulator
+  DECENTRY(DEC_ENTRY_DIVIDE_INTEGER);
   decDivideOp(res, lhs, rhs, set, DIVIDEINT, &status);
   if (status!=0) decStatus(res, status, set);
   return res;
@@ -1039,6 +1233,7 @@ decNumber * decNumberExp(decNumber *res, const decNumber *rhs,
   #if DECSUBSET
   decNumber *allocrhs=NULL;        // non-NULL if rounded rhs allocated
   #endif
+  DECENTRY(DEC_ENTRY_EXP);
 
   #if DECCHECK
   if (decCheckOperands(res, DECUNUSED, rhs, set)) return res;
@@ -1063,7 +1258,7 @@ decNumber * decNumberExp(decNumber *res, const decNumber *rhs,
     } while(0);                         // end protected
 
   #if DECSUBSET
-  if (allocrhs !=NULL) free(allocrhs);  // drop any storage used
+  if (allocrhs !=NULL) decRelease(set, allocrhs); // drop any storage used
   #endif
   // apply significant status
   if (status!=0) decStatus(res, status, set);
@@ -1099,6 +1294,7 @@ decNumber * decNumberFMA(decNumber *res, const decNumber *lhs,
   decNumber *allocbufa=NULL;       // -> allocated bufa, iff allocated
   decNumber *acc;                  // accumulator pointer
   decNumber dzero;                 // work
+  DECENTRY(DEC_ENTRY_FMA);
 
   #if DECCHECK
   if (decCheckOperands(res, lhs, rhs, set)) return res;
@@ -1125,7 +1321,7 @@ decNumber * decNumberFMA(decNumber *res, const decNumber *lhs,
     acc=bufa;                           // may fit
     needbytes=sizeof(decNumber)+(D2U(dcmul.digits)-1)*sizeof(Unit);
     if (needbytes>sizeof(bufa)) {       // need malloc space
-      allocbufa=(decNumber *)malloc(needbytes);
+      allocbufa=(decNumber *)decAlloc(set, needbytes);
       if (allocbufa==NULL) {            // hopeless -- abandon
         status|=DEC_Insufficient_storage;
         break;}
@@ -1158,7 +1354,7 @@ decNumber * decNumberFMA(decNumber *res, const decNumber *lhs,
     decAddOp(res, acc, fhs, set, 0, &status);
     } while(0);                         // end protected
 
-  if (allocbufa!=NULL) free(allocbufa); // drop any storage used
+  if (allocbufa!=NULL) decRelease(set, allocbufa); // drop any storage used
   if (status!=0) decStatus(res, status, set);
   #if DECCHECK
   decCheckInexact(res, set);
@@ -1185,6 +1381,7 @@ decNumber * decNumberInvert(decNumber *res, const decNumber *rhs,
   const Unit *ua, *msua;                // -> operand and its msu
   Unit  *uc, *msuc;                     // -> result and its msu
   Int   msudigs;                        // digits in res msu
+  DECENTRY(DEC_ENTRY_INVERT);
   #if DECCHECK
   if (decCheckOperands(res, DECUNUSED, rhs, set)) return res;
   #endif
@@ -1259,6 +1456,7 @@ decNumber * decNumberLn(decNumber *res, const decNumber *rhs,
   #if DECSUBSET
   decNumber *allocrhs=NULL;        // non-NULL if rounded rhs allocated
   #endif
+  DECENTRY(DEC_ENTRY_LN);
 
   #if DECCHECK
   if (decCheckOperands(res, DECUNUSED, rhs, set)) return res;
@@ -1285,7 +1483,7 @@ decNumber * decNumberLn(decNumber *res, const decNumber *rhs,
     } while(0);                         // end protected
 
   #if DECSUBSET
-  if (allocrhs !=NULL) free(allocrhs);  // drop any storage used
+  if (allocrhs !=NULL) decRelease(set, allocrhs); // drop any storage used
   #endif
   // apply significant status
   if (status!=0) decStatus(res, status, set);
@@ -1322,6 +1520,7 @@ decNumber * decNumberLn(decNumber *res, const decNumber *rhs,
 decNumber * decNumberLogB(decNumber *res, const decNumber *rhs,
                           decContext *set) {
   uInt status=0;                   // accumulator
+  DECENTRY(DEC_ENTRY_LOGB);
 
   #if DECCHECK
   if (decCheckOperands(res, DECUNUSED, rhs, set)) return res;
@@ -1403,6 +1602,7 @@ decNumber * decNumberLog10(decNumber *res, const decNumber *rhs,
   #endif
 
   decContext aset;                 // working context
+  DECENTRY(DEC_ENTRY_LOG10);
 
   #if DECCHECK
   if (decCheckOperands(res, DECUNUSED, rhs, set)) return res;
@@ -1427,6 +1627,7 @@ decNumber * decNumberLog10(decNumber *res, const decNumber *rhs,
     #endif
 
     decContextDefault(&aset, DEC_INIT_DECIMAL64); // clean context
+    aset.allocator=set->allocator;      // same working storage
 
     // handle exact powers of 10; only check if +ve finite
     if (!(rhs->bits&(DECNEG|DECSPECIAL)) && !ISZERO(rhs)) {
@@ -1460,7 +1661,7 @@ decNumber * decNumberLog10(decNumber *res, const decNumber *rhs,
     p=(rhs->digits+t>set->digits?rhs->digits+t:set->digits)+3;
     needbytes=sizeof(decNumber)+(D2U(p)-1)*sizeof(Unit);
     if (needbytes>sizeof(bufa)) {       // need malloc space
-      allocbufa=(decNumber *)malloc(needbytes);
+      allocbufa=(decNumber *)decAlloc(set, needbytes);
       if (allocbufa==NULL) {            // hopeless -- abandon
         status|=DEC_Insufficient_storage;
         break;}
@@ -1483,7 +1684,7 @@ decNumber * decNumberLog10(decNumber *res, const decNumber *rhs,
     p=set->digits+3;
     needbytes=sizeof(decNumber)+(D2U(p)-1)*sizeof(Unit);
     if (needbytes>sizeof(bufb)) {       // need malloc space
-      allocbufb=(decNumber *)malloc(needbytes);
+      allocbufb=(decNumber *)decAlloc(set, needbytes);
       if (allocbufb==NULL) {            // hopeless -- abandon
         status|=DEC_Insufficient_storage;
         break;}
@@ -1504,10 +1705,10 @@ decNumber * decNumberLog10(decNumber *res, const decNumber *rhs,
     decDivideOp(res, a, b, &aset, DIVIDE, &status); // into result
     } while(0);                         // [for break]
 
-  if (allocbufa!=NULL) free(allocbufa); // drop any storage used
-  if (allocbufb!=NULL) free(allocbufb); // ..
+  if (allocbufa!=NULL) decRelease(set, allocbufa); // drop any storage used
+  if (allocbufb!=NULL) decRelease(set, allocbufb); // ..
   #if DECSUBSET
-  if (allocrhs !=NULL) free(allocrhs);  // ..
+  if (allocrhs !=NULL) decRelease(set, allocrhs); // ..
   #endif
   // apply significant status
   if (status!=0) decStatus(res, status, set);
@@ -1532,6 +1733,7 @@ decNumber * decNumberLog10(decNumber *res, const decNumber *rhs,
 decNumber * decNumberMax(decNumber *res, const decNumber *lhs,
                          const decNumber *rhs, decContext *set) {
   uInt status=0;                        // accumulator
+  DECENTRY(DEC_ENTRY_MAX);
   decCompareOp(res, lhs, rhs, set, COMPMAX, &status);
   if (status!=0) decStatus(res, status, set);
   #if DECCHECK
@@ -1555,6 +1757,7 @@ decNumber * decNumberMax(decNumber *res, const decNumber *lhs,
 decNumber * decNumberMaxMag(decNumber *res, const decNumber *lhs,
                          const decNumber *rhs, decContext *set) {
   uInt status=0;                        // accumulator
+  DECENTRY(DEC_ENTRY_MAX_MAG);
   decCompareOp(res, lhs, rhs, set, COMPMAXMAG, &status);
   if (status!=0) decStatus(res, status, set);
   #if DECCHECK
@@ -1578,6 +1781,7 @@ decNumber * decNumberMaxMag(decNumber *res, const decNumber *lhs,
 decNumber * decNumberMin(decNumber *res, const decNumber *lhs,
                          const decNumber *rhs, decContext *set) {
   uInt status=0;                        // accumulator
+  DECENTRY(DEC_ENTRY_MIN);
   decCompareOp(res, lhs, rhs, set, COMPMIN, &status);
   if (status!=0) decStatus(res, status, set);
   #if DECCHECK
@@ -1601,6 +1805,7 @@ decNumber * decNumberMin(decNumber *res, const decNumber *lhs,
 decNumber * decNumberMinMag(decNumber *res, const decNumber *lhs,
                          const decNumber *rhs, decContext *set) {
   uInt status=0;                        // accumulator
+  DECENTRY(DEC_ENTRY_MIN_MAG);
   decCompareOp(res, lhs, rhs, set, COMPMINMAG, &status);
   if (status!=0) decStatus(res, status, set);
   #if DECCHECK
@@ -1627,6 +1832,7 @@ decNumber * decNumberMinus(decNumber *res, const decNumber *rhs,
                            decContext *set) {
   decNumber dzero;
   uInt status=0;                        // accumulator
+  DECENTRY(DEC_ENTRY_MINUS);
 
   #if DECCHECK
   if (decCheckOperands(res, DECUNUSED, rhs, set)) return res;
@@ -1658,6 +1864,7 @@ decNumber * decNumberNextMinus(decNumber *res, const decNumber *rhs,
   decNumber dtiny;                           // constant
   decContext workset=*set;                   // work
   uInt status=0;                             // accumulator
+  DECENTRY(DEC_ENTRY_NEXT_MINUS);
   #if DECCHECK
   if (decCheckOperands(res, DECUNUSED, rhs, set)) return res;
   #endif
@@ -1694,6 +1901,7 @@ decNumber * decNumberNextPlus(decNumber *res, const decNumber *rhs,
   decNumber dtiny;                           // constant
   decContext workset=*set;                   // work
   uInt status=0;                             // accumulator
+  DECENTRY(DEC_ENTRY_NEXT_PLUS);
   #if DECCHECK
   if (decCheckOperands(res, DECUNUSED, rhs, set)) return res;
   #endif
@@ -1735,6 +1943,7 @@ decNumber * decNumberNextToward(decNumber *res, const decNumber *lhs,
   decContext workset=*set;                   // work
   Int result;                                // ..
   uInt status=0;                             // accumulator
+  DECENTRY(DEC_ENTRY_NEXT_TOWARD);
   #if DECCHECK
   if (decCheckOperands(res, lhs, rhs, set)) return res;
   #endif
@@ -1743,7 +1952,7 @@ decNumber * decNumberNextToward(decNumber *res, const decNumber *lhs,
     decNaNs(res, lhs, rhs, set, &status);
     }
    else { // Is numeric, so no chance of sNaN Invalid, etc.
-    result=decCompare(lhs, rhs, 0);     // sign matters
+    result=decCompare(lhs, rhs, 0, set); // sign matters
     if (result==BADINT) status|=DEC_Insufficient_storage; // rare
      else { // valid compare
       if (result==0) decNumberCopySign(res, lhs, rhs); // easy
@@ -1803,6 +2012,7 @@ decNumber * decNumberOr(decNumber *res, const decNumber *lhs,
   const Unit *msua, *msub;              // -> operand msus
   Unit  *uc, *msuc;                     // -> result and its msu
   Int   msudigs;                        // digits in res msu
+  DECENTRY(DEC_ENTRY_OR);
   #if DECCHECK
   if (decCheckOperands(res, lhs, rhs, set)) return res;
   #endif
@@ -1871,6 +2081,7 @@ decNumber * decNumberPlus(decNumber *res, const decNumber *rhs,
                           decContext *set) {
   decNumber dzero;
   uInt status=0;                        // accumulator
+  DECENTRY(DEC_ENTRY_PLUS);
   #if DECCHECK
   if (decCheckOperands(res, DECUNUSED, rhs, set)) return res;
   #endif
@@ -1900,6 +2111,7 @@ decNumber * decNumberPlus(decNumber *res, const decNumber *rhs,
 decNumber * decNumberMultiply(decNumber *res, const decNumber *lhs,
                               const decNumber *rhs, decContext *set) {
   uInt status=0;                   // accumulator
+  DECENTRY(DEC_ENTRY_MULTIPLY);
   decMultiplyOp(res, lhs, rhs, set, &status);
   if (status!=0) decStatus(res, status, set);
   #if DECCHECK
@@ -1963,6 +2175,7 @@ decNumber * decNumberPower(decNumber *res, const decNumber *lhs,
   decNumber *dac=dacbuff;          // -> result accumulator
   // same again for possible 1/lhs calculation
   decNumber invbuff[D2N(DECBUFFER+9)];
+  DECENTRY(DEC_ENTRY_POWER);
 
   #if DECCHECK
   if (decCheckOperands(res, lhs, rhs, set)) return res;
@@ -2086,6 +2299,7 @@ decNumber * decNumberPower(decNumber *res, const decNumber *lhs,
        || decCheckMath(rhs, set, &status)) break; // variable status
 
       decContextDefault(&aset, DEC_INIT_DECIMAL64); // clean context
+      aset.allocator=set->allocator;    // same working storage
       aset.emax=DEC_MAX_MATH;           // usual bounds
       aset.emin=-DEC_MAX_MATH;          // ..
       aset.clamp=0;                     // and no concrete format
@@ -2128,7 +2342,7 @@ decNumber * decNumberPower(decNumber *res, const decNumber *lhs,
     needbytes=sizeof(decNumber)+(D2U(aset.digits)-1)*sizeof(Unit);
     // [needbytes also used below if 1/lhs needed]
     if (needbytes>sizeof(dacbuff)) {
-      allocdac=(decNumber *)malloc(needbytes);
+      allocdac=(decNumber *)decAlloc(set, needbytes);
       if (allocdac==NULL) {   // hopeless -- abandon
         status|=DEC_Insufficient_storage;
         break;}
@@ -2175,7 +2389,7 @@ decNumber * decNumberPower(decNumber *res, const decNumber *lhs,
           decDivideOp(dac, &dnOne, lhs, &aset, DIVIDE, &status);
           // now locate or allocate space for the inverted lhs
           if (needbytes>sizeof(invbuff)) {
-            allocinv=(decNumber *)malloc(needbytes);
+            allocinv=(decNumber *)decAlloc(set, needbytes);
             if (allocinv==NULL) {       // hopeless -- abandon
               status|=DEC_Insufficient_storage;
               break;}
@@ -2248,11 +2462,11 @@ decNumber * decNumberPower(decNumber *res, const decNumber *lhs,
     #endif
     } while(0);                         // end protected
 
-  if (allocdac!=NULL) free(allocdac);   // drop any storage used
-  if (allocinv!=NULL) free(allocinv);   // ..
+  if (allocdac!=NULL) decRelease(set, allocdac); // drop any storage used
+  if (allocinv!=NULL) decRelease(set, allocinv); // ..
   #if DECSUBSET
-  if (alloclhs!=NULL) free(alloclhs);   // ..
-  if (allocrhs!=NULL) free(allocrhs);   // ..
+  if (alloclhs!=NULL) decRelease(set, alloclhs); // ..
+  if (allocrhs!=NULL) decRelease(set, allocrhs); // ..
   #endif
   if (status!=0) decStatus(res, status, set);
   #if DECCHECK
@@ -2282,6 +2496,7 @@ decNumber * decNumberPower(decNumber *res, const decNumber *lhs,
 decNumber * decNumberQuantize(decNumber *res, const decNumber *lhs,
                               const decNumber *rhs, decContext *set) {
   uInt status=0;                        // accumulator
+  DECENTRY(DEC_ENTRY_QUANTIZE);
   decQuantizeOp(res, lhs, rhs, set, 1, &status);
   if (status!=0) decStatus(res, status, set);
   return res;
@@ -2312,6 +2527,7 @@ decNumber * decNumberReduce(decNumber *res, const decNumber *rhs,
   uInt status=0;                   // as usual
   Int  residue=0;                  // as usual
   Int  dropped;                    // work
+  DECENTRY(DEC_ENTRY_REDUCE);
 
   #if DECCHECK
   if (decCheckOperands(res, DECUNUSED, rhs, set)) return res;
@@ -2344,7 +2560,7 @@ decNumber * decNumberReduce(decNumber *res, const decNumber *rhs,
     } while(0);                              // end protected
 
   #if DECSUBSET
-  if (allocrhs !=NULL) free(allocrhs);       // ..
+  if (allocrhs !=NULL) decRelease(set, allocrhs); // ..
   #endif
   if (status!=0) decStatus(res, status, set);// then report status
   return res;
@@ -2371,6 +2587,7 @@ decNumber * decNumberReduce(decNumber *res, const decNumber *rhs,
 decNumber * decNumberRescale(decNumber *res, const decNumber *lhs,
                              const decNumber *rhs, decContext *set) {
   uInt status=0;                        // accumulator
+  DECENTRY(DEC_ENTRY_RESCALE);
   decQuantizeOp(res, lhs, rhs, set, 0, &status);
   if (status!=0) decStatus(res, status, set);
   return res;
@@ -2391,6 +2608,7 @@ decNumber * decNumberRescale(decNumber *res, const decNumber *lhs,
 decNumber * decNumberRemainder(decNumber *res, const decNumber *lhs,
                                const decNumber *rhs, decContext *set) {
   uInt status=0;                        // accumulator
+  DECENTRY(DEC_ENTRY_REMAINDER);
   decDivideOp(res, lhs, rhs, set, REMAINDER, &status);
   if (status!=0) decStatus(res, status, set);
   #if DECCHECK
@@ -2414,6 +2632,7 @@ decNumber * decNumberRemainder(decNumber *res, const decNumber *lhs,
 decNumber * decNumberRemainderNear(decNumber *res, const decNumber *lhs,
                                    const decNumber *rhs, decContext *set) {
   uInt status=0;                        // accumulator
+  DECENTRY(DEC_ENTRY_REMAINDER_NEAR);
   decDivideOp(res, lhs, rhs, set, REMNEAR, &status);
   if (status!=0) decStatus(res, status, set);
   #if DECCHECK
@@ -2451,6 +2670,7 @@ decNumber * decNumberRotate(decNumber *res, const decNumber *lhs,
                            const decNumber *rhs, decContext *set) {
   uInt status=0;              // accumulator
   Int  rotate;                // rhs as an Int
+  DECENTRY(DEC_ENTRY_ROTATE);
 
   #if DECCHECK
   if (decCheckOperands(res, lhs, rhs, set)) return res;
@@ -2608,6 +2828,7 @@ decNumber * decNumberScaleB(decNumber *res, const decNumber *lhs,
   Int  reqexp;                // requested exponent change [B]
   uInt status=0;              // accumulator
   Int  residue;               // work
+  DECENTRY(DEC_ENTRY_SCALEB);
 
   #if DECCHECK
   if (decCheckOperands(res, lhs, rhs, set)) return res;
@@ -2673,6 +2894,7 @@ decNumber * decNumberShift(decNumber *res, const decNumber *lhs,
                            const decNumber *rhs, decContext *set) {
   uInt status=0;              // accumulator
   Int  shift;                 // rhs as an Int
+  DECENTRY(DEC_ENTRY_SHIFT);
 
   #if DECCHECK
   if (decCheckOperands(res, lhs, rhs, set)) return res;
@@ -2830,6 +3052,7 @@ decNumber * decNumberSquareRoot(decNumber *res, const decNumber *rhs,
   // buffer for temporary variable, up to 3 digits
   decNumber buft[D2N(3)];
   decNumber *t=buft;               // up-to-3-digit constant or work
+  DECENTRY(DEC_ENTRY_SQUARE_ROOT);
 
   #if DECCHECK
   if (decCheckOperands(res, DECUNUSED, rhs, set)) return res;
@@ -2893,7 +3116,7 @@ decNumber * decNumberSquareRoot(decNumber *res, const decNumber *rhs,
 
     needbytes=sizeof(decNumber)+(D2U(rhs->digits)-1)*sizeof(Unit);
     if (needbytes>(Int)sizeof(buff)) {
-      allocbuff=(decNumber *)malloc(needbytes);
+      allocbuff=(decNumber *)decAlloc(set, needbytes);
       if (allocbuff==NULL) {  // hopeless -- abandon
         status|=DEC_Insufficient_storage;
         break;}
@@ -2902,8 +3125,8 @@ decNumber * decNumberSquareRoot(decNumber *res, const decNumber *rhs,
     // a and b both need to be able to hold a maxp-length number
     needbytes=sizeof(decNumber)+(D2U(maxp)-1)*sizeof(Unit);
     if (needbytes>(Int)sizeof(bufa)) {            // [same applies to b]
-      allocbufa=(decNumber *)malloc(needbytes);
-      allocbufb=(decNumber *)malloc(needbytes);
+      allocbufa=(decNumber *)decAlloc(set, needbytes);
+      allocbufb=(decNumber *)decAlloc(set, needbytes);
       if (allocbufa==NULL || allocbufb==NULL) {   // hopeless
         status|=DEC_Insufficient_storage;
         break;}
@@ -2918,6 +3141,7 @@ decNumber * decNumberSquareRoot(decNumber *res, const decNumber *rhs,
 
     // set up working context
     decContextDefault(&workset, DEC_INIT_DECIMAL64);
+    workset.allocator=set->allocator;
     workset.emax=DEC_MAX_EMAX;
     workset.emin=DEC_MIN_EMIN;
 
@@ -3115,11 +3339,11 @@ decNumber * decNumberSquareRoot(decNumber *res, const decNumber *rhs,
     decNumberCopy(res, a);                   // a is now the result
     } while(0);                              // end protected
 
-  if (allocbuff!=NULL) free(allocbuff);      // drop any storage used
-  if (allocbufa!=NULL) free(allocbufa);      // ..
-  if (allocbufb!=NULL) free(allocbufb);      // ..
+  if (allocbuff!=NULL) decRelease(set, allocbuff); // drop any storage used
+  if (allocbufa!=NULL) decRelease(set, allocbufa); // ..
+  if (allocbufb!=NULL) decRelease(set, allocbufb); // ..
   #if DECSUBSET
-  if (allocrhs !=NULL) free(allocrhs);       // ..
+  if (allocrhs !=NULL) decRelease(set, allocrhs); // ..
   #endif
   if (status!=0) decStatus(res, status, set);// then report status
   #if DECCHECK
@@ -3143,6 +3367,7 @@ decNumber * decNumberSquareRoot(decNumber *res, const decNumber *rhs,
 decNumber * decNumberSubtract(decNumber *res, const decNumber *lhs,
                               const decNumber *rhs, decContext *set) {
   uInt status=0;                        // accumulator
+  DECENTRY(DEC_ENTRY_SUBTRACT);
 
   decAddOp(res, lhs, rhs, set, DECNEG, &status);
   if (status!=0) decStatus(res, status, set);
@@ -3178,6 +3403,7 @@ decNumber * decNumberToIntegralExact(decNumber *res, const decNumber *rhs,
   decNumber dn;
   decContext workset;              // working context
   uInt status=0;                   // accumulator
+  DECENTRY(DEC_ENTRY_TO_INTEGRAL_EXACT);
 
   #if DECCHECK
   if (decCheckOperands(res, DECUNUSED, rhs, set)) return res;
@@ -3206,6 +3432,7 @@ decNumber * decNumberToIntegralExact(decNumber *res, const decNumber *rhs,
 decNumber * decNumberToIntegralValue(decNumber *res, const decNumber *rhs,
                                      decContext *set) {
   decContext workset=*set;         // working context
+  DECENTRY(DEC_ENTRY_TO_INTEGRAL_VALUE);
   workset.traps=0;                 // no traps
   decNumberToIntegralExact(res, rhs, &workset);
   // this never affects set, except for sNaNs; NaN will have been set
@@ -3235,6 +3462,7 @@ decNumber * decNumberXor(decNumber *res, const decNumber *lhs,
   const Unit *msua, *msub;              // -> operand msus
   Unit  *uc, *msuc;                     // -> result and its msu
   Int   msudigs;                        // digits in res msu
+  DECENTRY(DEC_ENTRY_XOR);
   #if DECCHECK
   if (decCheckOperands(res, lhs, rhs, set)) return res;
   #endif
@@ -3288,6 +3516,21 @@ decNumber * decNumberXor(decNumber *res, const decNumber *lhs,
 /* Utility routines                                                   */
 /* ================================================================== */
 
+/* ------------------------------------------------------------------ */
+/* decNumberAllocCounts -- return allocation counters                 */
+/*                                                                    */
+/*   entry is the public operator whose counters are wanted           */
+/*   returns the counters, for the calling thread, of storage that    */
+/*     the operator needed beyond its local buffers                   */
+/*                                                                    */
+/* The counters accumulate from the start of the thread or the last   */
+/* decNumberResetAllocCounts.                                         */
+/* ------------------------------------------------------------------ */
+const decAllocCounts * decNumberAllocCounts(enum decEntry entry) {
+  if ((unsigned)entry>=DEC_ENTRY_COUNT) entry=DEC_ENTRY_NONE;
+  return &decEntryCounts[entry];
+  } // decNumberAllocCounts
+
 /* ------------------------------------------------------------------ */
 /* decNumberClass -- return the decClass of a decNumber               */
 /*   dn -- the decNumber to test                                      */
@@ -3505,6 +3748,171 @@ decNumber * decNumberSetBCD(decNumber *dn, const uByte *bcd, uInt n) {
   return dn;
   } // decNumberSetBCD
 
+/* ------------------------------------------------------------------ */
+/* decNumberEntryToString -- convert decEntry to a string             */
+/*                                                                    */
+/*  entry is a decEntry                                               */
+/*  returns the name of the public operator, such as "decNumberAdd"   */
+/*    (or "" for DEC_ENTRY_NONE or an unknown decEntry)               */
+/* ------------------------------------------------------------------ */
+const char * decNumberEntryToString(enum decEntry entry) {
+  if ((unsigned)entry>=DEC_ENTRY_COUNT) entry=DEC_ENTRY_NONE;
+  return decEntryNames[entry];
+  } // decNumberEntryToString
+
+/* ------------------------------------------------------------------ */
+/* decNumberHash -- hash a decNumber consistently with equality       */
+/*                                                                    */
+/*   dn is the number to hash                                         */
+/*   returns a 32-bit hash of the numerical value of dn               */
+/*                                                                    */
+/* Numerically equal numbers (such as 1.0 and 1.00, or 0 and -0E+3)   */
+/* have equal hashes, so no reduction is needed before hashing.  All  */
+/* NaNs have the same hash.  The hash is also that given by           */
+/* decimal64Hash and decimal128Hash for numerically equal values, and */
+/* it does not depend on DECDPUN or DECUSE64.                         */
+/*                                                                    */
+/* No error is possible.                                              */
+/* ------------------------------------------------------------------ */
+uInt decNumberHash(const decNumber *dn) {
+  const Unit *up;                       // work
+  #if DECUSE64
+  uLong acc=0;                          // coefficient, modulo DECHASHP
+  #else
+  uInt  acc=0;                          // ..
+  #endif
+  #if DECCHECK
+  if (decCheckOperands(DECUNRESU, DECUNUSED, dn, DECUNCONT)) return 0;
+  #endif
+
+  if (!decNumberIsSpecial(dn)) {        // NaN payloads are ignored
+    for (up=dn->lsu+D2U(dn->digits)-1; up>=dn->lsu; up--) {
+      #if DECUSE64
+      acc=HASHFOLD(acc)*DECPOWERS[DECDPUN]+*up;  // stays <2**62
+      #else
+      acc=decHashMulAdd(acc, DECPOWERS[DECDPUN], *up);
+      #endif
+      }
+    }
+  return decHashFinish((uInt)HASHFOLD(acc), dn->exponent, dn->bits);
+  } // decNumberHash
+
+/* ------------------------------------------------------------------ */
+/* Hashing support, shared with decimal64 and decimal128              */
+/*                                                                    */
+/* The hash of a finite number c*10**e is based on the value of that  */
+/* number modulo the prime DECHASHP (2**31-1, see decNumberLocal.h),  */
+/* that is, on                                                        */
+/* c*10**e mod DECHASHP, where 10**e for negative e is the power of   */
+/* the inverse of 10, modulo DECHASHP.  Numerically equal numbers     */
+/* therefore give equal residues, whatever their exponents, without   */
+/* trailing zeros having to be removed first.  The residue (or a      */
+/* value above DECHASHP for a special value) is then mixed so that    */
+/* all its bits affect all the bits of the hash.                      */
+/* ------------------------------------------------------------------ */
+// 10**n mod DECHASHP for n=0-31, 10**(32*n), 10**-n, and 10**(-32*n)
+static const uInt DECHASH10[4][32]={
+  {0x00000001, 0x0000000a, 0x00000064, 0x000003e8, 0x00002710,
+   0x000186a0, 0x000f4240, 0x00989680, 0x05f5e100, 0x3b9aca00,
+   0x540be404, 0x4876e82e, 0x54a511d1, 0x4e72b230, 0x107af5e6,
+   0x24cd9afd, 0x70080de4, 0x60508af0, 0x43256d67, 0x1f76460b,
+   0x3a9ebc70, 0x4a335c64, 0x66019bed, 0x7c101749, 0x58a0e8e3,
+   0x764918e4, 0x1edaf8f1, 0x348db96c, 0x0d893e3c, 0x075c6e59,
+   0x499c4f7a, 0x601b1ac9},
+  {0x00000001, 0x410f0be1, 0x47fc6596, 0x4b935cae, 0x041ba647,
+   0x13b1b776, 0x3200e087, 0x04be766a, 0x371be80e, 0x65543487,
+   0x3bada399, 0x76f08d6f, 0x1475369c, 0x5de7a079, 0x4c4ae6b2,
+   0x22f36974, 0x61076245, 0x11127d6b, 0x5996397b, 0x783e9f36,
+   0x27292fcf, 0x20496eac, 0x40c8bef9, 0x1b291a5d, 0x59833b76,
+   0x6f4e7e97, 0x2dd9b187, 0x6c2cc491, 0x0c45718c, 0x7e5a84fb,
+   0x37337b78, 0x0aa44e53},
+  {0x00000001, 0x59999999, 0x15c28f5c, 0x022d0e56, 0x336ae7d5,
+   0x5ebde3fb, 0x6312fd32, 0x09e84c85, 0x40fda140, 0x39b2f686,
+   0x05c518a7, 0x0d608277, 0x0e23403f, 0x5b03866c, 0x22b38d71,
+   0x76ab8e24, 0x3f1127d0, 0x3981b72e, 0x05c02beb, 0x40933797,
+   0x79a8525b, 0x7f5da1d5, 0x3322f695, 0x451d18a8, 0x06e94f44,
+   0x1a4a87ed, 0x75d440ca, 0x0bc86ce1, 0x27940ae3, 0x2a5b9ab0,
+   0x51092911, 0x14e750e8},
+  {0x00000001, 0x4ee3ee7d, 0x2c7a0993, 0x0f3fe7e8, 0x37ec0558,
+   0x6ab5d3fc, 0x28159c82, 0x2608d3dc, 0x42cb160b, 0x7a93af69,
+   0x7ad78974, 0x629a0c85, 0x3990377b, 0x7e8ad3e0, 0x4861a376,
+   0x2fe2e83e, 0x4632956c, 0x5fa53149, 0x7428e9d7, 0x649cd776,
+   0x3089a586, 0x62d4b5d6, 0x309559ab, 0x4cdc4885, 0x564928ff,
+   0x67215201, 0x19f4ebb4, 0x4853e73c, 0x50b99cc3, 0x1708b052,
+   0x3612a3cf, 0x2f4513b3}};
+
+/* ------------------------------------------------------------------ */
+/* decHashMulAdd -- multiply and add, modulo DECHASHP                 */
+/*                                                                    */
+/*   a, b are the numbers to multiply, each less than DECHASHP        */
+/*   c    is the number to add, less than DECHASHP                    */
+/*   returns (a*b+c) mod DECHASHP                                     */
+/* ------------------------------------------------------------------ */
+uInt decHashMulAdd(uInt a, uInt b, uInt c) {
+  #if DECUSE64
+  uLong r=(uLong)a*b+c;                 // <2**62
+  r=HASHFOLD(r);                        // <2**32
+  r=HASHFOLD(r);                        // <=DECHASHP+1
+  #else
+  // no 64-bit arithmetic, so multiply by 16-bit halves; as 2**31 is
+  // 1 modulo DECHASHP, 2**32 is 2 and t*2**16 is th+tl*2**16 when
+  // t=th*2**15+tl
+  uInt ah=a>>16, al=a&0xffff;           // halves
+  uInt bh=b>>16, bl=b&0xffff;           // ..
+  uInt mid=ah*bl+al*bh;                 // <2**32
+  uInt r, t;                            // work
+  t=al*bl;                              // <2**32
+  r=(t&DECHASHP)+(t>>31)+c;             // <2**32
+  r=(r&DECHASHP)+(r>>31);               // <=DECHASHP+1
+  r+=ah*bh*2;                           // <2**32
+  r=(r&DECHASHP)+(r>>31);               // ..
+  r+=(mid>>15)+((mid&0x7fff)<<16);      // <2**32
+  r=(r&DECHASHP)+(r>>31);               // ..
+  #endif
+  return (uInt)(r>=DECHASHP ? r-DECHASHP : r);
+  } // decHashMulAdd
+
+/* ------------------------------------------------------------------ */
+/* decHashFinish -- finish a hash                                     */
+/*                                                                    */
+/*   coeff is congruent to the coefficient, modulo DECHASHP (and is   */
+/*         ignored if special)                                        */
+/*   exp   is the exponent                                            */
+/*   bits  is the sign and special bits, as for decNumber             */
+/*   returns the hash                                                 */
+/* ------------------------------------------------------------------ */
+uInt decHashFinish(uInt coeff, Int exp, uByte bits) {
+  uInt h=0;                             // residue, then hash
+  uInt e, pow, base;                    // work
+  const uInt *lo, *hi;                  // tables to use
+
+  coeff=HASHFOLD(coeff);                // now <=DECHASHP+1
+  if (coeff>=DECHASHP) coeff-=DECHASHP;
+  if (bits&DECSPECIAL) {
+    if (bits&DECNAN || bits&DECSNAN) h=DECHASHP+2;
+     else h=(bits&DECNEG ? DECHASHP+1 : DECHASHP);
+    }
+   else if (coeff!=0) {                 // [all zeros are 0]
+    if (exp>=0) {e=(uInt)exp;  lo=DECHASH10[0]; hi=DECHASH10[1];}
+     else       {e=(uInt)-exp; lo=DECHASH10[2]; hi=DECHASH10[3];}
+    if (e<32*32) pow=decHashMulAdd(lo[e&31], hi[e>>5], 0);
+     else {                             // rare; square and multiply
+      for (pow=1, base=lo[1]; e>0; e>>=1) {
+        if (e&1) pow=decHashMulAdd(pow, base, 0);
+        base=decHashMulAdd(base, base, 0);
+        }
+      }
+    h=decHashMulAdd(coeff, pow, 0);
+    if (bits&DECNEG && h!=0) h=DECHASHP-h;      // -x mod DECHASHP
+    }
+
+  // mix the bits (the MurmurHash3 finalizer)
+  h^=h>>16; h*=0x85ebca6b;
+  h^=h>>13; h*=0xc2b2ae35;
+  h^=h>>16;
+  return h;
+  } // decHashFinish
+
 /* ------------------------------------------------------------------ */
 /* decNumberIsNormal -- test normality of a decNumber                 */
 /*   dn is the decNumber to test                                      */
@@ -3565,6 +3973,15 @@ decNumber * decNumberTrim(decNumber *dn) {
   return decTrim(dn, &set, 0, 1, &dropped);
   } // decNumberTrim
 
+/* ------------------------------------------------------------------ */
+/* decNumberResetAllocCounts -- clear allocation counters             */
+/*                                                                    */
+/* Sets all the calling thread's allocation counters to 0.            */
+/* ------------------------------------------------------------------ */
+void decNumberResetAllocCounts(void) {
+  memset(decEntryCounts, 0, sizeof(decEntryCounts));
+  } // decNumberResetAllocCounts
+
 /* ------------------------------------------------------------------ */
 /* decNumberVersion -- return the name and version of this module     */
 /*                                                                    */
@@ -3620,10 +4037,8 @@ static void decToString(const decNumber *dn, char *string, Flag eng) {
   Int exp=dn->exponent;       // local copy
   Int e;                      // E-part value
   Int pre;                    // digits before the '.'
-  Int cut;                    // for counting digits in a Unit
   char *c=string;             // work [output pointer]
-  const Unit *up=dn->lsu+D2U(dn->digits)-1; // -> msu [input pointer]
-  uInt u, pow;                // work
+  uInt u;                     // work
 
   #if DECCHECK
   if (decCheckOperands(DECUNRESU, dn, DECUNUSED, DECUNCONT)) {
@@ -3653,16 +4068,8 @@ static void decToString(const decNumber *dn, char *string, Flag eng) {
     // [drop through to add integer]
     }
 
-  // calculate how many digits in msu, and hence first cut
-  cut=MSUDIGITS(dn->digits);       // [faster than remainder]
-  cut--;                           // power of ten for digit
-
   if (exp==0) {                    // simple integer [common fastpath]
-    for (;up>=dn->lsu; up--) {     // each Unit from msu
-      u=*up;                       // contains DECDPUN digits to lay out
-      for (; cut>=0; c++, cut--) TODIGIT(u, cut, c, pow);
-      cut=DECDPUN-1;               // next Unit has all digits
-      }
+    c=decUnitsToChars(dn, c);
     *c='\0';                       // terminate the string
     return;}
 
@@ -3698,52 +4105,28 @@ static void decToString(const decNumber *dn, char *string, Flag eng) {
     } // need exponent
 
   /* lay out the digits of the coefficient, adding 0s and . as needed */
-  u=*up;
   if (pre>0) {                     // xxx.xxx or xx00 (engineering) form
-    Int n=pre;
-    for (; pre>0; pre--, c++, cut--) {
-      if (cut<0) {                 // need new Unit
-        if (up==dn->lsu) break;    // out of input digits (pre>digits)
-        up--;
-        cut=DECDPUN-1;
-        u=*up;
-        }
-      TODIGIT(u, cut, c, pow);
-      }
-    if (n<dn->digits) {            // more to come, after '.'
-      *c='.'; c++;
-      for (;; c++, cut--) {
-        if (cut<0) {               // need new Unit
-          if (up==dn->lsu) break;  // out of input digits
-          up--;
-          cut=DECDPUN-1;
-          u=*up;
-          }
-        TODIGIT(u, cut, c, pow);
-        }
+    Int n=dn->digits;
+    c=decUnitsToChars(dn, c);
+    if (pre<n) {                   // '.' goes among the digits
+      char *dot=c-n+pre;           // -> first digit after '.'
+      memmove(dot+1, dot, n-pre);
+      *dot='.';
+      c++;
       }
-     else for (; pre>0; pre--, c++) *c='0'; // 0 padding (for engineering) needed
+     else for (pre-=n; pre>0; pre--, c++) *c='0'; // 0 padding (for engineering) needed
     }
    else {                          // 0.xxx or 0.000xxx form
     *c='0'; c++;
     *c='.'; c++;
     for (; pre<0; pre++, c++) *c='0';   // add any 0's after '.'
-    for (; ; c++, cut--) {
-      if (cut<0) {                 // need new Unit
-        if (up==dn->lsu) break;    // out of input digits
-        up--;
-        cut=DECDPUN-1;
-        u=*up;
-        }
-      TODIGIT(u, cut, c, pow);
-      }
+    c=decUnitsToChars(dn, c);
     }
 
   /* Finally add the E-part, if needed.  It will never be 0, has a
      base maximum and minimum of +999999999 through -999999999, but
      could range down to -1999999998 for anormal numbers */
   if (e!=0) {
-    Flag had=0;               // 1=had non-zero
     *c='E'; c++;
     *c='+'; c++;              // assume positive
     u=e;                      // ..
@@ -3752,17 +4135,70 @@ static void decToString(const decNumber *dn, char *string, Flag eng) {
       u=-e;                   // uInt, please
       }
     // lay out the exponent [_itoa or equivalent is not ANSI C]
-    for (cut=9; cut>=0; cut--) {
-      TODIGIT(u, cut, c, pow);
-      if (*c=='0' && !had) continue;    // skip leading zeros
-      had=1;                            // had non-0
-      c++;                              // step for next
-      } // cut
+    c=decExpToChars(u, c);
     }
   *c='\0';          // terminate the string (all paths)
   return;
   } // decToString
 
+/* ------------------------------------------------------------------ */
+/* decUnitsToChars -- lay out the digits of a coefficient             */
+/*                                                                    */
+/*   dn is the number whose coefficient is to be laid out             */
+/*   c  is where to lay out the digits                                */
+/*                                                                    */
+/* returns a pointer to the character after the last digit            */
+/*                                                                    */
+/* dn->digits characters are laid out, with no terminator.  When      */
+/* DECDPUN is 3 each Unit is copied from bin2ascii; otherwise the     */
+/* digits of each Unit are removed one at a time with TODIGIT.        */
+/* ------------------------------------------------------------------ */
+static char *decUnitsToChars(const decNumber *dn, char *c) {
+  const Unit *up=dn->lsu+D2U(dn->digits)-1; // -> msu [input pointer]
+  Int cut=MSUDIGITS(dn->digits);   // digits in msu [faster than remainder]
+  #if DECDPUN==3
+  memcpy(c, &bin2ascii[*up*3+3-cut], cut);   // msu, less leading 0s
+  c+=cut;
+  for (up--; up>=dn->lsu; up--, c+=3) memcpy(c, &bin2ascii[*up*3], 3);
+  #else
+  uInt u, pow;                     // work
+  for (cut--; up>=dn->lsu; up--) { // each Unit from msu
+    u=*up;                         // contains DECDPUN digits to lay out
+    for (; cut>=0; c++, cut--) TODIGIT(u, cut, c, pow);
+    cut=DECDPUN-1;                 // next Unit has all digits
+    }
+  #endif
+  return c;
+  } // decUnitsToChars
+
+/* ------------------------------------------------------------------ */
+/* decExpToChars -- lay out an exponent magnitude                     */
+/*                                                                    */
+/*   u is the value to lay out (>0)                                   */
+/*   c is where to lay out the digits                                 */
+/*                                                                    */
+/* returns a pointer to the character after the last digit            */
+/*                                                                    */
+/* The value (at most ten digits) is built from the right, three      */
+/* digits at a time, in a local buffer and then copied to c with no   */
+/* leading zeros and no terminator.                                   */
+/* ------------------------------------------------------------------ */
+static char *decExpToChars(uInt u, char *c) {
+  char buf[12];                    // work; ten digits needed
+  char *b=buf+sizeof(buf);         // -> end of digits
+  Int n;                           // digits in leading group
+  for (; u>=1000; u/=1000) {       // each full group of three
+    b-=3;
+    memcpy(b, &bin2ascii[(u%1000)*3], 3);
+    }
+  n=(u>=100 ? 3 : (u>=10 ? 2 : 1));
+  b-=n;
+  memcpy(b, &bin2ascii[u*3+3-n], n);
+  n=(Int)(buf+sizeof(buf)-b);
+  memcpy(c, b, n);
+  return c+n;
+  } // decExpToChars
+
 /* ------------------------------------------------------------------ */
 /* decAddOp -- add/subtract operation                                 */
 /*                                                                    */
@@ -3797,6 +4233,12 @@ static void decToString(const decNumber *dn, char *string, Flag eng) {
 /* Addition, especially x=x+1, is speed-critical.                     */
 /* The static buffer is larger than might be expected to allow for    */
 /* calls from higher-level funtions (notable exp).                    */
+/*                                                                    */
+/* FASTADD enables a path which adds operands of up to 38 digits as   */
+/* uLLongs.  With small Units the conversions to and from binary      */
+/* cost more than the Unit loop they replace (about 30% slower for    */
+/* 16-digit operands with DECDPUN=3), so it is off by default; define */
+/* DECFASTADD=1 to use it.                                            */
 /* ------------------------------------------------------------------ */
 static decNumber * decAddOp(decNumber *res, const decNumber *lhs,
                             const decNumber *rhs, decContext *set,
@@ -3824,69 +4266,99 @@ static decNumber * decAddOp(decNumber *res, const decNumber *lhs,
   #endif
 
   do {                             // protect allocated storage
-    #if DECSUBSET
-    if (!set->extended) {
-      // reduce operands and set lostDigits status, as needed
-      if (lhs->digits>reqdigits) {
-        alloclhs=decRoundOperand(lhs, set, status);
-        if (alloclhs==NULL) break;
-        lhs=alloclhs;
-        }
-      if (rhs->digits>reqdigits) {
-        allocrhs=decRoundOperand(rhs, set, status);
-        if (allocrhs==NULL) break;
-        rhs=allocrhs;
-        }
-      }
-    #endif
-    // [following code does not require input rounding]
-
     // note whether signs differ [used all paths]
     diffsign=(Flag)((lhs->bits^rhs->bits^negate)&DECNEG);
 
-    // handle infinities and NaNs
-    if (SPECIALARGS) {                  // a special bit set
-      if (SPECIALARGS & (DECSNAN | DECNAN))  // a NaN
-        decNaNs(res, lhs, rhs, set, status);
-       else { // one or two infinities
-        if (decNumberIsInfinite(lhs)) { // LHS is infinity
-          // two infinities with different signs is invalid
-          if (decNumberIsInfinite(rhs) && diffsign) {
-            *status|=DEC_Invalid_operation;
-            break;
-            }
-          bits=lhs->bits & DECNEG;      // get sign from LHS
-          }
-         else bits=(rhs->bits^negate) & DECNEG;// RHS must be Infinity
-        bits|=DECINF;
-        decNumberZero(res);
-        res->bits=bits;                 // set +/- infinity
-        } // an infinity
-      break;
-      }
-
-    // Quick exit for add 0s; return the non-0, modified as need be
-    if (ISZERO(lhs)) {
-      Int adjust;                       // work
-      Int lexp=lhs->exponent;           // save in case LHS==RES
-      bits=lhs->bits;                   // ..
-      residue=0;                        // clear accumulator
-      decCopyFit(res, rhs, set, &residue, status); // copy (as needed)
-      res->bits^=negate;                // flip if rhs was negated
+    // one test passes finite, non-zero operands which need no
+    // rounding straight to the arithmetic
+    if (ODDARGS(set)) {
       #if DECSUBSET
-      if (set->extended) {              // exponents on zeros count
+      if (!set->extended) {
+        // reduce operands and set lostDigits status, as needed
+        if (lhs->digits>reqdigits) {
+          alloclhs=decRoundOperand(lhs, set, status);
+          if (alloclhs==NULL) break;
+          lhs=alloclhs;
+          }
+        if (rhs->digits>reqdigits) {
+          allocrhs=decRoundOperand(rhs, set, status);
+          if (allocrhs==NULL) break;
+          rhs=allocrhs;
+          }
+        }
       #endif
-        // exponent will be the lower of the two
-        adjust=lexp-res->exponent;      // adjustment needed [if -ve]
-        if (ISZERO(res)) {              // both 0: special IEEE 754 rules
-          if (adjust<0) res->exponent=lexp;  // set exponent
-          // 0-0 gives +0 unless rounding to -infinity, and -0-0 gives -0
-          if (diffsign) {
-            if (set->round!=DEC_ROUND_FLOOR) res->bits=0;
-             else res->bits=DECNEG;     // preserve 0 sign
+      // [following code does not require input rounding]
+
+      // handle infinities and NaNs
+      if (SPECIALARGS) {                  // a special bit set
+        if (SPECIALARGS & (DECSNAN | DECNAN))  // a NaN
+          decNaNs(res, lhs, rhs, set, status);
+         else { // one or two infinities
+          if (decNumberIsInfinite(lhs)) { // LHS is infinity
+            // two infinities with different signs is invalid
+            if (decNumberIsInfinite(rhs) && diffsign) {
+              *status|=DEC_Invalid_operation;
+              break;
+              }
+            bits=lhs->bits & DECNEG;      // get sign from LHS
             }
-          }
-         else { // non-0 res
+           else bits=(rhs->bits^negate) & DECNEG;// RHS must be Infinity
+          bits|=DECINF;
+          decNumberZero(res);
+          res->bits=bits;                 // set +/- infinity
+          } // an infinity
+        break;
+        }
+
+      // Quick exit for add 0s; return the non-0, modified as need be
+      if (ISZERO(lhs)) {
+        Int adjust;                       // work
+        Int lexp=lhs->exponent;           // save in case LHS==RES
+        bits=lhs->bits;                   // ..
+        residue=0;                        // clear accumulator
+        decCopyFit(res, rhs, set, &residue, status); // copy (as needed)
+        res->bits^=negate;                // flip if rhs was negated
+        #if DECSUBSET
+        if (set->extended) {              // exponents on zeros count
+        #endif
+          // exponent will be the lower of the two
+          adjust=lexp-res->exponent;      // adjustment needed [if -ve]
+          if (ISZERO(res)) {              // both 0: special IEEE 754 rules
+            if (adjust<0) res->exponent=lexp;  // set exponent
+            // 0-0 gives +0 unless rounding to -infinity, and -0-0 gives -0
+            if (diffsign) {
+              if (set->round!=DEC_ROUND_FLOOR) res->bits=0;
+               else res->bits=DECNEG;     // preserve 0 sign
+              }
+            }
+           else { // non-0 res
+            if (adjust<0) {     // 0-padding needed
+              if ((res->digits-adjust)>set->digits) {
+                adjust=res->digits-set->digits;     // to fit exactly
+                *status|=DEC_Rounded;               // [but exact]
+                }
+              res->digits=decShiftToMost(res->lsu, res->digits, -adjust);
+              res->exponent+=adjust;                // set the exponent.
+              }
+            } // non-0 res
+        #if DECSUBSET
+          } // extended
+        #endif
+        decFinish(res, set, &residue, status);      // clean and finalize
+        break;}
+
+      if (ISZERO(rhs)) {                  // [lhs is non-zero]
+        Int adjust;                       // work
+        Int rexp=rhs->exponent;           // save in case RHS==RES
+        bits=rhs->bits;                   // be clean
+        residue=0;                        // clear accumulator
+        decCopyFit(res, lhs, set, &residue, status); // copy (as needed)
+        #if DECSUBSET
+        if (set->extended) {              // exponents on zeros count
+        #endif
+          // exponent will be the lower of the two
+          // [0-0 case handled above]
+          adjust=rexp-res->exponent;      // adjustment needed [if -ve]
           if (adjust<0) {     // 0-padding needed
             if ((res->digits-adjust)>set->digits) {
               adjust=res->digits-set->digits;     // to fit exactly
@@ -3895,38 +4367,12 @@ static decNumber * decAddOp(decNumber *res, const decNumber *lhs,
             res->digits=decShiftToMost(res->lsu, res->digits, -adjust);
             res->exponent+=adjust;                // set the exponent.
             }
-          } // non-0 res
-      #if DECSUBSET
-        } // extended
-      #endif
-      decFinish(res, set, &residue, status);      // clean and finalize
-      break;}
-
-    if (ISZERO(rhs)) {                  // [lhs is non-zero]
-      Int adjust;                       // work
-      Int rexp=rhs->exponent;           // save in case RHS==RES
-      bits=rhs->bits;                   // be clean
-      residue=0;                        // clear accumulator
-      decCopyFit(res, lhs, set, &residue, status); // copy (as needed)
-      #if DECSUBSET
-      if (set->extended) {              // exponents on zeros count
-      #endif
-        // exponent will be the lower of the two
-        // [0-0 case handled above]
-        adjust=rexp-res->exponent;      // adjustment needed [if -ve]
-        if (adjust<0) {     // 0-padding needed
-          if ((res->digits-adjust)>set->digits) {
-            adjust=res->digits-set->digits;     // to fit exactly
-            *status|=DEC_Rounded;               // [but exact]
-            }
-          res->digits=decShiftToMost(res->lsu, res->digits, -adjust);
-          res->exponent+=adjust;                // set the exponent.
-          }
-      #if DECSUBSET
-        } // extended
-      #endif
-      decFinish(res, set, &residue, status);      // clean and finalize
-      break;}
+        #if DECSUBSET
+          } // extended
+        #endif
+        decFinish(res, set, &residue, status);      // clean and finalize
+        break;}
+      } // odd operands
 
     // [NB: both fastpath and mainpath code below assume these cases
     // (notably 0-0) have already been handled]
@@ -3968,6 +4414,156 @@ static decNumber * decAddOp(decNumber *res, const decNumber *lhs,
         }
       }
 
+    #if DECSTATS
+    decNumberStats.addOps++;
+    #endif
+
+    // Fastpath for aligned operands (as is usual for currency and
+    // other fixed-scale data) where the result cannot need rounding:
+    // for addition when both are shorter than DIGITS (so a carry into
+    // a new Unit must fit), and for subtraction (which cannot
+    // lengthen) when both fit in DIGITS.  Units are added directly
+    // into the result, which is safe even if it is an operand as each
+    // Unit is read before it is written.  For subtraction the smaller
+    // magnitude is taken from the larger, so there is never a borrow
+    // out of the top Unit.
+    if (padding==0
+     #if DECSUBSET
+     && set->extended
+     #endif
+     && (diffsign ? lhs->digits<=reqdigits && rhs->digits<=reqdigits
+                  : lhs->digits<reqdigits && rhs->digits<reqdigits)) {
+      const Unit *ap=lhs->lsu, *bp=rhs->lsu; // longer/larger and other
+      Int   aunits=D2U(lhs->digits);    // their lengths in Units
+      Int   bunits=D2U(rhs->digits);    // ..
+      Int   exponent=lhs->exponent;     // result exponent
+      Int   m=1;                        // +1 to add, -1 to subtract
+      Int   carry=0;                    // carry or borrow (-1)
+      Int   i;                          // work
+      bits=lhs->bits;                   // assume sign is that of LHS
+      if (diffsign) {
+        m=-1;
+        if (decUnitCompare(ap, aunits, bp, bunits, 0, set)<0) {
+          ap=rhs->lsu; bp=lhs->lsu;     // swap
+          aunits=bunits; bunits=D2U(lhs->digits);
+          bits=(uByte)(rhs->bits^negate); // sign is now that of RHS
+          }
+        }
+       else if (aunits<bunits) {        // RHS is longer
+        ap=rhs->lsu; bp=lhs->lsu;
+        aunits=bunits; bunits=D2U(lhs->digits);
+        }
+      #if DECSTATS
+      decNumberStats.addAlign++;
+      #endif
+
+      for (i=0; i<bunits; i++) {        // both contribute
+        carry+=ap[i]+m*bp[i];
+        if (carry>DECDPUNMAX) {
+          res->lsu[i]=(Unit)(carry-(DECDPUNMAX+1));
+          carry=1;
+          }
+         else if (carry<0) {
+          res->lsu[i]=(Unit)(carry+(DECDPUNMAX+1));
+          carry=-1;
+          }
+         else {
+          res->lsu[i]=(Unit)carry;
+          carry=0;
+          }
+        }
+      for (; i<aunits; i++) {           // only the longer contributes
+        carry+=ap[i];
+        if (carry>DECDPUNMAX) {
+          res->lsu[i]=0;                // [must have been 999...]
+          carry=1;
+          }
+         else if (carry<0) {
+          res->lsu[i]=DECDPUNMAX;       // [must have been 000...]
+          carry=-1;
+          }
+         else {
+          res->lsu[i]=(Unit)carry;
+          carry=0;
+          }
+        }
+      if (carry>0) res->lsu[i++]=1;     // carry into new Unit
+
+      res->bits=(uByte)(bits&DECNEG);
+      res->exponent=exponent;
+      res->digits=decGetDigits(res->lsu, i);
+      residue=0;
+      decFinish(res, set, &residue, status);
+      // exact zero sign, as below
+      if (ISZERO(res) && diffsign && (*status&DEC_Inexact)==0) {
+        if (set->round==DEC_ROUND_FLOOR) res->bits|=DECNEG;   // sign -
+                                    else res->bits&=~DECNEG;  // sign +
+        }
+      break;
+      }
+
+    #if FASTADD
+    // Fastpath for operands which fit the context and which, once
+    // aligned, have no more than 38 digits: the exact result is
+    // calculated in a uLLong and then rounded as in the general
+    // case below.  The operand with the lower exponent is not padded
+    // and (as below) gives the sign unless the result is negative.
+    if (lhs->digits<=reqdigits && rhs->digits<=reqdigits
+     #if DECSUBSET
+     && set->extended
+     #endif
+     && lhs->digits<=38 && rhs->digits<=38
+     && (padding>=0 ? rhs->digits+padding : lhs->digits-padding)<=38) {
+      Unit   acc128[D2U(39)];           // exact result
+      uLLong a, b;                      // unpadded and padded operands
+      Int    exponent;                  // result exponent
+      Int    units;                     // Units in acc128
+      if (padding>=0) {
+        a=decGetULLong(lhs);
+        b=decGetULLong(rhs);
+        if (padding>0) b*=decPow10ULLong(padding);
+        bits=lhs->bits;
+        exponent=lhs->exponent;
+        }
+       else {
+        a=decGetULLong(rhs);
+        b=decGetULLong(lhs)*decPow10ULLong(-padding);
+        bits=(uByte)(rhs->bits^negate);
+        exponent=rhs->exponent;
+        }
+      if (!diffsign) a+=b;              // [<2*10**38, so cannot wrap]
+       else if (a>=b) a-=b;
+       else {
+        a=b-a;
+        bits^=DECNEG;                   // flip the sign
+        }
+      #if DECSTATS
+      decNumberStats.add128++;
+      #endif
+
+      res->bits=(uByte)(bits&DECNEG);   // operands no longer needed
+      res->exponent=exponent;
+      residue=0;
+      if (reqdigits<=38 && a<decPow10ULLong(reqdigits)) {
+        // fits, so no rounding is needed: lay out directly in res
+        units=decULLongToUnits(a, res->lsu);
+        res->digits=decGetDigits(res->lsu, units);
+        }
+       else {
+        units=decULLongToUnits(a, acc128);
+        res->digits=decGetDigits(acc128, units);
+        decSetCoeff(res, set, acc128, res->digits, &residue, status);
+        }
+      decFinish(res, set, &residue, status);
+      // exact zero sign, as below
+      if (ISZERO(res) && diffsign && (*status&DEC_Inexact)==0) {
+        if (set->round==DEC_ROUND_FLOOR) res->bits|=DECNEG;   // sign -
+                                    else res->bits&=~DECNEG;  // sign +
+        }
+      break;
+      }
+    #endif
+
     // Now align (pad) the lhs or rhs so they can be added or
     // subtracted, as necessary.  If one number is much larger than
     // the other (that is, if in plain form there is a least one
@@ -4039,7 +4635,7 @@ static decNumber * decAddOp(decNumber *res, const decNumber *lhs,
       acc=accbuff;                      // assume use local buffer
       if (need*sizeof(Unit)>sizeof(accbuff)) {
         // printf("malloc add %ld %ld\n", need, sizeof(accbuff));
-        allocacc=(Unit *)malloc(need*sizeof(Unit));
+        allocacc=(Unit *)decAlloc(set, need*sizeof(Unit));
         if (allocacc==NULL) {           // hopeless -- abandon
           *status|=DEC_Insufficient_storage;
           break;}
@@ -4134,10 +4730,10 @@ static decNumber * decAddOp(decNumber *res, const decNumber *lhs,
       }
     } while(0);                              // end protected
 
-  if (allocacc!=NULL) free(allocacc);        // drop any storage used
+  if (allocacc!=NULL) decRelease(set, allocacc); // drop any storage used
   #if DECSUBSET
-  if (allocrhs!=NULL) free(allocrhs);        // ..
-  if (alloclhs!=NULL) free(alloclhs);        // ..
+  if (allocrhs!=NULL) decRelease(set, allocrhs); // ..
+  if (alloclhs!=NULL) decRelease(set, alloclhs); // ..
   #endif
   return res;
   } // decAddOp
@@ -4250,7 +4846,6 @@ static decNumber * decDivideOp(decNumber *res,
   uByte bits;                      // working sign
   Unit  *target;                   // work
   const Unit *source;              // ..
-  uInt  const *pow;                // ..
   Int   shift, cut;                // ..
   #if DECSUBSET
   Int   dropped;                   // work
@@ -4261,107 +4856,111 @@ static decNumber * decDivideOp(decNumber *res,
   #endif
 
   do {                             // protect allocated storage
-    #if DECSUBSET
-    if (!set->extended) {
-      // reduce operands and set lostDigits status, as needed
-      if (lhs->digits>reqdigits) {
-        alloclhs=decRoundOperand(lhs, set, status);
-        if (alloclhs==NULL) break;
-        lhs=alloclhs;
-        }
-      if (rhs->digits>reqdigits) {
-        allocrhs=decRoundOperand(rhs, set, status);
-        if (allocrhs==NULL) break;
-        rhs=allocrhs;
-        }
-      }
-    #endif
-    // [following code does not require input rounding]
-
     bits=(lhs->bits^rhs->bits)&DECNEG;  // assumed sign for divisions
 
-    // handle infinities and NaNs
-    if (SPECIALARGS) {                  // a special bit set
-      if (SPECIALARGS & (DECSNAN | DECNAN)) { // one or two NaNs
-        decNaNs(res, lhs, rhs, set, status);
-        break;
-        }
-      // one or two infinities
-      if (decNumberIsInfinite(lhs)) {   // LHS (dividend) is infinite
-        if (decNumberIsInfinite(rhs) || // two infinities are invalid ..
-            op & (REMAINDER | REMNEAR)) { // as is remainder of infinity
-          *status|=DEC_Invalid_operation;
-          break;
+    // one test passes finite, non-zero operands which need no
+    // rounding straight to the division
+    if (ODDARGS(set)) {
+      #if DECSUBSET
+      if (!set->extended) {
+        // reduce operands and set lostDigits status, as needed
+        if (lhs->digits>reqdigits) {
+          alloclhs=decRoundOperand(lhs, set, status);
+          if (alloclhs==NULL) break;
+          lhs=alloclhs;
+          }
+        if (rhs->digits>reqdigits) {
+          allocrhs=decRoundOperand(rhs, set, status);
+          if (allocrhs==NULL) break;
+          rhs=allocrhs;
           }
-        // [Note that infinity/0 raises no exceptions]
-        decNumberZero(res);
-        res->bits=bits|DECINF;          // set +/- infinity
-        break;
         }
-       else {                           // RHS (divisor) is infinite
-        residue=0;
-        if (op&(REMAINDER|REMNEAR)) {
-          // result is [finished clone of] lhs
-          decCopyFit(res, lhs, set, &residue, status);
+      #endif
+      // [following code does not require input rounding]
+
+      // handle infinities and NaNs
+      if (SPECIALARGS) {                  // a special bit set
+        if (SPECIALARGS & (DECSNAN | DECNAN)) { // one or two NaNs
+          decNaNs(res, lhs, rhs, set, status);
+          break;
           }
-         else {  // a division
+        // one or two infinities
+        if (decNumberIsInfinite(lhs)) {   // LHS (dividend) is infinite
+          if (decNumberIsInfinite(rhs) || // two infinities are invalid ..
+              op & (REMAINDER | REMNEAR)) { // as is remainder of infinity
+            *status|=DEC_Invalid_operation;
+            break;
+            }
+          // [Note that infinity/0 raises no exceptions]
           decNumberZero(res);
-          res->bits=bits;               // set +/- zero
-          // for DIVIDEINT the exponent is always 0.  For DIVIDE, result
-          // is a 0 with infinitely negative exponent, clamped to minimum
-          if (op&DIVIDE) {
-            res->exponent=set->emin-set->digits+1;
-            *status|=DEC_Clamped;
+          res->bits=bits|DECINF;          // set +/- infinity
+          break;
+          }
+         else {                           // RHS (divisor) is infinite
+          residue=0;
+          if (op&(REMAINDER|REMNEAR)) {
+            // result is [finished clone of] lhs
+            decCopyFit(res, lhs, set, &residue, status);
             }
+           else {  // a division
+            decNumberZero(res);
+            res->bits=bits;               // set +/- zero
+            // for DIVIDEINT the exponent is always 0.  For DIVIDE, result
+            // is a 0 with infinitely negative exponent, clamped to minimum
+            if (op&DIVIDE) {
+              res->exponent=set->emin-set->digits+1;
+              *status|=DEC_Clamped;
+              }
+            }
+          decFinish(res, set, &residue, status);
+          break;
           }
-        decFinish(res, set, &residue, status);
-        break;
         }
-      }
 
-    // handle 0 rhs (x/0)
-    if (ISZERO(rhs)) {                  // x/0 is always exceptional
-      if (ISZERO(lhs)) {
-        decNumberZero(res);             // [after lhs test]
-        *status|=DEC_Division_undefined;// 0/0 will become NaN
-        }
-       else {
-        decNumberZero(res);
-        if (op&(REMAINDER|REMNEAR)) *status|=DEC_Invalid_operation;
+      // handle 0 rhs (x/0)
+      if (ISZERO(rhs)) {                  // x/0 is always exceptional
+        if (ISZERO(lhs)) {
+          decNumberZero(res);             // [after lhs test]
+          *status|=DEC_Division_undefined;// 0/0 will become NaN
+          }
          else {
-          *status|=DEC_Division_by_zero; // x/0
-          res->bits=bits|DECINF;         // .. is +/- Infinity
+          decNumberZero(res);
+          if (op&(REMAINDER|REMNEAR)) *status|=DEC_Invalid_operation;
+           else {
+            *status|=DEC_Division_by_zero; // x/0
+            res->bits=bits|DECINF;         // .. is +/- Infinity
+            }
           }
-        }
-      break;}
+        break;}
 
-    // handle 0 lhs (0/x)
-    if (ISZERO(lhs)) {                  // 0/x [x!=0]
-      #if DECSUBSET
-      if (!set->extended) decNumberZero(res);
-       else {
-      #endif
-        if (op&DIVIDE) {
-          residue=0;
-          exponent=lhs->exponent-rhs->exponent; // ideal exponent
-          decNumberCopy(res, lhs);      // [zeros always fit]
-          res->bits=bits;               // sign as computed
-          res->exponent=exponent;       // exponent, too
-          decFinalize(res, set, &residue, status);   // check exponent
-          }
-         else if (op&DIVIDEINT) {
-          decNumberZero(res);           // integer 0
-          res->bits=bits;               // sign as computed
-          }
-         else {                         // a remainder
-          exponent=rhs->exponent;       // [save in case overwrite]
-          decNumberCopy(res, lhs);      // [zeros always fit]
-          if (exponent<res->exponent) res->exponent=exponent; // use lower
+      // handle 0 lhs (0/x)
+      if (ISZERO(lhs)) {                  // 0/x [x!=0]
+        #if DECSUBSET
+        if (!set->extended) decNumberZero(res);
+         else {
+        #endif
+          if (op&DIVIDE) {
+            residue=0;
+            exponent=lhs->exponent-rhs->exponent; // ideal exponent
+            decNumberCopy(res, lhs);      // [zeros always fit]
+            res->bits=bits;               // sign as computed
+            res->exponent=exponent;       // exponent, too
+            decFinalize(res, set, &residue, status);   // check exponent
+            }
+           else if (op&DIVIDEINT) {
+            decNumberZero(res);           // integer 0
+            res->bits=bits;               // sign as computed
+            }
+           else {                         // a remainder
+            exponent=rhs->exponent;       // [save in case overwrite]
+            decNumberCopy(res, lhs);      // [zeros always fit]
+            if (exponent<res->exponent) res->exponent=exponent; // use lower
+            }
+        #if DECSUBSET
           }
-      #if DECSUBSET
-        }
-      #endif
-      break;}
+        #endif
+        break;}
+      } // odd operands
 
     // Precalculate exponent.  This starts off adjusted (and hence fits
     // in 31 bits) and becomes the usual unadjusted exponent as the
@@ -4395,14 +4994,14 @@ static decNumber * decDivideOp(decNumber *res,
         }
       } // fastpaths
 
-    /* Long (slow) division is needed; roll up the sleeves... */
+    /* Long (slow) division is needed; roll up the sleeves...         */
 
     // The accumulator will hold the quotient of the division.
     // If it needs to be too long for stack storage, then allocate.
     acclength=D2U(reqdigits+DECDPUN);   // in Units
     if (acclength*sizeof(Unit)>sizeof(accbuff)) {
       // printf("malloc dvacc %ld units\n", acclength);
-      allocacc=(Unit *)malloc(acclength*sizeof(Unit));
+      allocacc=(Unit *)decAlloc(set, acclength*sizeof(Unit));
       if (allocacc==NULL) {             // hopeless -- abandon
         *status|=DEC_Insufficient_storage;
         break;}
@@ -4427,7 +5026,7 @@ static decNumber * decDivideOp(decNumber *res,
     if (!(op&DIVIDE)) var1units++;
     if ((var1units+1)*sizeof(Unit)>sizeof(varbuff)) {
       // printf("malloc dvvar %ld units\n", var1units+1);
-      varalloc=(Unit *)malloc((var1units+1)*sizeof(Unit));
+      varalloc=(Unit *)decAlloc(set, (var1units+1)*sizeof(Unit));
       if (varalloc==NULL) {             // hopeless -- abandon
         *status|=DEC_Insufficient_storage;
         break;}
@@ -4467,8 +5066,7 @@ static decNumber * decDivideOp(decNumber *res,
     // number of leading zeros in var1 msu and subtract those in var2 msu.
     // [This is actually done by counting the digits and negating, as
     // lead1=DECDPUN-digits1, and similarly for lead2.]
-    for (pow=&powers[1]; *msu1>=*pow; pow++) exponent--;
-    for (pow=&powers[1]; *msu2>=*pow; pow++) exponent++;
+    exponent-=UNITDIGITS(*msu1)-UNITDIGITS(*msu2);
 
     // Now, if doing an integer divide or remainder, ensure that
     // the result will be Unit-aligned.  To do this, shift the var1
@@ -4570,10 +5168,7 @@ static decNumber * decDivideOp(decNumber *res,
       if (accunits!=0 || thisunit!=0) {      // is first or non-zero
         *accnext=thisunit;                   // store in accumulator
         // account exactly for the new digits
-        if (accunits==0) {
-          accdigits++;                       // at least one
-          for (pow=&powers[1]; thisunit>=*pow; pow++) accdigits++;
-          }
+        if (accunits==0) accdigits+=UNITDIGITS(thisunit);
          else accdigits+=DECDPUN;
         accunits++;                          // update count
         accnext--;                           // ready for next
@@ -4713,7 +5308,7 @@ static decNumber * decDivideOp(decNumber *res,
           // remainder's coefficient, which must now be compared to the
           // RHS.  The remainder's exponent may be smaller than the RHS's.
           compare=decUnitCompare(accnext, tarunits, rhs->lsu, D2U(rhs->digits),
-                                 rhs->exponent-exponent);
+                                 rhs->exponent-exponent, set);
           if (compare==BADINT) {             // deep trouble
             *status|=DEC_Insufficient_storage;
             break;}
@@ -4786,11 +5381,11 @@ static decNumber * decDivideOp(decNumber *res,
     #endif
     } while(0);                              // end protected
 
-  if (varalloc!=NULL) free(varalloc);   // drop any storage used
-  if (allocacc!=NULL) free(allocacc);   // ..
+  if (varalloc!=NULL) decRelease(set, varalloc); // drop any storage used
+  if (allocacc!=NULL) decRelease(set, allocacc); // ..
   #if DECSUBSET
-  if (allocrhs!=NULL) free(allocrhs);   // ..
-  if (alloclhs!=NULL) free(alloclhs);   // ..
+  if (allocrhs!=NULL) decRelease(set, allocrhs); // ..
+  if (alloclhs!=NULL) decRelease(set, alloclhs); // ..
   #endif
   return res;
   } // decDivideOp
@@ -4831,7 +5426,7 @@ static decNumber * decDivideOp(decNumber *res,
 /* Static buffers are larger than needed just for multiply, to allow  */
 /* for calls from other operations (notably exp).                     */
 /* ------------------------------------------------------------------ */
-#define FASTMUL (DECUSE64 && DECDPUN<5)
+#define FASTMUL (DECUSE64 && (DECDPUN<5 || DECDPUN==9))
 static decNumber * decMultiplyOp(decNumber *res, const decNumber *lhs,
                                  const decNumber *rhs, decContext *set,
                                  uInt *status) {
@@ -4847,9 +5442,12 @@ static decNumber * decMultiplyOp(decNumber *res, const decNumber *lhs,
   const Unit *mer, *mermsup;       // work
   Int   madlength;                 // Units in multiplicand
   Int   shift;                     // Units to shift multiplicand by
+  #if DECUSE128 && FASTMUL
+  Unit  acc128[D2U(39)];           // accumulator for 128-bit fastpath
+  #endif
 
   #if FASTMUL
-    // if DECDPUN is 1 or 3 work in base 10**9, otherwise
+    // if DECDPUN is 1, 3, or 9 work in base 10**9, otherwise
     // (DECDPUN is 2 or 4) then work in base 10**8
     #if DECDPUN & 1                // odd
       #define FASTBASE 1000000000  // base
@@ -4862,7 +5460,8 @@ static decNumber * decMultiplyOp(decNumber *res, const decNumber *lhs,
     #endif
     // three buffers are used, two for chunked copies of the operands
     // (base 10**8 or base 10**9) and one base 2**64 accumulator with
-    // lazy carry evaluation
+    // lazy carry evaluation [when DECDPUN is 9 the operand Units are
+    // already base 10**9 items, so are used in place]
     uInt   zlhibuff[(DECBUFFER*2+1)/8+1]; // buffer (+1 for DECBUFFER==0)
     uInt  *zlhi=zlhibuff;                 // -> lhs array
     uInt  *alloclhi=NULL;                 // -> allocated buffer, iff allocated
@@ -4881,8 +5480,10 @@ static decNumber * decMultiplyOp(decNumber *res, const decNumber *lhs,
     Int    lazy;                   // lazy carry counter
     uLong  lcarry;                 // uLong carry
     uInt   carry;                  // carry (NB not uLong)
+    #if DECDPUN!=FASTDIGS
     Int    count;                  // work
     const  Unit *cup;              // ..
+    #endif
     Unit  *up;                     // ..
     uLong *lp;                     // ..
     Int    p;                      // ..
@@ -4900,19 +5501,41 @@ static decNumber * decMultiplyOp(decNumber *res, const decNumber *lhs,
   // precalculate result sign
   bits=(uByte)((lhs->bits^rhs->bits)&DECNEG);
 
-  // handle infinities and NaNs
-  if (SPECIALARGS) {               // a special bit set
-    if (SPECIALARGS & (DECSNAN | DECNAN)) { // one or two NaNs
-      decNaNs(res, lhs, rhs, set, status);
+  // one test passes finite, non-zero operands which need no
+  // rounding straight to the multiplication
+  if (ODDARGS(set)) {
+    // handle infinities and NaNs
+    if (SPECIALARGS) {             // a special bit set
+      if (SPECIALARGS & (DECSNAN | DECNAN)) { // one or two NaNs
+        decNaNs(res, lhs, rhs, set, status);
+        return res;}
+      // one or two infinities; Infinity * 0 is invalid
+      if (((lhs->bits & DECINF)==0 && ISZERO(lhs))
+        ||((rhs->bits & DECINF)==0 && ISZERO(rhs))) {
+        *status|=DEC_Invalid_operation;
+        return res;}
+      decNumberZero(res);
+      res->bits=bits|DECINF;       // infinity
       return res;}
-    // one or two infinities; Infinity * 0 is invalid
-    if (((lhs->bits & DECINF)==0 && ISZERO(lhs))
-      ||((rhs->bits & DECINF)==0 && ISZERO(rhs))) {
-      *status|=DEC_Invalid_operation;
+
+    // Quick exit for a 0 operand, unless the other must be rounded
+    // first: the product is a 0 with the sum of the exponents [as
+    // the main path would give, including the wrap check there]
+    if ((ISZERO(lhs) || ISZERO(rhs))
+     #if DECSUBSET
+     && (set->extended
+      || (lhs->digits<=set->digits && rhs->digits<=set->digits))
+     #endif
+     ) {
+      exponent=lhs->exponent+rhs->exponent;
+      if (lhs->exponent<0 && rhs->exponent<0 && exponent>0)
+        exponent=-2*DECNUMMAXE;    // force underflow
+      decNumberZero(res);          // OK to overwrite now
+      res->bits=bits;              // set sign
+      res->exponent=exponent;
+      decFinish(res, set, &residue, status);
       return res;}
-    decNumberZero(res);
-    res->bits=bits|DECINF;         // infinity
-    return res;}
+    } // odd operands
 
   // For best speed, as in DMSRCN [the original Rexx numerics
   // module], use the shorter number as the multiplier (rhs) and
@@ -4942,6 +5565,22 @@ static decNumber * decMultiplyOp(decNumber *res, const decNumber *lhs,
     #endif
     // [following code does not require input rounding]
 
+    #if DECSTATS
+    decNumberStats.mulOps++;
+    #endif
+    #if DECUSE128 && FASTMUL
+    // if both coefficients fit in a uLong (19 digits) the exact
+    // product fits in a uLLong and needs just one multiply
+    if (lhs->digits<=19) {         // [lhs is the longer]
+      acc=acc128;
+      accunits=decULLongToUnits(decGetULLong(lhs)
+                                *decGetULLong(rhs), acc);
+      #if DECSTATS
+      decNumberStats.mul128++;
+      #endif
+      }
+     else
+    #endif
     #if FASTMUL                    // fastpath can be used
     // use the fast path if there are enough digits in the shorter
     // operand to make the setup and takedown worthwhile
@@ -4953,14 +5592,19 @@ static decNumber * decMultiplyOp(decNumber *res, const decNumber *lhs,
       iacc=ilhs+irhs;
 
       // allocate buffers if required, as usual
+      #if DECDPUN==FASTDIGS
+      zlhi=(uInt *)lhs->lsu;       // [read only]
+      zrhi=(uInt *)rhs->lsu;       // ..
+      #else
       needbytes=ilhs*sizeof(uInt);
       if (needbytes>(Int)sizeof(zlhibuff)) {
-        alloclhi=(uInt *)malloc(needbytes);
+        alloclhi=(uInt *)decAlloc(set, needbytes);
         zlhi=alloclhi;}
       needbytes=irhs*sizeof(uInt);
       if (needbytes>(Int)sizeof(zrhibuff)) {
-        allocrhi=(uInt *)malloc(needbytes);
+        allocrhi=(uInt *)decAlloc(set, needbytes);
         zrhi=allocrhi;}
+      #endif
 
       // Allocating the accumulator space needs a special case when
       // DECDPUN=1 because when converting the accumulator to Units
@@ -4975,7 +5619,7 @@ static decNumber * decMultiplyOp(decNumber *res, const decNumber *lhs,
       needbytes+=zoff*8;
       #endif
       if (needbytes>(Int)sizeof(zaccbuff)) {
-        allocacc=(uLong *)malloc(needbytes);
+        allocacc=(uLong *)decAlloc(set, needbytes);
         zacc=(uLong *)allocacc;}
       if (zlhi==NULL||zrhi==NULL||zacc==NULL) {
         *status|=DEC_Insufficient_storage;
@@ -4987,6 +5631,10 @@ static decNumber * decMultiplyOp(decNumber *res, const decNumber *lhs,
       #endif
 
       // assemble the chunked copies of the left and right sides
+      #if DECDPUN==FASTDIGS
+      lmsi=zlhi+ilhs-1;  // -> msi
+      rmsi=zrhi+irhs-1;  // ..
+      #else
       for (count=lhs->digits, cup=lhs->lsu, lip=zlhi; count>0; lip++)
         for (p=0, *lip=0; p<FASTDIGS && count>0;
              p+=DECDPUN, cup++, count-=DECDPUN)
@@ -4997,6 +5645,7 @@ static decNumber * decMultiplyOp(decNumber *res, const decNumber *lhs,
              p+=DECDPUN, cup++, count-=DECDPUN)
           *rip+=*cup*powers[p];
       rmsi=rip-1;     // save -> msi
+      #endif
 
       // zero the accumulator
       for (lp=zacc; lp<zacc+iacc; lp++) *lp=0;
@@ -5071,7 +5720,7 @@ static decNumber * decMultiplyOp(decNumber *res, const decNumber *lhs,
       acc=accbuff;                 // -> assume buffer for accumulator
       needbytes=(D2U(lhs->digits)+D2U(rhs->digits))*sizeof(Unit);
       if (needbytes>(Int)sizeof(accbuff)) {
-        allocacc=(Unit *)malloc(needbytes);
+        allocacc=(Unit *)decAlloc(set, needbytes);
         if (allocacc==NULL) {*status|=DEC_Insufficient_storage; break;}
         acc=(Unit *)allocacc;                // use the allocated space
         }
@@ -5131,14 +5780,14 @@ static decNumber * decMultiplyOp(decNumber *res, const decNumber *lhs,
     decFinish(res, set, &residue, status);   // final cleanup
     } while(0);                         // end protected
 
-  if (allocacc!=NULL) free(allocacc);   // drop any storage used
+  if (allocacc!=NULL) decRelease(set, allocacc); // drop any storage used
   #if DECSUBSET
-  if (allocrhs!=NULL) free(allocrhs);   // ..
-  if (alloclhs!=NULL) free(alloclhs);   // ..
+  if (allocrhs!=NULL) decRelease(set, allocrhs); // ..
+  if (alloclhs!=NULL) decRelease(set, alloclhs); // ..
   #endif
   #if FASTMUL
-  if (allocrhi!=NULL) free(allocrhi);   // ..
-  if (alloclhi!=NULL) free(alloclhi);   // ..
+  if (allocrhi!=NULL) decRelease(set, allocrhi); // ..
+  if (alloclhi!=NULL) decRelease(set, alloclhi); // ..
   #endif
   return res;
   } // decMultiplyOp
@@ -5295,7 +5944,7 @@ decNumber * decExpOp(decNumber *res, const decNumber *rhs,
     *d->lsu=4;                          // set 4 ..
     d->exponent=-set->digits;           // * 10**(-d)
     if (decNumberIsNegative(rhs)) d->exponent--;  // negative case
-    comp=decCompare(d, rhs, 1);         // signless compare
+    comp=decCompare(d, rhs, 1, set);    // signless compare
     if (comp==BADINT) {
       *status|=DEC_Insufficient_storage;
       break;}
@@ -5311,6 +5960,7 @@ decNumber * decExpOp(decNumber *res, const decNumber *rhs,
     // set up the context to be used for calculating a, as this is
     // used on both paths below
     decContextDefault(&aset, DEC_INIT_DECIMAL64);
+    aset.allocator=set->allocator;      // same working storage
     // accumulator bounds are as requested (could underflow)
     aset.emax=set->emax;                // usual bounds
     aset.emin=set->emin;                // ..
@@ -5358,7 +6008,7 @@ decNumber * decExpOp(decNumber *res, const decNumber *rhs,
         decNumber *newrhs=bufr;         // assume will fit on stack
         needbytes=sizeof(decNumber)+(D2U(rhs->digits)-1)*sizeof(Unit);
         if (needbytes>sizeof(bufr)) {   // need malloc space
-          allocrhs=(decNumber *)malloc(needbytes);
+          allocrhs=(decNumber *)decAlloc(set, needbytes);
           if (allocrhs==NULL) {         // hopeless -- abandon
             *status|=DEC_Insufficient_storage;
             break;}
@@ -5390,7 +6040,7 @@ decNumber * decExpOp(decNumber *res, const decNumber *rhs,
       // sufficiently exact.
       needbytes=sizeof(decNumber)+(D2U(p*2)-1)*sizeof(Unit);
       if (needbytes>sizeof(bufa)) {     // need malloc space
-        allocbufa=(decNumber *)malloc(needbytes);
+        allocbufa=(decNumber *)decAlloc(set, needbytes);
         if (allocbufa==NULL) {          // hopeless -- abandon
           *status|=DEC_Insufficient_storage;
           break;}
@@ -5402,7 +6052,7 @@ decNumber * decExpOp(decNumber *res, const decNumber *rhs,
       // calculation below, which needs an extra two digits
       needbytes=sizeof(decNumber)+(D2U(p+2)-1)*sizeof(Unit);
       if (needbytes>sizeof(buft)) {     // need malloc space
-        allocbuft=(decNumber *)malloc(needbytes);
+        allocbuft=(decNumber *)decAlloc(set, needbytes);
         if (allocbuft==NULL) {          // hopeless -- abandon
           *status|=DEC_Insufficient_storage;
           break;}
@@ -5416,6 +6066,7 @@ decNumber * decExpOp(decNumber *res, const decNumber *rhs,
 
       // set up the contexts for calculating a, t, and d
       decContextDefault(&tset, DEC_INIT_DECIMAL64);
+      tset.allocator=set->allocator;    // same working storage
       dset=tset;
       // accumulator bounds are set above, set precision now
       aset.digits=p*2;                  // double
@@ -5487,9 +6138,9 @@ decNumber * decExpOp(decNumber *res, const decNumber *rhs,
     decFinish(res, set, &residue, status);       // cleanup/set flags
     } while(0);                         // end protected
 
-  if (allocrhs !=NULL) free(allocrhs);  // drop any storage used
-  if (allocbufa!=NULL) free(allocbufa); // ..
-  if (allocbuft!=NULL) free(allocbuft); // ..
+  if (allocrhs !=NULL) decRelease(set, allocrhs); // drop any storage used
+  if (allocbufa!=NULL) decRelease(set, allocbufa); // ..
+  if (allocbuft!=NULL) decRelease(set, allocbuft); // ..
   // [status is handled by caller]
   return res;
   } // decExpOp
@@ -5667,7 +6318,7 @@ decNumber * decLnOp(decNumber *res, const decNumber *rhs,
     // estimate.
     needbytes=sizeof(decNumber)+(D2U(MAXI(p,16))-1)*sizeof(Unit);
     if (needbytes>sizeof(bufa)) {     // need malloc space
-      allocbufa=(decNumber *)malloc(needbytes);
+      allocbufa=(decNumber *)decAlloc(set, needbytes);
       if (allocbufa==NULL) {          // hopeless -- abandon
         *status|=DEC_Insufficient_storage;
         break;}
@@ -5676,7 +6327,7 @@ decNumber * decLnOp(decNumber *res, const decNumber *rhs,
     pp=p+rhs->digits;
     needbytes=sizeof(decNumber)+(D2U(MAXI(pp,16))-1)*sizeof(Unit);
     if (needbytes>sizeof(bufb)) {     // need malloc space
-      allocbufb=(decNumber *)malloc(needbytes);
+      allocbufb=(decNumber *)decAlloc(set, needbytes);
       if (allocbufb==NULL) {          // hopeless -- abandon
         *status|=DEC_Insufficient_storage;
         break;}
@@ -5693,6 +6344,7 @@ decNumber * decLnOp(decNumber *res, const decNumber *rhs,
     // truncated.
 
     decContextDefault(&aset, DEC_INIT_DECIMAL64); // 16-digit extended
+    aset.allocator=set->allocator;      // same working storage
     r=rhs->exponent+rhs->digits;        // 'normalised' exponent
     decNumberFromInt32(a, r);           // a=r
     decNumberFromInt32(b, 2302585);     // b=ln(10) (2.302585)
@@ -5798,8 +6450,8 @@ decNumber * decLnOp(decNumber *res, const decNumber *rhs,
     decFinish(res, set, &residue, status);       // cleanup/set flags
     } while(0);                         // end protected
 
-  if (allocbufa!=NULL) free(allocbufa); // drop any storage used
-  if (allocbufb!=NULL) free(allocbufb); // ..
+  if (allocbufa!=NULL) decRelease(set, allocbufa); // drop any storage used
+  if (allocbufb!=NULL) decRelease(set, allocbufb); // ..
   // [status is handled by caller]
   return res;
   } // decLnOp
@@ -5963,8 +6615,8 @@ static decNumber * decQuantizeOp(decNumber *res, const decNumber *lhs,
     } while(0);                         // end protected
 
   #if DECSUBSET
-  if (allocrhs!=NULL) free(allocrhs);   // drop any storage used
-  if (alloclhs!=NULL) free(alloclhs);   // ..
+  if (allocrhs!=NULL) decRelease(set, allocrhs); // drop any storage used
+  if (alloclhs!=NULL) decRelease(set, alloclhs); // ..
   #endif
   return res;
   } // decQuantizeOp
@@ -6061,7 +6713,7 @@ decNumber * decCompareOp(decNumber *res, const decNumber *lhs,
          else { // both NaN or both sNaN
           // now it just depends on the payload
           result=decUnitCompare(lhs->lsu, D2U(lhs->digits),
-                                rhs->lsu, D2U(rhs->digits), 0);
+                                rhs->lsu, D2U(rhs->digits), 0, set);
           // [Error not possible, as these are 'aligned']
           } // both same NaNs
         if (decNumberIsNegative(lhs)) result=-result;
@@ -6084,8 +6736,8 @@ decNumber * decCompareOp(decNumber *res, const decNumber *lhs,
       break;
       }
     // have numbers
-    if (op==COMPMAXMAG || op==COMPMINMAG) result=decCompare(lhs, rhs, 1);
-     else result=decCompare(lhs, rhs, 0);    // sign matters
+    if (op==COMPMAXMAG || op==COMPMINMAG) result=decCompare(lhs, rhs, 1, set);
+     else result=decCompare(lhs, rhs, 0, set); // sign matters
     } while(0);                              // end protected
 
   if (result==BADINT) *status|=DEC_Insufficient_storage; // rare
@@ -6146,8 +6798,8 @@ decNumber * decCompareOp(decNumber *res, const decNumber *lhs,
       }
     }
   #if DECSUBSET
-  if (allocrhs!=NULL) free(allocrhs);   // free any storage used
-  if (alloclhs!=NULL) free(alloclhs);   // ..
+  if (allocrhs!=NULL) decRelease(set, allocrhs); // free any storage used
+  if (alloclhs!=NULL) decRelease(set, alloclhs); // ..
   #endif
   return res;
   } // decCompareOp
@@ -6160,12 +6812,13 @@ decNumber * decCompareOp(decNumber *res, const decNumber *lhs,
 /*  Arg1 is A, a decNumber which is not a NaN                         */
 /*  Arg2 is B, a decNumber which is not a NaN                         */
 /*  Arg3 is 1 for a sign-independent compare, 0 otherwise             */
+/*  Arg4 is the context, for the allocator of any working storage     */
 /*                                                                    */
 /*  returns -1, 0, or 1 for A<B, A==B, or A>B, or BADINT if failure   */
 /*  (the only possible failure is an allocation error)                */
 /* ------------------------------------------------------------------ */
 static Int decCompare(const decNumber *lhs, const decNumber *rhs,
-                      Flag abs) {
+                      Flag abs, const decContext *set) {
   Int   result;                    // result value
   Int   sigr;                      // rhs signum
   Int   compare;                   // work
@@ -6206,7 +6859,7 @@ static Int decCompare(const decNumber *lhs, const decNumber *rhs,
     }
   compare=decUnitCompare(lhs->lsu, D2U(lhs->digits),
                          rhs->lsu, D2U(rhs->digits),
-                         rhs->exponent-lhs->exponent);
+                         rhs->exponent-lhs->exponent, set);
   if (compare!=BADINT) compare*=result;      // comparison succeeded
   return compare;
   } // decCompare
@@ -6223,13 +6876,15 @@ static Int decCompare(const decNumber *lhs, const decNumber *rhs,
 /*  Arg3 is B first Unit (lsu)                                        */
 /*  Arg4 is B length in Units                                         */
 /*  Arg5 is E (0 if the units are aligned)                            */
+/*  Arg6 is the context, for the allocator of any working storage     */
 /*                                                                    */
 /*  returns -1, 0, or 1 for A<B, A==B, or A>B, or BADINT if failure   */
 /*  (the only possible failure is an allocation error, which can      */
 /*  only occur if E!=0)                                               */
 /* ------------------------------------------------------------------ */
 static Int decUnitCompare(const Unit *a, Int alength,
-                          const Unit *b, Int blength, Int exp) {
+                          const Unit *b, Int blength, Int exp,
+                          const decContext *set) {
   Unit  *acc;                      // accumulator for result
   Unit  accbuff[SD2U(DECBUFFER*2+1)]; // local buffer
   Unit  *allocacc=NULL;            // -> allocated acc buffer, iff allocated
@@ -6263,7 +6918,7 @@ static Int decUnitCompare(const Unit *a, Int alength,
   need+=2;
   acc=accbuff;                          // assume use local buffer
   if (need*sizeof(Unit)>sizeof(accbuff)) {
-    allocacc=(Unit *)malloc(need*sizeof(Unit));
+    allocacc=(Unit *)decAlloc(set, need*sizeof(Unit));
     if (allocacc==NULL) return BADINT;  // hopeless -- abandon
     acc=allocacc;
     }
@@ -6281,10 +6936,91 @@ static Int decUnitCompare(const Unit *a, Int alength,
     result=(*u==0 ? 0 : +1);
     }
   // clean up and return the result
-  if (allocacc!=NULL) free(allocacc);   // drop any storage used
+  if (allocacc!=NULL) decRelease(set, allocacc); // drop any storage used
   return result;
   } // decUnitCompare
 
+#if SIMDADD
+/* ------------------------------------------------------------------ */
+/* decUnitSplitBlock -- split A+(B*M) into remainders and carries     */
+/*                                                                    */
+/*   r is the remainders array to set (n Ints)                        */
+/*   q is the carries array to set (n Ints)                           */
+/*   a is the first Unit of A                                         */
+/*   b is the first Unit of B                                         */
+/*   n is the number of Units in each of A and B (1-SIMDBLOCK)        */
+/*   m is the multiplier, as for decUnitAddSub, with |m| no more than */
+/*     DECDPUNMAX+1                                                   */
+/*                                                                    */
+/* For each Unit, A+(B*M) is biased by (DECDPUNMAX+1)**2 to make it   */
+/* positive, so that the quotient and remainder by DECDPUNMAX+1 can   */
+/* use unsigned division by a constant, which needs no branches.  The */
+/* bias is only enough (and the sum only fits) while |m| is at most   */
+/* DECDPUNMAX+1, so decUnitAddSub uses the scalar loop for any other  */
+/* multiplier.                                                        */
+/* There is no dependency between Units so the loop vectorizes; the   */
+/* target_clones attribute has GCC build SSE4.1 and AVX2 versions as  */
+/* well as the default, and the best is chosen when the program loads.*/
+/* ------------------------------------------------------------------ */
+#if DECSIMD
+__attribute__((target_clones("avx2", "sse4.1", "default"),
+               optimize("tree-vectorize", "vect-cost-model=dynamic")))
+static void decUnitSplitBlock(Int *__restrict__ r, Int *__restrict__ q,
+                              const Unit *__restrict__ a,
+                              const Unit *__restrict__ b, Int n, Int m) {
+#else
+static void decUnitSplitBlock(Int *r, Int *q, const Unit *a,
+                              const Unit *b, Int n, Int m) {
+#endif
+  Int i;                           // work
+  for (i=0; i<n; i++) {
+    uInt t=(uInt)((Int)a[i]+(Int)b[i]*m
+                  +(DECDPUNMAX+1)*(DECDPUNMAX+1));
+    uInt est=t/(DECDPUNMAX+1);
+    r[i]=(Int)(t-est*(DECDPUNMAX+1));
+    q[i]=(Int)est-(DECDPUNMAX+1);  // remove the bias
+    }
+  } // decUnitSplitBlock
+
+/* ------------------------------------------------------------------ */
+/* decUnitAddSubBlock -- C=A+(B*M) for equal-length Unit arrays       */
+/*                                                                    */
+/*   a is the first Unit of A                                         */
+/*   b is the first Unit of B                                         */
+/*   c is the first Unit of C; it may be the same array as A or B     */
+/*   n is the number of Units in each of A, B, and C (>0)             */
+/*   m is the multiplier, -(DECDPUNMAX+1) through DECDPUNMAX+1        */
+/*   carry is the carry into the first Unit                           */
+/*                                                                    */
+/*   returns the carry out of the last Unit                           */
+/*                                                                    */
+/* This is the vector kernel for decUnitAddSub.  Each block of Units  */
+/* is first split into remainders and carries (decUnitSplitBlock,     */
+/* which has no carry chain); then each remainder has the carry from  */
+/* the Unit below added, which can at most overflow (or underflow) by */
+/* one, so the only serial step is a one-Unit ripple with no divide.  */
+/* ------------------------------------------------------------------ */
+static eInt decUnitAddSubBlock(const Unit *a, const Unit *b, Unit *c,
+                               Int n, Int m, eInt carry) {
+  Int r[SIMDBLOCK], q[SIMDBLOCK];  // remainders and carries
+  Int i, len;                      // work
+  Int v;                           // ..
+
+  for (; n>0; n-=len, a+=len, b+=len, c+=len) {
+    len=n<SIMDBLOCK ? n : SIMDBLOCK;
+    decUnitSplitBlock(r, q, a, b, len, m);
+    for (i=0; i<len; i++) {
+      v=r[i]+(Int)carry;           // [carry is small]
+      carry=q[i];
+      if (v>DECDPUNMAX) {v-=DECDPUNMAX+1; carry++;}
+       else if (v<0) {v+=DECDPUNMAX+1; carry--;}
+      c[i]=(Unit)v;
+      }
+    }
+  return carry;
+  } // decUnitAddSubBlock
+#endif
+
 /* ------------------------------------------------------------------ */
 /* decUnitAddSub -- add or subtract two >=0 integers in Unit arrays   */
 /*                                                                    */
@@ -6343,6 +7079,8 @@ static Int decUnitAddSub(const Unit *a, Int alength,
   Int  add;                        // work
   #if DECDPUN<=4                   // myriadal, millenary, etc.
   Int  est;                        // estimated quotient
+  #elif DECDPUN==9
+  ueInt est;                       // quotient
   #endif
 
   #if DECTRACE
@@ -6374,6 +7112,16 @@ static Int decUnitAddSub(const Unit *a, Int alength,
   // and B contribute, and the second (if necessary) where only one or
   // other of the numbers contribute.
   // Carry handling is the same (i.e., duplicated) in each case.
+  #if SIMDADD
+  // long runs where both contribute use the vector kernel, if its
+  // bias allows the multiplier [decDivideOp's estimates need not be
+  // within -DECDPUNMAX through +DECDPUNMAX]
+  if (minC-c>=SIMDMIN && m<=DECDPUNMAX+1 && m>=-(DECDPUNMAX+1)) {
+    Int n=(Int)(minC-c);
+    carry=decUnitAddSubBlock(a, b, c, n, m, carry);
+    a+=n; b+=n; c+=n;
+    }
+  #endif
   for (; c<minC; c++) {
     carry+=*a;
     a++;
@@ -6434,6 +7182,25 @@ static Int decUnitAddSub(const Unit *a, Int alength,
       est=QUOT10(carry, DECDPUN);
       *c=(Unit)(carry-est*(DECDPUNMAX+1));
       carry=est-(DECDPUNMAX+1);              // correctly negative
+    #elif DECDPUN==9
+      // unsigned division by the constant 10**9 is a multiply and a
+      // shift; est is the quotient and *c the remainder
+      if ((ueInt)carry<(DECDPUNMAX+1)*2) {   // fastpath carry +1
+        *c=(Unit)(carry-(DECDPUNMAX+1));     // [helps additions]
+        carry=1;
+        continue;
+        }
+      if (carry>=0) {
+        est=(ueInt)carry/(DECDPUNMAX+1);
+        *c=(Unit)(carry-est*(DECDPUNMAX+1));
+        carry=est;
+        continue;
+        }
+      // negative case
+      carry=carry+(eInt)(DECDPUNMAX+1)*(DECDPUNMAX+1); // make positive
+      est=(ueInt)carry/(DECDPUNMAX+1);
+      *c=(Unit)(carry-est*(DECDPUNMAX+1));
+      carry=(eInt)est-(DECDPUNMAX+1);        // correctly negative
     #else
       // remainder operator is undefined if negative, so must test
       if ((ueInt)carry<(DECDPUNMAX+1)*2) {   // fastpath carry +1
@@ -6520,6 +7287,23 @@ static Int decUnitAddSub(const Unit *a, Int alength,
       est=QUOT10(carry, DECDPUN);
       *c=(Unit)(carry-est*(DECDPUNMAX+1));
       carry=est-(DECDPUNMAX+1);              // correctly negative
+    #elif DECDPUN==9
+      if ((ueInt)carry<(DECDPUNMAX+1)*2){    // fastpath carry 1
+        *c=(Unit)(carry-(DECDPUNMAX+1));
+        carry=1;
+        continue;
+        }
+      if (carry>=0) {
+        est=(ueInt)carry/(DECDPUNMAX+1);
+        *c=(Unit)(carry-est*(DECDPUNMAX+1));
+        carry=est;
+        continue;
+        }
+      // negative case
+      carry=carry+(eInt)(DECDPUNMAX+1)*(DECDPUNMAX+1); // make positive
+      est=(ueInt)carry/(DECDPUNMAX+1);
+      *c=(Unit)(carry-est*(DECDPUNMAX+1));
+      carry=(eInt)est-(DECDPUNMAX+1);        // correctly negative
     #else
       if ((ueInt)carry<(DECDPUNMAX+1)*2){    // fastpath carry 1
         *c=(Unit)(carry-(DECDPUNMAX+1));
@@ -6610,12 +7394,8 @@ static decNumber * decTrim(decNumber *dn, decContext *set, Flag all,
   up=dn->lsu;                      // -> current Unit
   for (d=0; d<dn->digits-1; d++) { // [don't strip the final digit]
     // slice by powers
-    #if DECDPUN<=4
-      uInt quot=QUOT10(*up, cut);
-      if ((*up-quot*powers[cut])!=0) break;  // found non-0 digit
-    #else
-      if (*up%powers[cut]!=0) break;         // found non-0 digit
-    #endif
+    uInt quot=QUOT10(*up, cut);
+    if ((*up-quot*powers[cut])!=0) break;    // found non-0 digit
     // have a trailing 0
     if (!all) {                    // trimming
       // [if exp>0 then all trailing 0s are significant for trim]
@@ -6702,14 +7482,9 @@ static Int decShiftToMost(Unit *uar, Int digits, Int shift) {
     first=uar+D2U(digits+shift)-1; // where msu of source will end up
     for (; source>=uar; source--, target--) {
       // split the source Unit and accumulate remainder for next
-      #if DECDPUN<=4
-        uInt quot=QUOT10(*source, cut);
-        uInt rem=*source-quot*powers[cut];
-        next+=quot;
-      #else
-        uInt rem=*source%powers[cut];
-        next+=*source/powers[cut];
-      #endif
+      uInt quot=QUOT10(*source, cut);
+      uInt rem=*source-quot*powers[cut];
+      next+=quot;
       if (target<=first) *target=(Unit)next;   // write to target iff valid
       next=rem*powers[DECDPUN-cut];            // save remainder for next Unit
       }
@@ -6758,24 +7533,14 @@ static Int decShiftToLeast(Unit *uar, Int units, Int shift) {
   // messier
   up=uar+D2U(shift-cut);           // source; correct to whole Units
   count=units*DECDPUN-shift;       // the maximum new length
-  #if DECDPUN<=4
-    quot=QUOT10(*up, cut);
-  #else
-    quot=*up/powers[cut];
-  #endif
+  quot=QUOT10(*up, cut);
   for (; ; target++) {
     *target=(Unit)quot;
     count-=(DECDPUN-cut);
     if (count<=0) break;
     up++;
-    quot=*up;
-    #if DECDPUN<=4
-      quot=QUOT10(quot, cut);
-      rem=*up-quot*powers[cut];
-    #else
-      rem=quot%powers[cut];
-      quot=quot/powers[cut];
-    #endif
+    quot=QUOT10(*up, cut);
+    rem=*up-quot*powers[cut];
     *target=(Unit)(*target+rem*powers[DECDPUN-cut]);
     count-=cut;
     if (count<=0) break;
@@ -6810,8 +7575,8 @@ static decNumber *decRoundOperand(const decNumber *dn, decContext *set,
 
   // Allocate storage for the returned decNumber, big enough for the
   // length specified by the context
-  res=(decNumber *)malloc(sizeof(decNumber)
-                          +(D2U(set->digits)-1)*sizeof(Unit));
+  res=(decNumber *)decAlloc(set, sizeof(decNumber)
+                               +(D2U(set->digits)-1)*sizeof(Unit));
   if (res==NULL) {
     *status|=DEC_Insufficient_storage;
     return NULL;
@@ -6891,9 +7656,6 @@ static void decSetCoeff(decNumber *dn, decContext *set, const Unit *lsu,
   const Unit *up;             // work
   Unit  *target;              // ..
   Int   count;                // ..
-  #if DECDPUN<=4
-  uInt  temp;                 // ..
-  #endif
 
   discard=len-set->digits;    // digits to discard
   if (discard<=0) {           // no digits are being discarded
@@ -6973,27 +7735,15 @@ static void decSetCoeff(decNumber *dn, decContext *set, const Unit *lsu,
    else { // discard digit is in low digit(s), and not top digit
     uInt  discard1;                // first discarded digit
     uInt  quot, rem;               // for divisions
-    if (cut==0) quot=*up;          // is at bottom of unit
+    // split the Unit once, above the discard digit, by reciprocal
+    // multiply; the discard digit is then the top digit of the rest
+    quot=QUOT10(*up, cut+1);       // digits kept
+    rem=*up-quot*powers[cut+1];    // discard digit and those below
+    if (cut==0) discard1=rem;      // is at bottom of unit
      else /* cut>0 */ {            // it's not at bottom of unit
-      #if DECDPUN<=4
-        quot=QUOT10(*up, cut);
-        rem=*up-quot*powers[cut];
-      #else
-        rem=*up%powers[cut];
-        quot=*up/powers[cut];
-      #endif
-      if (rem!=0) *residue=1;
+      discard1=QUOT10(rem, cut);
+      if (rem-discard1*powers[cut]!=0) *residue=1;
       }
-    // discard digit is now at bottom of quot
-    #if DECDPUN<=4
-      temp=(quot*6554)>>16;        // fast /10
-      // Vowels algorithm here not a win (9 instructions)
-      discard1=quot-X10(temp);
-      quot=temp;
-    #else
-      discard1=quot%10;
-      quot=quot/10;
-    #endif
     // here, discard1 is the guard digit, and residue is everything
     // else [use mapping array to accumulate residue safely]
     *residue+=resmap[discard1];
@@ -7014,14 +7764,8 @@ static void decSetCoeff(decNumber *dn, decContext *set, const Unit *lsu,
         count-=(DECDPUN-cut);
         if (count<=0) break;
         up++;
-        quot=*up;
-        #if DECDPUN<=4
-          quot=QUOT10(quot, cut);
-          rem=*up-quot*powers[cut];
-        #else
-          rem=quot%powers[cut];
-          quot=quot/powers[cut];
-        #endif
+        quot=QUOT10(*up, cut);
+        rem=*up-quot*powers[cut];
         *target=(Unit)(*target+rem*powers[DECDPUN-cut]);
         count-=cut;
         if (count<=0) break;
@@ -7293,7 +8037,7 @@ static void decFinalize(decNumber *dn, decContext *set, Int *residue,
     decNumberZero(&nmin);
     nmin.lsu[0]=1;
     nmin.exponent=set->emin;
-    comp=decCompare(dn, &nmin, 1);                // (signless compare)
+    comp=decCompare(dn, &nmin, 1, set);           // (signless compare)
     if (comp==BADINT) {                           // oops
       *status|=DEC_Insufficient_storage;          // abandon...
       return;
@@ -7571,13 +8315,8 @@ static Int decGetInt(const decNumber *dn) {
      else {                             // [not multiple of DECDPUN]
       Int rem;                          // work
       // slice off fraction digits and check for non-zero
-      #if DECDPUN<=4
-        theInt=QUOT10(*up, count);
-        rem=*up-theInt*powers[count];
-      #else
-        rem=*up%powers[count];          // slice off discards
-        theInt=*up/powers[count];
-      #endif
+      theInt=QUOT10(*up, count);        // slice off discards
+      rem=*up-theInt*powers[count];
       if (rem!=0) return BADINT;        // non-zero fraction
       // it looks good
       got=DECDPUN-count;                // number of digits so far
@@ -7614,6 +8353,126 @@ static Int decGetInt(const decNumber *dn) {
   return theInt;
   } // decGetInt
 
+#if DECUSE128
+/* DECULCHUNK is the number of digits (a multiple of DECDPUN) which   */
+/* are worked on as a uInt when converting Units to or from a uLLong, */
+/* and DECULCHUNKPOW is 10**DECULCHUNK (a constant, so that division  */
+/* by it can be done by reciprocal multiplication)                    */
+#define DECULCHUNK ((9/DECDPUN)*DECDPUN)
+#define DECULCHUNKPOW (DECULCHUNK==9 ? 1000000000 : DECULCHUNK==8      \
+  ? 100000000 : DECULCHUNK==7 ? 10000000 : DECULCHUNK==6 ? 1000000     \
+  : 100000)
+
+/* ------------------------------------------------------------------ */
+/* decGetULLong -- get the coefficient of a number as a uLLong        */
+/*                                                                    */
+/*   dn is the number [which will not be altered]; it must be finite  */
+/*      and have no more than 38 digits                               */
+/*                                                                    */
+/*   returns the coefficient, ignoring sign and exponent              */
+/*                                                                    */
+/* Units are first gathered into DECULCHUNK-digit uInts, so only one  */
+/* wide multiply is needed per chunk, and coefficients of up to 19    */
+/* digits (the usual case) are accumulated in a uLong, which is       */
+/* cheaper than 128-bit multiplication.                               */
+/* ------------------------------------------------------------------ */
+static uLLong decGetULLong(const decNumber *dn) {
+  const Unit *up=dn->lsu+D2U(dn->digits)-1;  // -> msu
+  Int    n=D2U(dn->digits)%(DECULCHUNK/DECDPUN);  // Units in top chunk
+  uInt   chunk=0;                       // current chunk
+  uLong  c64;                           // accumulators
+  uLLong c;                             // ..
+
+  if (n==0) n=DECULCHUNK/DECDPUN;       // top chunk is full
+  for (; n>0; n--, up--) chunk=chunk*(DECDPUNMAX+1)+*up;
+  c64=chunk;
+  if (dn->digits<=19) {                 // result fits in a uLong
+    while (up>=dn->lsu) {
+      for (chunk=0, n=DECULCHUNK/DECDPUN; n>0; n--, up--)
+        chunk=chunk*(DECDPUNMAX+1)+*up;
+      c64=c64*DECULCHUNKPOW+chunk;
+      }
+    return c64;
+    }
+  c=c64;
+  while (up>=dn->lsu) {
+    for (chunk=0, n=DECULCHUNK/DECDPUN; n>0; n--, up--)
+      chunk=chunk*(DECDPUNMAX+1)+*up;
+    c=c*DECULCHUNKPOW+chunk;
+    }
+  return c;
+  } // decGetULLong
+
+#if FASTADD
+/* ------------------------------------------------------------------ */
+/* decPow10ULLong -- return a power of ten as a uLLong                */
+/*                                                                    */
+/*   n is the power, 0 through 38                                     */
+/*                                                                    */
+/* Powers up to 10**19 are in a uLong table; higher powers need one   */
+/* 128-bit multiply.                                                  */
+/* ------------------------------------------------------------------ */
+static const uLong pow10ULong[20]={1, 10, 100, 1000, 10000, 100000,
+  1000000, 10000000, 100000000, 1000000000, 10000000000ULL,
+  100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+  100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+  100000000000000000ULL, 1000000000000000000ULL,
+  10000000000000000000ULL};
+static uLLong decPow10ULLong(Int n) {
+  if (n<=19) return pow10ULong[n];
+  return (uLLong)pow10ULong[n-19]*pow10ULong[19];
+  } // decPow10ULLong
+#endif
+
+/* ------------------------------------------------------------------ */
+/* decULLongToUnits -- lay out a uLLong as a Unit array               */
+/*                                                                    */
+/*   c is the value to convert                                        */
+/*   uar is the Unit array to fill; it must have room for D2U(39)     */
+/*      Units                                                         */
+/*                                                                    */
+/*   returns the number of Units set (at least 1)                     */
+/*                                                                    */
+/* Any part of c above 2**64 is split off with a 128-bit division (at */
+/* most two), and the rest is split into DECULCHUNK-digit uInts so    */
+/* that the Units themselves are generated using uInt arithmetic.     */
+/* ------------------------------------------------------------------ */
+#define DECULUNITS(chunk, up) {                                       \
+  Int n_;                                                             \
+  for (n_=0; n_<DECULCHUNK; n_+=DECDPUN, (up)++) {                    \
+    *(up)=(Unit)((chunk)%(DECDPUNMAX+1));                             \
+    (chunk)/=DECDPUNMAX+1;                                            \
+    }}
+static Int decULLongToUnits(uLLong c, Unit *uar) {
+  Unit  *up=uar;                        // work
+  uLong  lo;                            // current uLong part
+  uInt   chunk;                         // current uInt chunk
+
+  while ((c>>64)!=0) {                  // too big for a uLong
+    const uLong split=(uLong)DECULCHUNKPOW*DECULCHUNKPOW;
+    uLLong q=c/split;                   // [slow divide]
+    lo=(uLong)(c-q*split);
+    c=q;
+    chunk=(uInt)(lo%DECULCHUNKPOW);
+    DECULUNITS(chunk, up);
+    chunk=(uInt)(lo/DECULCHUNKPOW);
+    DECULUNITS(chunk, up);
+    }
+  for (lo=(uLong)c; lo>=DECULCHUNKPOW; lo/=DECULCHUNKPOW) {
+    chunk=(uInt)(lo%DECULCHUNKPOW);
+    DECULUNITS(chunk, up);
+    }
+  chunk=(uInt)lo;                       // most significant chunk
+  do {
+    *up=(Unit)(chunk%(DECDPUNMAX+1));
+    chunk/=DECDPUNMAX+1;
+    up++;
+    } while (chunk!=0);
+  return (Int)(up-uar);
+  } // decULLongToUnits
+#undef DECULUNITS
+#endif
+
 /* ------------------------------------------------------------------ */
 /* decDecap -- decapitate the coefficient of a number                 */
 /*                                                                    */
@@ -7671,6 +8530,142 @@ static Flag decBiStr(const char *targ, const char *str1, const char *str2) {
   return 1;
   } // decBiStr
 
+#if FASTSTR
+/* ------------------------------------------------------------------ */
+/* decFromStringFast -- fastpath for decNumberFromString              */
+/*                                                                    */
+/*   dn    is the number to set                                       */
+/*   chars is the string to convert ('\0' terminated)                 */
+/*   set   is the context                                             */
+/*                                                                    */
+/*   returns 1 if dn was set, or 0 if decNumberFromString must do the */
+/*   conversion (in which case dn is unchanged)                       */
+/*                                                                    */
+/* Only plain numbers ([sign] digits [. digits]) are handled, and     */
+/* only if the coefficient fits in set->digits and the exponent needs */
+/* no checking; the general code handles exponents, special values,   */
+/* rounding, and syntax errors.                                       */
+/*                                                                    */
+/* Runs of digits are located eight characters at a time (SWAR: a     */
+/* uLong is treated as a vector of bytes) and converted nine at a     */
+/* time, using three multiplies to combine eight digits in parallel.  */
+/* The integer and fraction digits are converted where they lie, with */
+/* any Unit which straddles the '.' completed across the two.         */
+/* ------------------------------------------------------------------ */
+// DECSWARNOND -- is non-zero in each byte of uLong x which is not an
+// ASCII digit.  The +0x06 can carry between bytes, but only out of a
+// byte that is itself not a digit, so the lowest non-zero byte (the
+// first non-digit) is always correct.
+#define DECSWARNOND(x) ((((x)&0xf0f0f0f0f0f0f0f0ULL)^0x3030303030303030ULL) \
+   | ((((x)+0x0606060606060606ULL)&0xf0f0f0f0f0f0f0f0ULL)                \
+      ^0x3030303030303030ULL))
+// DECSWAR8 -- converts uLong x holding eight ASCII digits (the most
+// significant first in memory) to its value: pairs, then quads, then
+// the octet are combined, each step one multiply for all lanes
+#define DECSWAR8(x) {                                                 \
+  x-=0x3030303030303030ULL;                                           \
+  x=(x*10+(x>>8))&0x00ff00ff00ff00ffULL;                              \
+  x=(x*100+(x>>16))&0x0000ffff0000ffffULL;                            \
+  x=(x*10000+(x>>32))&0x00000000ffffffffULL;}
+
+// decSkipDigits -- return the first character at or after c which is
+// not a digit; short runs are scanned a character at a time, and long
+// ones eight at a time once the end of the string is known (so that
+// no read goes beyond it); inlined, as it is called for every string
+__attribute__((always_inline)) static __inline__
+const char *decSkipDigits(const char *c) {
+  const char *end;                 // -> terminator
+  uLong x;                         // eight characters
+  Int   i;                         // work
+  for (i=0; i<8; i++, c++) if (*c<'0' || *c>'9') return c;
+  end=c+strlen(c);
+  for (; c+8<=end; c+=8) {
+    memcpy(&x, c, 8);
+    x=DECSWARNOND(x);
+    if (x!=0) return c+(__builtin_ctzll(x)>>3);
+    }
+  for (; c<end; c++) if (*c<'0' || *c>'9') break;
+  return c;
+  } // decSkipDigits
+
+static Flag decFromStringFast(decNumber *dn, const char *chars,
+                              decContext *set) {
+  const char *c=chars;             // -> first integer digit
+  const char *ce;                  // -> end of integer digits
+  const char *f;                   // -> first fraction digit
+  const char *fe;                  // -> end of fraction digits
+  const char *s, *e;               // segment being converted
+  uByte bits=0;                    // sign
+  Int   d;                         // significant digits
+  Int   seg;                       // segment number
+  Int   pend=0, pendn=0;           // partial Unit, and its digits
+  uLong x;                         // eight characters
+  Unit  *up;                       // -> Unit to set
+
+  #if DECSUBSET
+  if (!set->extended) return 0;    // zeros are special
+  #endif
+  if (*c=='-') {bits=DECNEG; c++;}
+   else if (*c=='+') c++;
+  ce=decSkipDigits(c);
+  f=ce; fe=ce;                     // assume no fraction
+  if (*ce=='.') {
+    f=ce+1;
+    fe=decSkipDigits(f);
+    }
+  if (*fe!='\0') return 0;         // exponent, special, or bad
+  if (ce==c && fe==f) return 0;    // no digits
+
+  // skip leading zeros, into the fraction if need be
+  for (; c<ce && *c=='0';) c++;
+  if (c==ce) for (s=f; s<fe && *s=='0';) s++;
+   else s=f;                       // [all fraction digits count]
+  d=(Int)((ce-c)+(fe-s));
+  if (d>set->digits) return 0;     // needs rounding
+  if (d==0) d=1;                   // a zero
+  if (f-fe-1<set->emin-d || f-fe-1>set->emax-set->digits) return 0;
+
+  // convert from the right: fraction digits (from s), then integer
+  up=dn->lsu;
+  for (seg=(s==fe); seg<2; seg++) {  // [skip an empty fraction]
+    if (seg==1) {s=c; e=ce;}
+     else e=fe;
+    if (pendn>0) {                 // complete a straddling Unit
+      for (; pendn<3 && e>s; pendn++) {
+        e--;
+        pend+=(*e-'0')*(pendn==1 ? 10 : 100);
+        }
+      if (pendn<3) continue;       // [this segment used up]
+      *up=(Unit)pend;
+      up++;
+      pendn=0;
+      }
+    for (; e-s>=9; e-=9, up+=3) {  // three Units at a time
+      uInt v;
+      memcpy(&x, e-9, 8);
+      DECSWAR8(x);
+      v=(uInt)x*10+(uInt)(e[-1]-'0');
+      up[0]=(Unit)(v%1000);
+      up[1]=(Unit)(v/1000%1000);
+      up[2]=(Unit)(v/1000000);
+      }
+    for (; e-s>=3; e-=3, up++)
+      *up=(Unit)((e[-3]-'0')*100+(e[-2]-'0')*10+(e[-1]-'0'));
+    for (pend=0; e>s; pendn++) {   // start a partial Unit
+      e--;
+      pend+=(*e-'0')*(pendn==0 ? 1 : 10);
+      }
+    } // seg
+  if (pendn>0 || up==dn->lsu) *up=(Unit)pend;   // [or zero]
+  dn->bits=bits;
+  dn->exponent=(Int)(f-fe);
+  dn->digits=d;
+  return 1;
+  } // decFromStringFast
+#undef DECSWARNOND
+#undef DECSWAR8
+#endif
+
 /* ------------------------------------------------------------------ */
 /* decNaNs -- handle NaN operand or operands                          */
 /*                                                                    */
@@ -7759,44 +8754,20 @@ static void decStatus(decNumber *dn, uInt status, decContext *set) {
 /*   returns the number of (significant) digits in the array          */
 /*                                                                    */
 /* All leading zeros are excluded, except the last if the array has   */
-/* only zero Units.                                                   */
+/* only zero Units.  The digits of the most significant Unit are      */
+/* counted with UNITDIGITS, without a compare for each digit.         */
 /* ------------------------------------------------------------------ */
 // This may be called twice during some operations.
 static Int decGetDigits(Unit *uar, Int len) {
   Unit *up=uar+(len-1);            // -> msu
-  Int  digits=(len-1)*DECDPUN+1;   // possible digits excluding msu
-  #if DECDPUN>4
-  uInt const *pow;                 // work
-  #endif
-                                   // (at least 1 in final msu)
+
   #if DECCHECK
   if (len<1) printf("decGetDigits called with len<1 [%ld]\n", (LI)len);
   #endif
 
-  for (; up>=uar; up--) {
-    if (*up==0) {                  // unit is all 0s
-      if (digits==1) break;        // a zero has one digit
-      digits-=DECDPUN;             // adjust for 0 unit
-      continue;}
-    // found the first (most significant) non-zero Unit
-    #if DECDPUN>1                  // not done yet
-    if (*up<10) break;             // is 1-9
-    digits++;
-    #if DECDPUN>2                  // not done yet
-    if (*up<100) break;            // is 10-99
-    digits++;
-    #if DECDPUN>3                  // not done yet
-    if (*up<1000) break;           // is 100-999
-    digits++;
-    #if DECDPUN>4                  // count the rest ...
-    for (pow=&powers[4]; *up>=*pow; pow++) digits++;
-    #endif
-    #endif
-    #endif
-    #endif
-    break;
-    } // up
-  return digits;
+  for (; *up==0 && up>uar; up--);  // skip leading 0 Units
+  // here up -> the most significant non-zero Unit, or the lsu
+  return (Int)(up-uar)*DECDPUN+UNITDIGITS(*up);
   } // decGetDigits
 
 #if DECTRACE | DECCHECK
@@ -8071,6 +9042,57 @@ static void decCheckInexact(const decNumber *dn, decContext *set) {
   } // decCheckInexact
 #endif
 
+/* ------------------------------------------------------------------ */
+/* decAlloc -- allocate working storage                               */
+/*                                                                    */
+/*   set is the context of the operation needing the storage          */
+/*   n is the number of bytes to allocate                             */
+/*   returns the storage, or NULL if none is available                */
+/*                                                                    */
+/* The allocator is that of the context, or else the thread default   */
+/* (see decContextGetAllocator); if neither is set, the thread        */
+/* scratch workspace is used (or malloc, if DECALLOC is set, so that  */
+/* the storage is accounted and fenced).                              */
+/* Storage is always released with decRelease, under the same set,    */
+/* before the operation returns.                                      */
+/* ------------------------------------------------------------------ */
+static void *decAlloc(const decContext *set, size_t n) {
+  const decAllocator *allocator=decContextGetAllocator(set);
+  decAllocCounts *counts=&decEntryCounts[decEntryNow];
+  if (decEntryBytes==0) counts->heapCalls++;  // first for this call
+  counts->allocs++;
+  counts->bytes+=n;
+  if (n>counts->largest) counts->largest=n;
+  decEntryBytes+=n;
+  if (decEntryBytes>counts->peak) counts->peak=decEntryBytes;
+  if (allocator==NULL) {
+    #if DECALLOC
+    return malloc(n);
+    #else
+    return decWorkAlloc(n);
+    #endif
+    }
+  return (*allocator->alloc)(allocator->opaque, n);
+  } // decAlloc
+
+/* ------------------------------------------------------------------ */
+/* decRelease -- release working storage                              */
+/*                                                                    */
+/*   set is the context given to decAlloc                             */
+/*   alloc is the storage returned by decAlloc                        */
+/* ------------------------------------------------------------------ */
+static void decRelease(const decContext *set, void *alloc) {
+  const decAllocator *allocator=decContextGetAllocator(set);
+  if (allocator==NULL) {
+    #if DECALLOC
+    free(alloc);
+    #else
+    decWorkRelease(alloc);
+    #endif
+    }
+   else (*allocator->release)(allocator->opaque, alloc);
+  } // decRelease
+
 #if DECALLOC
 #undef malloc
 #undef free
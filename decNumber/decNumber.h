@@ -40,8 +40,10 @@
   /* constant.  This must not be changed without recompiling the      */
   /* decNumber library modules. */
 
+  #if !defined(DECDPUN)
   #define DECDPUN 3           /* DECimal Digits Per UNit [must be >0  */
                               /* and <10; 3 or powers of 2 are best]. */
+  #endif
 
   /* DECNUMDIGITS is the default number of digits that can be held in */
   /* the structure.  If undefined, 1 is assumed and it is assumed     */
@@ -91,6 +93,57 @@
   /*    formats) are -0.00000{9...}# and -9.{9...}E+999999999#        */
   /*    (where # is '\0')                                             */
 
+  /* DECSTATS enables counters of how often the arithmetic fastpaths  */
+  /* are taken, for tuning.  The counters are global and are not      */
+  /* thread-safe.  This must match the setting used when compiling    */
+  /* the decNumber module.                                            */
+  #if !defined(DECSTATS)
+    #define DECSTATS 0
+  #endif
+  #if DECSTATS
+    typedef struct {
+      uint64_t addOps;   /* decAddOp calls needing multi-unit code    */
+      uint64_t add128;   /* .. of which used the 128-bit fastpath     */
+      uint64_t addAlign; /* .. of which had aligned operands          */
+      uint64_t mulOps;   /* decMultiplyOp calls with finite operands  */
+      uint64_t mul128;   /* .. of which used the 128-bit fastpath     */
+      } decStats;
+    extern decStats decNumberStats;
+  #endif
+
+  /* Allocation counters.  Each public operator taking a decContext   */
+  /* counts, per thread, its calls and any working storage that it    */
+  /* needed beyond its local buffers (from the context allocator, the */
+  /* scratch workspace, or malloc).  decNumberNormalize counts as     */
+  /* decNumberReduce, and storage needed by an operator called from   */
+  /* another (as decNumberQuantize is by decNumberToIntegralExact) is */
+  /* counted for the operator called.                                 */
+  enum decEntry {
+    DEC_ENTRY_NONE, DEC_ENTRY_ABS, DEC_ENTRY_ADD, DEC_ENTRY_AND,
+    DEC_ENTRY_COMPARE, DEC_ENTRY_COMPARE_SIGNAL,
+    DEC_ENTRY_COMPARE_TOTAL, DEC_ENTRY_COMPARE_TOTAL_MAG,
+    DEC_ENTRY_DIVIDE, DEC_ENTRY_DIVIDE_INTEGER, DEC_ENTRY_EXP,
+    DEC_ENTRY_FMA, DEC_ENTRY_FROM_STRING, DEC_ENTRY_INVERT,
+    DEC_ENTRY_LN, DEC_ENTRY_LOGB, DEC_ENTRY_LOG10, DEC_ENTRY_MAX,
+    DEC_ENTRY_MAX_MAG, DEC_ENTRY_MIN, DEC_ENTRY_MIN_MAG,
+    DEC_ENTRY_MINUS, DEC_ENTRY_MULTIPLY, DEC_ENTRY_NEXT_MINUS,
+    DEC_ENTRY_NEXT_PLUS, DEC_ENTRY_NEXT_TOWARD, DEC_ENTRY_OR,
+    DEC_ENTRY_PLUS, DEC_ENTRY_POWER, DEC_ENTRY_QUANTIZE,
+    DEC_ENTRY_REDUCE, DEC_ENTRY_REMAINDER, DEC_ENTRY_REMAINDER_NEAR,
+    DEC_ENTRY_RESCALE, DEC_ENTRY_ROTATE, DEC_ENTRY_SCALEB,
+    DEC_ENTRY_SHIFT, DEC_ENTRY_SQUARE_ROOT, DEC_ENTRY_SUBTRACT,
+    DEC_ENTRY_TO_INTEGRAL_EXACT, DEC_ENTRY_TO_INTEGRAL_VALUE,
+    DEC_ENTRY_XOR, DEC_ENTRY_COUNT
+    };
+  typedef struct {
+    uint64_t calls;      /* calls of the operator                     */
+    uint64_t heapCalls;  /* .. of which needed working storage        */
+    uint64_t allocs;     /* working storage allocations               */
+    uint64_t bytes;      /* .. and their total size, in bytes         */
+    uint64_t largest;    /* largest allocation                        */
+    uint64_t peak;       /* most bytes allocated during one call      */
+    } decAllocCounts;
+
 
   /* ---------------------------------------------------------------- */
   /* decNumber public functions and macros                            */
@@ -148,15 +201,19 @@
   decNumber * decNumberXor(decNumber *, const decNumber *, const decNumber *, decContext *);
 
   /* Utilities                                                        */
+  const decAllocCounts * decNumberAllocCounts(enum decEntry);
   enum decClass decNumberClass(const decNumber *, decContext *);
   const char * decNumberClassToString(enum decClass);
   decNumber  * decNumberCopy(decNumber *, const decNumber *);
   decNumber  * decNumberCopyAbs(decNumber *, const decNumber *);
   decNumber  * decNumberCopyNegate(decNumber *, const decNumber *);
   decNumber  * decNumberCopySign(decNumber *, const decNumber *, const decNumber *);
+  const char * decNumberEntryToString(enum decEntry);
+  uint32_t     decNumberHash(const decNumber *);
   decNumber  * decNumberNextMinus(decNumber *, const decNumber *, decContext *);
   decNumber  * decNumberNextPlus(decNumber *, const decNumber *, decContext *);
   decNumber  * decNumberNextToward(decNumber *, const decNumber *, const decNumber *, decContext *);
+  void         decNumberResetAllocCounts(void);
   decNumber  * decNumberTrim(decNumber *);
   const char * decNumberVersion(void);
   decNumber  * decNumberZero(decNumber *);
@@ -0,0 +1,382 @@
+/* ------------------------------------------------------------------ */
+/* decNumber.hpp -- C++ value types for decNumber                     */
+/* ------------------------------------------------------------------ */
+/* dec::Number<InlineDigits> owns a decNumber.  Numbers of up to      */
+/* InlineDigits digits are held in the object itself, and larger ones */
+/* in storage from malloc, which is freed by the destructor; a move   */
+/* takes over that storage (or copies the inline units), so Numbers   */
+/* may be returned and held in containers with no explicit free.      */
+/*                                                                    */
+/* The arithmetic is that of the C functions, under an explicit       */
+/* dec::Context, which wraps a decContext and collects the status:    */
+/*                                                                    */
+/*   dec::Context ctx(DEC_INIT_DECIMAL128);                           */
+/*   dec::Number<34> a("1.25", ctx), b("3", ctx);                     */
+/*   dec::Number<34> c=ctx(a)*b;               // decNumberMultiply   */
+/*   dec::add(c, c, a, ctx);                   // c=c+a, into c       */
+/*                                                                    */
+/* ctx(a) binds a Number to the context for one operator; the named   */
+/* functions write into an existing Number, so storage is reused.     */
+/* dec::Decimal<32>, dec::Decimal<64>, and dec::Decimal<128> hold     */
+/* decimal32, decimal64, and decimal128 encodings, with the same      */
+/* operators (each operand is decoded, and the result rounded once,   */
+/* to the precision and exponent range of the format, under the       */
+/* rounding mode and traps of the context).                           */
+/*                                                                    */
+/* This header needs C++11; it is not used by the C modules.          */
+/* ------------------------------------------------------------------ */
+
+#if !defined(DECNUMBERHPP)
+  #define DECNUMBERHPP
+
+  #include <stddef.h>
+  #include <stdint.h>
+  #include <stdlib.h>
+  #include <string.h>
+  #include <new>
+  #include <string>
+  #include <utility>
+
+  extern "C" {                  // decimal128 first, for DECNUMDIGITS
+  #include "decimal128.h"
+  #include "decimal64.h"
+  #include "decimal32.h"
+  #include "decNumberFixed.h"
+  }
+
+  namespace dec {
+
+  template<int InlineDigits> class Number;
+  template<int InlineDigits> class Operand;
+  template<int Bits> class Decimal;
+  template<int Bits> class DecimalOperand;
+
+  /* ---------------------------------------------------------------- */
+  /* Context -- a decContext, for the operations                      */
+  /* ---------------------------------------------------------------- */
+  class Context {
+    public:
+      decContext set;
+
+      explicit Context(int32_t kind=DEC_INIT_BASE) {
+        decContextDefault(&set, kind);
+        }
+      explicit Context(const decContext &from) : set(from) {}
+
+      int32_t  digits() const {return set.digits;}
+      uint32_t status() const {return set.status;}
+      void     clearStatus() {set.status=0;}
+
+      // bind an operand to this context, for one operator
+      template<int N>
+      Operand<N> operator()(const Number<N> &number) {
+        return Operand<N>(number, *this);
+        }
+      template<int B>
+      DecimalOperand<B> operator()(const Decimal<B> &decimal) {
+        return DecimalOperand<B>(decimal, *this);
+        }
+    }; // Context
+
+  /* ---------------------------------------------------------------- */
+  /* Number -- a decNumber with inline storage for InlineDigits       */
+  /* ---------------------------------------------------------------- */
+  template<int InlineDigits> class Number {
+    public:
+      Number() : heap(NULL), heapDigits(0) {
+        decNumberZero(&local.number);
+        }
+      Number(const char *string, Context &ctx)
+        : heap(NULL), heapDigits(0) {
+        decNumberFromString(reserve(ctx.digits()), string, &ctx.set);
+        }
+      explicit Number(const decNumber *dn) : heap(NULL), heapDigits(0) {
+        decNumberCopy(reserve(dn->digits), dn);
+        }
+      Number(const Number &other) : heap(NULL), heapDigits(0) {
+        decNumberCopy(reserve(other.get()->digits), other.get());
+        }
+      Number(Number &&other) noexcept : heap(other.heap),
+          heapDigits(other.heapDigits) {
+        if (heap==NULL) local=other.local;
+        other.heap=NULL;
+        other.heapDigits=0;
+        }
+      ~Number() {if (heap!=NULL) free(heap);}
+
+      Number &operator=(const Number &other) {
+        if (this!=&other) decNumberCopy(reserve(other.get()->digits),
+                                        other.get());
+        return *this;
+        }
+      Number &operator=(Number &&other) noexcept {
+        if (this==&other) return *this;
+        if (heap!=NULL) free(heap);
+        heap=other.heap;
+        heapDigits=other.heapDigits;
+        if (heap==NULL) local=other.local;
+        other.heap=NULL;
+        other.heapDigits=0;
+        return *this;
+        }
+
+      // the decNumber, for the C functions
+      decNumber *get() {
+        return heap!=NULL ? heap : &local.number;
+        }
+      const decNumber *get() const {
+        return heap!=NULL ? heap : &local.number;
+        }
+
+      // the most digits the number can hold without reallocation
+      int32_t capacity() const {
+        return heap!=NULL ? heapDigits : decFixedDigits(&local);
+        }
+
+      // make room for digits digits; the value is kept only if it
+      // already fits, and the decNumber is returned
+      decNumber *reserve(int32_t digits) {
+        decNumber *grown;
+        if (digits<=capacity()) return get();
+        grown=(decNumber *)malloc(sizeof(decNumber)
+          +(DECFIXED_Units(digits)-DECNUMUNITS)*sizeof(decNumberUnit));
+        if (grown==NULL) throw std::bad_alloc();
+        free(heap);
+        heap=grown;
+        heapDigits=digits;
+        return decNumberZero(heap);
+        }
+
+      std::string toString() const {
+        std::string string(get()->digits+14, '\0');
+        decNumberToString(get(), &string[0]);
+        string.resize(strlen(string.c_str()));
+        return string;
+        }
+
+    private:
+      typedef decNumberFixed(InlineDigits) Local;
+      Local      local;             // the number, if it fits
+      decNumber *heap;              // the number, if it did not
+      int32_t    heapDigits;        // capacity of heap
+    }; // Number
+
+  /* ---------------------------------------------------------------- */
+  /* Named operations, into an existing Number                        */
+  /* ---------------------------------------------------------------- */
+  // The result is written into res, which grows if the context needs
+  // more digits than it can hold; res may be one of the operands.
+  typedef decNumber * (*decUnary)(decNumber *, const decNumber *,
+                                  decContext *);
+  typedef decNumber * (*decBinary)(decNumber *, const decNumber *,
+                                   const decNumber *, decContext *);
+
+  template<int N> inline Number<N> & apply(decUnary fn, Number<N> &res,
+                                           const Number<N> &rhs,
+                                           Context &ctx) {
+    if (res.capacity()>=ctx.digits()) {
+      fn(res.get(), rhs.get(), &ctx.set);
+      return res;
+      }
+    Number<N> grown;              // res may be rhs, so keep it for now
+    fn(grown.reserve(ctx.digits()), rhs.get(), &ctx.set);
+    return res=std::move(grown);
+    } // apply
+
+  template<int N> inline Number<N> & apply(decBinary fn, Number<N> &res,
+                                           const Number<N> &lhs,
+                                           const Number<N> &rhs,
+                                           Context &ctx) {
+    if (res.capacity()>=ctx.digits()) {
+      fn(res.get(), lhs.get(), rhs.get(), &ctx.set);
+      return res;
+      }
+    Number<N> grown;              // res may be an operand, as above
+    fn(grown.reserve(ctx.digits()), lhs.get(), rhs.get(), &ctx.set);
+    return res=std::move(grown);
+    } // apply
+
+  #define DEC_UNARY(name, fn)                                         \
+    template<int N> inline Number<N> & name(Number<N> &res,           \
+        const Number<N> &rhs, Context &ctx) {                         \
+      return apply(fn, res, rhs, ctx);                                \
+      }
+  #define DEC_BINARY(name, fn)                                        \
+    template<int N> inline Number<N> & name(Number<N> &res,           \
+        const Number<N> &lhs, const Number<N> &rhs, Context &ctx) {   \
+      return apply(fn, res, lhs, rhs, ctx);                           \
+      }
+  DEC_UNARY(abs,             decNumberAbs)
+  DEC_UNARY(exp,             decNumberExp)
+  DEC_UNARY(ln,              decNumberLn)
+  DEC_UNARY(log10,           decNumberLog10)
+  DEC_UNARY(minus,           decNumberMinus)
+  DEC_UNARY(plus,            decNumberPlus)
+  DEC_UNARY(reduce,          decNumberReduce)
+  DEC_UNARY(squareRoot,      decNumberSquareRoot)
+  DEC_BINARY(add,            decNumberAdd)
+  DEC_BINARY(compare,        decNumberCompare)
+  DEC_BINARY(compareTotal,   decNumberCompareTotal)
+  DEC_BINARY(divide,         decNumberDivide)
+  DEC_BINARY(divideInteger,  decNumberDivideInteger)
+  DEC_BINARY(max,            decNumberMax)
+  DEC_BINARY(min,            decNumberMin)
+  DEC_BINARY(multiply,       decNumberMultiply)
+  DEC_BINARY(power,          decNumberPower)
+  DEC_BINARY(quantize,       decNumberQuantize)
+  DEC_BINARY(remainder,      decNumberRemainder)
+  DEC_BINARY(subtract,       decNumberSubtract)
+  #undef DEC_UNARY
+  #undef DEC_BINARY
+
+  /* ---------------------------------------------------------------- */
+  /* Operand -- a Number bound to a Context, for the operators        */
+  /* ---------------------------------------------------------------- */
+  template<int N> class Operand {
+    public:
+      Operand(const Number<N> &number, Context &context)
+        : value(number), ctx(context) {}
+      const Number<N> &value;
+      Context         &ctx;
+    }; // Operand
+
+  #define DEC_OPERATOR(op, fn)                                        \
+    template<int N> inline Number<N> operator op(const Operand<N> &lhs,\
+        const Number<N> &rhs) {                                       \
+      Number<N> res;                                                  \
+      fn(res.reserve(lhs.ctx.digits()), lhs.value.get(), rhs.get(),   \
+         &lhs.ctx.set);                                               \
+      return res;                                                     \
+      }
+  DEC_OPERATOR(+, decNumberAdd)
+  DEC_OPERATOR(-, decNumberSubtract)
+  DEC_OPERATOR(*, decNumberMultiply)
+  DEC_OPERATOR(/, decNumberDivide)
+  DEC_OPERATOR(%, decNumberRemainder)
+  #undef DEC_OPERATOR
+
+  template<int N> inline Number<N> operator-(const Operand<N> &rhs) {
+    Number<N> res;
+    decNumberMinus(res.reserve(rhs.ctx.digits()), rhs.value.get(),
+                   &rhs.ctx.set);
+    return res;
+    }
+
+  /* ---------------------------------------------------------------- */
+  /* Decimal -- a decimal32, decimal64, or decimal128                 */
+  /* ---------------------------------------------------------------- */
+  template<int Bits> struct DecimalFormat;
+  #define DEC_FORMAT(bits, kind)                                      \
+    template<> struct DecimalFormat<bits> {                           \
+      typedef decimal##bits Encoding;                                 \
+      enum {digits=DECIMAL##bits##_Pmax,                              \
+            emax=DECIMAL##bits##_Emax,                                \
+            emin=DECIMAL##bits##_Emin,                                \
+            stringLength=DECIMAL##bits##_String,                      \
+            init=DEC_INIT_##kind};                                    \
+      static decNumber * toNumber(const Encoding *d, decNumber *dn) { \
+        return decimal##bits##ToNumber(d, dn);                        \
+        }                                                             \
+      static Encoding * fromNumber(Encoding *d, const decNumber *dn,  \
+                                   decContext *set) {                 \
+        return decimal##bits##FromNumber(d, dn, set);                 \
+        }                                                             \
+      };
+  DEC_FORMAT(32,  DECIMAL32)
+  DEC_FORMAT(64,  DECIMAL64)
+  DEC_FORMAT(128, DECIMAL128)
+  #undef DEC_FORMAT
+
+  template<int Bits> class Decimal {
+    public:
+      typedef DecimalFormat<Bits>          Format;
+      typedef typename Format::Encoding    Encoding;
+      typedef decNumberFixed(Format::digits) Fixed;
+
+      Decimal() {
+        Fixed zero;
+        Context ctx(Format::init);
+        Format::fromNumber(&encoding, decFixedZero(&zero), &ctx.set);
+        }
+      Decimal(const char *string, Context &ctx) {
+        Fixed fixed;
+        Context work(formatContext(ctx));
+        decNumberFromString(decFixedNumber(&fixed), string, &work.set);
+        Format::fromNumber(&encoding, decFixedNumber(&fixed),
+                           &work.set);
+        ctx.set.status|=work.set.status;
+        }
+      explicit Decimal(const Encoding &from) : encoding(from) {}
+      template<int N> Decimal(const Number<N> &number, Context &ctx) {
+        Format::fromNumber(&encoding, number.get(), &ctx.set);
+        }
+
+      // the number, decoded
+      Number<Format::digits> toNumber() const {
+        Number<Format::digits> number;
+        Format::toNumber(&encoding, number.get());
+        return number;
+        }
+      // decode into *fixed, and give its decNumber
+      decNumber *decode(Fixed *fixed) const {
+        return Format::toNumber(&encoding, decFixedNumber(fixed));
+        }
+
+      // ctx with the precision, exponent range, and clamping of the
+      // format, and no status, so that a result is rounded only once
+      // (the encoding of it is then exact)
+      static Context formatContext(const Context &ctx) {
+        Context work(ctx.set);
+        work.set.digits=Format::digits;
+        work.set.emax=Format::emax;
+        work.set.emin=Format::emin;
+        work.set.clamp=1;
+        work.set.status=0;
+        return work;
+        }
+
+      std::string toString() const {
+        Fixed fixed;
+        char string[Format::stringLength];
+        decNumberToString(decode(&fixed), string);
+        return std::string(string);
+        }
+
+      Encoding encoding;
+    }; // Decimal
+
+  template<int B> class DecimalOperand {
+    public:
+      DecimalOperand(const Decimal<B> &decimal, Context &context)
+        : value(decimal), ctx(context) {}
+      const Decimal<B> &value;
+      Context          &ctx;
+    }; // DecimalOperand
+
+  // The operands are decoded, and the operation carried out under the
+  // format context of the context, so the result fits the format and
+  // its encoding adds no second rounding; the status is that of the
+  // operation
+  #define DEC_OPERATOR(op, fn)                                        \
+    template<int B> inline Decimal<B> operator op(                    \
+        const DecimalOperand<B> &lhs, const Decimal<B> &rhs) {        \
+      typename Decimal<B>::Fixed a, b, res;                           \
+      typename Decimal<B>::Encoding encoding;                         \
+      Context work(Decimal<B>::formatContext(lhs.ctx));               \
+      fn(decFixedNumber(&res), lhs.value.decode(&a), rhs.decode(&b),  \
+         &work.set);                                                  \
+      Decimal<B>::Format::fromNumber(&encoding, decFixedNumber(&res), \
+                                     &work.set);                      \
+      lhs.ctx.set.status|=work.set.status;                            \
+      return Decimal<B>(encoding);                                    \
+      }
+  DEC_OPERATOR(+, decNumberAdd)
+  DEC_OPERATOR(-, decNumberSubtract)
+  DEC_OPERATOR(*, decNumberMultiply)
+  DEC_OPERATOR(/, decNumberDivide)
+  DEC_OPERATOR(%, decNumberRemainder)
+  #undef DEC_OPERATOR
+
+  } // namespace dec
+
+#endif
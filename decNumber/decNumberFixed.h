@@ -0,0 +1,77 @@
+/* ------------------------------------------------------------------ */
+/* decNumberFixed.h -- Fixed-capacity decNumbers                      */
+/* ------------------------------------------------------------------ */
+/* A decNumber holds only DECNUMDIGITS digits in its structure, and   */
+/* larger numbers need storage for the rest of their coefficient to   */
+/* follow it.  The types here are a decNumber with that storage       */
+/* appended, for numbers of up to a fixed number of digits, so they   */
+/* may be declared locally, or embedded in other structures, with no  */
+/* allocation or D2U arithmetic.                                      */
+/*                                                                    */
+/* decNumber7, decNumber16, and decNumber34 hold the coefficients of  */
+/* decimal32, decimal64, and decimal128 numbers; decNumberFixed(n) is */
+/* the type for up to n digits, for example:                          */
+/*                                                                    */
+/*   typedef decNumberFixed(50) decNumber50;                          */
+/*                                                                    */
+/* The decNumber is the first member, number, of each type, so the    */
+/* address of a fixed-capacity number may be used anywhere that a     */
+/* decNumber * is accepted; the accessor macros below give it with    */
+/* the capacity checked.                                              */
+/* ------------------------------------------------------------------ */
+
+#if !defined(DECNUMBERFIXED)
+  #define DECNUMBERFIXED
+  #define DECFIXEDNAME     "decNumberFixed"             /* Short name */
+  #define DECFIXEDFULLNAME "Fixed-Capacity Numbers"   /* Verbose name */
+  #define DECFIXEDAUTHOR   "Mike Cowlishaw"           /* Who to blame */
+
+  #if !defined(DECNUMBER)
+    #include "decNumber.h"
+  #endif
+
+  /* Units needed for n digits, and those beyond the decNumber's own  */
+  #define DECFIXED_Units(n) (((n)+DECDPUN-1)/DECDPUN)
+  #define DECFIXED_More(n)  (DECFIXED_Units(n)>DECNUMUNITS            \
+    ? DECFIXED_Units(n)-DECNUMUNITS : 1)
+
+  /* The type of a decNumber with room for n digits [n a constant]    */
+  #define decNumberFixed(n) struct {                                  \
+    decNumber     number;                                             \
+    decNumberUnit more[DECFIXED_More(n)];                             \
+    }
+
+  typedef decNumberFixed(7)  decNumber7;   /* decimal32 coefficients  */
+  typedef decNumberFixed(16) decNumber16;  /* decimal64 coefficients  */
+  typedef decNumberFixed(34) decNumber34;  /* decimal128 coefficients */
+
+  /* ---------------------------------------------------------------- */
+  /* Accessor macros, for fixed-capacity number *fx                   */
+  /* ---------------------------------------------------------------- */
+  /* The capacity of *fx, in digits                                   */
+  #define decFixedDigits(fx) ((int32_t)DECDPUN                       \
+    *(int32_t)(sizeof((fx)->more)/sizeof(decNumberUnit)+DECNUMUNITS))
+  /* 1 if *fx can hold a coefficient of n digits, 0 otherwise         */
+  #define decFixedFits(fx, n) ((int32_t)(n)<=decFixedDigits(fx))
+  /* The decNumber in *fx, as an operand (which fits by construction) */
+  #define decFixedNumber(fx)  (&(fx)->number)
+  /* The decNumber in *fx, as the result of an operation under        */
+  /* context set, or NULL if a result rounded to set->digits might    */
+  /* not fit; then DEC_Invalid_operation is set in set->status        */
+  /* (quietly; no trap is raised).  The caller must test for NULL     */
+  /* before passing the result to an operation.  set is evaluated     */
+  /* more than once.                                                  */
+  #define decFixedResult(fx, set) (decFixedFits(fx, (set)->digits)    \
+    ? &(fx)->number                                                   \
+    : (decContextSetStatusQuiet(set, DEC_Invalid_operation),          \
+       (decNumber *)NULL))
+  /* The decNumber in *fx, set to a copy of decNumber *dn, or NULL    */
+  /* (with *fx unchanged) if the coefficient of dn does not fit; the  */
+  /* caller must test for NULL.  dn is evaluated more than once, so   */
+  /* must have no side effects.                                       */
+  #define decFixedCopy(fx, dn) (decFixedFits(fx, (dn)->digits)       \
+    ? decNumberCopy(&(fx)->number, dn) : (decNumber *)NULL)
+  /* Set *fx to 0, and give its decNumber                             */
+  #define decFixedZero(fx)    decNumberZero(&(fx)->number)
+
+#endif
@@ -40,6 +40,38 @@
   #define DECUSE64  1         /* 1=use int64s, 0=int32 & smaller only */
   #endif
 
+  /* Conditional code flag -- 128-bit integers, used by decQuad       */
+  #if !defined(DECUSE128)
+    #if DECUSE64 && defined(__SIZEOF_INT128__)
+    #define DECUSE128 1       /* 1=use int128s (needs DECUSE64)       */
+    #else
+    #define DECUSE128 0
+    #endif
+  #endif
+
+  /* Conditional code flag -- vector kernels, chosen at run time      */
+  #if !defined(DECSIMD)
+    #if defined(__GNUC__) && defined(__x86_64__) && defined(__ELF__)
+    #define DECSIMD 1         /* 1=add AVX2/SSE4.1 clones (GCC ifunc) */
+    #else
+    #define DECSIMD 0
+    #endif
+  #endif
+
+  /* Storage class for per-thread data, such as the thread default    */
+  /* allocator; if empty, that data is shared by all threads          */
+  #if !defined(DECTLS)
+    #if defined(_MSC_VER)
+    #define DECTLS __declspec(thread)
+    #elif defined(__GNUC__)
+    #define DECTLS __thread
+    #elif defined(__STDC_VERSION__) && __STDC_VERSION__>=201112L
+    #define DECTLS _Thread_local
+    #else
+    #define DECTLS
+    #endif
+  #endif
+
   /* Conditional code flag -- set this to 0 to exclude printf calls   */
   #if !defined(DECPRINT)
   #define DECPRINT  1         /* 1=allow printf calls; 0=no printf    */
@@ -63,6 +95,14 @@
                               /* rounded up to a multiple of 4; must  */
                               /* be zero or positive.                 */
   #endif
+  /* Default limit, in bytes, of the scratch workspace of each thread */
+  /* for storage too large for the local buffers; 0 for none.  None   */
+  /* is the default as nothing frees a workspace when its thread      */
+  /* ends: a program which sets a limit (see decContextSetWorkspace-  */
+  /* Limit) calls decContextFreeWorkspace before each thread ends.    */
+  #if !defined(DECWORKSPACE)
+  #define DECWORKSPACE 0
+  #endif
 
 
   /* ---------------------------------------------------------------- */
@@ -77,6 +117,9 @@
   #if DECTRACE & !DECPRINT
     #error DECTRACE needs DECPRINT to be useful
   #endif
+  #if DECUSE128 & !DECUSE64
+    #error DECUSE128 needs DECUSE64
+  #endif
 
   /* ---------------------------------------------------------------- */
   /* Definitions for all modules (general-purpose)                    */
@@ -96,6 +139,9 @@
   #define Long   int64_t
   #define uLong  uint64_t
   #endif
+  #if DECUSE128
+  #define uLLong unsigned __int128
+  #endif
 
   /* Development-use definitions                                      */
   typedef long int LI;        /* for printf arguments only            */
@@ -119,6 +165,10 @@
   extern const uByte  BIN2BCD8[4000];   /* 0-999 -> ddd + len         */
   extern const uShort BCD2DPD[2458];    /* 0-0x999 -> DPD (0x999=2457)*/
 
+  /* Working storage from the thread scratch workspace (decContext.c) */
+  extern void *decWorkAlloc(size_t);
+  extern void  decWorkRelease(void *);
+
   /* LONGMUL32HI -- set w=(u*v)>>32, where w, u, and v are uInts      */
   /* (that is, sets w to be the high-order word of the 64-bit result; */
   /* the low-order word is simply u*v.)                               */
@@ -142,6 +192,13 @@
   #define ROUNDDOWN(i, n) (((i)/n)*n)
   #define ROUNDDOWN4(i)   ((i)&~3)      /* special for n=4            */
 
+  /* DECHASHP is the prime, 2**31-1, modulo which decNumberHash,      */
+  /* decimal64Hash, and decimal128Hash reduce numbers.  HASHFOLD      */
+  /* takes a uLong x<2**62 to a smaller value, <2**32, which is the   */
+  /* same modulo DECHASHP (as 2**31 is 1 modulo DECHASHP).            */
+  #define DECHASHP    ((uInt)0x7fffffff)
+  #define HASHFOLD(x) (((x)&DECHASHP)+((x)>>31))
+
   /* References to multi-byte sequences under different sizes; these  */
   /* require locally declared variables, but do not violate strict    */
   /* aliasing or alignment (as did the UINTAT simple cast to uInt).   */
@@ -270,6 +327,21 @@
   /* using D2U                                                        */
   #define MSUDIGITS(d) ((d)-(D2U(d)-1)*DECDPUN)
 
+  /* UNITDIGITS -- returns the digits in Unit u (1 if u is 0), which  */
+  /* may be any uInt less than 10**9.  When the compiler can count    */
+  /* leading zeros the count is estimated from the bit length (using  */
+  /* 1233/4096 as log10(2)) and corrected with one comparison, as in  */
+  /* decRegDigits; otherwise u is compared with the powers of ten.    */
+  #if defined(__GNUC__)
+    #define UNITBITS(u) (32-__builtin_clz((uInt)(u)|1))
+    #define UNITDIGITS(u) (((UNITBITS(u)*1233)>>12)                   \
+      +(((uInt)(u)|1)>=DECPOWERS[(UNITBITS(u)*1233)>>12]))
+  #else
+    #define UNITDIGITS(u) ((u)<10 ? 1 : (u)<100 ? 2 : (u)<1000 ? 3    \
+      : (u)<10000 ? 4 : (u)<100000 ? 5 : (u)<1000000 ? 6              \
+      : (u)<10000000 ? 7 : (u)<100000000 ? 8 : 9)
+  #endif
+
   /* D2N -- return the number of decNumber structs that would be      */
   /* needed to contain that number of digits (and the initial         */
   /* decNumber struct) safely.  Note that one Unit is included in the */
@@ -357,6 +429,14 @@
   /* Format-dependent macros and constants                            */
   #if defined(DECPMAX)
 
+    /* Coefficient registers -- the decFloat modules always work in   */
+    /* 64-bit (and, for decQuad, 128-bit) integers, as DECUSE64 and   */
+    /* DECUSE128 select the arithmetic of the decNumber modules only  */
+    #define uDFLong  uint64_t
+    #if defined(__SIZEOF_INT128__)
+    #define uDFLLong unsigned __int128
+    #endif
+
     /* Useful constants                                               */
     #define DECPMAX9  (ROUNDUP(DECPMAX, 9)/9)  /* 'Pmax' in 10**9s    */
     /* Top words for a zero                                           */
@@ -382,9 +462,11 @@
     /* code.                                                          */
     #if DECPMAX==7
       #define ZEROWORD SINGLEZERO
-      /* [test macros not needed except for Zero]                     */
+      /* [test macros not needed except for Zero and Int]             */
       #define DFISZERO(df)  ((DFWORD(df, 0)&0x1c0fffff)==0         \
                           && (DFWORD(df, 0)&0x60000000)!=0x60000000)
+      #define DFISINT(df) ((DFWORD(df, 0)&0x63f00000)==0x22500000  \
+                         ||(DFWORD(df, 0)&0x7bf00000)==0x6a500000)
     #elif DECPMAX==16
       #define ZEROWORD DOUBLEZERO
       #define DFISZERO(df)  ((DFWORD(df, 1)==0                     \
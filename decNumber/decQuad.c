@@ -0,0 +1,105 @@
+/* ------------------------------------------------------------------ */
+/* decQuad.c -- decQuad operations module                             */
+/* ------------------------------------------------------------------ */
+/* This module comprises decQuad operations (including conversions)   */
+/* ------------------------------------------------------------------ */
+
+#include "decContext.h"       // public includes
+#define  DECNUMDIGITS 34      // make decNumbers with space for 34
+#include "decNumber.h"        // base number library (for proxies)
+#include "decimal128.h"        // .. and its format (for proxies)
+#include "decQuad.h"        // ..
+
+/* Constant mappings for shared code */
+#define DECPMAX     DECQUAD_Pmax
+#define DECEMIN     DECQUAD_Emin
+#define DECEMAX     DECQUAD_Emax
+#define DECEMAXD    DECQUAD_EmaxD
+#define DECBYTES    DECQUAD_Bytes
+#define DECSTRING   DECQUAD_String
+#define DECECONL    DECQUAD_EconL
+#define DECBIAS     DECQUAD_Bias
+#define DECLETS     DECQUAD_Declets
+// parameters of next-wider format
+#define DECWBYTES   DECQUAD_Bytes
+#define DECWECONL   DECQUAD_EconL
+
+/* Type and function mappings for shared code */
+#define decFloat                   decQuad      // Type name
+#define DECREG                     uDFLLong       // Coefficient register
+
+// Utilities and conversions (binary results, extractors, etc.)
+#define decFloatFromInt32          decQuadFromInt32
+#define decFloatFromNumber         decQuadFromNumber
+#define decFloatFromString         decQuadFromString
+#define decFloatFromUInt32         decQuadFromUInt32
+#define decFloatToEngString        decQuadToEngString
+#define decFloatToNumber           decQuadToNumber
+#define decFloatToString           decQuadToString
+#define decFloatZero               decQuadZero
+
+// Computational (result is a decFloat)
+#define decFloatAbs                decQuadAbs
+#define decFloatAdd                decQuadAdd
+#define decFloatAnd                decQuadAnd
+#define decFloatDivide             decQuadDivide
+#define decFloatDivideInteger      decQuadDivideInteger
+#define decFloatFMA                decQuadFMA
+#define decFloatInvert             decQuadInvert
+#define decFloatLogB               decQuadLogB
+#define decFloatMax                decQuadMax
+#define decFloatMaxMag             decQuadMaxMag
+#define decFloatMin                decQuadMin
+#define decFloatMinMag             decQuadMinMag
+#define decFloatMinus              decQuadMinus
+#define decFloatMultiply           decQuadMultiply
+#define decFloatNextMinus          decQuadNextMinus
+#define decFloatNextPlus           decQuadNextPlus
+#define decFloatNextToward         decQuadNextToward
+#define decFloatOr                 decQuadOr
+#define decFloatPlus               decQuadPlus
+#define decFloatQuantize           decQuadQuantize
+#define decFloatReduce             decQuadReduce
+#define decFloatRemainder          decQuadRemainder
+#define decFloatRemainderNear      decQuadRemainderNear
+#define decFloatRotate             decQuadRotate
+#define decFloatScaleB             decQuadScaleB
+#define decFloatShift              decQuadShift
+#define decFloatSubtract           decQuadSubtract
+#define decFloatToIntegralValue    decQuadToIntegralValue
+#define decFloatToIntegralExact    decQuadToIntegralExact
+#define decFloatXor                decQuadXor
+
+// Comparisons
+#define decFloatCompare            decQuadCompare
+#define decFloatCompareSignal      decQuadCompareSignal
+#define decFloatCompareTotal       decQuadCompareTotal
+#define decFloatCompareTotalMag    decQuadCompareTotalMag
+
+// Copies
+#define decFloatCanonical          decQuadCanonical
+#define decFloatCopy               decQuadCopy
+#define decFloatCopyAbs            decQuadCopyAbs
+#define decFloatCopyNegate         decQuadCopyNegate
+#define decFloatCopySign           decQuadCopySign
+
+// Non-computational
+#define decFloatClass              decQuadClass
+#define decFloatClassString        decQuadClassString
+#define decFloatDigits             decQuadDigits
+#define decFloatIsCanonical        decQuadIsCanonical
+#define decFloatIsFinite           decQuadIsFinite
+#define decFloatIsInfinite         decQuadIsInfinite
+#define decFloatIsInteger          decQuadIsInteger
+#define decFloatIsNaN              decQuadIsNaN
+#define decFloatIsNormal           decQuadIsNormal
+#define decFloatIsSignaling        decQuadIsSignaling
+#define decFloatIsSigned           decQuadIsSigned
+#define decFloatIsSubnormal        decQuadIsSubnormal
+#define decFloatIsZero             decQuadIsZero
+#define decFloatRadix              decQuadRadix
+#define decFloatSameQuantum        decQuadSameQuantum
+#define decFloatVersion            decQuadVersion
+
+#include "decCommon.c"                  // non-arithmetic decFloat routines
+#include "decBasic.c"                   // basic formats routines
@@ -0,0 +1,70 @@
+/* ------------------------------------------------------------------ */
+/* decSingle.c -- decSingle operations module                         */
+/* ------------------------------------------------------------------ */
+/* This module comprises decSingle operations (including conversions) */
+/* ------------------------------------------------------------------ */
+
+#include "decContext.h"       // public includes
+#include "decSingle.h"        // ..
+
+/* Constant mappings for shared code */
+#define DECPMAX     DECSINGLE_Pmax
+#define DECEMIN     DECSINGLE_Emin
+#define DECEMAX     DECSINGLE_Emax
+#define DECEMAXD    DECSINGLE_EmaxD
+#define DECBYTES    DECSINGLE_Bytes
+#define DECSTRING   DECSINGLE_String
+#define DECECONL    DECSINGLE_EconL
+#define DECBIAS     DECSINGLE_Bias
+#define DECLETS     DECSINGLE_Declets
+// parameters of next-wider format
+#define DECWBYTES   DECDOUBLE_Bytes
+#define DECWECONL   DECDOUBLE_EconL
+#define DECWBIAS    DECDOUBLE_Bias
+#define DECWPMAX    DECDOUBLE_Pmax
+
+/* Type and function mappings for shared code */
+#define decFloat                   decSingle      // Type name
+#define decFloatWider              decDouble      // Type name
+#define DECREG                     uInt           // Coefficient register
+
+// Utilities and conversions (binary results, extractors, etc.)
+#define decFloatFromString         decSingleFromString
+#define decFloatFromWider          decSingleFromWider
+#define decFloatToEngString        decSingleToEngString
+#define decFloatToString           decSingleToString
+#define decFloatToWider            decSingleToWider
+#define decFloatZero               decSingleZero
+
+// Comparisons
+#define decFloatCompare            decSingleCompare
+#define decFloatCompareSignal      decSingleCompareSignal
+#define decFloatCompareTotal       decSingleCompareTotal
+#define decFloatCompareTotalMag    decSingleCompareTotalMag
+
+// Copies
+#define decFloatCanonical          decSingleCanonical
+#define decFloatCopy               decSingleCopy
+#define decFloatCopyAbs            decSingleCopyAbs
+#define decFloatCopyNegate         decSingleCopyNegate
+#define decFloatCopySign           decSingleCopySign
+
+// Non-computational
+#define decFloatClass              decSingleClass
+#define decFloatClassString        decSingleClassString
+#define decFloatDigits             decSingleDigits
+#define decFloatIsCanonical        decSingleIsCanonical
+#define decFloatIsFinite           decSingleIsFinite
+#define decFloatIsInfinite         decSingleIsInfinite
+#define decFloatIsInteger          decSingleIsInteger
+#define decFloatIsNaN              decSingleIsNaN
+#define decFloatIsNormal           decSingleIsNormal
+#define decFloatIsSignaling        decSingleIsSignaling
+#define decFloatIsSigned           decSingleIsSigned
+#define decFloatIsSubnormal        decSingleIsSubnormal
+#define decFloatIsZero             decSingleIsZero
+#define decFloatRadix              decSingleRadix
+#define decFloatSameQuantum        decSingleSameQuantum
+#define decFloatVersion            decSingleVersion
+
+#include "decCommon.c"                  // non-arithmetic decFloat routines
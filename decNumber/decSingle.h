@@ -0,0 +1,98 @@
+/* ------------------------------------------------------------------ */
+/* decSingle.h -- Decimal 32-bit format module header                 */
+/* ------------------------------------------------------------------ */
+/* This header file is included by all modules that use decSingle     */
+/* directly.  A decSingle is an IEEE 754 decimal32 in DPD encoding,   */
+/* worked on directly (without conversion to a decNumber); it has a   */
+/* fixed precision of 7 digits and a fixed exponent range.  See       */
+/* decCommon.c for the implementation.                                */
+/*                                                                    */
+/* decSingle is a storage format, so only conversions, comparisons,   */
+/* copies, and the non-computational routines are provided; for       */
+/* arithmetic, widen to decDouble.  decQuad.c must also be included   */
+/* in any build that uses decSingle, as it holds the lookup tables    */
+/* that are shared by the formats.                                    */
+/* ------------------------------------------------------------------ */
+
+#if !defined(DECSINGLE)
+  #define DECSINGLE
+
+  #define DECSINGLENAME       "decimalSingle"         /* Short name   */
+  #define DECSINGLETITLE      "Decimal 32-bit datum"  /* Verbose name */
+  #define DECSINGLEAUTHOR     "Mike Cowlishaw"        /* Who to blame */
+
+  /* parameters for decSingles                                        */
+  #define DECSINGLE_Bytes    4    /* length                           */
+  #define DECSINGLE_Pmax     7    /* maximum precision (digits)       */
+  #define DECSINGLE_Emin   -95    /* minimum adjusted exponent        */
+  #define DECSINGLE_Emax    96    /* maximum adjusted exponent        */
+  #define DECSINGLE_EmaxD    3    /* maximum exponent digits          */
+  #define DECSINGLE_Bias   101    /* bias for the exponent            */
+  #define DECSINGLE_String  16    /* maximum string length, +1        */
+  #define DECSINGLE_EconL    6    /* exponent continuation length     */
+  #define DECSINGLE_Declets  2    /* count of declets                 */
+  /* highest biased exponent (Elimit-1)                               */
+  #define DECSINGLE_Ehigh (DECSINGLE_Emax + DECSINGLE_Bias - (DECSINGLE_Pmax-1))
+
+  /* Required includes                                                */
+  #include "decContext.h"
+  #include "decQuad.h"
+  #include "decDouble.h"
+
+  /* The decSingle decimal 32-bit type, accessible by all sizes       */
+  typedef union {
+    uint8_t   bytes[DECSINGLE_Bytes];   /* fields: 1, 5, 6, 20 bits   */
+    uint16_t shorts[DECSINGLE_Bytes/2];
+    uint32_t  words[DECSINGLE_Bytes/4];
+    } decSingle;
+
+  /* ---------------------------------------------------------------- */
+  /* Routines -- implemented as decFloat routines in common files     */
+  /* ---------------------------------------------------------------- */
+
+  /* Utilities and conversions (binary results, extractors, etc.)     */
+  extern decSingle * decSingleFromString(decSingle *, const char *, decContext *);
+  extern decSingle * decSingleFromWider(decSingle *, const decDouble *, decContext *);
+  extern char      * decSingleToEngString(const decSingle *, char *);
+  extern char      * decSingleToString(const decSingle *, char *);
+  extern decDouble * decSingleToWider(const decSingle *, decDouble *);
+  extern decSingle * decSingleZero(decSingle *);
+
+  /* Comparisons                                                      */
+  extern decSingle * decSingleCompare(decSingle *, const decSingle *, const decSingle *, decContext *);
+  extern decSingle * decSingleCompareSignal(decSingle *, const decSingle *, const decSingle *, decContext *);
+  extern decSingle * decSingleCompareTotal(decSingle *, const decSingle *, const decSingle *);
+  extern decSingle * decSingleCompareTotalMag(decSingle *, const decSingle *, const decSingle *);
+
+  /* Copies                                                           */
+  extern decSingle * decSingleCanonical(decSingle *, const decSingle *);
+  extern decSingle * decSingleCopy(decSingle *, const decSingle *);
+  extern decSingle * decSingleCopyAbs(decSingle *, const decSingle *);
+  extern decSingle * decSingleCopyNegate(decSingle *, const decSingle *);
+  extern decSingle * decSingleCopySign(decSingle *, const decSingle *, const decSingle *);
+
+  /* Non-computational                                                */
+  extern enum decClass decSingleClass(const decSingle *);
+  extern const char *  decSingleClassString(const decSingle *);
+  extern uint32_t      decSingleDigits(const decSingle *);
+  extern uint32_t      decSingleIsCanonical(const decSingle *);
+  extern uint32_t      decSingleIsFinite(const decSingle *);
+  extern uint32_t      decSingleIsInfinite(const decSingle *);
+  extern uint32_t      decSingleIsInteger(const decSingle *);
+  extern uint32_t      decSingleIsNaN(const decSingle *);
+  extern uint32_t      decSingleIsNormal(const decSingle *);
+  extern uint32_t      decSingleIsSignaling(const decSingle *);
+  extern uint32_t      decSingleIsSigned(const decSingle *);
+  extern uint32_t      decSingleIsSubnormal(const decSingle *);
+  extern uint32_t      decSingleIsZero(const decSingle *);
+  extern uint32_t      decSingleRadix(const decSingle *);
+  extern uint32_t      decSingleSameQuantum(const decSingle *, const decSingle *);
+  extern const char *  decSingleVersion(void);
+
+  /* decNumber conversions; these are implemented as macros so as not */
+  /* to force a dependency on decimal32 and decNumber in decSingle.   */
+  /* decSingleFromNumber returns a decimal32 * to avoid warnings.     */
+  #define decSingleToNumber(ds, dn) decimal32ToNumber((decimal32 *)(ds), dn)
+  #define decSingleFromNumber(ds, dn, set) decimal32FromNumber((decimal32 *)(ds), dn, set)
+
+#endif
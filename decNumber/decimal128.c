@@ -39,11 +39,16 @@
 #define BIN2DPD BIN2DPDx
 extern const uInt   COMBEXP[32], COMBMSD[32];
 extern const uShort DPD2BIN[1024];
-extern const uShort BIN2DPD[1000];      // [not used]
+extern const uShort BIN2DPD[1000];
 extern const uByte  BIN2CHAR[4001];
 
 extern void decDigitsFromDPD(decNumber *, const uInt *, Int);
 extern void decDigitsToDPD(const decNumber *, uInt *, Int);
+extern Int  decDigitsFromString(const char *, uInt *, Int, Int *, uInt *);
+extern void decBinFromDPD(uInt *, Int, const uInt *, Int, uInt);
+extern uInt decBinToDPD(uInt *, Int, uInt *, Int);
+extern void decKeyFromDPD(uByte *, Int, const uInt *, uInt, Int, Int, Flag);
+extern uInt decHashFromDPD(Int, const uInt *, uInt, Int, uByte);
 
 #if DECTRACE || DECCHECK
 void decimal128Show(const decimal128 *);          // for debug
@@ -253,27 +258,18 @@ decNumber * decimal128ToNumber(const decimal128 *d128, decNumber *dn) {
   } // decimal128ToNumber
 
 /* ------------------------------------------------------------------ */
-/* to-scientific-string -- conversion to numeric string               */
-/* to-engineering-string -- conversion to numeric string              */
-/*                                                                    */
-/*   decimal128ToString(d128, string);                                */
-/*   decimal128ToEngString(d128, string);                             */
-/*                                                                    */
-/*  d128 is the decimal128 format number to convert                   */
-/*  string is the string where the result will be laid out            */
+/* decimal128ToChars -- lay out a decimal128 as a string              */
 /*                                                                    */
-/*  string must be at least 24 characters                             */
+/*   d128   is the decimal128 format number to lay out                */
+/*   string is where to lay out the number                            */
+/*   eng    is 1 if Engineering, 0 if Scientific                      */
 /*                                                                    */
-/*  No error is possible, and no status can be set.                   */
+/* The coefficient is laid out directly from the declets, using       */
+/* BIN2CHAR, and then the '.', any padding, and the exponent are      */
+/* added; no decNumber is needed.                                     */
 /* ------------------------------------------------------------------ */
-char * decimal128ToEngString(const decimal128 *d128, char *string){
-  decNumber dn;                         // work
-  decimal128ToNumber(d128, &dn);
-  decNumberToEngString(&dn, string);
-  return string;
-  } // decimal128ToEngString
-
-char * decimal128ToString(const decimal128 *d128, char *string){
+static char * decimal128ToChars(const decimal128 *d128, char *string,
+                                Flag eng){
   uInt msd;                        // coefficient MSD
   Int  exp;                        // exponent top two bits or full
   uInt comb;                       // combination field
@@ -380,6 +376,29 @@ char * decimal128ToString(const decimal128 *d128, char *string){
   if (exp>0 || pre<-5) {           // need exponential form
     e=pre-1;                       // calculate E value
     pre=1;                         // assume one digit before '.'
+    if (eng && e!=0) {             // engineering: may need to adjust
+      Int adj;                     // adjustment
+      // The C remainder operator is undefined for negative numbers, so
+      // a positive remainder calculation must be used here
+      if (e<0) {
+        adj=(-e)%3;
+        if (adj!=0) adj=3-adj;
+        }
+       else { // e>0
+        adj=e%3;
+        }
+      e=e-adj;
+      // if dealing with zero still produce an exponent which is a
+      // multiple of three, as expected, but there will only be the
+      // one zero before the E, still.  Otherwise note the padding.
+      if (c-cstart!=1 || *cstart!='0') pre+=adj;
+       else {  // is zero
+        if (adj!=0) {              // 0.00Esnn needed
+          e=e+3;
+          pre=-(2-adj);
+          }
+        } // zero
+      } // eng
     } // exponential form
 
   /* modify the coefficient, adding 0s, '.', and E+nn as needed */
@@ -392,45 +411,68 @@ char * decimal128ToString(const decimal128 *d128, char *string){
       *t='.';                           // insert the dot
       c++;                              // length increased by one
       }
-
-    // finally add the E-part, if needed; it will never be 0, and has
-    // a maximum length of 4 digits
-    if (e!=0) {
-      *c++='E';                    // starts with E
-      *c++='+';                    // assume positive
-      if (e<0) {
-        *(c-1)='-';                // oops, need '-'
-        e=-e;                      // uInt, please
-        }
-      if (e<1000) {                // 3 (or fewer) digits case
-        u=&BIN2CHAR[e*4];          // -> length byte
-        memcpy(c, u+4-*u, 4);      // copy fixed 4 characters [is safe]
-        c+=*u;                     // bump pointer appropriately
-        }
-       else {                      // 4-digits
-        Int thou=((e>>3)*1049)>>17; // e/1000
-        Int rem=e-(1000*thou);      // e%1000
-        *c++='0'+(char)thou;
-        u=&BIN2CHAR[rem*4];        // -> length byte
-        memcpy(c, u+1, 4);         // copy fixed 3+1 characters [is safe]
-        c+=3;                      // bump pointer, always 3 digits
-        }
-      }
-    *c='\0';                       // add terminator
-    //printf("res %s\n", string);
-    return string;
+     else for (; c<dotat; c++) *c='0';  // 0 padding (for engineering)
     } // pre>0
+   else {
+    /* -5<=pre<=0: here for plain 0.ddd or 0.000ddd forms (which can
+       only have an E if an engineering zero) */
+    t=c+1-pre;
+    c=t+1;                              // end of the laid-out number
+    for (; s>=cstart; s--, t--) *t=*s;  // shift whole coefficient right
+    t=cstart;
+    *t++='0';                           // always starts with 0.
+    *t++='.';
+    for (; pre<0; pre++) *t++='0';      // add any 0's after '.'
+    }
 
-  /* -5<=pre<=0: here for plain 0.ddd or 0.000ddd forms (can never have E) */
-  t=c+1-pre;
-  *(t+1)='\0';                          // can add terminator now
-  for (; s>=cstart; s--, t--) *t=*s;    // shift whole coefficient right
-  c=cstart;
-  *c++='0';                             // always starts with 0.
-  *c++='.';
-  for (; pre<0; pre++) *c++='0';        // add any 0's after '.'
+  // finally add the E-part, if needed; it will never be 0, and has
+  // a maximum length of 4 digits
+  if (e!=0) {
+    *c++='E';                      // starts with E
+    *c++='+';                      // assume positive
+    if (e<0) {
+      *(c-1)='-';                  // oops, need '-'
+      e=-e;                        // uInt, please
+      }
+    if (e<1000) {                  // 3 (or fewer) digits case
+      u=&BIN2CHAR[e*4];            // -> length byte
+      memcpy(c, u+4-*u, 4);        // copy fixed 4 characters [is safe]
+      c+=*u;                       // bump pointer appropriately
+      }
+     else {                        // 4-digits
+      Int thou=((e>>3)*1049)>>17;   // e/1000
+      Int rem=e-(1000*thou);        // e%1000
+      *c++='0'+(char)thou;
+      u=&BIN2CHAR[rem*4];          // -> length byte
+      memcpy(c, u+1, 4);           // copy fixed 3+1 characters [is safe]
+      c+=3;                        // bump pointer, always 3 digits
+      }
+    }
+  *c='\0';                           // add terminator
   //printf("res %s\n", string);
   return string;
+  } // decimal128ToChars
+
+/* ------------------------------------------------------------------ */
+/* to-scientific-string -- conversion to numeric string               */
+/* to-engineering-string -- conversion to numeric string              */
+/*                                                                    */
+/*   decimal128ToString(d128, string);                                */
+/*   decimal128ToEngString(d128, string);                             */
+/*                                                                    */
+/*  d128 is the decimal128 format number to convert                   */
+/*  string is the string where the result will be laid out            */
+/*                                                                    */
+/*  string must be at least 24 characters                             */
+/*                                                                    */
+/*  No error is possible, and no status can be set.                   */
+/* ------------------------------------------------------------------ */
+char * decimal128ToEngString(const decimal128 *d128, char *string){
+  return decimal128ToChars(d128, string, 1);
+  } // decimal128ToEngString
+
+char * decimal128ToString(const decimal128 *d128, char *string){
+  return decimal128ToChars(d128, string, 0);
   } // decimal128ToString
 
 /* ------------------------------------------------------------------ */
@@ -447,11 +489,48 @@ char * decimal128ToString(const decimal128 *d128, char *string){
 /* The context is supplied to this routine is used for error handling */
 /* (setting of status and traps) and for the rounding mode, only.     */
 /* If an error occurs, the result will be a valid decimal128 NaN.     */
+/*                                                                    */
+/* A plain number which fits exactly (no rounding or clamping, and    */
+/* not subnormal) is packed directly from the string; all others are  */
+/* converted by way of a decNumber.                                   */
 /* ------------------------------------------------------------------ */
 decimal128 * decimal128FromString(decimal128 *result, const char *string,
                                   decContext *set) {
   decContext dc;                             // work
   decNumber dn;                              // ..
+  const char *c=string;                      // -> after sign
+  uInt targar[4]={0, 0, 0, 0};               // target 128-bit
+  uInt msd, comb, exp;                       // work
+  uInt uiwork;                               // for macros
+  Int  d, e;                                 // digits and exponent
+
+  // fastpath: plain numbers which fit exactly need no decNumber
+  if (*c=='-' || *c=='+') c++;
+  d=decDigitsFromString(c, targar, 11, &e, &msd);
+  if (d>0
+   && e>=-DECIMAL128_Bias                    // not clamped ..
+   && e<=DECIMAL128_Ehigh-DECIMAL128_Bias    // .. or folded down
+   && e+d-1>=DECIMAL128_Emin) {              // and not subnormal
+    exp=(uInt)(e+DECIMAL128_Bias);           // bias exponent
+    if (msd>=8) comb=0x18 | ((exp>>11) & 0x06) | (msd & 0x01);
+           else comb=((exp>>9) & 0x18) | msd;
+    targhi|=comb<<26;                        // add combination field ..
+    targhi|=(exp&0xfff)<<14;                 // .. and exponent continuation
+    if (*string=='-') targhi|=0x80000000;    // add sign bit
+    if (DECLITEND) {
+      (void)UBFROMUI(result->bytes,    targlo);
+      (void)UBFROMUI(result->bytes+4,  targml);
+      (void)UBFROMUI(result->bytes+8,  targmh);
+      (void)UBFROMUI(result->bytes+12, targhi);
+      }
+     else {
+      (void)UBFROMUI(result->bytes,    targhi);
+      (void)UBFROMUI(result->bytes+4,  targmh);
+      (void)UBFROMUI(result->bytes+8,  targml);
+      (void)UBFROMUI(result->bytes+12, targlo);
+      }
+    return result;
+    }
 
   decContextDefault(&dc, DEC_INIT_DECIMAL128); // no traps, please
   dc.round=set->round;                         // use supplied rounding
@@ -496,6 +575,475 @@ decimal128 * decimal128Canonical(decimal128 *result, const decimal128 *d128) {
   return result;
   } // decimal128Canonical
 
+/* ------------------------------------------------------------------ */
+/* decimal128ArrayToNumberUnits -- convert decimal128s to decNumber   */
+/*                                 fields                             */
+/*                                                                    */
+/*   d128   is the array of decimal128s to convert                    */
+/*   count  is the number of decimal128s                              */
+/*   units  is the matrix of count rows of DECIMAL128_Units Units     */
+/*          which receives the coefficients (lsu first in each row)   */
+/*   digits is the array which receives the digits counts             */
+/*   exps   is the array which receives the exponents                 */
+/*   bits   is the array which receives the decNumber bits            */
+/*                                                                    */
+/* Row i holds exactly what decimal128ToNumber would set in the lsu   */
+/* of a decNumber, with any unused Units set to 0, so a decNumber can */
+/* be made by copying a row with digits[i], exps[i], and bits[i].     */
+/*                                                                    */
+/* When DECDPUN is 3 each declet is one Unit, and the 128 bits are    */
+/* handled as two uLongs so only one declet crosses a word; the loop  */
+/* then needs only DPD2BIN lookups, shifts, and stores.  Otherwise    */
+/* each decimal128 is converted by decimal128ToNumber.                */
+/*                                                                    */
+/* No error is possible.                                              */
+/* ------------------------------------------------------------------ */
+void decimal128ArrayToNumberUnits(const decimal128 *d128, Int count,
+                                  Unit *units, Int *digits, Int *exps,
+                                  uByte *bits) {
+  Int  i, n;                       // work
+  #if DECDPUN==3 && DECUSE64
+  uLong lo64, hi64;                // source 128-bit, as two halves
+  uInt sour[4];                    // source 128-bit, as words
+  uInt top;                        // the word with the sign
+  uInt comb, msd, exp;             // ..
+  uInt uiwork;                     // for macros
+
+  for (i=0; i<count; i++, units+=DECIMAL128_Units) {
+    // load source from storage; this is endian
+    if (DECLITEND) {
+      sour[0]=UBTOUI(d128[i].bytes   );
+      sour[1]=UBTOUI(d128[i].bytes+4 );
+      sour[2]=UBTOUI(d128[i].bytes+8 );
+      sour[3]=UBTOUI(d128[i].bytes+12);
+      }
+     else {
+      sour[3]=UBTOUI(d128[i].bytes   );
+      sour[2]=UBTOUI(d128[i].bytes+4 );
+      sour[1]=UBTOUI(d128[i].bytes+8 );
+      sour[0]=UBTOUI(d128[i].bytes+12);
+      }
+    lo64=((uLong)sour[1]<<32) | sour[0];
+    hi64=((uLong)sour[3]<<32) | sour[2];
+    top=sour[3];
+    comb=(top>>26)&0x1f;           // combination field
+    msd=COMBMSD[comb];             // decode the combination field
+    exp=COMBEXP[comb];             // ..
+    bits[i]=(uByte)(top&0x80000000 ? DECNEG : 0);
+
+    if (exp==3) {                  // is a special
+      exps[i]=0;
+      if (msd==0) {                // Infinity has no coefficient
+        bits[i]|=DECINF;
+        lo64=0;
+        hi64=0;
+        }
+       else bits[i]|=(uByte)(top&0x02000000 ? DECSNAN : DECNAN);
+      msd=0;                       // no top digit
+      }
+     else exps[i]=(Int)((exp<<12)+((top>>14)&0xfff))-DECIMAL128_Bias;
+
+    units[0] =DPD2BIN[lo64&0x3ff];
+    units[1] =DPD2BIN[(lo64>>10)&0x3ff];
+    units[2] =DPD2BIN[(lo64>>20)&0x3ff];
+    units[3] =DPD2BIN[(lo64>>30)&0x3ff];
+    units[4] =DPD2BIN[(lo64>>40)&0x3ff];
+    units[5] =DPD2BIN[(lo64>>50)&0x3ff];
+    units[6] =DPD2BIN[((lo64>>60) | (hi64<<4))&0x3ff];
+    units[7] =DPD2BIN[(hi64>>6)&0x3ff];
+    units[8] =DPD2BIN[(hi64>>16)&0x3ff];
+    units[9] =DPD2BIN[(hi64>>26)&0x3ff];
+    units[10]=DPD2BIN[(hi64>>36)&0x3ff];
+    units[11]=(Unit)msd;
+
+    // count the digits from the most significant non-zero Unit
+    for (n=DECIMAL128_Units-1; n>0 && units[n]==0; n--);
+    digits[i]=n*DECDPUN+1;
+    if (units[n]>=10) digits[i]++;
+    if (units[n]>=100) digits[i]++;
+    } // i
+
+  #else
+  decNumber dn;                    // work
+  for (i=0; i<count; i++, units+=DECIMAL128_Units) {
+    decimal128ToNumber(&d128[i], &dn);
+    digits[i]=dn.digits;
+    exps[i]=dn.exponent;
+    bits[i]=dn.bits;
+    for (n=0; n<(Int)D2U(dn.digits); n++) units[n]=dn.lsu[n];
+    for (; n<DECIMAL128_Units; n++) units[n]=0;
+    } // i
+  #endif
+  } // decimal128ArrayToNumberUnits
+
+/* ------------------------------------------------------------------ */
+/* decimal128ArrayFromNumberUnits -- convert decNumber fields to      */
+/*                                   decimal128s                      */
+/*                                                                    */
+/*   d128   is the array of decimal128s which receives the results    */
+/*   count  is the number of decimal128s                              */
+/*   units  is the matrix of count rows of DECIMAL128_Units Units     */
+/*          holding the coefficients (lsu first in each row)          */
+/*   digits is the array of digits counts                             */
+/*   exps   is the array of exponents                                 */
+/*   bits   is the array of decNumber bits                            */
+/*   set    is the context, used only for reporting errors and for    */
+/*          the rounding mode                                         */
+/*                                                                    */
+/* Each row is treated as the coefficient of a decNumber, which must  */
+/* be valid, and is converted as by decimal128FromNumber (rows which  */
+/* do not need rounding, clamping, or subnormal processing are packed */
+/* directly, using BIN2DPD, when DECDPUN is 3).  Any status from the  */
+/* conversions is accumulated in set.                                 */
+/* ------------------------------------------------------------------ */
+void decimal128ArrayFromNumberUnits(decimal128 *d128, Int count,
+                                    const Unit *units, const Int *digits,
+                                    const Int *exps, const uByte *bits,
+                                    decContext *set) {
+  Int  i, n;                       // work
+  decNumber dn;                    // work
+  #if DECDPUN==3 && DECUSE64
+  uLong lo64, hi64;                // target 128-bit, as two halves
+  uInt top;                        // the word with the sign
+  uInt comb, msd, exp;             // ..
+  uInt uiwork;                     // for macros
+  #endif
+
+  for (i=0; i<count; i++, units+=DECIMAL128_Units) {
+    #if DECDPUN==3 && DECUSE64
+    if ((bits[i]&DECSPECIAL)==0    // finite ..
+     && digits[i]<=DECIMAL128_Pmax // .. fits without rounding ..
+     && exps[i]>=-DECIMAL128_Bias  // .. and not clamped ..
+     && exps[i]<=DECIMAL128_Ehigh-DECIMAL128_Bias // .. or folded down
+     && exps[i]+digits[i]-1>=DECIMAL128_Emin) {   // and not subnormal
+      lo64 =(uLong)BIN2DPD[units[0]];
+      lo64|=(uLong)BIN2DPD[units[1]]<<10;
+      lo64|=(uLong)BIN2DPD[units[2]]<<20;
+      lo64|=(uLong)BIN2DPD[units[3]]<<30;
+      lo64|=(uLong)BIN2DPD[units[4]]<<40;
+      lo64|=(uLong)BIN2DPD[units[5]]<<50;
+      lo64|=(uLong)BIN2DPD[units[6]]<<60;
+      hi64 =(uLong)BIN2DPD[units[6]]>>4;
+      hi64|=(uLong)BIN2DPD[units[7]]<<6;
+      hi64|=(uLong)BIN2DPD[units[8]]<<16;
+      hi64|=(uLong)BIN2DPD[units[9]]<<26;
+      hi64|=(uLong)BIN2DPD[units[10]]<<36;
+      msd=units[11];               // [did not really need conversion]
+      exp=(uInt)(exps[i]+DECIMAL128_Bias);   // bias exponent
+      if (msd>=8) comb=0x18 | ((exp>>11) & 0x06) | (msd & 0x01);
+             else comb=((exp>>9) & 0x18) | msd;
+      top=(uInt)(hi64>>32);
+      top|=comb<<26;               // add combination field ..
+      top|=(exp&0xfff)<<14;        // .. and exponent continuation
+      if (bits[i]&DECNEG) top|=0x80000000; // add sign bit
+      // now write to storage; this is endian
+      if (DECLITEND) {
+        (void)UBFROMUI(d128[i].bytes,    (uInt)lo64);
+        (void)UBFROMUI(d128[i].bytes+4,  (uInt)(lo64>>32));
+        (void)UBFROMUI(d128[i].bytes+8,  (uInt)hi64);
+        (void)UBFROMUI(d128[i].bytes+12, top);
+        }
+       else {
+        (void)UBFROMUI(d128[i].bytes,    top);
+        (void)UBFROMUI(d128[i].bytes+4,  (uInt)hi64);
+        (void)UBFROMUI(d128[i].bytes+8,  (uInt)(lo64>>32));
+        (void)UBFROMUI(d128[i].bytes+12, (uInt)lo64);
+        }
+      continue;
+      }
+    #endif
+    // general case: make a decNumber and convert that
+    dn.digits=digits[i];
+    dn.exponent=exps[i];
+    dn.bits=bits[i];
+    for (n=0; n<(Int)D2U(digits[i]); n++) dn.lsu[n]=units[n];
+    decimal128FromNumber(&d128[i], &dn, set);
+    } // i
+  } // decimal128ArrayFromNumberUnits
+
+/* ------------------------------------------------------------------ */
+/* decimal128ToBID -- transcode a decimal128 to the BID encoding      */
+/*                                                                    */
+/*   bid  is the target, which receives the binary integer decimal    */
+/*        (BID) encoding of the same value, in the same byte order as */
+/*        a decimal128                                                */
+/*   d128 is the source decimal128 (DPD encoding); may be the same as */
+/*        bid                                                         */
+/*   returns bid                                                      */
+/*                                                                    */
+/* The coefficient is converted by decBinFromDPD, with no decNumber   */
+/* needed.  The result is canonical: an Infinity has a zero           */
+/* coefficient and a NaN has a zero exponent continuation.  A         */
+/* coefficient always fits in 113 bits, so the form with the implied  */
+/* 100 prefix is never used.                                          */
+/*                                                                    */
+/* No error is possible.                                              */
+/* ------------------------------------------------------------------ */
+decimal128 * decimal128ToBID(decimal128 *bid, const decimal128 *d128) {
+  uInt sour[4];                    // coefficient continuation
+  uInt bin[4];                     // coefficient, binary
+  uInt top;                        // the word with the sign
+  uInt comb, msd, exp;             // ..
+  uInt uiwork;                     // for macros
+
+  // load source from storage; this is endian
+  if (DECLITEND) {
+    sour[0]=UBTOUI(d128->bytes   );
+    sour[1]=UBTOUI(d128->bytes+4 );
+    sour[2]=UBTOUI(d128->bytes+8 );
+    top    =UBTOUI(d128->bytes+12);
+    }
+   else {
+    top    =UBTOUI(d128->bytes   );
+    sour[2]=UBTOUI(d128->bytes+4 );
+    sour[1]=UBTOUI(d128->bytes+8 );
+    sour[0]=UBTOUI(d128->bytes+12);
+    }
+  sour[3]=top&0x00003fff;          // clean coefficient continuation
+  comb=(top>>26)&0x1f;             // combination field
+  msd=COMBMSD[comb];               // decode the combination field
+  exp=COMBEXP[comb];               // ..
+
+  if (exp==3) {                    // is a special
+    if (msd==0) {                  // Infinity
+      bin[3]=0x78000000;
+      bin[2]=0;
+      bin[1]=0;
+      bin[0]=0;
+      }
+     else {                        // NaN; payload is below 10**33
+      decBinFromDPD(bin, 4, sour, 11, 0);
+      bin[3]|=top&0x7e000000;
+      }
+    }
+   else {                          // is a finite number
+    exp=(exp<<12)+((top>>14)&0xfff);        // biased exponent
+    decBinFromDPD(bin, 4, sour, 11, msd);
+    bin[3]|=exp<<17;
+    }
+  bin[3]|=top&0x80000000;          // add sign bit
+
+  // now write to storage; this is endian
+  if (DECLITEND) {
+    (void)UBFROMUI(bid->bytes,    bin[0]);
+    (void)UBFROMUI(bid->bytes+4,  bin[1]);
+    (void)UBFROMUI(bid->bytes+8,  bin[2]);
+    (void)UBFROMUI(bid->bytes+12, bin[3]);
+    }
+   else {
+    (void)UBFROMUI(bid->bytes,    bin[3]);
+    (void)UBFROMUI(bid->bytes+4,  bin[2]);
+    (void)UBFROMUI(bid->bytes+8,  bin[1]);
+    (void)UBFROMUI(bid->bytes+12, bin[0]);
+    }
+  return bid;
+  } // decimal128ToBID
+
+/* ------------------------------------------------------------------ */
+/* decimal128FromBID -- transcode a BID encoding to a decimal128      */
+/*                                                                    */
+/*   d128 is the target decimal128 (DPD encoding)                     */
+/*   bid  is the source, a binary integer decimal (BID) encoding in   */
+/*        the same byte order as a decimal128; may be the same as     */
+/*        d128                                                        */
+/*   returns d128                                                     */
+/*                                                                    */
+/* The coefficient is converted by decBinToDPD, with no decNumber     */
+/* needed, and the result is canonical.  As in IEEE 754, a            */
+/* coefficient greater than 10**34-1 (which includes every            */
+/* coefficient in the form with the implied 100 prefix) is            */
+/* non-canonical and is taken to be 0, as is a NaN payload greater    */
+/* than 10**33-1.                                                     */
+/*                                                                    */
+/* No error is possible.                                              */
+/* ------------------------------------------------------------------ */
+// the greatest canonical coefficient and NaN payload, as for bin
+static const uInt BIDMAX[4]={0xffffffff, 0x378d8e63, 0xbead87c0,
+                             0x0001ed09};
+static const uInt BIDMAXNAN[4]={0xffffffff, 0x38c15b09, 0xc6448d93,
+                                0x0000314d};
+decimal128 * decimal128FromBID(decimal128 *d128, const decimal128 *bid) {
+  uInt targ[4]={0, 0, 0, 0};       // coefficient continuation
+  uInt bin[4];                     // coefficient, binary
+  uInt top;                        // the word with the sign
+  uInt comb, msd, exp;             // ..
+  const uInt *max;                 // greatest canonical bin
+  Int  i;                          // work
+  uInt uiwork;                     // for macros
+
+  // load source from storage; this is endian
+  if (DECLITEND) {
+    bin[0]=UBTOUI(bid->bytes   );
+    bin[1]=UBTOUI(bid->bytes+4 );
+    bin[2]=UBTOUI(bid->bytes+8 );
+    top   =UBTOUI(bid->bytes+12);
+    }
+   else {
+    top   =UBTOUI(bid->bytes   );
+    bin[2]=UBTOUI(bid->bytes+4 );
+    bin[1]=UBTOUI(bid->bytes+8 );
+    bin[0]=UBTOUI(bid->bytes+12);
+    }
+
+  exp=0;
+  if ((top&0x78000000)==0x78000000) {   // is a special
+    bin[3]=top&0x00003fff;         // NaN payload: trailing 110 bits
+    max=BIDMAXNAN;
+    }
+   else if ((top&0x60000000)==0x60000000) { // implied 100 prefix
+    exp=(top>>15)&0x3fff;
+    bin[3]=0xffffffff;             // always over 10**34-1
+    max=BIDMAX;
+    }
+   else {
+    exp=(top>>17)&0x3fff;
+    bin[3]=top&0x0001ffff;
+    max=BIDMAX;
+    }
+  for (i=3; i>0 && bin[i]==max[i]; i--);
+  if (bin[i]>max[i]) {             // non-canonical
+    bin[3]=0;
+    bin[2]=0;
+    bin[1]=0;
+    bin[0]=0;
+    }
+
+  if ((top&0x78000000)==0x78000000) {   // is a special
+    if (top&0x04000000) {          // NaN
+      decBinToDPD(targ, 11, bin, 4);
+      targ[3]|=top&0x7e000000;     // add NaN or sNaN bits
+      }
+     else targ[3]=0x78000000;      // Infinity
+    }
+   else {                          // is a finite number
+    msd=decBinToDPD(targ, 11, bin, 4);
+    if (msd>=8) comb=0x18 | ((exp>>11) & 0x06) | (msd & 0x01);
+           else comb=((exp>>9) & 0x18) | msd;
+    targ[3]|=comb<<26;             // add combination field ..
+    targ[3]|=(exp&0xfff)<<14;      // .. and exponent continuation
+    }
+  targ[3]|=top&0x80000000;         // add sign bit
+
+  // now write to storage; this is endian
+  if (DECLITEND) {
+    (void)UBFROMUI(d128->bytes,    targ[0]);
+    (void)UBFROMUI(d128->bytes+4,  targ[1]);
+    (void)UBFROMUI(d128->bytes+8,  targ[2]);
+    (void)UBFROMUI(d128->bytes+12, targ[3]);
+    }
+   else {
+    (void)UBFROMUI(d128->bytes,    targ[3]);
+    (void)UBFROMUI(d128->bytes+4,  targ[2]);
+    (void)UBFROMUI(d128->bytes+8,  targ[1]);
+    (void)UBFROMUI(d128->bytes+12, targ[0]);
+    }
+  return d128;
+  } // decimal128FromBID
+
+/* ------------------------------------------------------------------ */
+/* decimal128ToKey -- make an order-preserving sort key               */
+/*                                                                    */
+/*   d128 is the source decimal128                                    */
+/*   key  is the target, DECIMAL128_KeyBytes bytes                    */
+/*   returns key                                                      */
+/*                                                                    */
+/* Comparing two keys as unsigned byte strings orders the decimal128s */
+/* as decimal64ToKey does for decimal64s (qv.): as compare-total,     */
+/* except that numerically equal numbers have equal keys (but -0 is   */
+/* just below +0), and NaN exponent continuations are ignored.        */
+/*                                                                    */
+/* No error is possible.                                              */
+/* ------------------------------------------------------------------ */
+uByte * decimal128ToKey(const decimal128 *d128, uByte *key) {
+  uInt sour[4];                    // coefficient continuation
+  uInt top;                        // the word with the sign
+  uInt comb, msd, exp;             // ..
+  Int  special=0;                  // class field for a special
+  uInt uiwork;                     // for macros
+
+  // load source from storage; this is endian
+  if (DECLITEND) {
+    sour[0]=UBTOUI(d128->bytes   );
+    sour[1]=UBTOUI(d128->bytes+4 );
+    sour[2]=UBTOUI(d128->bytes+8 );
+    top    =UBTOUI(d128->bytes+12);
+    }
+   else {
+    top    =UBTOUI(d128->bytes   );
+    sour[2]=UBTOUI(d128->bytes+4 );
+    sour[1]=UBTOUI(d128->bytes+8 );
+    sour[0]=UBTOUI(d128->bytes+12);
+    }
+  sour[3]=top&0x00003fff;          // clean coefficient continuation
+  comb=(top>>26)&0x1f;             // combination field
+  msd=COMBMSD[comb];               // decode the combination field
+  exp=COMBEXP[comb];               // ..
+
+  if (exp==3) {                    // is a special
+    // the class fields follow the largest finite one
+    if (msd==0) {                  // Infinity has no coefficient
+      special=(DECIMAL128_Ehigh+DECIMAL128_Pmax+1)*9;
+      sour[0]=0;
+      sour[1]=0;
+      sour[2]=0;
+      sour[3]=0;
+      }
+     else special=(DECIMAL128_Ehigh+DECIMAL128_Pmax+1)*9
+                  +(top&0x02000000 ? 1 : 2);
+    msd=0;                         // no top digit
+    }
+   else exp=(exp<<12)+((top>>14)&0xfff);    // biased exponent
+
+  decKeyFromDPD(key, 11, sour, msd, (Int)exp, special, top>>31);
+  return key;
+  } // decimal128ToKey
+
+/* ------------------------------------------------------------------ */
+/* decimal128Hash -- hash a decimal128 consistently with equality     */
+/*                                                                    */
+/*   d128 is the decimal128 to hash                                   */
+/*   returns a 32-bit hash of its numerical value                     */
+/*                                                                    */
+/* The hash is that given by decNumberHash for the same value, so all */
+/* the members of a cohort (and both zeros) have equal hashes.  It is */
+/* computed directly from the declets, with no conversion.            */
+/*                                                                    */
+/* No error is possible.                                              */
+/* ------------------------------------------------------------------ */
+uInt decimal128Hash(const decimal128 *d128) {
+  uInt sour[4];                    // coefficient continuation
+  uInt top;                        // the word with the sign
+  uInt comb, msd, exp;             // ..
+  uByte bits;                      // sign and special bits
+  uInt uiwork;                     // for macros
+
+  // load source from storage; this is endian
+  if (DECLITEND) {
+    sour[0]=UBTOUI(d128->bytes   );
+    sour[1]=UBTOUI(d128->bytes+4 );
+    sour[2]=UBTOUI(d128->bytes+8 );
+    top    =UBTOUI(d128->bytes+12);
+    }
+   else {
+    top    =UBTOUI(d128->bytes   );
+    sour[2]=UBTOUI(d128->bytes+4 );
+    sour[1]=UBTOUI(d128->bytes+8 );
+    sour[0]=UBTOUI(d128->bytes+12);
+    }
+  sour[3]=top&0x00003fff;          // clean coefficient continuation
+  comb=(top>>26)&0x1f;             // combination field
+  msd=COMBMSD[comb];               // decode the combination field
+  exp=COMBEXP[comb];               // ..
+  bits=(uByte)(top&0x80000000 ? DECNEG : 0);
+
+  if (exp==3) {                    // is a special [payload not used]
+    bits|=(msd==0 ? DECINF : DECNAN);
+    return decHashFromDPD(11, sour, 0, 0, bits);
+    }
+  exp=(exp<<12)+((top>>14)&0xfff); // biased exponent
+  return decHashFromDPD(11, sour, msd, (Int)exp-DECIMAL128_Bias, bits);
+  } // decimal128Hash
+
 #if DECTRACE || DECCHECK
 /* Macros for accessing decimal128 fields.  These assume the argument
    is a reference (pointer) to the decimal128 structure, and the
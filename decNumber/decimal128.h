@@ -78,4 +78,25 @@
   uint32_t    decimal128IsCanonical(const decimal128 *);
   decimal128 * decimal128Canonical(decimal128 *, const decimal128 *);
 
+  /* Transcoding to and from the BID (binary integer decimal)         */
+  /* encoding, in the same byte order as the DPD encoding             */
+  decimal128 * decimal128ToBID(decimal128 *, const decimal128 *);
+  decimal128 * decimal128FromBID(decimal128 *, const decimal128 *);
+
+  /* Order-preserving sort keys (compare as unsigned byte strings)    */
+  #define DECIMAL128_KeyBytes 16
+  uint8_t    * decimal128ToKey(const decimal128 *, uint8_t *);
+
+  /* Hash consistent with numerical equality (as decNumberHash)       */
+  uint32_t     decimal128Hash(const decimal128 *);
+
+  /* Bulk conversions between decimal128 arrays and rows of decNumber */
+  /* fields; each coefficient is DECIMAL128_Units Units, lsu first    */
+  #define DECIMAL128_Units ((DECIMAL128_Pmax+DECDPUN-1)/DECDPUN)
+  void decimal128ArrayToNumberUnits(const decimal128 *, int32_t,
+                     decNumberUnit *, int32_t *, int32_t *, uint8_t *);
+  void decimal128ArrayFromNumberUnits(decimal128 *, int32_t,
+                     const decNumberUnit *, const int32_t *,
+                     const int32_t *, const uint8_t *, decContext *);
+
 #endif
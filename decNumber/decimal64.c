@@ -44,6 +44,13 @@ extern const uByte  BIN2CHAR[4001];
 
 extern void decDigitsFromDPD(decNumber *, const uInt *, Int);
 extern void decDigitsToDPD(const decNumber *, uInt *, Int);
+extern Int  decDigitsFromString(const char *, uInt *, Int, Int *, uInt *);
+extern void decBinFromDPD(uInt *, Int, const uInt *, Int, uInt);
+extern uInt decBinToDPD(uInt *, Int, uInt *, Int);
+extern void decKeyFromDPD(uByte *, Int, const uInt *, uInt, Int, Int, Flag);
+extern uInt decHashFromDPD(Int, const uInt *, uInt, Int, uByte);
+extern uInt decHashMulAdd(uInt, uInt, uInt);    // [in decNumber.c]
+extern uInt decHashFinish(uInt, Int, uByte);     // ..
 
 #if DECTRACE || DECCHECK
 void decimal64Show(const decimal64 *);            // for debug
@@ -269,27 +276,18 @@ decNumber * decimal64ToNumber(const decimal64 *d64, decNumber *dn) {
 
 
 /* ------------------------------------------------------------------ */
-/* to-scientific-string -- conversion to numeric string               */
-/* to-engineering-string -- conversion to numeric string              */
-/*                                                                    */
-/*   decimal64ToString(d64, string);                                  */
-/*   decimal64ToEngString(d64, string);                               */
+/* decimal64ToChars -- lay out a decimal64 as a string                */
 /*                                                                    */
-/*  d64 is the decimal64 format number to convert                     */
-/*  string is the string where the result will be laid out            */
-/*                                                                    */
-/*  string must be at least 24 characters                             */
+/*   d64    is the decimal64 format number to lay out                 */
+/*   string is where to lay out the number                            */
+/*   eng    is 1 if Engineering, 0 if Scientific                      */
 /*                                                                    */
-/*  No error is possible, and no status can be set.                   */
+/* The coefficient is laid out directly from the declets, using       */
+/* BIN2CHAR, and then the '.', any padding, and the exponent are      */
+/* added; no decNumber is needed.                                     */
 /* ------------------------------------------------------------------ */
-char * decimal64ToEngString(const decimal64 *d64, char *string){
-  decNumber dn;                         // work
-  decimal64ToNumber(d64, &dn);
-  decNumberToEngString(&dn, string);
-  return string;
-  } // decimal64ToEngString
-
-char * decimal64ToString(const decimal64 *d64, char *string){
+static char * decimal64ToChars(const decimal64 *d64, char *string,
+                               Flag eng){
   uInt msd;                        // coefficient MSD
   Int  exp;                        // exponent top two bits or full
   uInt comb;                       // combination field
@@ -378,6 +376,29 @@ char * decimal64ToString(const decimal64 *d64, char *string){
   if (exp>0 || pre<-5) {           // need exponential form
     e=pre-1;                       // calculate E value
     pre=1;                         // assume one digit before '.'
+    if (eng && e!=0) {             // engineering: may need to adjust
+      Int adj;                     // adjustment
+      // The C remainder operator is undefined for negative numbers, so
+      // a positive remainder calculation must be used here
+      if (e<0) {
+        adj=(-e)%3;
+        if (adj!=0) adj=3-adj;
+        }
+       else { // e>0
+        adj=e%3;
+        }
+      e=e-adj;
+      // if dealing with zero still produce an exponent which is a
+      // multiple of three, as expected, but there will only be the
+      // one zero before the E, still.  Otherwise note the padding.
+      if (c-cstart!=1 || *cstart!='0') pre+=adj;
+       else {  // is zero
+        if (adj!=0) {              // 0.00Esnn needed
+          e=e+3;
+          pre=-(2-adj);
+          }
+        } // zero
+      } // eng
     } // exponential form
 
   /* modify the coefficient, adding 0s, '.', and E+nn as needed */
@@ -390,35 +411,58 @@ char * decimal64ToString(const decimal64 *d64, char *string){
       *t='.';                           // insert the dot
       c++;                              // length increased by one
       }
-
-    // finally add the E-part, if needed; it will never be 0, and has
-    // a maximum length of 3 digits
-    if (e!=0) {
-      *c++='E';                    // starts with E
-      *c++='+';                    // assume positive
-      if (e<0) {
-        *(c-1)='-';                // oops, need '-'
-        e=-e;                      // uInt, please
-        }
-      u=&BIN2CHAR[e*4];            // -> length byte
-      memcpy(c, u+4-*u, 4);        // copy fixed 4 characters [is safe]
-      c+=*u;                       // bump pointer appropriately
-      }
-    *c='\0';                       // add terminator
-    //printf("res %s\n", string);
-    return string;
+     else for (; c<dotat; c++) *c='0';  // 0 padding (for engineering)
     } // pre>0
+   else {
+    /* -5<=pre<=0: here for plain 0.ddd or 0.000ddd forms (which can
+       only have an E if an engineering zero) */
+    t=c+1-pre;
+    c=t+1;                              // end of the laid-out number
+    for (; s>=cstart; s--, t--) *t=*s;  // shift whole coefficient right
+    t=cstart;
+    *t++='0';                           // always starts with 0.
+    *t++='.';
+    for (; pre<0; pre++) *t++='0';      // add any 0's after '.'
+    }
 
-  /* -5<=pre<=0: here for plain 0.ddd or 0.000ddd forms (can never have E) */
-  t=c+1-pre;
-  *(t+1)='\0';                          // can add terminator now
-  for (; s>=cstart; s--, t--) *t=*s;    // shift whole coefficient right
-  c=cstart;
-  *c++='0';                             // always starts with 0.
-  *c++='.';
-  for (; pre<0; pre++) *c++='0';        // add any 0's after '.'
+  // finally add the E-part, if needed; it will never be 0, and has
+  // a maximum length of 3 digits
+  if (e!=0) {
+    *c++='E';                      // starts with E
+    *c++='+';                      // assume positive
+    if (e<0) {
+      *(c-1)='-';                  // oops, need '-'
+      e=-e;                        // uInt, please
+      }
+    u=&BIN2CHAR[e*4];              // -> length byte
+    memcpy(c, u+4-*u, 4);          // copy fixed 4 characters [is safe]
+    c+=*u;                         // bump pointer appropriately
+    }
+  *c='\0';                           // add terminator
   //printf("res %s\n", string);
   return string;
+  } // decimal64ToChars
+
+/* ------------------------------------------------------------------ */
+/* to-scientific-string -- conversion to numeric string               */
+/* to-engineering-string -- conversion to numeric string              */
+/*                                                                    */
+/*   decimal64ToString(d64, string);                                  */
+/*   decimal64ToEngString(d64, string);                               */
+/*                                                                    */
+/*  d64 is the decimal64 format number to convert                     */
+/*  string is the string where the result will be laid out            */
+/*                                                                    */
+/*  string must be at least 24 characters                             */
+/*                                                                    */
+/*  No error is possible, and no status can be set.                   */
+/* ------------------------------------------------------------------ */
+char * decimal64ToEngString(const decimal64 *d64, char *string){
+  return decimal64ToChars(d64, string, 1);
+  } // decimal64ToEngString
+
+char * decimal64ToString(const decimal64 *d64, char *string){
+  return decimal64ToChars(d64, string, 0);
   } // decimal64ToString
 
 /* ------------------------------------------------------------------ */
@@ -435,11 +479,44 @@ char * decimal64ToString(const decimal64 *d64, char *string){
 /* The context is supplied to this routine is used for error handling */
 /* (setting of status and traps) and for the rounding mode, only.     */
 /* If an error occurs, the result will be a valid decimal64 NaN.      */
+/*                                                                    */
+/* A plain number which fits exactly (no rounding or clamping, and    */
+/* not subnormal) is packed directly from the string; all others are  */
+/* converted by way of a decNumber.                                   */
 /* ------------------------------------------------------------------ */
 decimal64 * decimal64FromString(decimal64 *result, const char *string,
                                 decContext *set) {
   decContext dc;                             // work
   decNumber dn;                              // ..
+  const char *c=string;                      // -> after sign
+  uInt targar[2]={0, 0};                     // target 64-bit
+  uInt msd, comb, exp;                       // work
+  uInt uiwork;                               // for macros
+  Int  d, e;                                 // digits and exponent
+
+  // fastpath: plain numbers which fit exactly need no decNumber
+  if (*c=='-' || *c=='+') c++;
+  d=decDigitsFromString(c, targar, 5, &e, &msd);
+  if (d>0
+   && e>=-DECIMAL64_Bias                     // not clamped ..
+   && e<=DECIMAL64_Ehigh-DECIMAL64_Bias      // .. or folded down
+   && e+d-1>=DECIMAL64_Emin) {               // and not subnormal
+    exp=(uInt)(e+DECIMAL64_Bias);            // bias exponent
+    if (msd>=8) comb=0x18 | ((exp>>7) & 0x06) | (msd & 0x01);
+           else comb=((exp>>5) & 0x18) | msd;
+    targhi|=comb<<26;                        // add combination field ..
+    targhi|=(exp&0xff)<<18;                  // .. and exponent continuation
+    if (*string=='-') targhi|=0x80000000;    // add sign bit
+    if (DECLITEND) {
+      (void)UBFROMUI(result->bytes,   targar[0]);
+      (void)UBFROMUI(result->bytes+4, targar[1]);
+      }
+     else {
+      (void)UBFROMUI(result->bytes,   targar[1]);
+      (void)UBFROMUI(result->bytes+4, targar[0]);
+      }
+    return result;
+    }
 
   decContextDefault(&dc, DEC_INIT_DECIMAL64); // no traps, please
   dc.round=set->round;                        // use supplied rounding
@@ -485,6 +562,491 @@ decimal64 * decimal64Canonical(decimal64 *result, const decimal64 *d64) {
   return result;
   } // decimal64Canonical
 
+/* ------------------------------------------------------------------ */
+/* decimal64ArrayToNumberUnits -- convert decimal64s to decNumber     */
+/*                                fields                              */
+/*                                                                    */
+/*   d64    is the array of decimal64s to convert                     */
+/*   count  is the number of decimal64s                               */
+/*   units  is the matrix of count rows of DECIMAL64_Units Units      */
+/*          which receives the coefficients (lsu first in each row)   */
+/*   digits is the array which receives the digits counts             */
+/*   exps   is the array which receives the exponents                 */
+/*   bits   is the array which receives the decNumber bits            */
+/*                                                                    */
+/* Row i holds exactly what decimal64ToNumber would set in the lsu    */
+/* of a decNumber, with any unused Units set to 0, so a decNumber can */
+/* be made by copying a row with digits[i], exps[i], and bits[i].     */
+/*                                                                    */
+/* When DECDPUN is 3 each declet is one Unit, and the 64 bits are     */
+/* handled as a single uLong so no declet crosses a word; the loop    */
+/* then needs only DPD2BIN lookups, shifts, and stores.  Otherwise    */
+/* each decimal64 is converted by decimal64ToNumber.                  */
+/*                                                                    */
+/* No error is possible.                                              */
+/* ------------------------------------------------------------------ */
+void decimal64ArrayToNumberUnits(const decimal64 *d64, Int count,
+                                 Unit *units, Int *digits, Int *exps,
+                                 uByte *bits) {
+  Int  i, n;                       // work
+  #if DECDPUN==3 && DECUSE64
+  uLong sour;                      // source 64-bit
+  uInt top, low;                   // the word with the sign, the other
+  uInt comb, msd, exp;             // ..
+  uInt uiwork;                     // for macros
+
+  for (i=0; i<count; i++, units+=DECIMAL64_Units) {
+    // load source from storage; this is endian
+    if (DECLITEND) {
+      low=UBTOUI(d64[i].bytes);
+      top=UBTOUI(d64[i].bytes+4);
+      }
+     else {
+      top=UBTOUI(d64[i].bytes);
+      low=UBTOUI(d64[i].bytes+4);
+      }
+    sour=((uLong)top<<32) | low;
+    comb=(top>>26)&0x1f;           // combination field
+    msd=COMBMSD[comb];             // decode the combination field
+    exp=COMBEXP[comb];             // ..
+    bits[i]=(uByte)(top&0x80000000 ? DECNEG : 0);
+
+    if (exp==3) {                  // is a special
+      exps[i]=0;
+      if (msd==0) {                // Infinity has no coefficient
+        bits[i]|=DECINF;
+        sour=0;
+        }
+       else bits[i]|=(uByte)(top&0x02000000 ? DECSNAN : DECNAN);
+      msd=0;                       // no top digit
+      }
+     else exps[i]=(Int)((exp<<8)+((top>>18)&0xff))-DECIMAL64_Bias;
+
+    units[0]=DPD2BIN[sour&0x3ff];
+    units[1]=DPD2BIN[(sour>>10)&0x3ff];
+    units[2]=DPD2BIN[(sour>>20)&0x3ff];
+    units[3]=DPD2BIN[(sour>>30)&0x3ff];
+    units[4]=DPD2BIN[(sour>>40)&0x3ff];
+    units[5]=(Unit)msd;
+
+    // count the digits from the most significant non-zero Unit
+    for (n=DECIMAL64_Units-1; n>0 && units[n]==0; n--);
+    digits[i]=n*DECDPUN+1;
+    if (units[n]>=10) digits[i]++;
+    if (units[n]>=100) digits[i]++;
+    } // i
+
+  #else
+  decNumber dn;                    // work
+  for (i=0; i<count; i++, units+=DECIMAL64_Units) {
+    decimal64ToNumber(&d64[i], &dn);
+    digits[i]=dn.digits;
+    exps[i]=dn.exponent;
+    bits[i]=dn.bits;
+    for (n=0; n<(Int)D2U(dn.digits); n++) units[n]=dn.lsu[n];
+    for (; n<DECIMAL64_Units; n++) units[n]=0;
+    } // i
+  #endif
+  } // decimal64ArrayToNumberUnits
+
+/* ------------------------------------------------------------------ */
+/* decimal64ArrayFromNumberUnits -- convert decNumber fields to       */
+/*                                  decimal64s                        */
+/*                                                                    */
+/*   d64    is the array of decimal64s which receives the results     */
+/*   count  is the number of decimal64s                               */
+/*   units  is the matrix of count rows of DECIMAL64_Units Units      */
+/*          holding the coefficients (lsu first in each row)          */
+/*   digits is the array of digits counts                             */
+/*   exps   is the array of exponents                                 */
+/*   bits   is the array of decNumber bits                            */
+/*   set    is the context, used only for reporting errors and for    */
+/*          the rounding mode                                         */
+/*                                                                    */
+/* Each row is treated as the coefficient of a decNumber, which must  */
+/* be valid, and is converted as by decimal64FromNumber (rows which   */
+/* do not need rounding, clamping, or subnormal processing are packed */
+/* directly, using BIN2DPD, when DECDPUN is 3).  Any status from the  */
+/* conversions is accumulated in set.                                 */
+/* ------------------------------------------------------------------ */
+void decimal64ArrayFromNumberUnits(decimal64 *d64, Int count,
+                                   const Unit *units, const Int *digits,
+                                   const Int *exps, const uByte *bits,
+                                   decContext *set) {
+  Int  i, n;                       // work
+  decNumber dn;                    // work
+  #if DECDPUN==3 && DECUSE64
+  uLong targ;                      // target 64-bit
+  uInt top;                        // the word with the sign
+  uInt comb, msd, exp;             // ..
+  uInt uiwork;                     // for macros
+  #endif
+
+  for (i=0; i<count; i++, units+=DECIMAL64_Units) {
+    #if DECDPUN==3 && DECUSE64
+    if ((bits[i]&DECSPECIAL)==0    // finite ..
+     && digits[i]<=DECIMAL64_Pmax  // .. fits without rounding ..
+     && exps[i]>=-DECIMAL64_Bias   // .. and not clamped ..
+     && exps[i]<=DECIMAL64_Ehigh-DECIMAL64_Bias   // .. or folded down
+     && exps[i]+digits[i]-1>=DECIMAL64_Emin) {    // and not subnormal
+      targ =(uLong)BIN2DPD[units[0]];
+      targ|=(uLong)BIN2DPD[units[1]]<<10;
+      targ|=(uLong)BIN2DPD[units[2]]<<20;
+      targ|=(uLong)BIN2DPD[units[3]]<<30;
+      targ|=(uLong)BIN2DPD[units[4]]<<40;
+      msd=units[5];                // [did not really need conversion]
+      exp=(uInt)(exps[i]+DECIMAL64_Bias);    // bias exponent
+      if (msd>=8) comb=0x18 | ((exp>>7) & 0x06) | (msd & 0x01);
+             else comb=((exp>>5) & 0x18) | msd;
+      top=(uInt)(targ>>32);
+      top|=comb<<26;               // add combination field ..
+      top|=(exp&0xff)<<18;         // .. and exponent continuation
+      if (bits[i]&DECNEG) top|=0x80000000; // add sign bit
+      // now write to storage; this is endian
+      if (DECLITEND) {
+        (void)UBFROMUI(d64[i].bytes,   (uInt)targ);
+        (void)UBFROMUI(d64[i].bytes+4, top);
+        }
+       else {
+        (void)UBFROMUI(d64[i].bytes,   top);
+        (void)UBFROMUI(d64[i].bytes+4, (uInt)targ);
+        }
+      continue;
+      }
+    #endif
+    // general case: make a decNumber and convert that
+    dn.digits=digits[i];
+    dn.exponent=exps[i];
+    dn.bits=bits[i];
+    for (n=0; n<(Int)D2U(digits[i]); n++) dn.lsu[n]=units[n];
+    decimal64FromNumber(&d64[i], &dn, set);
+    } // i
+  } // decimal64ArrayFromNumberUnits
+
+/* ------------------------------------------------------------------ */
+/* decimal64ToBID -- transcode a decimal64 to the BID encoding        */
+/*                                                                    */
+/*   bid is the target, which receives the binary integer decimal     */
+/*       (BID) encoding of the same value, in the same byte order as  */
+/*       a decimal64                                                  */
+/*   d64 is the source decimal64 (DPD encoding); may be the same as   */
+/*       bid                                                          */
+/*   returns bid                                                      */
+/*                                                                    */
+/* The coefficient is converted by decBinFromDPD, with no decNumber   */
+/* needed.  The result is canonical: an Infinity has a zero           */
+/* coefficient and a NaN has a zero exponent continuation.  When the  */
+/* coefficient needs more than 53 bits it is stored in the form with  */
+/* the implied 100 prefix.                                            */
+/*                                                                    */
+/* No error is possible.                                              */
+/* ------------------------------------------------------------------ */
+decimal64 * decimal64ToBID(decimal64 *bid, const decimal64 *d64) {
+  uInt sour[2];                    // coefficient continuation
+  uInt bin[2];                     // coefficient, binary
+  uInt top;                        // the word with the sign
+  uInt comb, msd, exp;             // ..
+  uInt uiwork;                     // for macros
+
+  // load source from storage; this is endian
+  if (DECLITEND) {
+    sour[0]=UBTOUI(d64->bytes);
+    top=UBTOUI(d64->bytes+4);
+    }
+   else {
+    top=UBTOUI(d64->bytes);
+    sour[0]=UBTOUI(d64->bytes+4);
+    }
+  sour[1]=top&0x0003ffff;          // clean coefficient continuation
+  comb=(top>>26)&0x1f;             // combination field
+  msd=COMBMSD[comb];               // decode the combination field
+  exp=COMBEXP[comb];               // ..
+
+  if (exp==3) {                    // is a special
+    if (msd==0) {                  // Infinity
+      bin[1]=0x78000000;
+      bin[0]=0;
+      }
+     else {                        // NaN; payload is below 10**15
+      decBinFromDPD(bin, 2, sour, 5, 0);
+      bin[1]|=top&0x7e000000;
+      }
+    }
+   else {                          // is a finite number
+    exp=(exp<<8)+((top>>18)&0xff); // biased exponent
+    decBinFromDPD(bin, 2, sour, 5, msd);
+    if (bin[1]<0x00200000) bin[1]|=exp<<21;   // fits in 53 bits
+     else bin[1]=0x60000000|(exp<<19)|(bin[1]&0x0007ffff);
+    }
+  bin[1]|=top&0x80000000;          // add sign bit
+
+  // now write to storage; this is endian
+  if (DECLITEND) {
+    (void)UBFROMUI(bid->bytes,   bin[0]);
+    (void)UBFROMUI(bid->bytes+4, bin[1]);
+    }
+   else {
+    (void)UBFROMUI(bid->bytes,   bin[1]);
+    (void)UBFROMUI(bid->bytes+4, bin[0]);
+    }
+  return bid;
+  } // decimal64ToBID
+
+/* ------------------------------------------------------------------ */
+/* decimal64FromBID -- transcode a BID encoding to a decimal64        */
+/*                                                                    */
+/*   d64 is the target decimal64 (DPD encoding)                       */
+/*   bid is the source, a binary integer decimal (BID) encoding in    */
+/*       the same byte order as a decimal64; may be the same as d64   */
+/*   returns d64                                                      */
+/*                                                                    */
+/* The coefficient is converted by decBinToDPD, with no decNumber     */
+/* needed, and the result is canonical.  As in IEEE 754, a            */
+/* coefficient greater than 10**16-1 is non-canonical and is taken    */
+/* to be 0, as is a NaN payload greater than 10**15-1.                */
+/*                                                                    */
+/* No error is possible.                                              */
+/* ------------------------------------------------------------------ */
+decimal64 * decimal64FromBID(decimal64 *d64, const decimal64 *bid) {
+  uInt targ[2]={0, 0};             // coefficient continuation
+  uInt bin[2];                     // coefficient, binary
+  uInt top;                        // the word with the sign
+  uInt comb, msd, exp;             // ..
+  uInt uiwork;                     // for macros
+
+  // load source from storage; this is endian
+  if (DECLITEND) {
+    bin[0]=UBTOUI(bid->bytes);
+    top=UBTOUI(bid->bytes+4);
+    }
+   else {
+    top=UBTOUI(bid->bytes);
+    bin[0]=UBTOUI(bid->bytes+4);
+    }
+
+  if ((top&0x78000000)==0x78000000) {   // is a special
+    if (top&0x04000000) {          // NaN
+      bin[1]=top&0x0003ffff;       // payload is the trailing 50 bits
+      if (bin[1]>0x38d7e                // payload over 10**15-1
+       || (bin[1]==0x38d7e && bin[0]>=0xa4c68000)) {
+        bin[1]=0;
+        bin[0]=0;
+        }
+      decBinToDPD(targ, 5, bin, 2);
+      targ[1]|=top&0x7e000000;     // add NaN or sNaN bits
+      }
+     else targ[1]=0x78000000;      // Infinity
+    }
+   else {                          // is a finite number
+    if ((top&0x60000000)==0x60000000) {     // implied 100 prefix
+      exp=(top>>19)&0x3ff;
+      bin[1]=0x00200000|(top&0x0007ffff);
+      if (bin[1]>0x2386f2                   // over 10**16-1
+       || (bin[1]==0x2386f2 && bin[0]>0x6fc0ffff)) {
+        bin[1]=0;
+        bin[0]=0;
+        }
+      }
+     else {
+      exp=(top>>21)&0x3ff;
+      bin[1]=top&0x001fffff;
+      }
+    msd=decBinToDPD(targ, 5, bin, 2);
+    if (msd>=8) comb=0x18 | ((exp>>7) & 0x06) | (msd & 0x01);
+           else comb=((exp>>5) & 0x18) | msd;
+    targ[1]|=comb<<26;             // add combination field ..
+    targ[1]|=(exp&0xff)<<18;       // .. and exponent continuation
+    }
+  targ[1]|=top&0x80000000;         // add sign bit
+
+  // now write to storage; this is endian
+  if (DECLITEND) {
+    (void)UBFROMUI(d64->bytes,   targ[0]);
+    (void)UBFROMUI(d64->bytes+4, targ[1]);
+    }
+   else {
+    (void)UBFROMUI(d64->bytes,   targ[1]);
+    (void)UBFROMUI(d64->bytes+4, targ[0]);
+    }
+  return d64;
+  } // decimal64FromBID
+
+/* ------------------------------------------------------------------ */
+/* decimal64ToKey -- make an order-preserving sort key                */
+/*                                                                    */
+/*   d64 is the source decimal64                                      */
+/*   key is the target, DECIMAL64_KeyBytes bytes                      */
+/*   returns key                                                      */
+/*                                                                    */
+/* Comparing two keys as unsigned byte strings (for example, with     */
+/* memcmp) orders them as the decimal64s would be ordered by          */
+/* decNumberCompareTotal, except that:                                */
+/*                                                                    */
+/*   -- numerically equal numbers (members of a cohort, such as 1.0   */
+/*      and 1.00) have equal keys; compare-total orders them by       */
+/*      exponent.  The exception is -0, whose key is just below that  */
+/*      of +0.                                                        */
+/*                                                                    */
+/*   -- the exponent continuation of a NaN is ignored, as is the msd. */
+/*                                                                    */
+/* So, NaNs sort outside all other values: -NaN, -sNaN (in each case  */
+/* larger payloads first), -Infinity, the negative numbers, -0, +0,   */
+/* the positive numbers, Infinity, sNaN, and NaN (in each case        */
+/* smaller payloads first).  The key is laid out by decKeyFromDPD.    */
+/*                                                                    */
+/* No error is possible.                                              */
+/* ------------------------------------------------------------------ */
+uByte * decimal64ToKey(const decimal64 *d64, uByte *key) {
+  uInt sour[2];                    // coefficient continuation
+  uInt top;                        // the word with the sign
+  uInt comb, msd, exp;             // ..
+  Int  special=0;                  // class field for a special
+  uInt uiwork;                     // for macros
+
+  // load source from storage; this is endian
+  if (DECLITEND) {
+    sour[0]=UBTOUI(d64->bytes);
+    top=UBTOUI(d64->bytes+4);
+    }
+   else {
+    top=UBTOUI(d64->bytes);
+    sour[0]=UBTOUI(d64->bytes+4);
+    }
+  sour[1]=top&0x0003ffff;          // clean coefficient continuation
+  comb=(top>>26)&0x1f;             // combination field
+  msd=COMBMSD[comb];               // decode the combination field
+  exp=COMBEXP[comb];               // ..
+
+  if (exp==3) {                    // is a special
+    // the class fields follow the largest finite one
+    if (msd==0) {                  // Infinity has no coefficient
+      special=(DECIMAL64_Ehigh+DECIMAL64_Pmax+1)*9;
+      sour[0]=0;
+      sour[1]=0;
+      }
+     else special=(DECIMAL64_Ehigh+DECIMAL64_Pmax+1)*9
+                  +(top&0x02000000 ? 1 : 2);
+    msd=0;                         // no top digit
+    }
+   else exp=(exp<<8)+((top>>18)&0xff);      // biased exponent
+
+  decKeyFromDPD(key, 5, sour, msd, (Int)exp, special, top>>31);
+  return key;
+  } // decimal64ToKey
+
+/* ------------------------------------------------------------------ */
+/* decimal64Sort -- sort decimal64s into ascending order              */
+/*                                                                    */
+/*   d64   is the array of decimal64s to sort, in place               */
+/*   count is the number of decimal64s                                */
+/*   set   is the context, used only for its allocator and for        */
+/*         reporting errors                                           */
+/*                                                                    */
+/* The order is that of the keys made by decimal64ToKey, and the sort */
+/* is stable, so members of a cohort (and NaNs which differ only in   */
+/* ignored bits) keep their original order.                           */
+/*                                                                    */
+/* This is a least-significant-byte-first radix sort of records each  */
+/* holding a key and its decimal64.  The counts for all eight passes  */
+/* are made in one scan, and a pass is skipped when every key has the */
+/* same byte in that position, as the class field bytes often do.     */
+/* It needs 4*count*DECIMAL64_KeyBytes bytes of working storage, from */
+/* the allocator of set (see decContextGetAllocator) or else the      */
+/* thread scratch workspace, as for decNumber operations; if that is  */
+/* not available the array is unchanged and Insufficient_storage is   */
+/* set.                                                               */
+/* ------------------------------------------------------------------ */
+#define DECRECORD (DECIMAL64_KeyBytes+DECIMAL64_Bytes) // record size
+void decimal64Sort(decimal64 *d64, Int count, decContext *set) {
+  const decAllocator *allocator=decContextGetAllocator(set);
+  uInt  counts[DECIMAL64_KeyBytes][256];  // byte counts, then offsets
+  uByte *work, *from, *to, *swap;  // records
+  uByte *rec;                      // ..
+  uInt  total, next;               // work
+  Int   i, b;                      // ..
+
+  if (count<2) return;
+  if (allocator!=NULL)
+    work=(uByte *)(*allocator->alloc)(allocator->opaque,
+                                      (size_t)count*DECRECORD*2);
+   else work=(uByte *)decWorkAlloc((size_t)count*DECRECORD*2);
+  if (work==NULL) {
+    decContextSetStatus(set, DEC_Insufficient_storage);
+    return;
+    }
+  from=work;
+  to=work+(size_t)count*DECRECORD;
+
+  memset(counts, 0, sizeof(counts));
+  for (i=0, rec=from; i<count; i++, rec+=DECRECORD) {
+    decimal64ToKey(&d64[i], rec);
+    memcpy(rec+DECIMAL64_KeyBytes, &d64[i], DECIMAL64_Bytes);
+    for (b=0; b<DECIMAL64_KeyBytes; b++) counts[b][rec[b]]++;
+    }
+
+  for (b=DECIMAL64_KeyBytes-1; b>=0; b--) {     // least significant first
+    if (counts[b][from[b]]==(uInt)count) continue;   // all the same
+    for (i=0, total=0; i<256; i++) {   // counts to offsets
+      next=total+counts[b][i];
+      counts[b][i]=total;
+      total=next;
+      }
+    for (i=0, rec=from; i<count; i++, rec+=DECRECORD) {
+      next=counts[b][rec[b]]++;
+      memcpy(to+(size_t)next*DECRECORD, rec, DECRECORD);
+      }
+    swap=from; from=to; to=swap;
+    } // b
+
+  for (i=0, rec=from; i<count; i++, rec+=DECRECORD) {
+    memcpy(&d64[i], rec+DECIMAL64_KeyBytes, DECIMAL64_Bytes);
+    }
+  if (allocator!=NULL) (*allocator->release)(allocator->opaque, work);
+   else decWorkRelease(work);
+  } // decimal64Sort
+
+/* ------------------------------------------------------------------ */
+/* decimal64Hash -- hash a decimal64 consistently with equality       */
+/*                                                                    */
+/*   d64 is the decimal64 to hash                                     */
+/*   returns a 32-bit hash of its numerical value                     */
+/*                                                                    */
+/* The hash is that given by decNumberHash for the same value, so all */
+/* the members of a cohort (and both zeros) have equal hashes.  It is */
+/* computed directly from the declets, with no conversion.            */
+/*                                                                    */
+/* No error is possible.                                              */
+/* ------------------------------------------------------------------ */
+uInt decimal64Hash(const decimal64 *d64) {
+  uInt sour[2];                    // coefficient continuation
+  uInt top;                        // the word with the sign
+  uInt comb, msd, exp;             // ..
+  uByte bits;                      // sign and special bits
+  uInt uiwork;                     // for macros
+
+  // load source from storage; this is endian
+  if (DECLITEND) {
+    sour[0]=UBTOUI(d64->bytes);
+    top=UBTOUI(d64->bytes+4);
+    }
+   else {
+    top=UBTOUI(d64->bytes);
+    sour[0]=UBTOUI(d64->bytes+4);
+    }
+  sour[1]=top&0x0003ffff;          // clean coefficient continuation
+  comb=(top>>26)&0x1f;             // combination field
+  msd=COMBMSD[comb];               // decode the combination field
+  exp=COMBEXP[comb];               // ..
+  bits=(uByte)(top&0x80000000 ? DECNEG : 0);
+
+  if (exp==3) {                    // is a special [payload not used]
+    bits|=(msd==0 ? DECINF : DECNAN);
+    return decHashFromDPD(5, sour, 0, 0, bits);
+    }
+  exp=(exp<<8)+((top>>18)&0xff);   // biased exponent
+  return decHashFromDPD(5, sour, msd, (Int)exp-DECIMAL64_Bias, bits);
+  } // decimal64Hash
+
 #if DECTRACE || DECCHECK
 /* Macros for accessing decimal64 fields.  These assume the
    argument is a reference (pointer) to the decimal64 structure,
@@ -746,9 +1308,6 @@ void decDigitsFromDPD(decNumber *dn, const uInt *sour, Int declets) {
   Unit  out=0;                     // accumulator
   Int   cut=0;                     // power of ten in current unit
   #endif
-  #if DECDPUN>4
-  uInt const *pow;                 // work
-  #endif
 
   // Expand the densely-packed integer, right to left
   for (n=declets-1; n>=0; n--) {   // count down declets of 10 bits
@@ -816,24 +1375,367 @@ void decDigitsFromDPD(decNumber *dn, const uInt *sour, Int declets) {
   #endif
 
   // here, last points to the most significant unit with digits;
-  // inspect it to get the final digits count -- this is essentially
-  // the same code as decGetDigits in decNumber.c
-  dn->digits=(last-dn->lsu)*DECDPUN+1;  // floor of digits, plus
-                                        // must be at least 1 digit
-  #if DECDPUN>1
-  if (*last<10) return;                 // common odd digit or 0
-  dn->digits++;                         // must be 2 at least
-  #if DECDPUN>2
-  if (*last<100) return;                // 10-99
-  dn->digits++;                         // must be 3 at least
-  #if DECDPUN>3
-  if (*last<1000) return;               // 100-999
-  dn->digits++;                         // must be 4 at least
-  #if DECDPUN>4
-  for (pow=&DECPOWERS[4]; *last>=*pow; pow++) dn->digits++;
-  #endif
+  // count its digits to get the final digits count -- as in
+  // decGetDigits in decNumber.c
+  dn->digits=(last-dn->lsu)*DECDPUN+UNITDIGITS(*last);
+  return;
+  } //decDigitsFromDPD
+
+/* ------------------------------------------------------------------ */
+/* decDigitsFromString -- pack a plain numeric string into DPD form   */
+/*                                                                    */
+/*   string  is the number, with any sign already removed             */
+/*   targ    is 2 or 4-element uInt array, which the caller must      */
+/*           have cleared to zeros                                    */
+/*   declets is the number of declets in the coefficient continuation */
+/*           (5 or 11)                                                */
+/*   exp     receives the exponent                                    */
+/*   msd     receives the most significant (combination field) digit  */
+/*                                                                    */
+/* returns the number of digits in the coefficient, or 0 if the       */
+/* string is not a plain finite number with no more than 3*declets+1  */
+/* significant digits and a short exponent, in which case targ, exp,  */
+/* and msd are undefined.                                             */
+/*                                                                    */
+/* The extent of the coefficient is found first, and its digits are   */
+/* then packed directly from the string, from the right, three at a   */
+/* time using BIN2DPD (stepping over any '.').  The declets are       */
+/* placed as for decDigitsToDPD, except that the msd is returned      */
+/* rather than being added to the coefficient continuation.  Leading  */
+/* zeros are not significant; a zero coefficient has 1 digit.         */
+/*                                                                    */
+/* Strings which are not handled here (specials, syntax errors, and   */
+/* those needing rounding) are left to decNumberFromString.           */
+/* ------------------------------------------------------------------ */
+// DIGIT -- macro to fetch the next digit leftwards into b
+#define DIGIT(b) {if (c==dotchar) c--; b=(uInt)(*c-'0'); c--;}
+Int decDigitsFromString(const char *string, uInt *targ, Int declets,
+                        Int *exp, uInt *msd) {
+  const char *c;                   // -> current character
+  const char *dotchar=NULL;        // -> '.', if any
+  const char *last;                // -> last coefficient character
+  const char *first;               // -> first significant digit
+  Int  d;                          // count of significant digits
+  Int  digits;                     // count of coefficient digits
+  Int  e=0;                        // E-part value
+  Int  n;                          // work
+  uInt b0, b1, b2;                 // digits
+  uInt dpd;                        // densely packed decimal value
+  uInt uoff;                       // bit offset of declet
+
+  for (c=string; *c>='0' && *c<='9'; c++);    // integer part
+  if (*c=='.') {                               // fraction part
+    dotchar=c;
+    for (c++; *c>='0' && *c<='9'; c++);
+    }
+  last=c-1;
+  digits=(Int)(c-string);
+  if (dotchar!=NULL) digits--;
+  if (digits==0) return 0;         // no digits: '.', Inf, etc.
+
+  if (*c=='e' || *c=='E') {        // have an E-part
+    Flag eneg=0;                   // 1 if exponent negative
+    c++;
+    if (*c=='-') {
+      eneg=1;
+      c++;
+      }
+     else if (*c=='+') c++;
+    if (*c=='\0') return 0;        // no exponent digits
+    for (; *c=='0'; c++);          // skip leading zeros
+    for (n=0; *c>='0' && *c<='9'; c++, n++) {
+      if (n==9) return 0;          // too long for this path
+      e=e*10+(Int)(*c-'0');
+      }
+    if (eneg) e=-e;
+    }
+  if (*c!='\0') return 0;          // junk at end [syntax error]
+  if (dotchar!=NULL) e-=(Int)(last-dotchar);  // digits after '.'
+  *exp=e;
+
+  for (first=string; *first=='0' || first==dotchar; first++);
+  d=(Int)(last-first)+1;           // [may be 0]
+  if (dotchar!=NULL && first<dotchar) d--;
+  if (d>declets*3+1) return 0;     // would need rounding
+
+  // pack the declets from the right; the digit beyond the declets,
+  // if any, is the msd
+  *msd=0;
+  c=last;
+  for (n=d, uoff=0; n>0; n-=3, uoff+=10) {
+    if (n>=3) {
+      DIGIT(b0); DIGIT(b1); DIGIT(b2);
+      dpd=BIN2DPD[b2*100+b1*10+b0];
+      }
+     else {
+      DIGIT(b0);
+      b1=0;
+      if (n==2) DIGIT(b1);
+      if (uoff==(uInt)declets*10) {     // only the msd is left
+        *msd=b0;
+        break;
+        }
+      dpd=BIN2DPD[b1*10+b0];
+      }
+    targ[uoff>>5]|=dpd<<(uoff&31);
+    if ((uoff&31)>22) targ[(uoff>>5)+1]|=dpd>>(32-(uoff&31));
+    } // n
+  return (d==0 ? 1 : d);
+  } // decDigitsFromString
+
+// decDeclet -- return declet n (0-1023) of the uInt array sour
+static uInt decDeclet(const uInt *sour, Int n) {
+  uInt uoff=(uInt)n*10;            // offset of the declet
+  uInt dpd=sour[uoff>>5]>>(uoff&31);
+  if ((uoff&31)>22) dpd|=sour[(uoff>>5)+1]<<(32-(uoff&31));
+  return dpd&0x3ff;
+  } // decDeclet
+
+/* ------------------------------------------------------------------ */
+/* decBinFromDPD -- convert a DPD coefficient to binary               */
+/*                                                                    */
+/*   bin     is the target, words uInts holding the coefficient as a  */
+/*           binary integer (the uInt at offset 0 is least            */
+/*           significant)                                             */
+/*   words   is the number of uInts in bin (2 or 4)                   */
+/*   sour    is the coefficient continuation, as for decDigitsFromDPD */
+/*   declets is the number of declets in sour (5 or 11)               */
+/*   msd     is the most significant (combination field) digit        */
+/*                                                                    */
+/* The digits are taken nine at a time, starting with a seven-digit   */
+/* chunk holding the msd and the top two declets (so declets must be  */
+/* two more than a multiple of three), and the binary integer is      */
+/* multiplied by 10**9 and the chunk added for each later chunk.      */
+/* Non-canonical declets are decoded as by DPD2BIN.                   */
+/*                                                                    */
+/* No error is possible.                                              */
+/* ------------------------------------------------------------------ */
+void decBinFromDPD(uInt *bin, Int words, const uInt *sour,
+                   Int declets, uInt msd) {
+  Int  n, w;                       // work
+  uInt chunk;                      // nine (or seven) digits, binary
+  uInt carry;                      // carry into the next uInt
+  #if DECUSE64
+  uLong prod;                      // product of a uInt and 10**9
+  #else
+  uInt lo, hi;                     // products of 16-bit halves
+  Int  i;                          // ..
   #endif
+
+  for (w=1; w<words; w++) bin[w]=0;
+  n=declets-1;
+  bin[0]=msd*1000000+(uInt)DPD2BIN[decDeclet(sour, n)]*1000
+        +DPD2BIN[decDeclet(sour, n-1)];
+  for (n=declets-3; n>=2; n-=3) {
+    chunk=(uInt)DPD2BIN[decDeclet(sour, n)]*1000000
+         +(uInt)DPD2BIN[decDeclet(sour, n-1)]*1000
+         +DPD2BIN[decDeclet(sour, n-2)];
+    #if DECUSE64
+    carry=chunk;
+    for (w=0; w<words; w++) {
+      prod=(uLong)bin[w]*1000000000+carry;
+      bin[w]=(uInt)prod;
+      carry=(uInt)(prod>>32);
+      }
+    #else
+    // no 64-bit arithmetic, so multiply by 1000 three times, by
+    // 16-bit halves, adding three digits of the chunk each time
+    for (i=0; i<3; i++) {
+      carry=(i==0 ? chunk/1000000 : i==1 ? chunk/1000%1000
+                                         : chunk%1000);
+      for (w=0; w<words; w++) {
+        lo=(bin[w]&0xffff)*1000+carry;
+        hi=(bin[w]>>16)*1000+(lo>>16);
+        bin[w]=(hi<<16)|(lo&0xffff);
+        carry=hi>>16;
+        }
+      } // i
+    #endif
+    } // n
+  } // decBinFromDPD
+
+/* ------------------------------------------------------------------ */
+/* decBinToDPD -- convert a binary coefficient to DPD                 */
+/*                                                                    */
+/*   targ    is 2 or 4-element uInt array, which the caller must      */
+/*           have cleared to zeros                                    */
+/*   declets is the number of declets in the coefficient continuation */
+/*           (5 or 11)                                                */
+/*   bin     is the coefficient, as for decBinFromDPD; it is used as  */
+/*           work space and is left undefined                         */
+/*   words   is the number of uInts in bin (2 or 4)                   */
+/*                                                                    */
+/* returns the most significant (combination field) digit             */
+/*                                                                    */
+/* The coefficient must be less than 10**(declets*3+1).  It is        */
+/* divided by 10**9 to give nine digits (three declets) at a time,    */
+/* from the right, and the final quotient gives the top two declets   */
+/* and the msd.  The declets are placed as for decDigitsToDPD.        */
+/*                                                                    */
+/* No error is possible.                                              */
+/* ------------------------------------------------------------------ */
+// PUTDECLET -- macro to add the declet for b (0-999) at offset o
+#define PUTDECLET(o, b) {dpd=BIN2DPD[b];                             \
+  targ[(o)>>5]|=dpd<<((o)&31);                                      \
+  if (((o)&31)>22) targ[((o)>>5)+1]|=dpd>>(32-((o)&31));}
+uInt decBinToDPD(uInt *targ, Int declets, uInt *bin, Int words) {
+  Int  n, w;                       // work
+  uInt chunk;                      // nine digits, binary
+  uInt uoff;                       // offset of the next declet
+  uInt dpd;                        // densely packed decimal value
+  #if DECUSE64
+  uLong part;                      // remainder and next uInt
+  #else
+  uInt part;                       // remainder and next 16 bits
+  uInt qhi;                        // quotient of the top half
+  Int  i;                          // ..
+  uInt scale;                      // ..
   #endif
+
+  for (n=declets, uoff=0; n>2; n-=3, uoff+=30) {
+    while (words>1 && bin[words-1]==0) words--;  // skip leading 0s
+    #if DECUSE64
+    chunk=0;
+    for (w=words-1; w>=0; w--) {
+      part=((uLong)chunk<<32)|bin[w];
+      bin[w]=(uInt)(part/1000000000);
+      chunk=(uInt)(part%1000000000);
+      }
+    #else
+    // no 64-bit arithmetic, so divide by 1000 three times, by 16-bit
+    // halves, collecting three digits of the chunk each time
+    chunk=0;
+    for (i=0, scale=1; i<3; i++, scale*=1000) {
+      part=0;
+      for (w=words-1; w>=0; w--) {
+        part=(part<<16)|(bin[w]>>16);
+        qhi=part/1000;
+        part=((part%1000)<<16)|(bin[w]&0xffff);
+        bin[w]=(qhi<<16)|(part/1000);
+        part%=1000;
+        }
+      chunk+=part*scale;
+      } // i
+    #endif
+    PUTDECLET(uoff,    chunk%1000);
+    PUTDECLET(uoff+10, chunk/1000%1000);
+    PUTDECLET(uoff+20, chunk/1000000);
+    } // n
+  // the quotient is now less than 10**7
+  chunk=bin[0];
+  PUTDECLET(uoff,    chunk%1000);
+  PUTDECLET(uoff+10, chunk/1000%1000);
+  return chunk/1000000;
+  } // decBinToDPD
+
+/* ------------------------------------------------------------------ */
+/* decKeyFromDPD -- make an order-preserving key from DPD fields      */
+/*                                                                    */
+/*   key     is the target, 8 or 16 bytes (declets*10+18 bits,        */
+/*           rounded up), most significant first                      */
+/*   declets is the number of declets in sour (5 or 11)               */
+/*   sour    is the coefficient continuation, as for decDigitsFromDPD */
+/*   msd     is the most significant (combination field) digit        */
+/*   exp     is the biased exponent, if finite                        */
+/*   special is 0 if finite, or the class field for an Infinity, sNaN */
+/*           or NaN (whose payload is then the declets)               */
+/*   neg     is 1 if the sign is negative                             */
+/*                                                                    */
+/* The key is a sign bit (1 for positive), a class field, and then    */
+/* the coefficient as declets*10 bits of three-digit binary groups.   */
+/* For a finite non-zero number the coefficient is first normalized   */
+/* (shifted left, in decimal, until its msd is non-zero), and the     */
+/* class field is then 9*(adjusted exponent+bias+1) plus that msd, -1 */
+/* [so numerically equal numbers have equal keys]; for a zero the     */
+/* class field and coefficient are 0.  The bits below the sign are    */
+/* inverted for a negative number.                                    */
+/*                                                                    */
+/* No error is possible.                                              */
+/* ------------------------------------------------------------------ */
+void decKeyFromDPD(uByte *key, Int declets, const uInt *sour, uInt msd,
+                   Int exp, Int special, Flag neg) {
+  uInt g[12];                      // three-digit groups, msd last
+  uInt w[4]={0, 0, 0, 0};          // key, least significant first
+  uInt v, carry, mult;             // work
+  uInt uoff;                       // offset of the next group
+  Int  i, n, t;                    // ..
+  Int  digits, shift;              // ..
+  Int  words=declets==5 ? 2 : 4;   // uInts in the key
+
+  for (i=0; i<declets; i++) g[i]=DPD2BIN[decDeclet(sour, i)];
+  g[declets]=msd;
+
+  if (special==0) {                // finite
+    for (t=declets; t>0 && g[t]==0; t--);      // find the top group
+    if (g[t]!=0) {                 // non-zero, so normalize
+      digits=t*3+(g[t]>=100 ? 3 : g[t]>=10 ? 2 : 1);
+      shift=declets*3+1-digits;
+      if (shift%3!=0) {            // multiply by 10 or 100
+        mult=(shift%3==1 ? 10 : 100);
+        for (i=0, carry=0; i<=t; i++) {
+          v=g[i]*mult+carry;
+          g[i]=v%1000;
+          carry=v/1000;
+          }
+        if (t<declets) g[t+1]=carry;
+        }
+      n=shift/3;                   // then move up by whole groups
+      if (n>0) {
+        for (i=declets; i>=n; i--) g[i]=g[i-n];
+        for (; i>=0; i--) g[i]=0;
+        }
+      special=(exp+digits)*9+(Int)g[declets]-1;
+      }
+    }
+  // [any special or zero has a 0 msd]
+
+  for (i=0, uoff=0; i<declets; i++, uoff+=10) {
+    w[uoff>>5]|=g[i]<<(uoff&31);
+    if ((uoff&31)>22) w[(uoff>>5)+1]|=g[i]>>(32-(uoff&31));
+    }
+  w[words-1]|=(uInt)special<<(uoff&31);        // class field
+  if (neg) {
+    for (i=0; i<words; i++) w[i]=~w[i];
+    w[words-1]&=0x7fffffff;
+    }
+   else w[words-1]|=0x80000000;
+
+  // lay out the key, most significant byte first
+  for (i=0; i<words*4; i++) key[i]=(uByte)(w[words-1-(i>>2)]>>(24-(i&3)*8));
+  } // decKeyFromDPD
+
+/* ------------------------------------------------------------------ */
+/* decHashFromDPD -- hash a number from its DPD fields                */
+/*                                                                    */
+/*   declets is the number of declets in sour (5 or 11)               */
+/*   sour    is the coefficient continuation, as for decDigitsFromDPD */
+/*   msd     is the most significant (combination field) digit        */
+/*   exp     is the exponent (unbiased), if finite                    */
+/*   bits    is the sign and special bits, as for decNumber           */
+/*   returns the hash, as for decNumberHash                           */
+/*                                                                    */
+/* The coefficient is reduced modulo DECHASHP a declet at a time,     */
+/* from the msd down, so no normalization or storage is needed.       */
+/*                                                                    */
+/* No error is possible.                                              */
+/* ------------------------------------------------------------------ */
+uInt decHashFromDPD(Int declets, const uInt *sour, uInt msd, Int exp,
+                    uByte bits) {
+  #if DECUSE64
+  uLong acc=msd;                   // coefficient, modulo DECHASHP
+  #else
+  uInt  acc=msd;                   // ..
   #endif
-  return;
-  } //decDigitsFromDPD
+  Int   n;                         // declet number
+
+  if ((bits&DECSPECIAL)==0) {
+    for (n=declets-1; n>=0; n--) {
+      #if DECUSE64
+      acc=HASHFOLD(acc)*1000+DPD2BIN[decDeclet(sour, n)];
+      #else
+      acc=decHashMulAdd(acc, 1000, DPD2BIN[decDeclet(sour, n)]);
+      #endif
+      }
+    }
+  return decHashFinish((uInt)HASHFOLD(acc), exp, bits);
+  } // decHashFromDPD
@@ -80,4 +80,26 @@
   uint32_t    decimal64IsCanonical(const decimal64 *);
   decimal64 * decimal64Canonical(decimal64 *, const decimal64 *);
 
+  /* Transcoding to and from the BID (binary integer decimal)         */
+  /* encoding, in the same byte order as the DPD encoding             */
+  decimal64 * decimal64ToBID(decimal64 *, const decimal64 *);
+  decimal64 * decimal64FromBID(decimal64 *, const decimal64 *);
+
+  /* Order-preserving sort keys (compare as unsigned byte strings)    */
+  #define DECIMAL64_KeyBytes 8
+  uint8_t   * decimal64ToKey(const decimal64 *, uint8_t *);
+  void        decimal64Sort(decimal64 *, int32_t, decContext *);
+
+  /* Hash consistent with numerical equality (as decNumberHash)       */
+  uint32_t    decimal64Hash(const decimal64 *);
+
+  /* Bulk conversions between decimal64 arrays and rows of decNumber  */
+  /* fields; each coefficient is DECIMAL64_Units Units, lsu first     */
+  #define DECIMAL64_Units ((DECIMAL64_Pmax+DECDPUN-1)/DECDPUN)
+  void decimal64ArrayToNumberUnits(const decimal64 *, int32_t,
+                     decNumberUnit *, int32_t *, int32_t *, uint8_t *);
+  void decimal64ArrayFromNumberUnits(decimal64 *, int32_t,
+                     const decNumberUnit *, const int32_t *,
+                     const int32_t *, const uint8_t *, decContext *);
+
 #endif
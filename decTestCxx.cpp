@@ -0,0 +1,226 @@
+/*
+ * C++ timings for the -b summary of decTestRunnerCxx (make
+ * decTestRunnerCxx), which is decTestRunner built with DECTESTCXX=1.
+ *
+ * Each add, subtract, multiply, divide and remainder testcase is run
+ * again, bench_count times each, with the C function, with the
+ * dec::Number operator (which returns a new Number), and with the
+ * dec::Number named function (which writes into an existing one), on
+ * the same operands under the same context, so that the summary shows
+ * what the wrapper of decNumber.hpp costs.  The three results and
+ * statuses must agree.
+ *
+ * Before any testfile is run, the constexpr tables of decDPD.hpp are
+ * compared with those of decDPD.h, and a set of _d64 and _d128
+ * constants, encoded when this file is compiled, with the encodings
+ * that decimal64FromString and decimal128FromString give at run time.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+
+#include "decNumber/decNumber.hpp"
+#include "decNumber/decDPD.hpp"
+
+#define DEC_BIN2DPD 1
+#define DEC_DPD2BIN 1
+#define DEC_DPD2BCD8 1
+#define DEC_BIN2CHAR 1
+#include "decNumber/decDPD.h"
+
+using namespace dec::literals;
+
+typedef dec::Number<DECIMAL128_Pmax> number_t;
+
+#define CXX_OP(name, sym, c_fn, cxx_fn)                                 \
+    struct name {                                                       \
+        static decNumber *c(decNumber *res, const decNumber *lhs,       \
+            const decNumber *rhs, decContext *set)                      \
+        {                                                               \
+            return c_fn(res, lhs, rhs, set);                            \
+        }                                                               \
+        static number_t oper(const dec::Operand<DECIMAL128_Pmax> &lhs,  \
+            const number_t &rhs)                                        \
+        {                                                               \
+            return lhs sym rhs;                                         \
+        }                                                               \
+        static void named(number_t &res, const number_t &lhs,           \
+            const number_t &rhs, dec::Context &ctx)                     \
+        {                                                               \
+            dec::cxx_fn(res, lhs, rhs, ctx);                            \
+        }                                                               \
+    };
+
+CXX_OP(cxx_add, +, decNumberAdd, add)
+CXX_OP(cxx_subtract, -, decNumberSubtract, subtract)
+CXX_OP(cxx_multiply, *, decNumberMultiply, multiply)
+CXX_OP(cxx_divide, /, decNumberDivide, divide)
+CXX_OP(cxx_remainder, %, decNumberRemainder, remainder)
+
+static bool same(const decNumber *lhs, const decNumber *rhs)
+{
+    dec::Context ctx(DEC_INIT_BASE);
+    decNumber result;
+
+    ctx.set.traps = 0;
+#if DECSUBSET
+    ctx.set.extended = 1;
+#endif
+    decNumberCompareTotal(&result, lhs, rhs, &ctx.set);
+    return decNumberIsZero(&result);
+}
+
+template<class Op> static int cxx_bench_op(decNumber * const *operands,
+    const decContext *set, long count, clock_t *clocks)
+{
+    dec::Context c_ctx(*set);
+    dec::Context op_ctx(*set);
+    dec::Context named_ctx(*set);
+    number_t lhs(operands[0]);
+    number_t rhs(operands[1]);
+    number_t c_result;
+    number_t op_result;
+    number_t named_result;
+    decNumber *res;
+    clock_t start;
+    long i;
+
+    res = c_result.reserve(set->digits);
+    start = clock();
+    for (i = 0; i < count; ++i) {
+        Op::c(res, lhs.get(), rhs.get(), &c_ctx.set);
+    }
+    clocks[0] += clock() - start;
+    start = clock();
+    for (i = 0; i < count; ++i) {
+        op_result = Op::oper(op_ctx(lhs), rhs);
+    }
+    clocks[1] += clock() - start;
+    start = clock();
+    for (i = 0; i < count; ++i) {
+        Op::named(named_result, lhs, rhs, named_ctx);
+    }
+    clocks[2] += clock() - start;
+
+    if (c_ctx.status() != op_ctx.status()
+        || c_ctx.status() != named_ctx.status()
+        || !same(c_result.get(), op_result.get())
+        || !same(c_result.get(), named_result.get())
+    ) {
+        return -1;
+    }
+    return 1;
+}
+
+/*
+ * Time count runs of a binary operator on operands[0] and operands[1]
+ * under set, adding the C, operator and named-function clocks to
+ * clocks[0], clocks[1] and clocks[2].  Returns 1, or 0 if the operator
+ * is not timed, or -1 if the results or statuses differ.
+ */
+extern "C" int cxx_bench(const char *op, decNumber * const *operands,
+    int operand_count, const decContext *set, long count, clock_t *clocks)
+{
+    if (operand_count != 2) {
+        return 0;
+    }
+    if (strcasecmp(op, "add") == 0) {
+        return cxx_bench_op<cxx_add>(operands, set, count, clocks);
+    } else if (strcasecmp(op, "subtract") == 0) {
+        return cxx_bench_op<cxx_subtract>(operands, set, count, clocks);
+    } else if (strcasecmp(op, "multiply") == 0) {
+        return cxx_bench_op<cxx_multiply>(operands, set, count, clocks);
+    } else if (strcasecmp(op, "divide") == 0) {
+        return cxx_bench_op<cxx_divide>(operands, set, count, clocks);
+    } else if (strcasecmp(op, "remainder") == 0) {
+        return cxx_bench_op<cxx_remainder>(operands, set, count, clocks);
+    }
+    return 0;
+}
+
+template<class T, size_t N> static int table_unmatched(
+    const std::array<T, N> &generated, const T *table)
+{
+    int unmatched = 0;
+    size_t i;
+
+    for (i = 0; i < N; ++i) {
+        if (generated[i] != table[i]) {
+            ++unmatched;
+        }
+    }
+    return unmatched;
+}
+
+static const struct {
+    decimal64 encoding;
+    const char *string;
+} d64_constants[] = {
+    {1_d64, "1"},
+    {0.1_d64, "0.1"},
+    {1.25_d64, "1.25"},
+    {100_d64, "100"},
+    {8_d64, "8"},
+    {9.876543210987654_d64, "9.876543210987654"},
+    {"-0"_d64, "-0"},
+    {0E-398_d64, "0E-398"},
+    {1E-383_d64, "1E-383"},
+    {9999999999999999E369_d64, "9.999999999999999E+384"},
+    {1E+384_d64, "1E+384"},
+    {"-Infinity"_d64, "-Infinity"},
+    {"NaN"_d64, "NaN"},
+    {"sNaN"_d64, "sNaN"},
+};
+
+static const struct {
+    decimal128 encoding;
+    const char *string;
+} d128_constants[] = {
+    {1_d128, "1"},
+    {0.000000001_d128, "0.000000001"},
+    {9999999999999999999999999999999999_d128,
+        "9999999999999999999999999999999999"},
+    {"-9.99E+6144"_d128, "-9.99E+6144"},
+    {1E+6144_d128, "1E+6144"},
+    {1E-6143_d128, "1E-6143"},
+    {"Inf"_d128, "Inf"},
+    {"-NaN"_d128, "-NaN"},
+};
+
+/*
+ * Compare the decDPD.hpp tables with those of decDPD.h, and the _d64
+ * and _d128 constants with decimal64FromString and decimal128FromString.
+ * Returns the number of entries and constants which differ.
+ */
+extern "C" int cxx_check_constants(void)
+{
+    dec::Context ctx64(DEC_INIT_DECIMAL64);
+    dec::Context ctx128(DEC_INIT_DECIMAL128);
+    decimal64 d64;
+    decimal128 d128;
+    int unmatched = 0;
+    size_t i;
+
+    unmatched += table_unmatched(dec::dpd::BIN2DPD, BIN2DPD);
+    unmatched += table_unmatched(dec::dpd::DPD2BIN, DPD2BIN);
+    unmatched += table_unmatched(dec::dpd::DPD2BCD8, DPD2BCD8);
+    unmatched += table_unmatched(dec::dpd::BIN2CHAR, BIN2CHAR);
+    for (i = 0; i < sizeof(d64_constants) / sizeof(*d64_constants); ++i) {
+        decimal64FromString(&d64, d64_constants[i].string, &ctx64.set);
+        if (memcmp(&d64, &d64_constants[i].encoding, sizeof(d64)) != 0) {
+            ++unmatched;
+        }
+    }
+    for (i = 0; i < sizeof(d128_constants) / sizeof(*d128_constants); ++i) {
+        decimal128FromString(&d128, d128_constants[i].string, &ctx128.set);
+        if (memcmp(&d128, &d128_constants[i].encoding, sizeof(d128)) != 0) {
+            ++unmatched;
+        }
+    }
+    return unmatched;
+}
@@ -0,0 +1,121 @@
+#! /bin/sh
+#
+# Build decTestRunner for each combination of DECDPUN, DECUSE64 and
+# DECBUFFER, run the corpus (testall and testall0) with each build for
+# correctness and the -b benchmark for speed, and print one table.
+#
+# Run by make matrix, which passes CC, CFLAGS, CPPFLAGS, LIBS, srcdir
+# and SOURCES (the .c files of decTestRunner).  The matrix is set by
+#   MATRIX_DPUN    DECDPUN values       (default "1 3 4 9")
+#   MATRIX_USE64   DECUSE64 values      (default "0 1")
+#   MATRIX_BUFFER  DECBUFFER values     (default "12 36 144")
+#   MATRIX_BENCH   -b count for testall (default 10; highPrecision.decTest
+#                  is run with a tenth of it, at least 1)
+# Each build, with the logs of its runs, is left in matrix/<variant>.
+# DECUSE64 selects the arithmetic of the decNumber modules, which the
+# -b timings use; decSingle, decDouble and decQuad keep their 64-bit
+# (and 128-bit) coefficient registers whatever it says.
+#
+# The corpus column is the failures of testall/testall0, which must be
+# those of the default build (DECDPUN=3, DECUSE64=1, DECBUFFER=36; DIFF
+# is shown if not), and the ratio is the testall ns/op of the build to
+# that of the default build.
+
+dpuns=${MATRIX_DPUN-"1 3 4 9"}
+use64s=${MATRIX_USE64-"0 1"}
+buffers=${MATRIX_BUFFER-"12 36 144"}
+bench=${MATRIX_BENCH-10}
+srcdir=${srcdir-.}
+CC=${CC-cc}
+
+bench_high=`expr $bench / 10`
+if test $bench_high -lt 1; then
+    bench_high=1
+fi
+
+# the failures or ns/op of the last summary line of a log
+failures()
+{
+    sed -n '$s/.*failure=\([0-9]*\).*/\1/p' "$1"
+}
+ns_per_op()
+{
+    sed -n '$s/.*ns\/op=\([0-9.]*\).*/\1/p' "$1"
+}
+
+rm -f matrix/results
+mkdir -p matrix || exit 1
+for dpun in $dpuns; do
+    for use64 in $use64s; do
+        for buffer in $buffers; do
+            variant=dpun$dpun-use64_$use64-buffer$buffer
+            dir=matrix/$variant
+            echo "== $variant" 1>&2
+            if test $dpun -gt 4 && test $use64 = 0; then
+                # decNumber.c needs 64-bit multiplies for units of 5 or
+                # more digits
+                echo "$dpun $use64 $buffer needs-DECUSE64" >>matrix/results
+                continue
+            fi
+            rm -rf $dir
+            mkdir $dir || exit 1
+            objects=
+            built=yes
+            flags="-DDECDPUN=$dpun -DDECUSE64=$use64 -DDECBUFFER=$buffer"
+            for source in $SOURCES; do
+                object=$dir/`basename $source .c`.o
+                $CC $CPPFLAGS $CFLAGS $flags -c -o $object $srcdir/$source \
+                    2>>$dir/build.log || built=no
+                objects="$objects $object"
+            done
+            if test $built = yes; then
+                $CC $CFLAGS -o $dir/decTestRunner $objects $LIBS \
+                    2>>$dir/build.log || built=no
+            fi
+            if test $built = no; then
+                echo "$dpun $use64 $buffer build-failed" >>matrix/results
+                continue
+            fi
+
+            $dir/decTestRunner $srcdir/testcases/dectest/testall.decTest \
+                >$dir/all.log 2>&1
+            $dir/decTestRunner $srcdir/testcases/dectest0/testall0.decTest \
+                >$dir/all0.log 2>&1
+            $dir/decTestRunner -b $bench \
+                $srcdir/testcases/dectest/testall.decTest >$dir/bench.log 2>&1
+            $dir/decTestRunner -b $bench_high \
+                $srcdir/testcases/bench/highPrecision.decTest \
+                >$dir/high.log 2>&1
+            echo "$dpun $use64 $buffer `failures $dir/all.log`" \
+                "`failures $dir/all0.log` `ns_per_op $dir/bench.log`" \
+                "`ns_per_op $dir/high.log`" >>matrix/results
+        done
+    done
+done
+
+awk '
+    { row[NR] = $0 }
+    $1 == 3 && $2 == 1 && $3 == 36 && NF == 7 { base = NR }
+    END {
+        printf "%-7s %-8s %-9s %-16s %12s %14s %6s\n", "DECDPUN",
+            "DECUSE64", "DECBUFFER", "corpus", "testall ns/op",
+            "highPrec ns/op", "ratio"
+        if (base) {
+            split(row[base], b)
+        }
+        for (i = 1; i <= NR; i++) {
+            n = split(row[i], f)
+            if (n != 7) {
+                gsub("-", " ", f[4])
+                printf "%-7s %-8s %-9s %s\n", f[1], f[2], f[3], f[4]
+                continue
+            }
+            corpus = f[4] "/" f[5]
+            if (base && (f[4] != b[4] || f[5] != b[5])) {
+                corpus = corpus " DIFF"
+            }
+            ratio = base && b[6] > 0 ? sprintf("%.2f", f[6] / b[6]) : "-"
+            printf "%-7s %-8s %-9s %-16s %12s %14s %6s\n", f[1], f[2], f[3],
+                corpus, f[6], f[7], ratio
+        }
+    }' matrix/results
@@ -0,0 +1,372 @@
+/*
+ * Native decSingle/decDouble/decQuad backend.
+ *
+ * This file is included by decTestRunner.c once for each format, with
+ * NATIVE_NAME defined as decSingle, decDouble or decQuad, and defines
+ * the operator table, operand conversion and operation dispatch for that
+ * format.
+ * NATIVE_MEMBER is the native_t member which holds the format, and
+ * NATIVE_ARITHMETIC is 0 for decSingle, which has no arithmetic.
+ */
+
+#define NATIVE_CAT2(a, b) a ## b
+#define NATIVE_CAT(a, b) NATIVE_CAT2(a, b)
+#define NATIVE(name) NATIVE_CAT(name ## _, NATIVE_NAME)
+#define NATIVE_FN(name) NATIVE_CAT(NATIVE_NAME, name)
+
+/*
+ * Convert the operands to the format, adding the status of the
+ * conversions (such as Clamped when an exponent is folded down) to
+ * *status.
+ */
+static s_or_f NATIVE(testcase_convert_operands)(testcase_t *testcase,
+    uint32_t *status)
+{
+    NATIVE_NAME *df;
+    decContext ctx;
+    char *s;
+    int i;
+
+    for (i = 0; i < testcase->operand_count; ++i) {
+        df = &testcase->native_operands[i].NATIVE_MEMBER;
+        s = testcase->operands[i];
+        if (s[0] == '#' && strlen(s + 1) == sizeof(df->bytes) * 2) {
+            if (!parse_hex(sizeof(df->bytes), df->bytes, s + 1)) {
+                DBGPRINTF("invalid hex notation [%s]\n", s);
+                return FAILURE;
+            }
+        } else if (strchr(s, '#') != NULL) {
+            ctx = testcase->operand_contexts[i];
+            ctx.status = 0;
+            NATIVE_FN(FromNumber)(df, testcase->operand_numbers[i], &ctx);
+            *status |= ctx.status;
+        } else {
+            ctx = *testcase->context;
+            ctx.status = 0;
+            NATIVE_FN(FromString)(df, s, &ctx);
+            *status |= ctx.status;
+        }
+    }
+    return SUCCESS;
+}
+
+/*
+ * Whether testcase_execute below carries out op: the storage operators,
+ * and the arithmetic operators too unless NATIVE_ARITHMETIC is 0.
+ * Testcases of other operators (such as dotproduct) are run with
+ * decNumber.
+ */
+static bool NATIVE(native_has_operator)(const char *op)
+{
+    static const char *const operators[] = {
+        "apply", "canonical", "class", "compare", "comparesig",
+        "comparetotal", "comparetotmag", "copy", "copyabs", "copynegate",
+        "copysign", "toeng", "tosci",
+#if NATIVE_ARITHMETIC
+        "abs", "add", "and", "divide", "divideint", "fma", "invert",
+        "logb", "max", "maxmag", "min", "minmag", "minus", "multiply",
+        "nextminus", "nextplus", "nexttoward", "or", "plus", "quantize",
+        "reduce", "remainder", "remaindernear", "rotate", "samequantum",
+        "scaleb", "shift", "subtract", "tointegral", "tointegralx", "xor",
+#endif
+        NULL
+    };
+    const char *const *p;
+
+    for (p = operators; *p; ++p) {
+        if (strcasecmp(op, *p) == 0) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+#if NATIVE_ARITHMETIC
+static s_or_f NATIVE(testcase_execute)(testcase_t *testcase)
+{
+    NATIVE_NAME *operands[3];
+    NATIVE_NAME *result;
+    decContext *set;
+    char *op;
+    char buf[DECQUAD_String];
+    int i;
+
+    for (i = 0; i < testcase->operand_count && i < 3; ++i) {
+        operands[i] = &testcase->native_operands[i].NATIVE_MEMBER;
+    }
+    result = &testcase->native_result.NATIVE_MEMBER;
+    set = testcase->context;
+    op = testcase->operator;
+
+    switch (tolower(op[0])) {
+    case 'a':
+        if (strcasecmp(op, "abs") == 0) {
+            NATIVE_FN(Abs)(result, operands[0], set);
+        } else if (strcasecmp(op, "add") == 0) {
+            NATIVE_FN(Add)(result, operands[0], operands[1], set);
+        } else if (strcasecmp(op, "and") == 0) {
+            NATIVE_FN(And)(result, operands[0], operands[1], set);
+        } else if (strcasecmp(op, "apply") == 0) {
+            NATIVE_FN(Copy)(result, operands[0]);
+        } else {
+            DBGPRINTF("error in testcase_execute. unknown operator: %s.\n",
+                op);
+            return FAILURE;
+        }
+        break;
+    case 'c':
+        if (strcasecmp(op, "canonical") == 0) {
+            NATIVE_FN(Canonical)(result, operands[0]);
+        } else if (strcasecmp(op, "class") == 0) {
+            testcase->actual_string = strdup(
+                NATIVE_FN(ClassString)(operands[0]));
+            return SUCCESS;
+        } else if (strcasecmp(op, "compare") == 0) {
+            NATIVE_FN(Compare)(result, operands[0], operands[1], set);
+        } else if (strcasecmp(op, "comparesig") == 0) {
+            NATIVE_FN(CompareSignal)(result, operands[0], operands[1], set);
+        } else if (strcasecmp(op, "comparetotal") == 0) {
+            NATIVE_FN(CompareTotal)(result, operands[0], operands[1]);
+        } else if (strcasecmp(op, "comparetotmag") == 0) {
+            NATIVE_FN(CompareTotalMag)(result, operands[0], operands[1]);
+        } else if (strcasecmp(op, "copy") == 0) {
+            NATIVE_FN(Copy)(result, operands[0]);
+        } else if (strcasecmp(op, "copyabs") == 0) {
+            NATIVE_FN(CopyAbs)(result, operands[0]);
+        } else if (strcasecmp(op, "copynegate") == 0) {
+            NATIVE_FN(CopyNegate)(result, operands[0]);
+        } else if (strcasecmp(op, "copysign") == 0) {
+            NATIVE_FN(CopySign)(result, operands[0], operands[1]);
+        } else {
+            DBGPRINTF("error in testcase_execute. unknown operator: %s.\n",
+                op);
+            return FAILURE;
+        }
+        break;
+    case 'd':
+        if (strcasecmp(op, "divide") == 0) {
+            NATIVE_FN(Divide)(result, operands[0], operands[1], set);
+        } else if (strcasecmp(op, "divideint") == 0) {
+            NATIVE_FN(DivideInteger)(result, operands[0], operands[1], set);
+        } else {
+            DBGPRINTF("error in testcase_execute. unknown operator: %s.\n",
+                op);
+            return FAILURE;
+        }
+        break;
+    case 'f':
+        if (strcasecmp(op, "fma") == 0) {
+            NATIVE_FN(FMA)(result, operands[0], operands[1], operands[2], set);
+        } else {
+            DBGPRINTF("error in testcase_execute. unknown operator: %s.\n",
+                op);
+            return FAILURE;
+        }
+        break;
+    case 'i':
+        if (strcasecmp(op, "invert") == 0) {
+            NATIVE_FN(Invert)(result, operands[0], set);
+        } else {
+            DBGPRINTF("error in testcase_execute. unknown operator: %s.\n",
+                op);
+            return FAILURE;
+        }
+        break;
+    case 'l':
+        if (strcasecmp(op, "logb") == 0) {
+            NATIVE_FN(LogB)(result, operands[0], set);
+        } else {
+            DBGPRINTF("error in testcase_execute. unknown operator: %s.\n",
+                op);
+            return FAILURE;
+        }
+        break;
+    case 'm':
+        if (strcasecmp(op, "max") == 0) {
+            NATIVE_FN(Max)(result, operands[0], operands[1], set);
+        } else if (strcasecmp(op, "maxmag") == 0) {
+            NATIVE_FN(MaxMag)(result, operands[0], operands[1], set);
+        } else if (strcasecmp(op, "min") == 0) {
+            NATIVE_FN(Min)(result, operands[0], operands[1], set);
+        } else if (strcasecmp(op, "minmag") == 0) {
+            NATIVE_FN(MinMag)(result, operands[0], operands[1], set);
+        } else if (strcasecmp(op, "minus") == 0) {
+            NATIVE_FN(Minus)(result, operands[0], set);
+        } else if (strcasecmp(op, "multiply") == 0) {
+            NATIVE_FN(Multiply)(result, operands[0], operands[1], set);
+        } else {
+            DBGPRINTF("error in testcase_execute. unknown operator: %s.\n",
+                op);
+            return FAILURE;
+        }
+        break;
+    case 'n':
+        if (strcasecmp(op, "nextminus") == 0) {
+            NATIVE_FN(NextMinus)(result, operands[0], set);
+        } else if (strcasecmp(op, "nextplus") == 0) {
+            NATIVE_FN(NextPlus)(result, operands[0], set);
+        } else if (strcasecmp(op, "nexttoward") == 0) {
+            NATIVE_FN(NextToward)(result, operands[0], operands[1], set);
+        } else {
+            DBGPRINTF("error in testcase_execute. unknown operator: %s.\n",
+                op);
+            return FAILURE;
+        }
+        break;
+    case 'o':
+        if (strcasecmp(op, "or") == 0) {
+            NATIVE_FN(Or)(result, operands[0], operands[1], set);
+        } else {
+            DBGPRINTF("error in testcase_execute. unknown operator: %s.\n",
+                op);
+            return FAILURE;
+        }
+        break;
+    case 'p':
+        if (strcasecmp(op, "plus") == 0) {
+            NATIVE_FN(Plus)(result, operands[0], set);
+        } else {
+            DBGPRINTF("error in testcase_execute. unknown operator: %s.\n",
+                op);
+            return FAILURE;
+        }
+        break;
+    case 'q':
+        if (strcasecmp(op, "quantize") == 0) {
+            NATIVE_FN(Quantize)(result, operands[0], operands[1], set);
+        } else {
+            DBGPRINTF("error in testcase_execute. unknown operator: %s.\n",
+                op);
+            return FAILURE;
+        }
+        break;
+    case 'r':
+        if (strcasecmp(op, "reduce") == 0) {
+            NATIVE_FN(Reduce)(result, operands[0], set);
+        } else if (strcasecmp(op, "remainder") == 0) {
+            NATIVE_FN(Remainder)(result, operands[0], operands[1], set);
+        } else if (strcasecmp(op, "remaindernear") == 0) {
+            NATIVE_FN(RemainderNear)(result, operands[0], operands[1], set);
+        } else if (strcasecmp(op, "rotate") == 0) {
+            NATIVE_FN(Rotate)(result, operands[0], operands[1], set);
+        } else {
+            DBGPRINTF("error in testcase_execute. unknown operator: %s.\n",
+                op);
+            return FAILURE;
+        }
+        break;
+    case 's':
+        if (strcasecmp(op, "samequantum") == 0) {
+            NATIVE_FN(FromUInt32)(result,
+                NATIVE_FN(SameQuantum)(operands[0], operands[1]));
+        } else if (strcasecmp(op, "scaleb") == 0) {
+            NATIVE_FN(ScaleB)(result, operands[0], operands[1], set);
+        } else if (strcasecmp(op, "shift") == 0) {
+            NATIVE_FN(Shift)(result, operands[0], operands[1], set);
+        } else if (strcasecmp(op, "subtract") == 0) {
+            NATIVE_FN(Subtract)(result, operands[0], operands[1], set);
+        } else {
+            DBGPRINTF("error in testcase_execute. unknown operator: %s.\n",
+                op);
+            return FAILURE;
+        }
+        break;
+    case 't':
+        if (strcasecmp(op, "toeng") == 0) {
+            NATIVE_FN(ToEngString)(operands[0], buf);
+            testcase->actual_string = strdup(buf);
+            return SUCCESS;
+        } else if (strcasecmp(op, "tointegral") == 0) {
+            NATIVE_FN(ToIntegralValue)(result, operands[0], set, set->round);
+        } else if (strcasecmp(op, "tointegralx") == 0) {
+            NATIVE_FN(ToIntegralExact)(result, operands[0], set);
+        } else if (strcasecmp(op, "tosci") == 0) {
+            NATIVE_FN(ToString)(operands[0], buf);
+            testcase->actual_string = strdup(buf);
+            return SUCCESS;
+        } else {
+            DBGPRINTF("error in testcase_execute. unknown operator: %s.\n",
+                op);
+            return FAILURE;
+        }
+        break;
+    case 'x':
+        if (strcasecmp(op, "xor") == 0) {
+            NATIVE_FN(Xor)(result, operands[0], operands[1], set);
+        } else {
+            DBGPRINTF("error in testcase_execute. unknown operator: %s.\n",
+                op);
+            return FAILURE;
+        }
+        break;
+    default:
+        DBGPRINTF("error in testcase_execute. unknown operator: %s.\n", op);
+        return FAILURE;
+    }
+
+    return SUCCESS;
+}
+#else
+static s_or_f NATIVE(testcase_execute)(testcase_t *testcase)
+{
+    NATIVE_NAME *operands[2] = {NULL, NULL};
+    NATIVE_NAME *result;
+    decContext *set;
+    char *op;
+    char buf[DECSINGLE_String];
+    int i;
+
+    for (i = 0; i < testcase->operand_count && i < 2; ++i) {
+        operands[i] = &testcase->native_operands[i].NATIVE_MEMBER;
+    }
+    result = &testcase->native_result.NATIVE_MEMBER;
+    set = testcase->context;
+    op = testcase->operator;
+
+    if (strcasecmp(op, "apply") == 0 || strcasecmp(op, "copy") == 0) {
+        NATIVE_FN(Copy)(result, operands[0]);
+    } else if (strcasecmp(op, "canonical") == 0) {
+        NATIVE_FN(Canonical)(result, operands[0]);
+    } else if (strcasecmp(op, "class") == 0) {
+        testcase->actual_string = strdup(NATIVE_FN(ClassString)(operands[0]));
+    } else if (strcasecmp(op, "compare") == 0) {
+        NATIVE_FN(Compare)(result, operands[0], operands[1], set);
+    } else if (strcasecmp(op, "comparesig") == 0) {
+        NATIVE_FN(CompareSignal)(result, operands[0], operands[1], set);
+    } else if (strcasecmp(op, "comparetotal") == 0) {
+        NATIVE_FN(CompareTotal)(result, operands[0], operands[1]);
+    } else if (strcasecmp(op, "comparetotmag") == 0) {
+        NATIVE_FN(CompareTotalMag)(result, operands[0], operands[1]);
+    } else if (strcasecmp(op, "copyabs") == 0) {
+        NATIVE_FN(CopyAbs)(result, operands[0]);
+    } else if (strcasecmp(op, "copynegate") == 0) {
+        NATIVE_FN(CopyNegate)(result, operands[0]);
+    } else if (strcasecmp(op, "copysign") == 0) {
+        NATIVE_FN(CopySign)(result, operands[0], operands[1]);
+    } else if (strcasecmp(op, "toeng") == 0) {
+        NATIVE_FN(ToEngString)(operands[0], buf);
+        testcase->actual_string = strdup(buf);
+    } else if (strcasecmp(op, "tosci") == 0) {
+        NATIVE_FN(ToString)(operands[0], buf);
+        testcase->actual_string = strdup(buf);
+    } else {
+        DBGPRINTF("error in testcase_execute. unknown operator: %s.\n", op);
+        return FAILURE;
+    }
+
+    return SUCCESS;
+}
+#endif
+
+static void NATIVE(testcase_convert_result)(testcase_t *testcase)
+{
+    if (testcase->actual_string == NULL) {
+        NATIVE_FN(ToNumber)(&testcase->native_result.NATIVE_MEMBER,
+            testcase->actual_number);
+    }
+}
+
+#undef NATIVE_FN
+#undef NATIVE
+#undef NATIVE_CAT
+#undef NATIVE_CAT2
@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <stdarg.h>
 #include <ctype.h>
+#include <time.h>
 
 #ifdef HAVE_CONFIG_H
 #include "config.h"
@@ -21,6 +22,11 @@
 #include "decNumber/decimal32.h"
 #include "decNumber/decimal64.h"
 #include "decNumber/decimal128.h"
+#include "decNumber/decSingle.h"
+#include "decNumber/decDouble.h"
+#include "decNumber/decQuad.h"
+#include "decNumber/decAccumulator.h"
+#include "decNumber/decNumberFixed.h"
 
 #define LINE_MAX_LEN  4000
 
@@ -60,6 +66,30 @@ typedef struct _testfile_t {
     int success_count;
     int failure_count;
     int skip_count;
+    int native_bytes;
+    /* testcases of a native file run with decNumber because their
+     * operands change when converted to the format */
+    int native_fallback_count;
+    bool bid_encoding;
+    clock_t bench_clock;
+    long bench_ops;
+    /* working storage taken from the thread scratch workspace, and
+     * from malloc, by the timed runs */
+    uint64_t bench_work_hits;
+    uint64_t bench_work_misses;
+#if DECTESTCXX
+    /* the C call, dec::Number operator and dec::Number named function
+     * timings of cxx_bench, and the operations they timed */
+    clock_t bench_cxx_clocks[3];
+    long bench_cxx_ops;
+#endif
+#if DECSTATS
+    decStats bench_stats;
+#endif
+    /* BID transcoding totals when the file started */
+    clock_t bench_from_bid_clock;
+    clock_t bench_to_bid_clock;
+    long bench_bid_ops;
 } testfile_t;
 
 #define testfile_context(testfile_ptr) (testfile_ptr->context)
@@ -69,6 +99,12 @@ typedef struct _tokens_t {
     char **tokens;
 } tokens_t;
 
+typedef union _native_t {
+    decSingle ds;
+    decDouble dd;
+    decQuad dq;
+} native_t;
+
 typedef struct _testcase_t {
     char *id;
     char *operator;
@@ -85,11 +121,212 @@ typedef struct _testcase_t {
     uint32_t actual_status;
     char *actual_string;
     decNumber *actual_number;
+    int native_bytes;
+    native_t *native_operands;
+    native_t native_result;
+    bool bid_encoding;
+    /* elements in each [x,y,...] vector operand (of dotproduct), which
+     * are flattened into operands, or -1 if there are none */
+    int vector_length;
+    char *vector_text;
 } testcase_t;
 
+/* -n: run ds*, dd* and dq* files with the decSingle, decDouble and
+ * decQuad modules */
+static bool native_mode = FALSE;
+/* -b count: run each testcase count more times and report timings */
+static long bench_count = 0;
+/* time taken by the decimal64FromBID, decimal128FromBID, ...ToBID
+ * transcodings of hex operands and results in BID files, which are
+ * timed when bench_count > 0; the counters are global, and the delta
+ * is reported by process_file */
+static clock_t from_bid_clock = 0;
+static clock_t to_bid_clock = 0;
+static long bid_ops = 0;
+/* -s count: sort count decimal64s with decimal64Sort and with qsort on
+ * decNumberCompareTotal, and report the times */
+static long sort_count = 0;
+/* -h count: hash count decimal64s (and equal values with other
+ * exponents) with decNumberHash, decimal64Hash and decimal128Hash,
+ * check the hashes agree, and report the times */
+static long hash_count = 0;
+/* -a count: sum count decimal64s with decNumberAdd and with a
+ * decAccumulator, and report the times */
+static long sum_count = 0;
+/* -m: give decNumber a scratch arena for its working storage, as the
+ * thread default allocator and the allocator of the testfile contexts;
+ * the arena is reset after each testcase, which must have released
+ * everything it took */
+static bool arena_mode = FALSE;
+/* -w bytes: limit the thread scratch workspace of decNumber (0 makes
+ * all its working storage come from malloc); the runner opts in to a
+ * 1MB workspace, which it frees before it exits */
+static long workspace_limit = 1048576;
+/* -r: report the working storage that decNumber allocated for each
+ * operator, from the decNumberAllocCounts counters */
+static bool alloc_report_mode = FALSE;
+
+#define ARENA_BYTES (1 << 22)
+#define ARENA_ALIGN 16
+
+typedef struct {
+    char *base;
+    size_t used;
+    size_t high_water;
+    long live;                  /* allocations not yet released */
+    long allocs;
+    long overflows;             /* allocations too big, left to malloc */
+} arena_t;
+
+static arena_t arena;
+
+static void *arena_alloc(void *opaque, size_t n)
+{
+    arena_t *a = (arena_t *)opaque;
+    size_t size;
+
+    size = (n + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+    ++a->allocs;
+    if (size > ARENA_BYTES - a->used) {
+        void *p = malloc(n);
+        if (p) {
+            ++a->overflows;
+            ++a->live;
+        }
+        return p;
+    }
+    ++a->live;
+    a->used += size;
+    if (a->used > a->high_water) {
+        a->high_water = a->used;
+    }
+    return a->base + a->used - size;
+}
+
+static void arena_release(void *opaque, void *p)
+{
+    arena_t *a = (arena_t *)opaque;
+
+    --a->live;
+    if ((char *)p < a->base || (char *)p >= a->base + ARENA_BYTES) {
+        free(p);
+    }
+}
+
+static const decAllocator arena_allocator = {
+    arena_alloc, arena_release, &arena
+};
+
+#define ALLOC_REPORT_MAX 64
+
+typedef struct {
+    char *operator;
+    long tests;
+    long heap_tests;            /* tests which needed working storage */
+    uint64_t allocs;
+    uint64_t bytes;
+    uint64_t largest;
+    uint64_t peak;              /* most bytes needed by one test */
+    int32_t heap_digits;        /* least precision which needed any */
+} alloc_report_t;
+
+static alloc_report_t alloc_report[ALLOC_REPORT_MAX];
+static int alloc_report_count = 0;
+
+/*
+ * Add the allocation counters of a testcase operation (executed after
+ * decNumberResetAllocCounts) to the report line of its operator.
+ */
+static void alloc_report_add(const char *operator, int32_t digits)
+{
+    alloc_report_t *r;
+    const decAllocCounts *counts;
+    uint64_t heap_calls = 0;
+    uint64_t peak = 0;
+    int i;
+
+    for (i = 0; i < alloc_report_count; ++i) {
+        if (strcmp(alloc_report[i].operator, operator) == 0) {
+            break;
+        }
+    }
+    if (i == alloc_report_count) {
+        if (i == ALLOC_REPORT_MAX) {
+            return;
+        }
+        alloc_report[i].operator = strdup(operator);
+        if (!alloc_report[i].operator) {
+            return;
+        }
+        alloc_report[i].heap_digits = -1;
+        ++alloc_report_count;
+    }
+    r = &alloc_report[i];
+    ++r->tests;
+    for (i = DEC_ENTRY_NONE + 1; i < DEC_ENTRY_COUNT; ++i) {
+        counts = decNumberAllocCounts((enum decEntry)i);
+        heap_calls += counts->heapCalls;
+        r->allocs += counts->allocs;
+        r->bytes += counts->bytes;
+        if (counts->largest > r->largest) {
+            r->largest = counts->largest;
+        }
+        if (counts->peak > peak) {
+            peak = counts->peak;
+        }
+    }
+    if (heap_calls == 0) {
+        return;
+    }
+    ++r->heap_tests;
+    if (peak > r->peak) {
+        r->peak = peak;
+    }
+    if (r->heap_digits < 0 || digits < r->heap_digits) {
+        r->heap_digits = digits;
+    }
+}
+
+static int alloc_report_compare(const void *a, const void *b)
+{
+    return strcmp(((const alloc_report_t *)a)->operator,
+        ((const alloc_report_t *)b)->operator);
+}
+
+static void alloc_report_print(void)
+{
+    alloc_report_t *r;
+    int i;
+
+    qsort(alloc_report, alloc_report_count, sizeof(alloc_report_t),
+        alloc_report_compare);
+    for (i = 0; i < alloc_report_count; ++i) {
+        r = &alloc_report[i];
+        printf("== allocations: %s tests=%ld, heap=%ld", r->operator,
+            r->tests, r->heap_tests);
+        if (r->heap_tests > 0) {
+            printf(" (from %ld digits), allocs=%.1f/test, bytes=%.0f/test,"
+                " largest=%lu, peak=%lu", (long)r->heap_digits,
+                (double)r->allocs / r->heap_tests,
+                (double)r->bytes / r->heap_tests,
+                (unsigned long)r->largest, (unsigned long)r->peak);
+        }
+        printf("\n");
+        free(r->operator);
+    }
+    alloc_report_count = 0;
+}
+
 static s_or_f process_file(char *filename, testfile_t *parent);
 static void status_print(uint32_t status);
 
+#if DECTESTCXX
+/* in decTestCxx.cpp */
+int cxx_bench(const char *op, decNumber * const *operands,
+    int operand_count, const decContext *set, long count, clock_t *clocks);
+int cxx_check_constants(void);
+#endif
+
 /*
  * named testcases to skip (>0.5 ulp or flags cases)
  * that Mr. Mike Cowlishaw is aware of.
@@ -360,11 +597,16 @@ static inline bool tokens_is_empty(tokens_t *tokens)
 
 static s_or_f testfile_init(testfile_t *testfile, const char* filename)
 {
+    const char *basename;
+
     testfile->filename = strdup(filename);
     testfile->fp = fopen(filename, "r");
 
     decContextDefault(&testfile->context, DEC_INIT_BASE);
     testfile->context.traps = 0;
+    if (arena_mode) {
+        decContextSetAllocator(&testfile->context, &arena_allocator);
+    }
 #if DECSUBSET
     testfile->context.extended = 0;
 #else
@@ -375,6 +617,36 @@ static s_or_f testfile_init(testfile_t *testfile, const char* filename)
     testfile->success_count = 0;
     testfile->failure_count = 0;
     testfile->skip_count = 0;
+    testfile->native_fallback_count = 0;
+    testfile->bench_clock = 0;
+    testfile->bench_ops = 0;
+    testfile->bench_work_hits = 0;
+    testfile->bench_work_misses = 0;
+#if DECTESTCXX
+    memset(testfile->bench_cxx_clocks, 0, sizeof(testfile->bench_cxx_clocks));
+    testfile->bench_cxx_ops = 0;
+#endif
+#if DECSTATS
+    /* counters are global; the delta is reported by process_file */
+    testfile->bench_stats = decNumberStats;
+#endif
+    testfile->bench_from_bid_clock = from_bid_clock;
+    testfile->bench_to_bid_clock = to_bid_clock;
+    testfile->bench_bid_ops = bid_ops;
+    testfile->bid_encoding = FALSE;
+
+    testfile->native_bytes = 0;
+    if (native_mode) {
+        basename = strrchr(filename, '/');
+        basename = basename ? basename + 1 : filename;
+        if (strncasecmp(basename, "ds", 2) == 0) {
+            testfile->native_bytes = DECSINGLE_Bytes;
+        } else if (strncasecmp(basename, "dd", 2) == 0) {
+            testfile->native_bytes = DECDOUBLE_Bytes;
+        } else if (strncasecmp(basename, "dq", 2) == 0) {
+            testfile->native_bytes = DECQUAD_Bytes;
+        }
+    }
 
     return testfile->fp != NULL;
 }
@@ -501,10 +773,39 @@ static s_or_f tokens_get_conditions(tokens_t *tokens, int offset,
     return SUCCESS;
 }
 
+/*
+ * Numbers of up to 34 digits (all those of the decimal formats) are
+ * taken from a pool of decNumber34s, so the common path does not use
+ * malloc; larger numbers, or more than the pool holds, are malloc'd.
+ */
+#define NUMBER_POOL_SIZE 64
+
+static decNumber34 number_pool[NUMBER_POOL_SIZE];
+static decNumber34 *number_pool_free[NUMBER_POOL_SIZE];
+static int number_pool_free_count = -1;
+
 static decNumber *alloc_number(int32_t numdigits)
 {
     uInt needbytes;
     decNumber *number;
+    decNumber34 *fixed;
+
+    if (number_pool_free_count < 0) {
+        for (number_pool_free_count = 0;
+            number_pool_free_count < NUMBER_POOL_SIZE;
+            ++number_pool_free_count
+        ) {
+            number_pool_free[number_pool_free_count]
+                = &number_pool[number_pool_free_count];
+        }
+    }
+    if (decFixedFits(&number_pool[0], numdigits)
+        && number_pool_free_count > 0
+    ) {
+        fixed = number_pool_free[--number_pool_free_count];
+        memset(fixed, 0, sizeof(decNumber34));
+        return decFixedNumber(fixed);
+    }
 
     needbytes = sizeof(decNumber) + (D2U(numdigits) - 1) * sizeof(Unit);
     number = (decNumber *)malloc(needbytes);
@@ -516,6 +817,18 @@ static decNumber *alloc_number(int32_t numdigits)
     return number;
 }
 
+static void free_number(decNumber *number)
+{
+    decNumber34 *fixed;
+
+    fixed = (decNumber34 *)number;
+    if (fixed >= number_pool && fixed < number_pool + NUMBER_POOL_SIZE) {
+        number_pool_free[number_pool_free_count++] = fixed;
+    } else {
+        free(number);
+    }
+}
+
 static s_or_f convert_hex_char_to_int(char ch, uint8_t *hex)
 {
     switch (ch) {
@@ -664,14 +977,126 @@ static s_or_f parse_decimal128_hex(const char *s, decNumber **number,
     return SUCCESS;
 }
 
-static s_or_f parse_hex_notation(const char *s, decNumber **number,
+/* time count round trips through BID for the -b summary */
+static void bench_bid64(decimal64 *bid64)
+{
+    decimal64 dec64;
+    clock_t start;
+    long i;
+
+    start = clock();
+    for (i = 0; i < bench_count; ++i) {
+        decimal64FromBID(&dec64, bid64);
+    }
+    from_bid_clock += clock() - start;
+    start = clock();
+    for (i = 0; i < bench_count; ++i) {
+        decimal64ToBID(bid64, &dec64);
+    }
+    to_bid_clock += clock() - start;
+    bid_ops += bench_count;
+}
+
+static void bench_bid128(decimal128 *bid128)
+{
+    decimal128 dec128;
+    clock_t start;
+    long i;
+
+    start = clock();
+    for (i = 0; i < bench_count; ++i) {
+        decimal128FromBID(&dec128, bid128);
+    }
+    from_bid_clock += clock() - start;
+    start = clock();
+    for (i = 0; i < bench_count; ++i) {
+        decimal128ToBID(bid128, &dec128);
+    }
+    to_bid_clock += clock() - start;
+    bid_ops += bench_count;
+}
+
+/*
+ * The BID encoding is transcoded to DPD, back to (canonical) BID, and
+ * to DPD again, so that both directions are checked by the testcases.
+ */
+static s_or_f parse_bid64_hex(const char *s, decNumber **number,
+    decContext *ctx)
+{
+    decimal64 bid64;
+    decimal64 dec64;
+
+    if (!parse_hex(DECIMAL64_Bytes, bid64.bytes, s)) {
+        DBGPRINTF("invalid hex notation [%s]\n", s);
+        return FAILURE;
+    }
+    decimal64FromBID(&dec64, &bid64);
+    decimal64ToBID(&bid64, &dec64);
+    decimal64FromBID(&dec64, &bid64);
+    if (bench_count > 0) {
+        bench_bid64(&bid64);
+    }
+
+    *number = alloc_number(DECIMAL64_Pmax);
+    if (!*number) {
+        return FAILURE;
+    }
+    decimal64ToNumber(&dec64, *number);
+    decimal64FromNumber(&dec64, *number, ctx);
+    decimal64ToNumber(&dec64, *number);
+    return SUCCESS;
+}
+
+static s_or_f parse_bid128_hex(const char *s, decNumber **number,
     decContext *ctx)
+{
+    decimal128 bid128;
+    decimal128 dec128;
+
+    if (!parse_hex(DECIMAL128_Bytes, bid128.bytes, s)) {
+        DBGPRINTF("invalid hex notation [%s]\n", s);
+        return FAILURE;
+    }
+    decimal128FromBID(&dec128, &bid128);
+    decimal128ToBID(&bid128, &dec128);
+    decimal128FromBID(&dec128, &bid128);
+    if (bench_count > 0) {
+        bench_bid128(&bid128);
+    }
+
+    *number = alloc_number(DECIMAL128_Pmax);
+    if (!*number) {
+        return FAILURE;
+    }
+    decimal128ToNumber(&dec128, *number);
+    decimal128FromNumber(&dec128, *number, ctx);
+    decimal128ToNumber(&dec128, *number);
+    return SUCCESS;
+}
+
+/* bid is TRUE in files with the "encoding: bid" directive, where the
+ * 16 and 32 hex digit forms are BID64 and BID128 encodings */
+static s_or_f parse_hex_notation(const char *s, decNumber **number,
+    decContext *ctx, bool bid)
 {
     int len;
 
     len = strlen(s) - 1;
     if (len == 0) {
         *number = NULL;
+    } else if (bid && len == 16) {
+        if (!parse_bid64_hex(s + 1, number, ctx)) {
+            DBGPRINTF("parse_bid64_hex failed [%s]\n", s);
+            return FAILURE;
+        }
+    } else if (bid && len == 32) {
+        if (!parse_bid128_hex(s + 1, number, ctx)) {
+            DBGPRINTF("parse_bid128_hex failed [%s]\n", s);
+            return FAILURE;
+        }
+    } else if (bid) {
+        DBGPRINTF("invalid BID hex notation [%s]\n", s);
+        return FAILURE;
     } else if (len == 8) {
         if (!parse_decimal32_hex(s + 1, number, ctx)) {
             DBGPRINTF("parse_decimal32_hex failed [%s]\n", s);
@@ -794,7 +1219,7 @@ static s_or_f parse_format_dependent_decimal32(const char *s,
     decNumberFromString(tmp, s, ctx);
 
     decimal32FromNumber(&dec32, tmp, ctx);
-    free(tmp);
+    free_number(tmp);
 
     *number = alloc_number(DECIMAL32_Pmax);
     if (!*number) {
@@ -819,7 +1244,7 @@ static s_or_f parse_format_dependent_decimal64(const char *s,
     decNumberFromString(tmp, s, ctx);
 
     decimal64FromNumber(&dec64, tmp, ctx);
-    free(tmp);
+    free_number(tmp);
 
     *number = alloc_number(DECIMAL64_Pmax);
     if (!*number) {
@@ -844,7 +1269,7 @@ static s_or_f parse_format_dependent_decimal128(const char *s,
     decNumberFromString(tmp, s, ctx);
 
     decimal128FromNumber(&dec128, tmp, ctx);
-    free(tmp);
+    free_number(tmp);
 
     *number = alloc_number(DECIMAL128_Pmax);
     if (!*number) {
@@ -855,6 +1280,53 @@ static s_or_f parse_format_dependent_decimal128(const char *s,
     return SUCCESS;
 }
 
+/*
+ * Whether ctx is the context of a decimal64 (or decimal128) format, as set
+ * by the directives of the dd* (or dq*) files: the format's precision and
+ * exponent limits, with clamping and extended values.
+ */
+static bool is_decimal64_context(const decContext *ctx)
+{
+    return ctx->digits == DECIMAL64_Pmax && ctx->emax == DECIMAL64_Emax
+        && ctx->emin == DECIMAL64_Emin && ctx->clamp == 1 && ctx->extended;
+}
+
+static bool is_decimal128_context(const decContext *ctx)
+{
+    return ctx->digits == DECIMAL128_Pmax && ctx->emax == DECIMAL128_Emax
+        && ctx->emin == DECIMAL128_Emin && ctx->clamp == 1 && ctx->extended;
+}
+
+static s_or_f parse_decimal64_string(const char *s, decNumber **number,
+    decContext *ctx)
+{
+    decimal64 dec64;
+
+    decimal64FromString(&dec64, s, ctx);
+
+    *number = alloc_number(DECIMAL64_Pmax);
+    if (!*number) {
+        return FAILURE;
+    }
+    decimal64ToNumber(&dec64, *number);
+    return SUCCESS;
+}
+
+static s_or_f parse_decimal128_string(const char *s, decNumber **number,
+    decContext *ctx)
+{
+    decimal128 dec128;
+
+    decimal128FromString(&dec128, s, ctx);
+
+    *number = alloc_number(DECIMAL128_Pmax);
+    if (!*number) {
+        return FAILURE;
+    }
+    decimal128ToNumber(&dec128, *number);
+    return SUCCESS;
+}
+
 static s_or_f parse_format_dependent_decimal(const char *s, decNumber **number,
     decContext *ctx)
 {
@@ -981,7 +1453,7 @@ static s_or_f testcase_convert_operand_to_number(testcase_t *testcase,
                 }
             } else {
                 if (!parse_hex_notation(s, &testcase->operand_numbers[arg_pos],
-                    ctx)
+                    ctx, testcase->bid_encoding)
                 ) {
                     DBGPRINTF("parse_hex_notation failed for operand %d. [%s]\n", arg_pos, s);
                     return FAILURE;
@@ -995,6 +1467,26 @@ static s_or_f testcase_convert_operand_to_number(testcase_t *testcase,
                 return FAILURE;
             }
         }
+    } else if (testcase->is_using_directive_precision
+        && is_decimal64_context(ctx)
+    ) {
+        /* only the operands of apply, tosci and toeng are in the
+         * directive context; decimal64FromString must convert them as
+         * decNumberFromString does in that context */
+        if (!parse_decimal64_string(s, &testcase->operand_numbers[arg_pos],
+            ctx)
+        ) {
+            return FAILURE;
+        }
+    } else if (testcase->is_using_directive_precision
+        && is_decimal128_context(ctx)
+    ) {
+        /* likewise with decimal128FromString */
+        if (!parse_decimal128_string(s, &testcase->operand_numbers[arg_pos],
+            ctx)
+        ) {
+            return FAILURE;
+        }
     } else {
         testcase->operand_numbers[arg_pos] = alloc_number(ctx->digits);
         if (!testcase->operand_numbers[arg_pos]) {
@@ -1062,7 +1554,9 @@ static s_or_f testcase_convert_result_to_number(testcase_t *testcase)
         ctx->clamp = 1;
 
         if (p_sharp == s) {
-            if (!parse_hex_notation(s, &testcase->expected_number, ctx)) {
+            if (!parse_hex_notation(s, &testcase->expected_number, ctx,
+                testcase->bid_encoding)
+            ) {
                 DBGPRINTF("parse_hex_notation failed for result. [%s]\n", s);
                 return FAILURE;
             }
@@ -1090,24 +1584,164 @@ static s_or_f testcase_convert_result_to_number(testcase_t *testcase)
     return SUCCESS;
 }
 
+/*
+ * Flatten the [x,y,...] vector operands of a testcase into its
+ * operands (the elements of the first vector, then those of the
+ * second, and so on), which are then converted and printed as usual.
+ * The elements are separated by commas, with no spaces, and every
+ * vector must have the same number of them.
+ */
+static s_or_f testcase_init_vector_operands(testcase_t *testcase,
+    tokens_t *tokens, int token_count)
+{
+    char *s;
+    char *p;
+    size_t len;
+    size_t size;
+    int length;
+    int i;
+    int j;
+
+    size = 0;
+    testcase->operand_count = 0;
+    for (i = 0; i < token_count; ++i) {
+        s = tokens->tokens[i + 2];
+        len = strlen(s);
+        if (len < 2 || s[0] != '[' || s[len - 1] != ']') {
+            DBGPRINTF("vector operand expected. [%s]\n", s);
+            return FAILURE;
+        }
+        length = (len == 2 ? 0 : count_char(s, len, ',') + 1);
+        if (i > 0 && length != testcase->vector_length) {
+            DBGPRINTF("vector operands differ in length. [%s]\n", s);
+            return FAILURE;
+        }
+        testcase->vector_length = length;
+        testcase->operand_count += length;
+        size += len - 1;
+    }
+
+    testcase->vector_text = (char *)malloc(size);
+    testcase->operands = (char **)calloc(testcase->operand_count + 1,
+        sizeof(char *));
+    if (!testcase->vector_text || !testcase->operands) {
+        DBGPRINT("out of memory in testcase_init_vector_operands\n");
+        return FAILURE;
+    }
+    p = testcase->vector_text;
+    j = 0;
+    for (i = 0; i < token_count; ++i) {
+        s = tokens->tokens[i + 2];
+        len = strlen(s);
+        memcpy(p, s + 1, len - 2);
+        p[len - 2] = '\0';
+        if (len > 2) {
+            testcase->operands[j++] = p;
+        }
+        for (; *p; ++p) {
+            if (*p == ',') {
+                *p = '\0';
+                testcase->operands[j++] = p + 1;
+            }
+        }
+        ++p;
+    }
+    return SUCCESS;
+}
+
+#define NATIVE_NAME decSingle
+#define NATIVE_MEMBER ds
+#define NATIVE_ARITHMETIC 0
+#include "decTestNative.c"
+#undef NATIVE_NAME
+#undef NATIVE_MEMBER
+#undef NATIVE_ARITHMETIC
+
+#define NATIVE_NAME decDouble
+#define NATIVE_MEMBER dd
+#define NATIVE_ARITHMETIC 1
+#include "decTestNative.c"
+#undef NATIVE_NAME
+#undef NATIVE_MEMBER
+#undef NATIVE_ARITHMETIC
+
+#define NATIVE_NAME decQuad
+#define NATIVE_MEMBER dq
+#define NATIVE_ARITHMETIC 1
+#include "decTestNative.c"
+#undef NATIVE_NAME
+#undef NATIVE_MEMBER
+#undef NATIVE_ARITHMETIC
+
+/*
+ * Whether the native backend of native_bytes carries out op.  With -n,
+ * testcases of other operators are still run with decNumber.
+ */
+static bool native_has_operator(int native_bytes, const char *op)
+{
+    if (native_bytes == DECSINGLE_Bytes) {
+        return native_has_operator_decSingle(op);
+    } else if (native_bytes == DECDOUBLE_Bytes) {
+        return native_has_operator_decDouble(op);
+    } else if (native_bytes == DECQUAD_Bytes) {
+        return native_has_operator_decQuad(op);
+    }
+    return FALSE;
+}
+
 static s_or_f testcase_init(testcase_t *testcase, testfile_t *testfile,
     tokens_t *tokens)
 {
     int i;
     char *op;
+    int token_count;
 
     testcase->id = tokens->tokens[0];
     op = testcase->operator = tokens->tokens[1];
     testcase->is_using_directive_precision = (strcasecmp(op, "apply") == 0
         || strcasecmp(op, "tosci") == 0 || strcasecmp(op, "toeng") == 0);
-    testcase->operand_count = tokens_count_operands(tokens);
+    token_count = tokens_count_operands(tokens);
+    testcase->operand_count = token_count;
     testcase->context = &testfile->context;
     testcase->context->traps = 0;
     testcase->context->status = 0;
     testcase->actual_status = 0;
     testcase->actual_string = NULL;
     testcase->actual_number = NULL;
-    if (!tokens_get_conditions(tokens, 2 + testcase->operand_count + 2,
+    testcase->native_operands = NULL;
+    testcase->native_bytes = 0;
+    testcase->bid_encoding = testfile->bid_encoding;
+    testcase->vector_length = -1;
+    testcase->vector_text = NULL;
+    if (testfile->native_bytes == DECSINGLE_Bytes
+        && testcase->context->digits == DECSINGLE_Pmax
+        && testcase->context->emax == DECSINGLE_Emax
+        && testcase->context->emin == DECSINGLE_Emin
+        && testcase->context->clamp
+    ) {
+        testcase->native_bytes = DECSINGLE_Bytes;
+    } else if (testfile->native_bytes == DECDOUBLE_Bytes
+        && testcase->context->digits == DECDOUBLE_Pmax
+        && testcase->context->emax == DECDOUBLE_Emax
+        && testcase->context->emin == DECDOUBLE_Emin
+        && testcase->context->clamp
+    ) {
+        testcase->native_bytes = DECDOUBLE_Bytes;
+    } else if (testfile->native_bytes == DECQUAD_Bytes
+        && testcase->context->digits == DECQUAD_Pmax
+        && testcase->context->emax == DECQUAD_Emax
+        && testcase->context->emin == DECQUAD_Emin
+        && testcase->context->clamp
+    ) {
+        testcase->native_bytes = DECQUAD_Bytes;
+    }
+    if (testcase->native_bytes != 0
+        && ((token_count > 0 && tokens->tokens[2][0] == '[')
+            || !native_has_operator(testcase->native_bytes, op))
+    ) {
+        testcase->native_bytes = 0;
+    }
+    if (!tokens_get_conditions(tokens, 2 + token_count + 2,
         &testcase->expected_status)
     ) {
         DBGPRINT("tokens_get_conditions failed.\n");
@@ -1116,17 +1750,24 @@ static s_or_f testcase_init(testcase_t *testcase, testfile_t *testfile,
 
     testcase->operand_numbers = NULL;
     testcase->operand_contexts = NULL;
-    testcase->operands = (char **)calloc(testcase->operand_count,
-        sizeof(char *));
-    if (!testcase->operands) {
-        DBGPRINT("out of memory in testcase_init\n");
-        return FAILURE;
-    }
-    for (i = 0; i < testcase->operand_count; ++i) {
-        testcase->operands[i] = tokens->tokens[i + 2];
+    testcase->operands = NULL;
+    if (token_count > 0 && tokens->tokens[2][0] == '[') {
+        if (!testcase_init_vector_operands(testcase, tokens, token_count)) {
+            return FAILURE;
+        }
+    } else {
+        testcase->operands = (char **)calloc(testcase->operand_count,
+            sizeof(char *));
+        if (!testcase->operands) {
+            DBGPRINT("out of memory in testcase_init\n");
+            return FAILURE;
+        }
+        for (i = 0; i < testcase->operand_count; ++i) {
+            testcase->operands[i] = tokens->tokens[i + 2];
+        }
     }
 
-    testcase->expected_string = tokens->tokens[2 + testcase->operand_count + 1];
+    testcase->expected_string = tokens->tokens[2 + token_count + 1];
     testcase->expected_number = NULL;
     if (strcasecmp(testcase->operator, "class") != 0
         && strcasecmp(testcase->operator, "tosci") != 0
@@ -1152,25 +1793,20 @@ static bool testcase_has_null_operand(testcase_t *testcase)
     return FALSE;
 }
 
-static s_or_f testcase_run(testcase_t *testcase)
+static s_or_f testcase_execute(testcase_t *testcase)
 {
     decNumber **operands;
     decNumber *result;
 
-    if (strlen(testcase->operator) == 0) {
-        DBGPRINT("error in testcase_run. operator is empty.\n");
-        return FAILURE;
+    if (testcase->native_bytes == DECSINGLE_Bytes) {
+        return testcase_execute_decSingle(testcase);
+    } else if (testcase->native_bytes == DECDOUBLE_Bytes) {
+        return testcase_execute_decDouble(testcase);
+    } else if (testcase->native_bytes == DECQUAD_Bytes) {
+        return testcase_execute_decQuad(testcase);
     }
 
-    if (!testcase_convert_operands_to_numbers(testcase)) {
-        return FAILURE;
-    }
     operands = testcase->operand_numbers;
-
-    testcase->actual_number = alloc_number(testcase->context->digits);
-    if (!testcase->actual_number) {
-        return FAILURE;
-    }
     result = testcase->actual_number;
 
     switch (tolower(testcase->operator[0])) {
@@ -1184,7 +1820,7 @@ static s_or_f testcase_run(testcase_t *testcase)
         } else if (strcasecmp(testcase->operator, "apply") == 0) {
             decNumberCopy(result, operands[0]);
         } else {
-            DBGPRINTF("error in testcase_run. unknown operator: %s.\n",
+            DBGPRINTF("error in testcase_execute. unknown operator: %s.\n",
                 testcase->operator);
             return FAILURE;
         }
@@ -1217,7 +1853,7 @@ static s_or_f testcase_run(testcase_t *testcase)
         } else if (strcasecmp(testcase->operator, "copysign") == 0) {
             decNumberCopySign(result, operands[0], operands[1]);
         } else {
-            DBGPRINTF("error in testcase_run. unknown operator: %s.\n",
+            DBGPRINTF("error in testcase_execute. unknown operator: %s.\n",
                 testcase->operator);
             return FAILURE;
         }
@@ -1229,8 +1865,17 @@ static s_or_f testcase_run(testcase_t *testcase)
         } else if (strcasecmp(testcase->operator, "divideint") == 0) {
             decNumberDivideInteger(result, operands[0], operands[1],
                 testcase->context);
+        } else if (strcasecmp(testcase->operator, "dotproduct") == 0) {
+            if (testcase->vector_length < 0) {
+                DBGPRINT("error in testcase_execute. dotproduct needs"
+                    " vector operands.\n");
+                return FAILURE;
+            }
+            decNumberDotProduct(result, (const decNumber * const *)operands,
+                (const decNumber * const *)operands + testcase->vector_length,
+                testcase->vector_length, testcase->context);
         } else {
-            DBGPRINTF("error in testcase_run. unknown operator: %s.\n",
+            DBGPRINTF("error in testcase_execute. unknown operator: %s.\n",
                 testcase->operator);
             return FAILURE;
         }
@@ -1239,7 +1884,7 @@ static s_or_f testcase_run(testcase_t *testcase)
         if (strcasecmp(testcase->operator, "exp") == 0) {
             decNumberExp(result, operands[0], testcase->context);
         } else {
-            DBGPRINTF("error in testcase_run. unknown operator: %s.\n",
+            DBGPRINTF("error in testcase_execute. unknown operator: %s.\n",
                 testcase->operator);
             return FAILURE;
         }
@@ -1249,7 +1894,7 @@ static s_or_f testcase_run(testcase_t *testcase)
             decNumberFMA(result, operands[0], operands[1], operands[2],
                 testcase->context);
         } else {
-            DBGPRINTF("error in testcase_run. unknown operator: %s.\n",
+            DBGPRINTF("error in testcase_execute. unknown operator: %s.\n",
                 testcase->operator);
             return FAILURE;
         }
@@ -1258,7 +1903,7 @@ static s_or_f testcase_run(testcase_t *testcase)
         if (strcasecmp(testcase->operator, "invert") == 0) {
             decNumberInvert(result, operands[0], testcase->context);
         } else {
-            DBGPRINTF("error in testcase_run. unknown operator: %s.\n",
+            DBGPRINTF("error in testcase_execute. unknown operator: %s.\n",
                 testcase->operator);
             return FAILURE;
         }
@@ -1271,7 +1916,7 @@ static s_or_f testcase_run(testcase_t *testcase)
         } else if (strcasecmp(testcase->operator, "logb") == 0) {
             decNumberLogB(result, operands[0], testcase->context);
         } else {
-            DBGPRINTF("error in testcase_run. unknown operator: %s.\n",
+            DBGPRINTF("error in testcase_execute. unknown operator: %s.\n",
                 testcase->operator);
             return FAILURE;
         }
@@ -1294,7 +1939,7 @@ static s_or_f testcase_run(testcase_t *testcase)
             decNumberMultiply(result, operands[0], operands[1],
                 testcase->context);
         } else {
-            DBGPRINTF("error in testcase_run. unknown operator: %s.\n",
+            DBGPRINTF("error in testcase_execute. unknown operator: %s.\n",
                 testcase->operator);
             return FAILURE;
         }
@@ -1308,7 +1953,7 @@ static s_or_f testcase_run(testcase_t *testcase)
             decNumberNextToward(result, operands[0], operands[1],
                 testcase->context);
         } else {
-            DBGPRINTF("error in testcase_run. unknown operator: %s.\n",
+            DBGPRINTF("error in testcase_execute. unknown operator: %s.\n",
                 testcase->operator);
             return FAILURE;
         }
@@ -1317,7 +1962,7 @@ static s_or_f testcase_run(testcase_t *testcase)
         if (strcasecmp(testcase->operator, "or") == 0) {
             decNumberOr(result, operands[0], operands[1], testcase->context);
         } else {
-            DBGPRINTF("error in testcase_run. unknown operator: %s.\n",
+            DBGPRINTF("error in testcase_execute. unknown operator: %s.\n",
                 testcase->operator);
             return FAILURE;
         }
@@ -1329,7 +1974,7 @@ static s_or_f testcase_run(testcase_t *testcase)
             decNumberPower(result, operands[0], operands[1],
                 testcase->context);
         } else {
-            DBGPRINTF("error in testcase_run. unknown operator: %s.\n",
+            DBGPRINTF("error in testcase_execute. unknown operator: %s.\n",
                 testcase->operator);
             return FAILURE;
         }
@@ -1339,7 +1984,7 @@ static s_or_f testcase_run(testcase_t *testcase)
             decNumberQuantize(result, operands[0], operands[1],
                 testcase->context);
         } else {
-            DBGPRINTF("error in testcase_run. unknown operator: %s.\n",
+            DBGPRINTF("error in testcase_execute. unknown operator: %s.\n",
                 testcase->operator);
             return FAILURE;
         }
@@ -1360,7 +2005,7 @@ static s_or_f testcase_run(testcase_t *testcase)
             decNumberRotate(result, operands[0], operands[1],
                 testcase->context);
         } else {
-            DBGPRINTF("error in testcase_run. unknown operator: %s.\n",
+            DBGPRINTF("error in testcase_execute. unknown operator: %s.\n",
                 testcase->operator);
             return FAILURE;
         }
@@ -1379,7 +2024,7 @@ static s_or_f testcase_run(testcase_t *testcase)
             decNumberSubtract(result, operands[0], operands[1],
                 testcase->context);
         } else {
-            DBGPRINTF("error in testcase_run. unknown operator: %s.\n",
+            DBGPRINTF("error in testcase_execute. unknown operator: %s.\n",
                 testcase->operator);
             return FAILURE;
         }
@@ -1395,7 +2040,7 @@ static s_or_f testcase_run(testcase_t *testcase)
             testcase->actual_string = convert_number_to_string(operands[0]);
         } else if (strcasecmp(testcase->operator, "trim") == 0) {
             if (testcase->actual_number->digits < operands[0]->digits) {
-                free(testcase->actual_number);
+                free_number(testcase->actual_number);
                 testcase->actual_number = alloc_number(operands[0]->digits);
                 if (!testcase->actual_number) {
                     return FAILURE;
@@ -1405,7 +2050,7 @@ static s_or_f testcase_run(testcase_t *testcase)
             decNumberCopy(result, operands[0]);
             decNumberTrim(result);
         } else {
-            DBGPRINTF("error in testcase_run. unknown operator: %s.\n",
+            DBGPRINTF("error in testcase_execute. unknown operator: %s.\n",
                 testcase->operator);
             return FAILURE;
         }
@@ -1414,44 +2059,160 @@ static s_or_f testcase_run(testcase_t *testcase)
         if (strcasecmp(testcase->operator, "xor") == 0) {
             decNumberXor(result, operands[0], operands[1], testcase->context);
         } else {
-            DBGPRINTF("error in testcase_run. unknown operator: %s.\n",
+            DBGPRINTF("error in testcase_execute. unknown operator: %s.\n",
                 testcase->operator);
             return FAILURE;
         }
         break;
     default:
-        DBGPRINTF("error in testcase_run. unknown operator: %s.\n",
+        DBGPRINTF("error in testcase_execute. unknown operator: %s.\n",
             testcase->operator);
         return FAILURE;
     }
 
-    testcase->actual_status = testcase->context->status;
-
     return SUCCESS;
 }
 
-static void testcase_print(testcase_t *testcase)
+static s_or_f testcase_run(testcase_t *testcase, testfile_t *testfile)
 {
-    int i;
-    int j;
-    char *s;
-    decNumber *n;
-    int unit_count;
+    clock_t start;
+    long i;
+    decWorkspaceStats work_start;
+    decWorkspaceStats work_end;
+    uint32_t conversion_status;
+#if DECTESTCXX
+    int cxx_result;
+#endif
 
-    printf("id=%s  %s ", testcase->id, testcase->operator);
-    for (i = 0; i < testcase->operand_count; ++i) {
-        if (i > 0) {
-            printf(" ");
-        }
-        printf("%s", testcase->operands[i]);
+    if (strlen(testcase->operator) == 0) {
+        DBGPRINT("error in testcase_run. operator is empty.\n");
+        return FAILURE;
     }
-    printf(" -> ");
-    printf("%s", testcase->expected_string);
-    printf(" expected_status=[");
-    status_print(testcase->expected_status);
-    printf("]\n");
 
-    if (testcase->operand_numbers) {
+    if (!testcase_convert_operands_to_numbers(testcase)) {
+        return FAILURE;
+    }
+
+    if (testcase->native_bytes != 0) {
+        testcase->native_operands = (native_t *)calloc(
+            testcase->operand_count, sizeof(native_t));
+        if (!testcase->native_operands) {
+            DBGPRINT("out of memory in testcase_run\n");
+            return FAILURE;
+        }
+        conversion_status = 0;
+        if (testcase->native_bytes == DECSINGLE_Bytes) {
+            if (!testcase_convert_operands_decSingle(testcase,
+                &conversion_status)
+            ) {
+                return FAILURE;
+            }
+        } else if (testcase->native_bytes == DECDOUBLE_Bytes) {
+            if (!testcase_convert_operands_decDouble(testcase,
+                &conversion_status)
+            ) {
+                return FAILURE;
+            }
+        } else if (!testcase_convert_operands_decQuad(testcase,
+            &conversion_status)
+        ) {
+            return FAILURE;
+        }
+        if (testcase->is_using_directive_precision) {
+            testcase->context->status |= conversion_status;
+        } else if (conversion_status
+            & (DEC_Clamped | DEC_Inexact | DEC_Rounded)
+        ) {
+            /*
+             * An operand was rounded, or its exponent folded down, so
+             * the native operands are not those of the testcase.
+             */
+            free(testcase->native_operands);
+            testcase->native_operands = NULL;
+            testcase->native_bytes = 0;
+            ++testfile->native_fallback_count;
+        }
+    }
+
+    testcase->actual_number = alloc_number(testcase->context->digits);
+    if (!testcase->actual_number) {
+        return FAILURE;
+    }
+
+    if (alloc_report_mode) {
+        decNumberResetAllocCounts();
+    }
+    if (!testcase_execute(testcase)) {
+        return FAILURE;
+    }
+    if (alloc_report_mode) {
+        alloc_report_add(testcase->operator, testcase->context->digits);
+    }
+    testcase->actual_status = testcase->context->status;
+
+    if (bench_count > 0) {
+        decContextGetWorkspaceStats(&work_start);
+        start = clock();
+        for (i = 0; i < bench_count; ++i) {
+            if (testcase->actual_string) {
+                free(testcase->actual_string);
+                testcase->actual_string = NULL;
+            }
+            testcase_execute(testcase);
+        }
+        testfile->bench_clock += clock() - start;
+        testfile->bench_ops += bench_count;
+        decContextGetWorkspaceStats(&work_end);
+        testfile->bench_work_hits += work_end.hits - work_start.hits;
+        testfile->bench_work_misses += work_end.misses - work_start.misses;
+        testcase->context->status = testcase->actual_status;
+#if DECTESTCXX
+        if (testcase->native_bytes == 0 && testcase->vector_length < 0) {
+            cxx_result = cxx_bench(testcase->operator,
+                testcase->operand_numbers, testcase->operand_count,
+                testcase->context, bench_count, testfile->bench_cxx_clocks);
+            if (cxx_result < 0) {
+                printf("dec::Number result unmatched: id=%s\n", testcase->id);
+            } else if (cxx_result > 0) {
+                testfile->bench_cxx_ops += bench_count;
+            }
+        }
+#endif
+    }
+
+    if (testcase->native_bytes == DECSINGLE_Bytes) {
+        testcase_convert_result_decSingle(testcase);
+    } else if (testcase->native_bytes == DECDOUBLE_Bytes) {
+        testcase_convert_result_decDouble(testcase);
+    } else if (testcase->native_bytes == DECQUAD_Bytes) {
+        testcase_convert_result_decQuad(testcase);
+    }
+
+    return SUCCESS;
+}
+
+static void testcase_print(testcase_t *testcase)
+{
+    int i;
+    int j;
+    char *s;
+    decNumber *n;
+    int unit_count;
+
+    printf("id=%s  %s ", testcase->id, testcase->operator);
+    for (i = 0; i < testcase->operand_count; ++i) {
+        if (i > 0) {
+            printf(" ");
+        }
+        printf("%s", testcase->operands[i]);
+    }
+    printf(" -> ");
+    printf("%s", testcase->expected_string);
+    printf(" expected_status=[");
+    status_print(testcase->expected_status);
+    printf("]\n");
+
+    if (testcase->operand_numbers) {
         printf("operand_numbers:\n");
         for (i = 0; i < testcase->operand_count; ++i) {
             print_operand(testcase, i);
@@ -1462,6 +2223,559 @@ static void testcase_print(testcase_t *testcase)
     fflush(stdout);
 }
 
+/*
+ * Set up *ctx for comparing numbers in the checks: with no traps and
+ * (with DECSUBSET) extended, so that operands of any length are compared
+ * as they are, rather than rounded with Lost_digits raising SIGFPE.
+ */
+static decContext *compare_context_init(decContext *ctx)
+{
+    decContextDefault(ctx, DEC_INIT_BASE);
+    ctx->traps = 0;
+#if DECSUBSET
+    ctx->extended = 1;
+#endif
+    return ctx;
+}
+
+/*
+ * The order of the decimal64ToKey and decimal128ToKey keys of the
+ * operands of a compare, comparesig, comparetotal or comparetotmag
+ * testcase must agree with the expected result, for each format which
+ * holds both operands exactly.  Keys of numerically equal operands are
+ * equal (but that of -0 is below that of +0), so any order is accepted
+ * for them in a comparetotal.
+ */
+static int sort_key_compare(const decNumber *lhs, const decNumber *rhs,
+    int format_bytes, bool *exact)
+{
+    decContext ctx;
+    decimal64 d64[2];
+    decimal128 d128[2];
+    uint8_t keys[2][DECIMAL128_KeyBytes];
+    int key_bytes;
+    int cmp;
+
+    if (format_bytes == DECIMAL64_Bytes) {
+        decContextDefault(&ctx, DEC_INIT_DECIMAL64);
+        decimal64ToKey(decimal64FromNumber(&d64[0], lhs, &ctx), keys[0]);
+        decimal64ToKey(decimal64FromNumber(&d64[1], rhs, &ctx), keys[1]);
+        key_bytes = DECIMAL64_KeyBytes;
+    } else {
+        decContextDefault(&ctx, DEC_INIT_DECIMAL128);
+        decimal128ToKey(decimal128FromNumber(&d128[0], lhs, &ctx), keys[0]);
+        decimal128ToKey(decimal128FromNumber(&d128[1], rhs, &ctx), keys[1]);
+        key_bytes = DECIMAL128_KeyBytes;
+    }
+    *exact = (ctx.status == 0);
+    cmp = memcmp(keys[0], keys[1], key_bytes);
+    return (cmp > 0) - (cmp < 0);
+}
+
+static bool testcase_check_sort_keys(testcase_t *testcase)
+{
+    static const int format_bytes[] = { DECIMAL64_Bytes, DECIMAL128_Bytes };
+    decNumber34 lhs_number;
+    decNumber34 rhs_number;
+    decNumber *lhs;
+    decNumber *rhs;
+    decNumber *result;
+    decNumber compare_result;
+    decContext ctx;
+    bool total;
+    bool exact;
+    bool matched;
+    int expected;
+    int actual;
+    int i;
+
+    total = (strcasecmp(testcase->operator, "comparetotal") == 0
+        || strcasecmp(testcase->operator, "comparetotmag") == 0);
+    if (!total && strcasecmp(testcase->operator, "compare") != 0
+        && strcasecmp(testcase->operator, "comparesig") != 0
+    ) {
+        return TRUE;
+    }
+#if DECSUBSET
+    /* subset arithmetic rounds the operands before comparing them */
+    if (!testcase->context->extended) {
+        return TRUE;
+    }
+#endif
+    result = testcase->expected_number;
+    if (!result || decNumberIsNaN(result)
+        || testcase->operand_numbers[0]->digits > DECIMAL128_Pmax
+        || testcase->operand_numbers[1]->digits > DECIMAL128_Pmax
+    ) {
+        return TRUE;
+    }
+    expected = decNumberIsZero(result) ? 0
+        : decNumberIsNegative(result) ? -1 : 1;
+
+    lhs = decFixedCopy(&lhs_number, testcase->operand_numbers[0]);
+    rhs = decFixedCopy(&rhs_number, testcase->operand_numbers[1]);
+    if (!lhs || !rhs) {
+        return TRUE;
+    }
+    if (strcasecmp(testcase->operator, "comparetotmag") == 0) {
+        decNumberCopyAbs(lhs, lhs);
+        decNumberCopyAbs(rhs, rhs);
+    }
+
+    matched = TRUE;
+    for (i = 0; i < 2 && matched; ++i) {
+        actual = sort_key_compare(lhs, rhs, format_bytes[i], &exact);
+        if (!exact || actual == expected) {
+            continue;
+        }
+        if (decNumberIsZero(lhs) && decNumberIsZero(rhs)) {
+            continue;
+        }
+        if (total && actual == 0) {
+            if (decNumberIsNaN(lhs) && decNumberIsNaN(rhs)) {
+                continue;
+            }
+            compare_context_init(&ctx);
+            decNumberCompare(&compare_result, lhs, rhs, &ctx);
+            if (decNumberIsZero(&compare_result)) {
+                continue;
+            }
+        }
+        printf("sort key order unmatched: %d-byte keys give %d\n",
+            format_bytes[i] == DECIMAL64_Bytes ? DECIMAL64_KeyBytes
+                : DECIMAL128_KeyBytes, actual);
+        matched = FALSE;
+    }
+    return matched;
+}
+
+/*
+ * Numerically equal operands of a compare or comparesig testcase must
+ * have equal decNumberHash hashes, and the decimal64Hash and
+ * decimal128Hash of each operand, in each format which holds it
+ * exactly, must equal its decNumberHash.
+ */
+static bool testcase_check_hashes(testcase_t *testcase)
+{
+    decNumber *operand;
+    decContext ctx;
+    decimal64 d64;
+    decimal128 d128;
+    uint32_t hashes[2];
+    int i;
+
+    if (strcasecmp(testcase->operator, "compare") != 0
+        && strcasecmp(testcase->operator, "comparesig") != 0
+    ) {
+        return TRUE;
+    }
+#if DECSUBSET
+    /* subset arithmetic rounds the operands before comparing them */
+    if (!testcase->context->extended) {
+        return TRUE;
+    }
+#endif
+    for (i = 0; i < 2; ++i) {
+        operand = testcase->operand_numbers[i];
+        hashes[i] = decNumberHash(operand);
+        decContextDefault(&ctx, DEC_INIT_DECIMAL64);
+        decimal64FromNumber(&d64, operand, &ctx);
+        if (ctx.status == 0 && decimal64Hash(&d64) != hashes[i]) {
+            printf("hash unmatched: decimal64Hash of operand %d\n", i + 1);
+            return FALSE;
+        }
+        decContextDefault(&ctx, DEC_INIT_DECIMAL128);
+        decimal128FromNumber(&d128, operand, &ctx);
+        if (ctx.status == 0 && decimal128Hash(&d128) != hashes[i]) {
+            printf("hash unmatched: decimal128Hash of operand %d\n", i + 1);
+            return FALSE;
+        }
+    }
+    if (testcase->expected_number
+        && decNumberIsZero(testcase->expected_number)
+        && hashes[0] != hashes[1]
+    ) {
+        printf("hash unmatched: equal operands hash differently\n");
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/*
+ * The sum of the operands of an add or subtract testcase taken with a
+ * decAccumulator (from the decNumbers, and from decimal64s and
+ * decimal128s when both operands fit those formats exactly) must be
+ * the decNumberAdd or decNumberSubtract result, with the same status.
+ */
+static bool testcase_check_accumulator(testcase_t *testcase)
+{
+    static const char *sources[] = { "decNumbers", "decimal64s",
+        "decimal128s" };
+    decAccumulator acc;
+    decContext ctx;
+    decContext format_ctx;
+    decNumber *lhs;
+    decNumber *rhs;
+    decNumber *result;
+    decNumber compare_result;
+    decimal64 d64[2];
+    decimal128 d128[2];
+    char *result_string;
+    bool matched;
+    int source;
+
+    if (testcase->native_bytes != 0 || !testcase->actual_number
+        || (strcasecmp(testcase->operator, "add") != 0
+            && strcasecmp(testcase->operator, "subtract") != 0)
+    ) {
+        return TRUE;
+    }
+#if DECSUBSET
+    /* subset arithmetic rounds the operands before adding them */
+    if (!testcase->context->extended) {
+        return TRUE;
+    }
+#endif
+    lhs = testcase->operand_numbers[0];
+    rhs = alloc_number(testcase->operand_numbers[1]->digits);
+    result = alloc_number(testcase->context->digits);
+    if (!rhs || !result) {
+        free_number(rhs);
+        free_number(result);
+        return FALSE;
+    }
+    decNumberCopy(rhs, testcase->operand_numbers[1]);
+    if (strcasecmp(testcase->operator, "subtract") == 0
+        && !decNumberIsNaN(rhs)
+    ) {
+        decNumberCopyNegate(rhs, rhs);
+    }
+
+    matched = TRUE;
+    for (source = 0; source < 3 && matched; ++source) {
+        /* NaN payloads too long for a format are dropped without any
+         * status, so NaNs are only summed as decNumbers */
+        if (source > 0 && (decNumberIsNaN(lhs) || decNumberIsNaN(rhs))) {
+            break;
+        }
+        decAccumulatorInit(&acc);
+        if (source == 0) {
+            decAccumulatorAdd(&acc, lhs);
+            decAccumulatorAdd(&acc, rhs);
+        } else if (source == 1) {
+            decContextDefault(&format_ctx, DEC_INIT_DECIMAL64);
+            decimal64FromNumber(&d64[0], lhs, &format_ctx);
+            decimal64FromNumber(&d64[1], rhs, &format_ctx);
+            if (format_ctx.status != 0) {
+                continue;
+            }
+            decAccumulatorAddDecimal64s(&acc, d64, 2);
+        } else {
+            decContextDefault(&format_ctx, DEC_INIT_DECIMAL128);
+            decimal128FromNumber(&d128[0], lhs, &format_ctx);
+            decimal128FromNumber(&d128[1], rhs, &format_ctx);
+            if (format_ctx.status != 0) {
+                continue;
+            }
+            decAccumulatorAddDecimal128s(&acc, d128, 2);
+        }
+        ctx = *testcase->context;
+        ctx.status = 0;
+        decAccumulatorToNumber(&acc, result, &ctx);
+        decAccumulatorFree(&acc);
+        /* operands too far apart to be summed exactly are not checked */
+        if (ctx.status & DEC_Insufficient_storage) {
+            continue;
+        }
+
+        compare_context_init(&format_ctx);
+        decNumberCompareTotal(&compare_result, result,
+            testcase->actual_number, &format_ctx);
+        if (!decNumberIsZero(&compare_result)
+            || ctx.status != testcase->actual_status
+        ) {
+            result_string = convert_number_to_string(result);
+            printf("accumulator sum unmatched: %s give [%s] [",
+                sources[source], result_string ? result_string : "");
+            status_print(ctx.status);
+            printf("]\n");
+            free(result_string);
+            matched = FALSE;
+        }
+    }
+    free_number(rhs);
+    free_number(result);
+    return matched;
+}
+
+/*
+ * result and status (from the source named) must be the actual result
+ * and status of the testcase, unless the source had too little storage
+ * for an exact sum.
+ */
+static bool dot_product_matched(testcase_t *testcase, const char *source,
+    const decNumber *result, uint32_t status)
+{
+    decContext ctx;
+    decNumber compare_result;
+    char *result_string;
+
+    if (status & DEC_Insufficient_storage) {
+        return TRUE;
+    }
+    compare_context_init(&ctx);
+    decNumberCompareTotal(&compare_result, result, testcase->actual_number,
+        &ctx);
+    if (decNumberIsZero(&compare_result)
+        && status == testcase->actual_status
+    ) {
+        return TRUE;
+    }
+    result_string = convert_number_to_string(result);
+    printf("dot product unmatched: %s gives [%s] [", source,
+        result_string ? result_string : "");
+    status_print(status);
+    printf("]\n");
+    free(result_string);
+    return FALSE;
+}
+
+/*
+ * A multiply testcase is the dot product of [lhs] and [rhs], and an fma
+ * testcase that of [lhs,fhs] and [rhs,1], so decNumberDotProduct must
+ * give their results.  When every element of a dotproduct testcase
+ * fits a decimal64 exactly, summing the decimal64 products with a
+ * decAccumulator must give its result too, as must decimal64DotProduct
+ * in a decimal64 context.
+ */
+static bool testcase_check_dot_product(testcase_t *testcase)
+{
+    decNumber **operands;
+    const decNumber *lhs[2];
+    const decNumber *rhs[2];
+    decNumber16 one;
+    decimal64 *d64;
+    decimal64 d64_result;
+    decAccumulator acc;
+    decContext ctx;
+    decContext format_ctx;
+    decNumber *result;
+    bool matched;
+    int count;
+    int i;
+
+    if (testcase->native_bytes != 0 || !testcase->actual_number) {
+        return TRUE;
+    }
+#if DECSUBSET
+    if (!testcase->context->extended) {
+        return TRUE;
+    }
+#endif
+    operands = testcase->operand_numbers;
+    if (strcasecmp(testcase->operator, "multiply") == 0) {
+        lhs[0] = operands[0];
+        rhs[0] = operands[1];
+        count = 1;
+    } else if (strcasecmp(testcase->operator, "fma") == 0) {
+        decNumberFromInt32(&one.number, 1);
+        lhs[0] = operands[0];
+        rhs[0] = operands[1];
+        lhs[1] = operands[2];
+        rhs[1] = &one.number;
+        count = 2;
+    } else if (strcasecmp(testcase->operator, "dotproduct") == 0) {
+        count = testcase->vector_length;
+    } else {
+        return TRUE;
+    }
+    result = alloc_number(testcase->context->digits);
+    if (!result) {
+        return FALSE;
+    }
+
+    if (strcasecmp(testcase->operator, "dotproduct") != 0) {
+        ctx = *testcase->context;
+        ctx.status = 0;
+        decNumberDotProduct(result, lhs, rhs, count, &ctx);
+        matched = dot_product_matched(testcase, "decNumberDotProduct",
+            result, ctx.status);
+        free_number(result);
+        return matched;
+    }
+
+    /* NaN payloads too long for a decimal64 are dropped without any
+     * status, so NaNs are not converted */
+    matched = TRUE;
+    d64 = (decimal64 *)malloc(sizeof(decimal64) * (count * 2 + 1));
+    if (!d64) {
+        free_number(result);
+        return FALSE;
+    }
+    decContextDefault(&format_ctx, DEC_INIT_DECIMAL64);
+    for (i = 0; i < count * 2; ++i) {
+        if (decNumberIsNaN(operands[i])) {
+            format_ctx.status |= DEC_Invalid_operation;
+            break;
+        }
+        decimal64FromNumber(&d64[i], operands[i], &format_ctx);
+    }
+    if (format_ctx.status == 0) {
+        ctx = *testcase->context;
+        ctx.status = 0;
+        decAccumulatorInit(&acc);
+        decAccumulatorAddDecimal64Products(&acc, d64, d64 + count, count);
+        decAccumulatorToNumber(&acc, result, &ctx);
+        decAccumulatorFree(&acc);
+        matched = dot_product_matched(testcase, "decimal64 products",
+            result, ctx.status);
+        if (matched && is_decimal64_context(testcase->context)) {
+            ctx = *testcase->context;
+            ctx.status = 0;
+            decimal64DotProduct(&d64_result, d64, d64 + count, count, &ctx);
+            decimal64ToNumber(&d64_result, result);
+            matched = dot_product_matched(testcase, "decimal64DotProduct",
+                result, ctx.status);
+        }
+    }
+    free(d64);
+    free_number(result);
+    return matched;
+}
+
+/*
+ * Each operand whose coefficient fits in a row of DECIMAL64_Units or
+ * DECIMAL128_Units Units (including those with a digit or two more than
+ * the format holds) must convert with decimal64ArrayFromNumberUnits and
+ * decimal128ArrayFromNumberUnits to the encoding and status given by
+ * decimal64FromNumber and decimal128FromNumber, and the encoding must
+ * convert back with decimal64ArrayToNumberUnits and
+ * decimal128ArrayToNumberUnits to the fields of decimal64ToNumber and
+ * decimal128ToNumber.
+ */
+static bool testcase_check_number_units(testcase_t *testcase)
+{
+    decNumber *operand;
+    decNumber34 number;
+    decContext ctx;
+    decContext row_ctx;
+    decimal64 d64[2];
+    decimal128 d128[2];
+    decNumberUnit units[DECIMAL128_Units];
+    int32_t digits;
+    int32_t exponent;
+    uint8_t bits;
+    int i;
+    int n;
+
+    if (testcase->native_bytes != 0 || !testcase->operand_numbers) {
+        return TRUE;
+    }
+    for (i = 0; i < testcase->operand_count; ++i) {
+        operand = testcase->operand_numbers[i];
+        if (!operand || operand->digits > DECIMAL128_Units * DECDPUN) {
+            continue;
+        }
+        digits = operand->digits;
+        exponent = operand->exponent;
+        bits = operand->bits;
+
+        if (digits <= DECIMAL64_Units * DECDPUN) {
+            memset(units, 0, sizeof(units));
+            memcpy(units, operand->lsu, D2U(digits) * sizeof(*units));
+            decContextDefault(&ctx, DEC_INIT_DECIMAL64);
+            decContextDefault(&row_ctx, DEC_INIT_DECIMAL64);
+            decimal64FromNumber(&d64[0], operand, &ctx);
+            decimal64ArrayFromNumberUnits(&d64[1], 1, units, &digits,
+                &exponent, &bits, &row_ctx);
+            if (memcmp(&d64[0], &d64[1], sizeof(d64[0])) != 0
+                || ctx.status != row_ctx.status
+            ) {
+                printf("number units unmatched: "
+                    "decimal64ArrayFromNumberUnits of operand %d\n", i + 1);
+                return FALSE;
+            }
+            decimal64ToNumber(&d64[0], &number.number);
+            decimal64ArrayToNumberUnits(&d64[0], 1, units, &digits,
+                &exponent, &bits);
+            for (n = 0; n < DECIMAL64_Units; ++n) {
+                if (units[n] != (n < (int)D2U(number.number.digits)
+                    ? number.number.lsu[n] : 0)
+                ) {
+                    break;
+                }
+            }
+            if (n < DECIMAL64_Units || digits != number.number.digits
+                || exponent != number.number.exponent
+                || bits != number.number.bits
+            ) {
+                printf("number units unmatched: "
+                    "decimal64ArrayToNumberUnits of operand %d\n", i + 1);
+                return FALSE;
+            }
+            digits = operand->digits;
+            exponent = operand->exponent;
+            bits = operand->bits;
+        }
+
+        memset(units, 0, sizeof(units));
+        memcpy(units, operand->lsu, D2U(digits) * sizeof(*units));
+        decContextDefault(&ctx, DEC_INIT_DECIMAL128);
+        decContextDefault(&row_ctx, DEC_INIT_DECIMAL128);
+        decimal128FromNumber(&d128[0], operand, &ctx);
+        decimal128ArrayFromNumberUnits(&d128[1], 1, units, &digits,
+            &exponent, &bits, &row_ctx);
+        if (memcmp(&d128[0], &d128[1], sizeof(d128[0])) != 0
+            || ctx.status != row_ctx.status
+        ) {
+            printf("number units unmatched: "
+                "decimal128ArrayFromNumberUnits of operand %d\n", i + 1);
+            return FALSE;
+        }
+        decimal128ToNumber(&d128[0], &number.number);
+        decimal128ArrayToNumberUnits(&d128[0], 1, units, &digits,
+            &exponent, &bits);
+        for (n = 0; n < DECIMAL128_Units; ++n) {
+            if (units[n] != (n < (int)D2U(number.number.digits)
+                ? number.number.lsu[n] : 0)
+            ) {
+                break;
+            }
+        }
+        if (n < DECIMAL128_Units || digits != number.number.digits
+            || exponent != number.number.exponent
+            || bits != number.number.bits
+        ) {
+            printf("number units unmatched: "
+                "decimal128ArrayToNumberUnits of operand %d\n", i + 1);
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+/*
+ * With -m, everything the testcase took from the arena (including any
+ * storage for the checks of the previous testcase) must have been
+ * released by now; the arena is then emptied for the next one.
+ */
+static bool testcase_check_arena(void)
+{
+    long live;
+
+    if (!arena_mode) {
+        return TRUE;
+    }
+    live = arena.live;
+    arena.live = 0;
+    arena.used = 0;
+    if (live != 0) {
+        printf("arena storage unreleased: %ld allocations\n", live);
+        return FALSE;
+    }
+    return TRUE;
+}
+
 static bool testcase_check(testcase_t *testcase)
 {
     bool value_matched;
@@ -1470,6 +2784,17 @@ static bool testcase_check(testcase_t *testcase)
     char *expected_string;
     decNumber compare_result;
 
+    if (!testcase_check_arena()
+        || !testcase_check_sort_keys(testcase)
+        || !testcase_check_hashes(testcase)
+        || !testcase_check_accumulator(testcase)
+        || !testcase_check_dot_product(testcase)
+        || !testcase_check_number_units(testcase)
+    ) {
+        testcase_print(testcase);
+        return FALSE;
+    }
+
     if (strcmp(testcase->expected_string, WHATEVER_RESULT) == 0) {
         value_matched = TRUE;
     } else if (testcase->actual_string != NULL) {
@@ -1526,7 +2851,7 @@ static int testcase_dtor(testcase_t *testcase)
     if (testcase->operand_numbers) {
         for (i = 0; i < testcase->operand_count; ++i) {
             if (testcase->operand_numbers[i]) {
-                free(testcase->operand_numbers[i]);
+                free_number(testcase->operand_numbers[i]);
             }
         }
         free(testcase->operand_numbers);
@@ -1534,16 +2859,22 @@ static int testcase_dtor(testcase_t *testcase)
     if (testcase->operand_contexts) {
         free(testcase->operand_contexts);
     }
+    if (testcase->native_operands) {
+        free(testcase->native_operands);
+    }
 
     if (testcase->actual_string) {
         free(testcase->actual_string);
     }
     if (testcase->actual_number) {
-        free(testcase->actual_number);
+        free_number(testcase->actual_number);
     }
 
     if (testcase->expected_number) {
-        free(testcase->expected_number);
+        free_number(testcase->expected_number);
+    }
+    if (testcase->vector_text) {
+        free(testcase->vector_text);
     }
 }
 
@@ -1567,7 +2898,7 @@ static s_or_f testfile_process_test(testfile_t *testfile, tokens_t *tokens)
     if (testcase_has_null_operand(&testcase) || is_in_skip_list(testcase.id)) {
         ++testfile->skip_count;
     } else {
-        if (!testcase_run(&testcase)) {
+        if (!testcase_run(&testcase, testfile)) {
             tokens_print(tokens);
             DBGPRINT("testcase_run failed.\n");
             return FAILURE;
@@ -1680,6 +3011,19 @@ static s_or_f handle_extended(testfile_t *testfile, tokens_t *tokens)
     return SUCCESS;
 }
 
+static s_or_f handle_encoding(testfile_t *testfile, tokens_t *tokens)
+{
+    if (strcasecmp(tokens->tokens[2], "bid") == 0) {
+        testfile->bid_encoding = TRUE;
+    } else if (strcasecmp(tokens->tokens[2], "dpd") == 0) {
+        testfile->bid_encoding = FALSE;
+    } else {
+        DBGPRINTF("unknown encoding [%s]\n", tokens->tokens[2]);
+        return FAILURE;
+    }
+    return SUCCESS;
+}
+
 #define TEST_SUFFIX ".decTest"
 
 static s_or_f handle_dectest(testfile_t *testfile, tokens_t *tokens)
@@ -1723,6 +3067,7 @@ static directive_handler_map_t directive_handlers[] = {
     { "minexponent", handle_min_exponent },
     { "clamp", handle_clamp },
     { "extended", handle_extended },
+    { "encoding", handle_encoding },
     { "version", handle_version },
     { NULL, NULL }
 };
@@ -1762,12 +3107,22 @@ static s_or_f testfile_process_tokens(testfile_t *testfile, tokens_t *tokens)
     return FAILURE;
 }
 
+#if DECSTATS
+static double stats_percent(uint64_t hits, uint64_t ops)
+{
+    return ops ? 100.0 * hits / ops : 0.0;
+}
+#endif
+
 static s_or_f process_file(char *filename, testfile_t *parent)
 {
     char line_buf[LINE_BUF_MAX_LEN];
     testfile_t testfile;
     tokens_t tokens;
     s_or_f result;
+#if DECTESTCXX
+    int i;
+#endif
 
     result = SUCCESS;
     testfile_init(&testfile, filename);
@@ -1784,28 +3139,472 @@ static s_or_f process_file(char *filename, testfile_t *parent)
             break;
         }
     }
-    printf("== %s: tests=%d, success=%d, failure=%d, skip=%d\n",
+    printf("== %s: tests=%d, success=%d, failure=%d, skip=%d",
         testfile.filename, testfile.test_count, testfile.success_count,
         testfile.failure_count, testfile.skip_count);
+    if (native_mode) {
+        printf(", decNumber=%d", testfile.native_fallback_count);
+    }
+    if (bench_count > 0) {
+        printf(", time=%.3fs, ns/op=%.1f",
+            (double)testfile.bench_clock / CLOCKS_PER_SEC,
+            testfile.bench_ops ? (double)testfile.bench_clock
+                / CLOCKS_PER_SEC * 1e9 / testfile.bench_ops : 0.0);
+        if (testfile.bench_work_hits + testfile.bench_work_misses > 0) {
+            printf(", workspace/op=%.2f, malloc/op=%.2f",
+                (double)testfile.bench_work_hits / testfile.bench_ops,
+                (double)testfile.bench_work_misses / testfile.bench_ops);
+        }
+#if DECTESTCXX
+        if (testfile.bench_cxx_ops > 0) {
+            printf(", C ns/op=%.1f, dec::Number operator ns/op=%.1f,"
+                " named ns/op=%.1f",
+                (double)testfile.bench_cxx_clocks[0] / CLOCKS_PER_SEC * 1e9
+                    / testfile.bench_cxx_ops,
+                (double)testfile.bench_cxx_clocks[1] / CLOCKS_PER_SEC * 1e9
+                    / testfile.bench_cxx_ops,
+                (double)testfile.bench_cxx_clocks[2] / CLOCKS_PER_SEC * 1e9
+                    / testfile.bench_cxx_ops);
+        }
+#endif
+#if DECSTATS
+        printf(", aligned=%.1f%%, add128=%.1f%%, mul128=%.1f%%",
+            stats_percent(
+                decNumberStats.addAlign - testfile.bench_stats.addAlign,
+                decNumberStats.addOps - testfile.bench_stats.addOps),
+            stats_percent(decNumberStats.add128 - testfile.bench_stats.add128,
+                decNumberStats.addOps - testfile.bench_stats.addOps),
+            stats_percent(decNumberStats.mul128 - testfile.bench_stats.mul128,
+                decNumberStats.mulOps - testfile.bench_stats.mulOps));
+#endif
+        if (bid_ops > testfile.bench_bid_ops) {
+            printf(", fromBID ns/op=%.1f, toBID ns/op=%.1f",
+                (double)(from_bid_clock - testfile.bench_from_bid_clock)
+                    / CLOCKS_PER_SEC * 1e9
+                    / (bid_ops - testfile.bench_bid_ops),
+                (double)(to_bid_clock - testfile.bench_to_bid_clock)
+                    / CLOCKS_PER_SEC * 1e9
+                    / (bid_ops - testfile.bench_bid_ops));
+        }
+    }
+    printf("\n");
     if (parent) {
         parent->test_count += testfile.test_count;
         parent->success_count += testfile.success_count;
         parent->failure_count += testfile.failure_count;
         parent->skip_count += testfile.skip_count;
+        parent->native_fallback_count += testfile.native_fallback_count;
+        parent->bench_clock += testfile.bench_clock;
+        parent->bench_ops += testfile.bench_ops;
+        parent->bench_work_hits += testfile.bench_work_hits;
+        parent->bench_work_misses += testfile.bench_work_misses;
+#if DECTESTCXX
+        for (i = 0; i < 3; ++i) {
+            parent->bench_cxx_clocks[i] += testfile.bench_cxx_clocks[i];
+        }
+        parent->bench_cxx_ops += testfile.bench_cxx_ops;
+#endif
     }
 
     testfile_dtor(&testfile);
     return result;
 }
 
+static int compare_total_decimal64(const void *lhs, const void *rhs)
+{
+    decNumber16 lhs_number;
+    decNumber16 rhs_number;
+    decNumber result;
+    decContext ctx;
+
+    decContextDefault(&ctx, DEC_INIT_DECIMAL64);
+    decimal64ToNumber((const decimal64 *)lhs, &lhs_number.number);
+    decimal64ToNumber((const decimal64 *)rhs, &rhs_number.number);
+    decNumberCompareTotal(&result, &lhs_number.number, &rhs_number.number,
+        &ctx);
+    return decNumberIsZero(&result) ? 0
+        : decNumberIsNegative(&result) ? -1 : 1;
+}
+
+/*
+ * Fill d64 with pseudo-random amounts with up to 16 digits and two to
+ * four decimal places (so there are many cohorts), with some zeros,
+ * Infinities and NaNs if specials is TRUE.
+ */
+static void random_decimal64s(decimal64 *d64, long count, bool specials)
+{
+    decContext ctx;
+    char s[DECIMAL64_String];
+    uint32_t seed;
+    uint32_t kind;
+    long i;
+
+    decContextDefault(&ctx, DEC_INIT_DECIMAL64);
+    seed = 1;
+    for (i = 0; i < count; ++i) {
+        seed = seed * 1103515245 + 12345;
+        kind = seed >> 28;
+        if (!specials && kind < 2) {
+            kind = 2;
+        }
+        switch (kind) {
+        case 0:
+            sprintf(s, "%s", (seed & 0x100) ? "-Inf" : "0E-3");
+            break;
+        case 1:
+            sprintf(s, "%sNaN%u", (seed & 0x100) ? "-" : "",
+                (seed >> 9) & 0xff);
+            break;
+        default:
+            sprintf(s, "%s%u%07uE-%u", (seed & 0x100) ? "-" : "",
+                (seed >> 9) & 0x7ff, (unsigned)(i % 10000000),
+                2 + (seed >> 20) % 3);
+            break;
+        }
+        decimal64FromString(&d64[i], s, &ctx);
+    }
+}
+
+/*
+ * Both sorts must give numerically equal values at each position; only
+ * the order within cohorts may differ.
+ */
+static void bench_sort(long count)
+{
+    decimal64 *by_qsort;
+    decimal64 *by_radix;
+    decNumber16 lhs_number;
+    decNumber16 rhs_number;
+    decNumber result;
+    decContext ctx;
+    clock_t qsort_clock;
+    clock_t radix_clock;
+    long i;
+    long differ;
+
+    by_qsort = (decimal64 *)malloc(sizeof(decimal64) * count);
+    by_radix = (decimal64 *)malloc(sizeof(decimal64) * count);
+    if (!by_qsort || !by_radix) {
+        DBGPRINT("out of memory in bench_sort\n");
+        free(by_qsort);
+        free(by_radix);
+        return;
+    }
+
+    decContextDefault(&ctx, DEC_INIT_DECIMAL64);
+    random_decimal64s(by_qsort, count, TRUE);
+    memcpy(by_radix, by_qsort, sizeof(decimal64) * count);
+
+    qsort_clock = clock();
+    qsort(by_qsort, count, sizeof(decimal64), compare_total_decimal64);
+    qsort_clock = clock() - qsort_clock;
+    radix_clock = clock();
+    decimal64Sort(by_radix, count, &ctx);
+    radix_clock = clock() - radix_clock;
+
+    differ = 0;
+    for (i = 0; i < count; ++i) {
+        decimal64ToNumber(&by_qsort[i], &lhs_number.number);
+        decimal64ToNumber(&by_radix[i], &rhs_number.number);
+        if (decNumberIsNaN(&lhs_number.number)
+            || decNumberIsNaN(&rhs_number.number)
+        ) {
+            decNumberCompareTotal(&result, &lhs_number.number,
+                &rhs_number.number, &ctx);
+        } else {
+            decNumberCompare(&result, &lhs_number.number,
+                &rhs_number.number, &ctx);
+        }
+        if (!decNumberIsZero(&result)) {
+            ++differ;
+        }
+    }
+
+    printf("== sort: count=%ld, qsort+decNumberCompareTotal=%.3fs"
+        " (%.1f ns/value), decimal64Sort=%.3fs (%.1f ns/value),"
+        " differing=%ld\n", count,
+        (double)qsort_clock / CLOCKS_PER_SEC,
+        (double)qsort_clock / CLOCKS_PER_SEC * 1e9 / count,
+        (double)radix_clock / CLOCKS_PER_SEC,
+        (double)radix_clock / CLOCKS_PER_SEC * 1e9 / count, differ);
+    free(by_qsort);
+    free(by_radix);
+}
+
+/* the FNV-1a hash of the exponent, sign and Units of the reduced
+ * decNumber of d64, for comparison with decimal64Hash */
+static uint32_t hash_reduced_units(const decimal64 *d64)
+{
+    decNumber16 reduced;
+    decContext ctx;
+    const uint8_t *p;
+    const uint8_t *end;
+    uint32_t hash;
+
+    decContextDefault(&ctx, DEC_INIT_DECIMAL64);
+    decimal64ToNumber(d64, &reduced.number);
+    decNumberReduce(&reduced.number, &reduced.number, &ctx);
+    hash = 2166136261u;
+    p = (const uint8_t *)&reduced.number.exponent;
+    end = p + sizeof(reduced.number.exponent);
+    for (; p < end; ++p) {
+        hash = (hash ^ *p) * 16777619u;
+    }
+    hash = (hash ^ reduced.number.bits) * 16777619u;
+    p = (const uint8_t *)reduced.number.lsu;
+    end = p + sizeof(decNumberUnit)
+        * ((reduced.number.digits + DECDPUN - 1) / DECDPUN);
+    for (; p < end; ++p) {
+        hash = (hash ^ *p) * 16777619u;
+    }
+    return hash;
+}
+
+/*
+ * Each value is hashed by decNumberHash, decimal64Hash and
+ * decimal128Hash, and so is a numerically equal value with a lower
+ * exponent (up to the full 34 digits of a decimal128) and, if it has
+ * trailing zeros, its reduced value; all the hashes must be equal.  The
+ * hashing times are compared with that of converting each decimal64 to
+ * a decNumber, reducing it, and hashing the Units.
+ */
+static void bench_hash(long count)
+{
+    decimal64 *d64;
+    decimal128 *d128;
+    decNumber16 *numbers;
+    decNumber34 other_number;
+    decNumber *other;
+    decNumber quantum;
+    decContext ctx;
+    decimal128 other128;
+    uint32_t hash;
+    volatile uint32_t sum;
+    clock_t reduce_clock;
+    clock_t number_clock;
+    clock_t d64_clock;
+    clock_t d128_clock;
+    long i;
+    long mismatches;
+
+    d64 = (decimal64 *)malloc(sizeof(decimal64) * count);
+    d128 = (decimal128 *)malloc(sizeof(decimal128) * count);
+    numbers = (decNumber16 *)malloc(sizeof(decNumber16) * count);
+    other = decFixedZero(&other_number);
+    if (!d64 || !d128 || !numbers) {
+        DBGPRINT("out of memory in bench_hash\n");
+        free(d64);
+        free(d128);
+        free(numbers);
+        return;
+    }
+
+    random_decimal64s(d64, count, TRUE);
+    decContextDefault(&ctx, DEC_INIT_DECIMAL128);
+    for (i = 0; i < count; ++i) {
+        decimal64ToNumber(&d64[i], &numbers[i].number);
+        decimal128FromNumber(&d128[i], &numbers[i].number, &ctx);
+    }
+
+    mismatches = 0;
+    for (i = 0; i < count; ++i) {
+        hash = decNumberHash(&numbers[i].number);
+        if (decimal64Hash(&d64[i]) != hash
+            || decimal128Hash(&d128[i]) != hash
+        ) {
+            ++mismatches;
+        }
+        if (decNumberIsSpecial(&numbers[i].number)) {
+            continue;
+        }
+        decNumberZero(&quantum);
+        quantum.exponent = numbers[i].number.exponent
+            - (int32_t)(i % (DECIMAL128_Pmax - numbers[i].number.digits + 1));
+        decNumberQuantize(other, &numbers[i].number, &quantum, &ctx);
+        if (decNumberIsZero(other) && (i & 1)) {
+            decNumberCopyNegate(other, other);
+        }
+        decimal128FromNumber(&other128, other, &ctx);
+        if (decNumberHash(other) != hash || decimal128Hash(&other128) != hash) {
+            ++mismatches;
+        }
+        decNumberReduce(other, &numbers[i].number, &ctx);
+        if (decNumberHash(other) != hash) {
+            ++mismatches;
+        }
+    }
+
+    /* the sum keeps the hashing from being optimized away */
+    sum = 0;
+    reduce_clock = clock();
+    for (i = 0; i < count; ++i) {
+        sum += hash_reduced_units(&d64[i]);
+    }
+    reduce_clock = clock() - reduce_clock;
+    number_clock = clock();
+    for (i = 0; i < count; ++i) {
+        sum += decNumberHash(&numbers[i].number);
+    }
+    number_clock = clock() - number_clock;
+    d64_clock = clock();
+    for (i = 0; i < count; ++i) {
+        sum += decimal64Hash(&d64[i]);
+    }
+    d64_clock = clock() - d64_clock;
+    d128_clock = clock();
+    for (i = 0; i < count; ++i) {
+        sum += decimal128Hash(&d128[i]);
+    }
+    d128_clock = clock() - d128_clock;
+
+    printf("== hash: count=%ld,"
+        " decimal64ToNumber+decNumberReduce+FNV=%.1f ns/value,"
+        " decNumberHash=%.1f ns/value, decimal64Hash=%.1f ns/value,"
+        " decimal128Hash=%.1f ns/value, mismatches=%ld\n",
+        count,
+        (double)reduce_clock / CLOCKS_PER_SEC * 1e9 / count,
+        (double)number_clock / CLOCKS_PER_SEC * 1e9 / count,
+        (double)d64_clock / CLOCKS_PER_SEC * 1e9 / count,
+        (double)d128_clock / CLOCKS_PER_SEC * 1e9 / count,
+        mismatches);
+    free(d64);
+    free(d128);
+    free(numbers);
+}
+
+/*
+ * The amounts are summed at decimal128 precision, so both sums are
+ * exact and must be equal; the add loop pays for a conversion and a
+ * rounded decNumberAdd per value, where the accumulator adds each
+ * value's declets into its limbs and rounds once.
+ */
+static void bench_sum(long count)
+{
+    decimal64 *d64;
+    decNumber34 add_number;
+    decNumber34 acc_number;
+    decNumber *add_sum;
+    decNumber *acc_sum;
+    decNumber16 number;
+    decAccumulator acc;
+    decContext ctx;
+    decNumber compare_result;
+    char add_string[DECIMAL128_String];
+    char acc_string[DECIMAL128_String];
+    clock_t add_clock;
+    clock_t acc_clock;
+    long i;
+
+    d64 = (decimal64 *)malloc(sizeof(decimal64) * count);
+    add_sum = decFixedZero(&add_number);
+    acc_sum = decFixedZero(&acc_number);
+    if (!d64) {
+        DBGPRINT("out of memory in bench_sum\n");
+        return;
+    }
+    random_decimal64s(d64, count, FALSE);
+    decContextDefault(&ctx, DEC_INIT_DECIMAL128);
+
+    add_clock = clock();
+    decNumberZero(add_sum);
+    for (i = 0; i < count; ++i) {
+        decimal64ToNumber(&d64[i], &number.number);
+        decNumberAdd(add_sum, add_sum, &number.number, &ctx);
+    }
+    add_clock = clock() - add_clock;
+
+    acc_clock = clock();
+    decAccumulatorInit(&acc);
+    decAccumulatorAddDecimal64s(&acc, d64, (int32_t)count);
+    decAccumulatorToNumber(&acc, acc_sum, &ctx);
+    decAccumulatorFree(&acc);
+    acc_clock = clock() - acc_clock;
+
+    decNumberCompareTotal(&compare_result, add_sum, acc_sum, &ctx);
+    decNumberToString(add_sum, add_string);
+    decNumberToString(acc_sum, acc_string);
+    printf("== sum: count=%ld, decNumberAdd=%.1f ns/value [%s],"
+        " decAccumulator=%.1f ns/value [%s], %s\n", count,
+        (double)add_clock / CLOCKS_PER_SEC * 1e9 / count, add_string,
+        (double)acc_clock / CLOCKS_PER_SEC * 1e9 / count, acc_string,
+        decNumberIsZero(&compare_result) ? "equal" : "DIFFERENT");
+    free(d64);
+}
+
 int
 main(int argc, char *argv[])
 {
-    if (argc != 2) {
-        fprintf(stderr, "Usage: %s testfile.\n", argv[0]);
+    int i;
+
+    for (i = 1; i < argc && argv[i][0] == '-'; ++i) {
+        if (strcmp(argv[i], "-n") == 0) {
+            native_mode = TRUE;
+        } else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc) {
+            bench_count = atol(argv[++i]);
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            sort_count = atol(argv[++i]);
+        } else if (strcmp(argv[i], "-h") == 0 && i + 1 < argc) {
+            hash_count = atol(argv[++i]);
+        } else if (strcmp(argv[i], "-a") == 0 && i + 1 < argc) {
+            sum_count = atol(argv[++i]);
+        } else if (strcmp(argv[i], "-m") == 0) {
+            arena_mode = TRUE;
+        } else if (strcmp(argv[i], "-w") == 0 && i + 1 < argc) {
+            workspace_limit = atol(argv[++i]);
+        } else if (strcmp(argv[i], "-r") == 0) {
+            alloc_report_mode = TRUE;
+        } else {
+            break;
+        }
+    }
+    if (i != argc - 1
+        && !((sort_count > 0 || hash_count > 0 || sum_count > 0)
+            && i == argc)
+    ) {
+        fprintf(stderr, "Usage: %s [-n] [-m] [-w bytes] [-r] [-b count]"
+            " [-s count] [-h count] [-a count] [testfile].\n", argv[0]);
+        return 1;
+    }
+#if DECTESTCXX
+    if (cxx_check_constants() != 0) {
+        DBGPRINT("constexpr DPD tables or constants unmatched\n");
         return 1;
     }
+#endif
+    if (arena_mode) {
+        arena.base = (char *)malloc(ARENA_BYTES);
+        if (!arena.base) {
+            DBGPRINT("out of memory for the arena\n");
+            return 1;
+        }
+        decContextSetThreadAllocator(&arena_allocator);
+    }
+    if (workspace_limit >= 0) {
+        decContextSetWorkspaceLimit((size_t)workspace_limit);
+    }
 
-    process_file(argv[1], NULL);
+    if (sort_count > 0) {
+        bench_sort(sort_count);
+    }
+    if (hash_count > 0) {
+        bench_hash(hash_count);
+    }
+    if (sum_count > 0) {
+        bench_sum(sum_count);
+    }
+    if (i < argc) {
+        process_file(argv[i], NULL);
+    }
+    if (alloc_report_mode) {
+        alloc_report_print();
+    }
+    if (arena_mode) {
+        decContextSetThreadAllocator(NULL);
+        printf("== arena: allocations=%ld, high-water=%lu bytes,"
+            " overflows=%ld, unreleased=%ld\n", arena.allocs,
+            (unsigned long)arena.high_water, arena.overflows, arena.live);
+        free(arena.base);
+    }
+    decContextFreeWorkspace();
     return 0;
 }